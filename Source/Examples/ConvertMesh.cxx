@@ -1,7 +1,7 @@
-#include "itkMeshFileReader.h"
-#include "itkMeshFileWriter.h"
+#include "itkMeshIOTranscoder.h"
 
-#include "itkMesh.h"
+#include <cstdlib>
+#include <iostream>
 
 int main(int argc, char **argv)
 {
@@ -10,35 +10,18 @@ int main(int argc, char **argv)
 		std::cerr<<"Usage : "<<argv[0]<<" inputMeshFile outputMeshFile"<<std::endl;
 		return EXIT_FAILURE;
 	}
-	
-	typedef float      MeshPixelType;
-	const unsigned int Dimension = 3;
-	
-	typedef itk::Mesh< MeshPixelType, Dimension >   MeshType;
-	typedef itk::MeshFileReader<MeshType>           ReaderType;
-	typedef itk::MeshFileWriter<MeshType>           WriterType;
-	
-	ReaderType::Pointer reader = ReaderType::New();
-	reader->SetFileName(argv[1]);
-	
-	try
-	{
-		reader->Update();
-	}
-	catch(itk::ExceptionObject & err)
-	{
-		std::cerr<<err<<std::endl;
-		return EXIT_FAILURE;
-	}
-	
- 	//Do something with itk::Mesh
-	
-	WriterType::Pointer writer = WriterType::New();
-	writer->SetFileName(argv[2]);
-	writer->SetInput(reader->GetOutput());
+
+	// The sections of the input file are handed to the output MeshIO as
+	// they are read, without building an itk::Mesh
+	typedef itk::MeshIOTranscoder TranscoderType;
+
+	TranscoderType::Pointer transcoder = TranscoderType::New();
+	transcoder->SetInputFileName(argv[1]);
+	transcoder->SetOutputFileName(argv[2]);
+
 	try
 	{
-		writer->Update();
+		transcoder->Update();
 	}
 	catch(itk::ExceptionObject & err)
 	{
@@ -47,5 +30,3 @@ int main(int argc, char **argv)
 	}
 	return EXIT_SUCCESS;
 }
-
-
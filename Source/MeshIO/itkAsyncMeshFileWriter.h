@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkAsyncMeshFileWriter.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-20 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkAsyncMeshFileWriter_h
+#define __itkAsyncMeshFileWriter_h
+
+#include "itkObject.h"
+#include "itkConditionVariable.h"
+#include "itkMeshFileWriter.h"
+#include "itkMultiThreader.h"
+#include "itkMutexLock.h"
+
+#include <deque>
+
+namespace itk
+{
+/** \class AsyncMeshFileWriter
+ * \brief Writes meshes to files on a background thread.
+ *
+ * AsyncMeshFileWriter queues the meshes passed to Write() and writes them
+ * with a MeshFileWriter on a dedicated IO thread, so that the thread
+ * producing the meshes does not wait for the disk. The queue holds at most
+ * MaximumQueueSize meshes; Write() blocks while it is full.
+ *
+ * By default Write() queues a copy of the mesh, which may then be modified
+ * right away. With releaseMesh the mesh itself is queued, which avoids the
+ * copy, and the caller must not modify it any more.
+ *
+ * An exception raised while writing a mesh is thrown by the next call to
+ * Write() or Flush(). The destructor writes the meshes still queued.
+ *
+ * \sa MeshFileWriter
+ *
+ * \ingroup IOFilters
+ */
+template< class TInputMesh >
+class ITK_EXPORT AsyncMeshFileWriter:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef AsyncMeshFileWriter        Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AsyncMeshFileWriter, Object);
+
+  /** Some convenient typedefs. */
+  typedef TInputMesh                           InputMeshType;
+  typedef typename InputMeshType::Pointer      InputMeshPointer;
+  typedef typename InputMeshType::ConstPointer InputMeshConstPointer;
+
+  /** Queue the mesh for writing to fileName. The MeshIO is created here, so
+   * that an unsupported file name is reported right away. Blocks while the
+   * queue is full, and throws the exception of a failed previous write. */
+  void Write(const InputMeshType *mesh, const std::string & fileName, bool releaseMesh = false);
+
+  /** Wait until all queued meshes are written, and throw the exception of
+   * a failed write. */
+  void Flush();
+
+  /** Set/Get the maximum number of meshes waiting to be written. */
+  itkSetClampMacro( MaximumQueueSize, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro(MaximumQueueSize, unsigned int);
+
+  /** Settings of the MeshFileWriter, taken when a mesh is queued. */
+  void SetFileTypeAsASCII(){ m_FileTypeIsBINARY = false; }
+  void SetFileTypeAsBINARY(){ m_FileTypeIsBINARY = true; }
+
+  itkSetMacro(UseCompression, bool);
+  itkGetConstMacro(UseCompression, bool);
+  itkBooleanMacro(UseCompression);
+
+  itkSetMacro(UseStreaming, bool);
+  itkGetConstMacro(UseStreaming, bool);
+  itkBooleanMacro(UseStreaming);
+
+protected:
+  AsyncMeshFileWriter();
+  ~AsyncMeshFileWriter();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** A mesh waiting to be written, with the settings to write it with */
+  struct WriteRequest
+  {
+    InputMeshConstPointer m_Mesh;
+    MeshIOBase::Pointer   m_MeshIO;
+    std::string           m_FileName;
+    bool                  m_FileTypeIsBINARY;
+    bool                  m_UseCompression;
+    bool                  m_UseStreaming;
+  };
+
+  /** Deep copy of the points, cells, point data and cell data of a mesh */
+  static InputMeshPointer CopyMesh(const InputMeshType *mesh);
+
+  template< class TContainer >
+  static typename TContainer::Pointer CopyContainer(const TContainer *container);
+
+  /** Entry point of the IO thread, and the loop writing the queued meshes */
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void *arg);
+
+  void ProcessRequests();
+
+  /** Throw the exception of a failed write, if any. Called with the lock
+   * held, which is released before throwing. */
+  void ThrowPendingError();
+
+private:
+  AsyncMeshFileWriter(const Self &); // purposely not implemented
+  void operator=(const Self &);      // purposely not implemented
+
+  unsigned int m_MaximumQueueSize;
+  bool         m_FileTypeIsBINARY;
+  bool         m_UseCompression;
+  bool         m_UseStreaming;
+
+  /** Queue shared with the IO thread, guarded by m_Lock */
+  std::deque< WriteRequest > m_Requests;
+  bool                       m_Writing;
+  bool                       m_Stop;
+  bool                       m_HasError;
+  ExceptionObject            m_Error;
+
+  SimpleMutexLock            m_Lock;
+  ConditionVariable::Pointer m_RequestQueued;
+  ConditionVariable::Pointer m_RequestDone;
+
+  MultiThreader::Pointer m_Threader;
+  int                    m_ThreadId;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkAsyncMeshFileWriter.txx"
+#endif
+
+#endif // __itkAsyncMeshFileWriter_h
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkAsyncMeshFileWriter.txx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-20 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkAsyncMeshFileWriter_txx
+#define __itkAsyncMeshFileWriter_txx
+
+#include "itkAsyncMeshFileWriter.h"
+#include "itkMeshIOFactory.h"
+
+namespace itk
+{
+template< class TInputMesh >
+AsyncMeshFileWriter< TInputMesh >
+::AsyncMeshFileWriter()
+{
+  m_MaximumQueueSize = 2;
+  m_FileTypeIsBINARY = false;
+  m_UseCompression = false;
+  m_UseStreaming = false;
+
+  m_Writing = false;
+  m_Stop = false;
+  m_HasError = false;
+
+  m_RequestQueued = ConditionVariable::New();
+  m_RequestDone = ConditionVariable::New();
+
+  m_Threader = MultiThreader::New();
+  m_ThreadId = m_Threader->SpawnThread(Self::ThreaderCallback, this);
+}
+
+template< class TInputMesh >
+AsyncMeshFileWriter< TInputMesh >
+::~AsyncMeshFileWriter()
+{
+  // The IO thread writes the remaining meshes before it stops
+  m_Lock.Lock();
+  m_Stop = true;
+  m_RequestQueued->Broadcast();
+  m_Lock.Unlock();
+
+  m_Threader->TerminateThread(m_ThreadId);
+
+  if ( m_HasError )
+    {
+    itkWarningMacro(<< "Failed to write a mesh: " << m_Error.GetDescription());
+    }
+}
+
+template< class TInputMesh >
+void
+AsyncMeshFileWriter< TInputMesh >
+::Write(const InputMeshType *mesh, const std::string & fileName, bool releaseMesh)
+{
+  if ( mesh == 0 )
+    {
+    itkExceptionMacro(<< "No input to writer!");
+    }
+
+  WriteRequest request;
+  request.m_FileName = fileName;
+  request.m_FileTypeIsBINARY = m_FileTypeIsBINARY;
+  request.m_UseCompression = m_UseCompression;
+  request.m_UseStreaming = m_UseStreaming;
+  request.m_MeshIO = MeshIOFactory::CreateMeshIO(fileName.c_str(), MeshIOFactory::WriteMode);
+  if ( request.m_MeshIO.IsNull() )
+    {
+    MeshFileWriterException e(__FILE__, __LINE__);
+    OStringStream           msg;
+    msg << " Could not create IO object for file " << fileName << std::endl;
+    e.SetDescription( msg.str().c_str() );
+    e.SetLocation(ITK_LOCATION);
+    throw e;
+    }
+
+  // The copy is made before waiting for room in the queue, so that the
+  // caller's mesh is not used once it may have been modified
+  if ( releaseMesh )
+    {
+    request.m_Mesh = mesh;
+    }
+  else
+    {
+    InputMeshPointer copy = CopyMesh(mesh);
+    request.m_Mesh = copy.GetPointer();
+    }
+
+  m_Lock.Lock();
+  while ( m_Requests.size() >= m_MaximumQueueSize && !m_HasError )
+    {
+    m_RequestDone->Wait(&m_Lock);
+    }
+  if ( m_HasError )
+    {
+    this->ThrowPendingError();
+    }
+  m_Requests.push_back(request);
+  m_RequestQueued->Signal();
+  m_Lock.Unlock();
+}
+
+template< class TInputMesh >
+void
+AsyncMeshFileWriter< TInputMesh >
+::Flush()
+{
+  m_Lock.Lock();
+  while ( !m_Requests.empty() || m_Writing )
+    {
+    m_RequestDone->Wait(&m_Lock);
+    }
+  if ( m_HasError )
+    {
+    this->ThrowPendingError();
+    }
+  m_Lock.Unlock();
+}
+
+template< class TInputMesh >
+void
+AsyncMeshFileWriter< TInputMesh >
+::ThrowPendingError()
+{
+  ExceptionObject error = m_Error;
+
+  m_HasError = false;
+  m_Lock.Unlock();
+  throw error;
+}
+
+template< class TInputMesh >
+ITK_THREAD_RETURN_TYPE
+AsyncMeshFileWriter< TInputMesh >
+::ThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+
+  static_cast< Self * >( info->UserData )->ProcessRequests();
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TInputMesh >
+void
+AsyncMeshFileWriter< TInputMesh >
+::ProcessRequests()
+{
+  m_Lock.Lock();
+  for (;; )
+    {
+    while ( m_Requests.empty() && !m_Stop )
+      {
+      m_RequestQueued->Wait(&m_Lock);
+      }
+    if ( m_Requests.empty() )
+      {
+      break;
+      }
+
+    WriteRequest request = m_Requests.front();
+    m_Requests.pop_front();
+    m_Writing = true;
+    m_Lock.Unlock();
+
+    // Write without holding the lock, so that meshes can be queued meanwhile
+    bool            failed = false;
+    ExceptionObject error;
+    try
+      {
+      typename MeshFileWriter< InputMeshType >::Pointer writer = MeshFileWriter< InputMeshType >::New();
+      writer->SetMeshIO(request.m_MeshIO);
+      writer->SetFileName( request.m_FileName.c_str() );
+      writer->SetInput(request.m_Mesh);
+      if ( request.m_FileTypeIsBINARY )
+        {
+        writer->SetFileTypeAsBINARY();
+        }
+      writer->SetUseCompression(request.m_UseCompression);
+      writer->SetUseStreaming(request.m_UseStreaming);
+      writer->Write();
+      }
+    catch ( ExceptionObject & e )
+      {
+      failed = true;
+      error = e;
+      }
+    catch ( std::exception & e )
+      {
+      failed = true;
+      error = ExceptionObject( __FILE__, __LINE__, e.what(), ITK_LOCATION );
+      }
+    catch ( ... )
+      {
+      // Any other exception would end the thread without signalling the
+      // request done, and Flush() would wait forever
+      const std::string description = "Unknown exception while writing " + request.m_FileName;
+      failed = true;
+      error = ExceptionObject( __FILE__, __LINE__, description.c_str(), ITK_LOCATION );
+      }
+
+    // Release the mesh before taking the lock again
+    request.m_Mesh = 0;
+
+    m_Lock.Lock();
+    m_Writing = false;
+    if ( failed && !m_HasError )
+      {
+      m_HasError = true;
+      m_Error = error;
+      }
+    m_RequestDone->Broadcast();
+    }
+  m_Lock.Unlock();
+}
+
+template< class TInputMesh >
+typename AsyncMeshFileWriter< TInputMesh >::InputMeshPointer
+AsyncMeshFileWriter< TInputMesh >
+::CopyMesh(const InputMeshType *mesh)
+{
+  InputMeshPointer copy = InputMeshType::New();
+
+  if ( mesh->GetPoints() )
+    {
+    copy->SetPoints( CopyContainer( mesh->GetPoints() ) );
+    }
+
+  if ( mesh->GetCells() )
+    {
+    copy->SetCellsAllocationMethod(InputMeshType::CellsAllocatedDynamicallyCellByCell);
+    for ( typename InputMeshType::CellsContainerConstIterator ct = mesh->GetCells()->Begin();
+          ct != mesh->GetCells()->End(); ++ct )
+      {
+      typename InputMeshType::CellAutoPointer cell;
+      ct.Value()->MakeCopy(cell);
+      copy->SetCell(ct.Index(), cell);
+      }
+    }
+
+  if ( mesh->GetPointData() )
+    {
+    copy->SetPointData( CopyContainer( mesh->GetPointData() ) );
+    }
+
+  if ( mesh->GetCellData() )
+    {
+    copy->SetCellData( CopyContainer( mesh->GetCellData() ) );
+    }
+
+  return copy;
+}
+
+template< class TInputMesh >
+template< class TContainer >
+typename TContainer::Pointer
+AsyncMeshFileWriter< TInputMesh >
+::CopyContainer(const TContainer *container)
+{
+  typename TContainer::Pointer copy = TContainer::New();
+  for ( typename TContainer::ConstIterator it = container->Begin(); it != container->End(); ++it )
+    {
+    copy->InsertElement( it.Index(), it.Value() );
+    }
+
+  return copy;
+}
+
+template< class TInputMesh >
+void
+AsyncMeshFileWriter< TInputMesh >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "MaximumQueueSize: " << m_MaximumQueueSize << "\n";
+  os << indent << "FileTypeIsBINARY: " << ( m_FileTypeIsBINARY ? "On" : "Off" ) << "\n";
+  os << indent << "UseCompression: " << ( m_UseCompression ? "On" : "Off" ) << "\n";
+  os << indent << "UseStreaming: " << ( m_UseStreaming ? "On" : "Off" ) << "\n";
+}
+} // end namespace itk
+
+#endif
@@ -33,29 +33,42 @@ namespace itk
 BYUMeshIO::BYUMeshIO()
 {
   this->AddSupportedWriteExtension(".byu");
+  this->AddSupportedReadExtension(".byu");
   m_PartId = itk::NumericTraits< unsigned int >::max();
   m_FirstCellId = itk::NumericTraits< unsigned int >::One;
   m_LastCellId = itk::NumericTraits< unsigned int >::max();
+  m_PointsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
+  m_CellsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
 }
 
-bool BYUMeshIO::CanReadFile(const char *fileName)
+unsigned int BYUMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
+  // The numbers of parts, points, polygons and edges
+  const std::string::size_type lineEnd = header.find('\n');
+  if ( lineEnd == std::string::npos )
     {
-    return false;
+    return 0;
     }
 
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".byu" )
+  const char *position = header.c_str();
+  const char *end = position + lineEnd;
+  for ( unsigned int ii = 0; ii < 4 && position != 0; ii++ )
     {
-    return false;
+    long long value;
+    position = MeshNumberParser::Parse(position, end, value);
     }
 
-  return true;
+  if ( position == 0 || std::string(position, end).find_first_not_of(" \t\r") != std::string::npos )
+    {
+    return 0;
+    }
+
+  return 30;
 }
 
 bool BYUMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".byu" )
+  if ( this->GetFileNameExtension(fileName) != ".byu" )
     {
     return false;
     }
@@ -63,41 +76,37 @@ bool BYUMeshIO::CanWriteFile(const char *fileName)
   return true;
 }
 
-void BYUMeshIO::ReadMeshInformation()
+void BYUMeshIO::CloseInputFile()
 {
-  // Define input file stream and attach it to input file
-  std::ifstream inputFile;
-
-  // Due to the windows couldn't work well for tellg() and seekg() for ASCII mode, hence we
-  //open the file with std::ios::binary 
-#ifdef _WIN32
-  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-  inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
-
-  if ( !inputFile.is_open() )
+  if ( m_InputFile.is_open() )
     {
-    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
-    return;
+    m_InputFile.close();
     }
+}
+
+void BYUMeshIO::ReadMeshInformation()
+{
+  // Attach the input file stream to input file, which stays open for the
+  // reads of the points and cells.
+  this->OpenInputFile(m_InputFile);
 
   // Read the ASCII file information
   unsigned int numberOfParts = 0;
   unsigned int numberOfEdges = 0;
 
   // Read the number of points and number of cells
-  inputFile >> numberOfParts;
-  inputFile >> this->m_NumberOfPoints;
-  inputFile >> this->m_NumberOfCells;
-  inputFile >> numberOfEdges;
+  MeshNumberParser::Read(m_InputFile, numberOfParts);
+  MeshNumberParser::Read(m_InputFile, this->m_NumberOfPoints);
+  MeshNumberParser::Read(m_InputFile, this->m_NumberOfCells);
+  MeshNumberParser::Read(m_InputFile, numberOfEdges);
 
   // Determine which part to read, default is to readl all parts
   if ( m_PartId > numberOfParts )
     {
     for ( unsigned int ii = 0; ii < numberOfParts; ii++ )
       {
-      inputFile >> m_FirstCellId >> m_LastCellId;
+      MeshNumberParser::Read(m_InputFile, m_FirstCellId);
+      MeshNumberParser::Read(m_InputFile, m_LastCellId);
       }
 
     m_FirstCellId = 1;
@@ -109,20 +118,22 @@ void BYUMeshIO::ReadMeshInformation()
     unsigned int lastId;
     for ( unsigned int ii = 0; ii < m_PartId; ii++ )
       {
-      inputFile >> firstId >> lastId;
+      MeshNumberParser::Read(m_InputFile, firstId);
+      MeshNumberParser::Read(m_InputFile, lastId);
       }
 
-    inputFile >> m_FirstCellId;
-    inputFile >> m_LastCellId;
+    MeshNumberParser::Read(m_InputFile, m_FirstCellId);
+    MeshNumberParser::Read(m_InputFile, m_LastCellId);
 
     for ( unsigned int ii = m_PartId + 1; ii < numberOfParts; ii++ )
       {
-      inputFile >> firstId >> lastId;
+      MeshNumberParser::Read(m_InputFile, firstId);
+      MeshNumberParser::Read(m_InputFile, lastId);
       }
     }
 
   // Determine the start position of points
-  m_FilePosition = inputFile.tellg();
+  m_PointsStartPosition = m_InputFile.tellg();
 
   /** 6. Set default parameters */
   this->m_PointDimension = 3;
@@ -149,17 +160,20 @@ void BYUMeshIO::ReadMeshInformation()
     {
     for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
       {
-      inputFile >> x;
+      MeshNumberParser::Read(m_InputFile, x);
       }
     }
 
+  // Determine the start position of cells
+  m_CellsStartPosition = m_InputFile.tellg();
+
   // Determine cellbuffersize
   int ptId;
   this->m_CellBufferSize = 0;
   SizeValueType numLines = 0;
   while ( numLines < this->m_NumberOfCells )
     {
-    inputFile >> ptId;
+    MeshNumberParser::Read(m_InputFile, ptId);
 
     this->m_CellBufferSize++;
     if ( ptId < 0 )
@@ -181,50 +195,23 @@ void BYUMeshIO::ReadMeshInformation()
   this->m_CellPixelComponentType = FLOAT;
   this->m_CellPixelType  = SCALAR;
   this->m_NumberOfCellPixelComponents = itk::NumericTraits< unsigned int >::One;
-
-  inputFile.close();
 }
 
 void BYUMeshIO::ReadPoints(void *buffer)
 {
-  // Define input file stream and attach it to input file
-  std::ifstream inputFile;
-
-  /** Due to the windows couldn't work well for tellg() and seekg() for ASCII mode, hence we
-  open the file with std::ios::binary */
-#ifdef _WIN32
-  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-  inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
-
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
-    return;
-    }
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the cells may be read meanwhile
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
   // Set the position to points start
-  inputFile.seekg(m_FilePosition, std::ios::beg);
+  inputFile.seekg(m_PointsStartPosition, std::ios::beg);
 
   // Number of data array
   double *data = static_cast< double * >( buffer );
 
   // Read points
-  inputFile.precision(12);
-
-  SizeValueType index = 0;
-  for ( SizeValueType id = 0; id < this->m_NumberOfPoints; id++ )
-    {
-    for ( unsigned int ii = 0; ii < this->m_PointDimension; ii++ )
-      {
-      inputFile >> data[index++];
-      }
-    }
-
-  // Determine cells start position
-  m_FilePosition = inputFile.tellg();
-  inputFile.close();
+  this->ReadBufferAsAscii(data, inputFile, this->m_NumberOfPoints * this->m_PointDimension);
 
   return;
 }
@@ -232,38 +219,26 @@ void BYUMeshIO::ReadPoints(void *buffer)
 void BYUMeshIO::ReadCells(void *buffer)
 {
   // Define input file stream and attach it to input file
-  std::ifstream inputFile;
-
-#ifdef _WIN32
-  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-  inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
-
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open input file " << this->m_FileName);
-    return;
-    }
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
-  // Set the position to current position
-  inputFile.seekg(m_FilePosition, std::ios::beg);
+  // Set the position to cells start
+  inputFile.seekg(m_CellsStartPosition, std::ios::beg);
 
   // Get cell buffer
-  inputFile.precision(12);
-  unsigned int *data = static_cast< unsigned int * >( buffer );
-  unsigned int  numPoints = 0;
-  SizeValueType id = itk::NumericTraits< SizeValueType >::Zero;
-  SizeValueType index = 2;
-  int           ptId;
-  m_FirstCellId -= 1;
-  m_LastCellId -= 1;
+  unsigned int *     data = static_cast< unsigned int * >( buffer );
+  unsigned int       numPoints = 0;
+  SizeValueType      id = itk::NumericTraits< SizeValueType >::Zero;
+  SizeValueType      index = 2;
+  int                ptId;
+  const unsigned int firstCellId = m_FirstCellId - 1;
+  const unsigned int lastCellId = m_LastCellId - 1;
   while ( id < this->m_NumberOfCells )
     {
-    inputFile >> ptId;
+    MeshNumberParser::Read(inputFile, ptId);
     if ( ptId >= 0 )
       {
-      if ( id >= m_FirstCellId && id <= m_LastCellId )
+      if ( id >= firstCellId && id <= lastCellId )
         {
         data[index++] = ptId - 1;
         numPoints++;
@@ -271,7 +246,7 @@ void BYUMeshIO::ReadCells(void *buffer)
       }
     else
       {
-      if ( id >= m_FirstCellId && id <= m_LastCellId )
+      if ( id >= firstCellId && id <= lastCellId )
         {
         data[index++] = -( ptId + 1 );
         numPoints++;
@@ -284,8 +259,6 @@ void BYUMeshIO::ReadCells(void *buffer)
       }
     }
 
-  inputFile.close();
-
   return;
 }
 
@@ -302,51 +275,38 @@ void BYUMeshIO::ReadCellData(void *buffer)
 void BYUMeshIO::WriteMeshInformation()
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios::out);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  // The output file stays open until Write()
+  this->OpenOutputFile();
 
   // Write BYU file header
   Indent indent(7);
-  outputFile << indent << 1;
-  outputFile << indent << this->m_NumberOfPoints;
-  outputFile << indent << this->m_NumberOfCells;
-  outputFile << indent << this->m_NumberOfPoints + this->m_NumberOfCells - 2 << std::endl;
-  outputFile << indent << 1;
-  outputFile << indent << this->m_NumberOfCells << std::endl;
-
-  outputFile.close();
+  m_OutputFile << indent << 1;
+  m_OutputFile << indent << this->m_NumberOfPoints;
+  m_OutputFile << indent << this->m_NumberOfCells;
+  m_OutputFile << indent << this->m_NumberOfPoints + this->m_NumberOfCells - 2 << "\n";
+  m_OutputFile << indent << 1;
+  m_OutputFile << indent << this->m_NumberOfCells << "\n";
 }
 
 void BYUMeshIO::WritePoints(void *buffer)
 {
   // check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app);
-
-  if ( !outputFile.is_open() )
+  // Write to the output file opened by WriteMeshInformation()
+  if ( !m_OutputFile.is_open() )
     {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
+    this->OpenOutputFile(true);
     }
 
   // Write points
@@ -354,78 +314,78 @@ void BYUMeshIO::WritePoints(void *buffer)
     {
     case UCHAR:
       {
-      WritePoints(static_cast< unsigned char * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned char * >( buffer ), m_OutputFile);
       break;
       }
     case CHAR:
       {
-      WritePoints(static_cast< char * >( buffer ), outputFile);
+      WritePoints(static_cast< char * >( buffer ), m_OutputFile);
 
       break;
       }
     case USHORT:
       {
-      WritePoints(static_cast< unsigned short * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned short * >( buffer ), m_OutputFile);
 
       break;
       }
     case SHORT:
       {
-      WritePoints(static_cast< short * >( buffer ), outputFile);
+      WritePoints(static_cast< short * >( buffer ), m_OutputFile);
 
       break;
       }
     case UINT:
       {
-      WritePoints(static_cast< unsigned int * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned int * >( buffer ), m_OutputFile);
 
       break;
       }
     case INT:
       {
-      WritePoints(static_cast< int * >( buffer ), outputFile);
+      WritePoints(static_cast< int * >( buffer ), m_OutputFile);
 
       break;
       }
     case ULONG:
       {
-      WritePoints(static_cast< unsigned long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long * >( buffer ), m_OutputFile);
 
       break;
       }
     case LONG:
       {
-      WritePoints(static_cast< long * >( buffer ), outputFile);
+      WritePoints(static_cast< long * >( buffer ), m_OutputFile);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePoints(static_cast< unsigned long long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long long * >( buffer ), m_OutputFile);
 
       break;
       }
     case LONGLONG:
       {
-      WritePoints(static_cast< long long * >( buffer ), outputFile);
+      WritePoints(static_cast< long long * >( buffer ), m_OutputFile);
 
       break;
       }
     case FLOAT:
       {
-      WritePoints(static_cast< float * >( buffer ), outputFile);
+      WritePoints(static_cast< float * >( buffer ), m_OutputFile);
 
       break;
       }
     case DOUBLE:
       {
-      WritePoints(static_cast< double * >( buffer ), outputFile);
+      WritePoints(static_cast< double * >( buffer ), m_OutputFile);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePoints(static_cast< long double * >( buffer ), outputFile);
+      WritePoints(static_cast< long double * >( buffer ), m_OutputFile);
 
       break;
       }
@@ -435,27 +395,22 @@ void BYUMeshIO::WritePoints(void *buffer)
       }
     }
 
-  outputFile.close();
   return;
 }
 
 void BYUMeshIO::WriteCells(void *buffer)
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app);
-
-  if ( !outputFile.is_open() )
+  // Write to the output file opened by WriteMeshInformation()
+  if ( !m_OutputFile.is_open() )
     {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
+    this->OpenOutputFile(true);
     }
 
   // Write triangles
@@ -463,67 +418,67 @@ void BYUMeshIO::WriteCells(void *buffer)
     {
     case UCHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile);
       break;
       }
     case CHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile);
       break;
       }
     case USHORT:
       {
-      WriteCells(static_cast< unsigned short * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned short * >( buffer ), m_OutputFile);
       break;
       }
     case SHORT:
       {
-      WriteCells(static_cast< short * >( buffer ), outputFile);
+      WriteCells(static_cast< short * >( buffer ), m_OutputFile);
       break;
       }
     case UINT:
       {
-      WriteCells(static_cast< unsigned int * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned int * >( buffer ), m_OutputFile);
       break;
       }
     case INT:
       {
-      WriteCells(static_cast< int * >( buffer ), outputFile);
+      WriteCells(static_cast< int * >( buffer ), m_OutputFile);
       break;
       }
     case ULONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile);
       break;
       }
     case LONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile);
       break;
       }
     case ULONGLONG:
       {
-      WriteCells(static_cast< unsigned long long * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned long long * >( buffer ), m_OutputFile);
       break;
       }
     case LONGLONG:
       {
-      WriteCells(static_cast< long long * >( buffer ), outputFile);
+      WriteCells(static_cast< long long * >( buffer ), m_OutputFile);
       break;
       }
     case FLOAT:
       {
-      WriteCells(static_cast< float * >( buffer ), outputFile);
+      WriteCells(static_cast< float * >( buffer ), m_OutputFile);
       break;
       }
     case DOUBLE:
       {
-      WriteCells(static_cast< double * >( buffer ), outputFile);
+      WriteCells(static_cast< double * >( buffer ), m_OutputFile);
       break;
       }
     case LDOUBLE:
       {
-      WriteCells(static_cast< long double * >( buffer ), outputFile);
+      WriteCells(static_cast< long double * >( buffer ), m_OutputFile);
       break;
       }
     default:
@@ -532,7 +487,6 @@ void BYUMeshIO::WriteCells(void *buffer)
       }
     }
 
-  outputFile.close();
 
   return;
 }
@@ -548,7 +502,9 @@ void BYUMeshIO::WriteCellData(void *buffer)
 }
 
 void BYUMeshIO::Write()
-{}
+{
+  this->CloseOutputFile();
+}
 
 void BYUMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -55,12 +55,9 @@ public:
 
   /*-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-* \param FileNameToRead The name of the file to test for reading.
-* \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-* \return Returns true if this MeshIO can read the file specified.
-   */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: BYU files have no magic number, a first
+   * line of four integers scores 30 */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
@@ -74,6 +71,10 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine if the file can be written with this MeshIO implementation.
@@ -100,38 +101,44 @@ public:
 protected:
   /** Write points to output stream */
   template< typename T >
-  void WritePoints(T *buffer, std::ofstream & outputFile)
+  void WritePoints(T *buffer, std::ostream & outputFile)
     {
-    Indent        indent(1);
-    SizeValueType index = itk::NumericTraits< SizeValueType >::Zero;
+    // The scientific notation applies with an AsciiPrecision
+    outputFile.setf(std::ios::scientific, std::ios::floatfield);
+
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = itk::NumericTraits< SizeValueType >::Zero;
 
     for ( SizeValueType ii = 0; ii < this->m_NumberOfPoints; ii++ )
       {
-      outputFile << indent;
+      formatter << " ";
       for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
         {
-        outputFile << std::scientific << buffer[index++] << " ";
+        formatter << buffer[index++] << " ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
   template< typename T >
-  void WriteCells(T *buffer, std::ofstream & outputFile)
+  void WriteCells(T *buffer, std::ostream & outputFile)
     {
-    Indent        indent(7);
-    SizeValueType index = itk::NumericTraits< SizeValueType >::Zero;
+    const char *        indent = "       ";
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = itk::NumericTraits< SizeValueType >::Zero;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    for ( SizeValueType ii = 0; ii < this->m_NumberOfCells; ii++ )
       {
       unsigned int numberOfCellPoints = static_cast< unsigned int >( buffer[++index] );
       index++;
       for ( unsigned int jj = 0; jj < numberOfCellPoints - 1; jj++ )
         {
-        outputFile << indent << buffer[index++] + 1;
+        formatter << indent << buffer[index++] + 1;
         }
 
-      outputFile << indent << -( buffer[index++] + 1 ) << '\n';
+      // The last point of a cell is marked by a minus sign, written on its
+      // own so that unsigned point identifiers are not wrapped around
+      formatter << indent << "-" << buffer[index++] + 1 << '\n';
       }
     }
 
@@ -145,11 +152,12 @@ private:
   BYUMeshIO(const Self &);      // purposely not implemented
   void operator=(const Self &); // purposely not implemented
 
-  StreamOffsetType m_FilePosition;
-  unsigned int     m_PartId;
-  unsigned int     m_FirstCellId;
-  unsigned int     m_LastCellId;
-  // std::ifstream    m_InputFile;
+  MeshInputFileStream m_InputFile;
+  StreamOffsetType    m_PointsStartPosition;
+  StreamOffsetType    m_CellsStartPosition;
+  unsigned int        m_PartId;
+  unsigned int        m_FirstCellId;
+  unsigned int        m_LastCellId;
 };
 } // end namespace itk
 
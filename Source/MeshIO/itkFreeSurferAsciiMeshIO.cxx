@@ -27,6 +27,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <limits>
 #include <vector>
 
 namespace itk
@@ -34,26 +35,19 @@ namespace itk
 FreeSurferAsciiMeshIO::FreeSurferAsciiMeshIO()
 {
   this->AddSupportedWriteExtension(".fsa");
+  this->AddSupportedReadExtension(".fsa");
+  m_PointsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
+  m_CellsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
 }
 
-bool FreeSurferAsciiMeshIO::CanReadFile(const char *fileName)
+unsigned int FreeSurferAsciiMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
-    {
-    return false;
-    }
-
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fsa" )
-    {
-    return false;
-    }
-
-  return true;
+  return header.compare(0, 7, "#!ascii") == 0 ? 100 : 0;
 }
 
 bool FreeSurferAsciiMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fsa" )
+  if ( this->GetFileNameExtension(fileName) != ".fsa" )
     {
     return false;
     }
@@ -63,27 +57,11 @@ bool FreeSurferAsciiMeshIO::CanWriteFile(const char *fileName)
 
 void FreeSurferAsciiMeshIO::OpenFile()
 {
-  if ( this->m_FileName.empty() )
-    {
-    itkExceptionMacro("No input FileName");
-    }
-
-  if ( !itksys::SystemTools::FileExists( m_FileName.c_str() ) )
-    {
-    itkExceptionMacro("File " << this->m_FileName << " does not exist");
-    }
-
-  this->m_InputFile.open(this->m_FileName.c_str(), std::ios::in);
-
-  if ( !m_InputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file " << this->m_FileName);
-    }
-
-  return;
+  // FileName, or the input buffer or stream set in its place
+  this->OpenInputFile(m_InputFile);
 }
 
-void FreeSurferAsciiMeshIO::CloseFile()
+void FreeSurferAsciiMeshIO::CloseInputFile()
 {
   if ( m_InputFile.is_open() )
     {
@@ -106,12 +84,34 @@ void FreeSurferAsciiMeshIO::ReadMeshInformation()
     std::getline(m_InputFile, line);
     }
   this->m_FileType = ASCII;
+  this->ResetSectionLayouts();
+  this->m_SectionLayouts[CELLS_SECTION].UniformCellArity = numberOfCellPoints;
 
   // Read the number of points and number of cells 
-  m_InputFile >> this->m_NumberOfPoints;
-  m_InputFile >> this->m_NumberOfCells;
+  MeshNumberParser::Read(m_InputFile, this->m_NumberOfPoints);
+  MeshNumberParser::Read(m_InputFile, this->m_NumberOfCells);
   this->m_PointDimension = 3;
 
+  // Find the triangles after the lines of the points, so that the points
+  // and the cells may be read concurrently
+  m_PointsStartPosition = m_InputFile.tellg();
+  m_InputFile.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+
+  SizeValueType numberOfPointLines = 0;
+  while ( numberOfPointLines < this->m_NumberOfPoints && std::getline(m_InputFile, line) )
+    {
+    if ( line.find_first_not_of(" \t\r") != std::string::npos )
+      {
+      numberOfPointLines++;
+      }
+    }
+  if ( numberOfPointLines < this->m_NumberOfPoints )
+    {
+    itkExceptionMacro(<< this->m_FileName << " holds " << numberOfPointLines << " of its "
+                      << this->m_NumberOfPoints << " points");
+    }
+  m_CellsStartPosition = m_InputFile.tellg();
+
   // If number of points is not equal zero, update points
   if ( this->m_NumberOfPoints )
     {
@@ -147,18 +147,19 @@ void FreeSurferAsciiMeshIO::ReadPoints(void *buffer)
   // Number of data array
   float *data = static_cast< float * >( buffer );
 
-  // Read points
-  m_InputFile.precision(12);
+  // Read points through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the cells may be read meanwhile
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
+  inputFile.seekg(m_PointsStartPosition, std::ios::beg);
   float value;
 
-  unsigned long index = 0;
-  for ( unsigned long id = 0; id < this->m_NumberOfPoints; id++ )
+  SizeValueType index = 0;
+  for ( SizeValueType id = 0; id < this->m_NumberOfPoints; id++ )
     {
-    for ( unsigned int ii = 0; ii < this->m_PointDimension; ii++ )
-      {
-      m_InputFile >> data[index++];
-      }
-    m_InputFile >> value;
+    this->ReadBufferAsAscii(data + index, inputFile, this->m_PointDimension);
+    index += this->m_PointDimension;
+    MeshNumberParser::Read(inputFile, value);
     }
 
   return;
@@ -167,25 +168,23 @@ void FreeSurferAsciiMeshIO::ReadPoints(void *buffer)
 void FreeSurferAsciiMeshIO::ReadCells(void *buffer)
 {
   // Get cell buffer
-  m_InputFile.precision(12);
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
+  inputFile.seekg(m_CellsStartPosition, std::ios::beg);
   const unsigned int numberOfCellPoints = 3;
   unsigned int *     data = new unsigned int[this->m_NumberOfCells * numberOfCellPoints];
-  unsigned long      index = 0;
+  SizeValueType      index = 0;
   float              value;
 
-  for ( unsigned long id = 0; id < this->m_NumberOfCells; id++ )
+  for ( SizeValueType id = 0; id < this->m_NumberOfCells; id++ )
     {
-    for ( unsigned int ii = 0; ii < numberOfCellPoints; ii++ )
-      {
-      m_InputFile >> data[index++];
-      }
-    m_InputFile >> value;
+    this->ReadBufferAsAscii(data + index, inputFile, numberOfCellPoints);
+    index += numberOfCellPoints;
+    MeshNumberParser::Read(inputFile, value);
     }
 
   this->WriteCellsBuffer(data, static_cast< unsigned int * >( buffer ), TRIANGLE_CELL, 3, this->m_NumberOfCells);
   delete[] data;
-
-  CloseFile();
 }
 
 void FreeSurferAsciiMeshIO::ReadPointData(void *buffer)
@@ -201,128 +200,109 @@ void FreeSurferAsciiMeshIO::ReadCellData(void *buffer)
 void FreeSurferAsciiMeshIO::WriteMeshInformation()
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile( this->m_FileName.c_str() );
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  // The output file stays open until Write()
+  this->OpenOutputFile();
 
   // Write FreeSurfer Surface file header
-  outputFile << "#!ascii version of " << this->m_FileName << std::endl;
+  m_OutputFile << "#!ascii version of " << this->m_FileName << "\n";
 
   // Write the number of points and number of cells
-  outputFile << this->m_NumberOfPoints << "    " << this->m_NumberOfCells << std::endl;
-
-  outputFile.close();
+  m_OutputFile << this->m_NumberOfPoints << "    " << this->m_NumberOfCells << "\n";
 }
 
 void FreeSurferAsciiMeshIO::WritePoints(void *buffer)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(POINTS_SECTION);
+  this->WritePointsChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTS_SECTION);
+}
 
+void FreeSurferAsciiMeshIO::WritePointsChunk(void *buffer, SizeValueType numberOfPoints)
+{
   // Write points
   switch ( this->m_PointComponentType )
     {
     case UCHAR:
       {
-      WritePoints(static_cast< unsigned char * >( buffer ), outputFile, itk::NumericTraits< unsigned char >::Zero);
+      WritePoints(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< unsigned char >::Zero);
       break;
       }
     case CHAR:
       {
-      WritePoints(static_cast< char * >( buffer ), outputFile, itk::NumericTraits< char >::Zero);
+      WritePoints(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< char >::Zero);
 
       break;
       }
     case USHORT:
       {
-      WritePoints(static_cast< unsigned short * >( buffer ), outputFile, itk::NumericTraits< unsigned short >::Zero);
+      WritePoints(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< unsigned short >::Zero);
 
       break;
       }
     case SHORT:
       {
-      WritePoints(static_cast< short * >( buffer ), outputFile, itk::NumericTraits< short >::Zero);
+      WritePoints(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< short >::Zero);
 
       break;
       }
     case UINT:
       {
-      WritePoints(static_cast< unsigned int * >( buffer ), outputFile, itk::NumericTraits< unsigned int >::Zero);
+      WritePoints(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< unsigned int >::Zero);
 
       break;
       }
     case INT:
       {
-      WritePoints(static_cast< int * >( buffer ), outputFile, itk::NumericTraits< int >::Zero);
+      WritePoints(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< int >::Zero);
 
       break;
       }
     case ULONG:
       {
-      WritePoints(static_cast< unsigned long * >( buffer ), outputFile, itk::NumericTraits< unsigned long >::Zero);
+      WritePoints(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< unsigned long >::Zero);
 
       break;
       }
     case LONG:
       {
-      WritePoints(static_cast< long * >( buffer ), outputFile, itk::NumericTraits< long >::Zero);
+      WritePoints(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< long >::Zero);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePoints( static_cast< unsigned long long * >( buffer ), outputFile,
+      WritePoints( static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints,
                   static_cast< unsigned long long >( itk::NumericTraits< unsigned long >::Zero ) );
 
       break;
       }
     case LONGLONG:
       {
-      WritePoints( static_cast< long long * >( buffer ), outputFile, static_cast< long long >( itk::NumericTraits< long >::Zero ) );
+      WritePoints( static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints, static_cast< long long >( itk::NumericTraits< long >::Zero ) );
 
       break;
       }
     case FLOAT:
       {
-      WritePoints(static_cast< float * >( buffer ), outputFile, itk::NumericTraits< float >::Zero);
+      WritePoints(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< float >::Zero);
 
       break;
       }
     case DOUBLE:
       {
-      WritePoints(static_cast< double * >( buffer ), outputFile, itk::NumericTraits< double >::Zero);
+      WritePoints(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< double >::Zero);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePoints(static_cast< long double * >( buffer ), outputFile, itk::NumericTraits< long double >::Zero);
+      WritePoints(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints, itk::NumericTraits< long double >::Zero);
 
       break;
       }
@@ -331,97 +311,84 @@ void FreeSurferAsciiMeshIO::WritePoints(void *buffer)
       itkExceptionMacro(<< "Unknown point pixel component type" << std::endl);
       }
     }
-
-  outputFile.close();
-  return;
 }
 
 void FreeSurferAsciiMeshIO::WriteCells(void *buffer)
 {
-  // Check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(CELLS_SECTION);
+  this->WriteCellsChunk(buffer, this->m_NumberOfCells);
+  this->EndWriteSection(CELLS_SECTION);
+}
 
+void FreeSurferAsciiMeshIO::WriteCellsChunk(void *buffer, SizeValueType numberOfCells)
+{
   // Write triangles
   switch ( this->m_CellComponentType )
     {
     case UCHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case CHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case USHORT:
       {
-      WriteCells(static_cast< unsigned short * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case SHORT:
       {
-      WriteCells(static_cast< short * >( buffer ), outputFile);
+      WriteCells(static_cast< short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case UINT:
       {
-      WriteCells(static_cast< unsigned int * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case INT:
       {
-      WriteCells(static_cast< int * >( buffer ), outputFile);
+      WriteCells(static_cast< int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONGLONG:
       {
-      WriteCells( static_cast< unsigned long long * >( buffer ), outputFile,
+      WriteCells( static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfCells,
                  static_cast< unsigned long long >( itk::NumericTraits< unsigned long >::Zero ) );
       break;
       }
     case LONGLONG:
       {
-      WriteCells( static_cast< long long * >( buffer ), outputFile, static_cast< long long >( itk::NumericTraits< long >::Zero ) );
+      WriteCells( static_cast< long long * >( buffer ), m_OutputFile, numberOfCells, static_cast< long long >( itk::NumericTraits< long >::Zero ) );
       break;
       }
     case FLOAT:
       {
-      WriteCells(static_cast< float * >( buffer ), outputFile);
+      WriteCells(static_cast< float * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case DOUBLE:
       {
-      WriteCells(static_cast< double * >( buffer ), outputFile);
+      WriteCells(static_cast< double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LDOUBLE:
       {
-      WriteCells(static_cast< long double * >( buffer ), outputFile);
+      WriteCells(static_cast< long double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     default:
@@ -429,24 +396,32 @@ void FreeSurferAsciiMeshIO::WriteCells(void *buffer)
       itkExceptionMacro(<< "Unknown cell pixel component type" << std::endl);
       }
     }
+}
 
-  outputFile.close();
+void FreeSurferAsciiMeshIO::WritePointData(void *buffer)
+{
+  return;
+}
 
+void FreeSurferAsciiMeshIO::WriteCellData(void *buffer)
+{
   return;
 }
 
-void FreeSurferAsciiMeshIO::WritePointData(void *buffer)
+void FreeSurferAsciiMeshIO::WritePointDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfPoints))
 {
   return;
 }
 
-void FreeSurferAsciiMeshIO::WriteCellData(void *buffer)
+void FreeSurferAsciiMeshIO::WriteCellDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
 {
   return;
 }
 
 void FreeSurferAsciiMeshIO::Write()
-{}
+{
+  this->CloseOutputFile();
+}
 
 void FreeSurferAsciiMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
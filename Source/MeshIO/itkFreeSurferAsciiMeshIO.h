@@ -53,12 +53,9 @@ public:
 
   /*-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-  * \param FileNameToRead The name of the file to test for reading.
-  * \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-  * \return Returns true if this MeshIO can read the file specified.
-  */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: 100 for the "#!ascii" comment starting
+   * the FreeSurfer ASCII surfaces */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
@@ -72,6 +69,10 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine if the file can be written with this MeshIO implementation.
@@ -96,51 +97,67 @@ public:
 
   virtual void Write();
 
+  /** FreeSurfer ascii files are written chunk by chunk, point and cell data
+   * are ignored */
+  virtual bool CanStreamWrite() { return true; }
+
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
 protected:
   /** Write points to output stream */
   template< typename T >
-  void WritePoints(T *buffer, std::ofstream & outputFile, T label = itk::NumericTraits< T >::Zero)
+  void WritePoints(T *buffer, std::ostream & outputFile, SizeValueType numberOfPoints, T label = itk::NumericTraits< T >::Zero)
   {
-    outputFile.precision(6);
-    unsigned long index = 0;
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+    // The fixed notation applies with an AsciiPrecision
+    outputFile.setf(std::ios::fixed, std::ios::floatfield);
+
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = 0;
+    for ( SizeValueType ii = 0; ii < numberOfPoints; ii++ )
       {
       for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
         {
-        outputFile << std::fixed << buffer[index++] << "  ";
+        formatter << buffer[index++] << "  ";
         }
-      outputFile << label << '\n';
+      formatter << label << '\n';
       }
   }
 
   template< typename T >
-  void WriteCells(T *buffer, std::ofstream & outputFile, T label = itk::NumericTraits< T >::Zero)
+  void WriteCells(T *buffer, std::ostream & outputFile, SizeValueType numberOfCells, T label = itk::NumericTraits< T >::Zero)
   {
     const unsigned int numberOfCellPoints = 3;
-    unsigned long      index = 0;
+    SizeValueType      index = 0;
 
-    T *data = new T[this->m_NumberOfCells * numberOfCellPoints];
+    T *data = new T[numberOfCells * numberOfCellPoints];
 
-    ReadCellsBuffer(buffer, data);
+    ReadCellsBuffer(buffer, data, numberOfCells);
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
       for ( unsigned int jj = 0; jj < numberOfCellPoints; jj++ )
         {
-        outputFile << data[index++] << "  ";
+        formatter << data[index++] << "  ";
         }
-      outputFile << label << '\n';
+      formatter << label << '\n';
       }
     delete[] data;
   }
 
   /** Read cells from a data buffer, used when writting cells */
   template< typename TInput, typename TOutput >
-  void ReadCellsBuffer(TInput *input, TOutput *output)
+  void ReadCellsBuffer(TInput *input, TOutput *output, SizeValueType numberOfCells)
     {
     if ( input && output )
       {
-      for ( size_t ii = 0; ii < this->m_NumberOfCells; ii++ )
+      for ( size_t ii = 0; ii < numberOfCells; ii++ )
         {
         for ( unsigned int jj = 0; jj < 3; jj++ )
           {
@@ -159,13 +176,13 @@ protected:
 
   void OpenFile();
 
-  void CloseFile();
-
 private:
   FreeSurferAsciiMeshIO(const Self &); // purposely not implemented
   void operator=(const Self &); // purposely not implemented
 
-  std::ifstream m_InputFile;
+  MeshInputFileStream m_InputFile;
+  StreamOffsetType    m_PointsStartPosition; // file position for points relative to std::ios::beg
+  StreamOffsetType    m_CellsStartPosition;  // file position for cells relative to std::ios::beg
 };
 } // end namespace itk
 
@@ -35,28 +35,33 @@ FreeSurferBinaryMeshIO::FreeSurferBinaryMeshIO()
 {
   this->AddSupportedWriteExtension(".fsb");
   this->AddSupportedWriteExtension(".fcv");
+  this->AddSupportedReadExtension(".fsb");
+  this->AddSupportedReadExtension(".fcv");
+
+  // Surfaces and curvatures are always written in binary, big endian
+  this->m_FileType = BINARY;
+  this->m_ByteOrder = BigEndian;
+  m_FileTypeIdentifier = 0;
+  m_DataStartPosition = 0;
 }
 
-bool FreeSurferBinaryMeshIO::CanReadFile(const char *fileName)
+unsigned int FreeSurferBinaryMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
-    {
-    return false;
-    }
-
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fsb" 
-       && itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fcv" )
+  // Surfaces start with 0xFFFFFE, curvatures with 0xFFFFFF
+  if ( header.size() < 3
+       || static_cast< unsigned char >( header[0] ) != 0xFF || static_cast< unsigned char >( header[1] ) != 0xFF
+       || ( static_cast< unsigned char >( header[2] ) != 0xFE && static_cast< unsigned char >( header[2] ) != 0xFF ) )
     {
-    return false;
+    return 0;
     }
 
-  return true;
+  return 100;
 }
 
 bool FreeSurferBinaryMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fsb" 
-       && itksys::SystemTools::GetFilenameLastExtension(fileName) != ".fcv" )
+  if ( this->GetFileNameExtension(fileName) != ".fsb" 
+       && this->GetFileNameExtension(fileName) != ".fcv" )
     {
     return false;
     }
@@ -66,27 +71,11 @@ bool FreeSurferBinaryMeshIO::CanWriteFile(const char *fileName)
 
 void FreeSurferBinaryMeshIO::OpenFile()
 {
-  if ( this->m_FileName.empty() )
-    {
-    itkExceptionMacro("No input FileName");
-    }
-
-  if ( !itksys::SystemTools::FileExists( m_FileName.c_str() ) )
-    {
-    itkExceptionMacro("File " << this->m_FileName << " does not exist");
-    }
-
-  m_InputFile.open(this->m_FileName.c_str(), std::ios::binary);
-
-  if ( !this->m_InputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file inputFile " << this->m_FileName);
-    }
-
-  return;
+  // FileName, or the input buffer or stream set in its place
+  this->OpenInputFile(m_InputFile);
 }
 
-void FreeSurferBinaryMeshIO::CloseFile()
+void FreeSurferBinaryMeshIO::CloseInputFile()
 {
   if ( m_InputFile.is_open() )
     {
@@ -104,6 +93,7 @@ void FreeSurferBinaryMeshIO::ReadMeshInformation()
   const unsigned int fileTypeIdLength = 3;
   unsigned char      fileTypeId[fileTypeIdLength];
   this->m_FileType = BINARY;
+  this->ResetSectionLayouts();
 
   // Read file type
   m_InputFile.read(reinterpret_cast< char * >( fileTypeId ), fileTypeIdLength);
@@ -147,13 +137,14 @@ void FreeSurferBinaryMeshIO::ReadMeshInformation()
     itk::uint32_t numberOfPoints;
     m_InputFile.read( (char *)( &numberOfPoints ), sizeof( numberOfPoints ) );
     itk::ByteSwapper< itk::uint32_t >::SwapFromSystemToBigEndian(&numberOfPoints);
-    this->m_NumberOfPoints = static_cast< unsigned long int >( numberOfPoints );
+    this->m_NumberOfPoints = static_cast< SizeValueType >( numberOfPoints );
 
     itk::uint32_t numberOfCells;
     m_InputFile.read( (char *)( &numberOfCells ), sizeof( numberOfCells ) );
     itk::ByteSwapper< itk::uint32_t >::SwapFromSystemToBigEndian(&numberOfCells);
-    this->m_NumberOfCells = static_cast< unsigned long int >( numberOfCells );
+    this->m_NumberOfCells = static_cast< SizeValueType >( numberOfCells );
 
+    m_DataStartPosition = m_InputFile.tellg();
     this->m_PointDimension = 3;
 
     // If number of points is not equal zero, update points
@@ -174,6 +165,12 @@ void FreeSurferBinaryMeshIO::ReadMeshInformation()
     // Set default cell component type
     this->m_CellComponentType  = UINT;
     this->m_CellBufferSize = this->m_NumberOfCells * ( numberOfCellPoints + 2 );
+
+    // The points are a block of big endian floats, the triangles records of
+    // three 32 bits identifiers
+    this->SetBinarySectionLayout(POINTS_SECTION, FLOAT, this->m_PointDimension, true);
+    this->SetBinarySectionLayout(CELLS_SECTION, UINT, numberOfCellPoints, false);
+    this->m_SectionLayouts[CELLS_SECTION].UniformCellArity = numberOfCellPoints;
     }
   // If input file is curvature file
   else if ( m_FileTypeIdentifier == ( -1 & 0x00ffffff ) )
@@ -188,16 +185,19 @@ void FreeSurferBinaryMeshIO::ReadMeshInformation()
     itk::uint32_t numberOfPoints;
     m_InputFile.read( (char *)( &numberOfPoints ), sizeof( numberOfPoints ) );
     itk::ByteSwapper< itk::uint32_t >::SwapFromSystemToBigEndian(&numberOfPoints);
-    this->m_NumberOfPoints = static_cast< unsigned long int >( numberOfPoints );
+    this->m_NumberOfPoints = static_cast< SizeValueType >( numberOfPoints );
 
     itk::uint32_t numberOfCells;
     m_InputFile.read( (char *)( &numberOfCells ), sizeof( numberOfCells ) );
     itk::ByteSwapper< itk::uint32_t >::SwapFromSystemToBigEndian(&numberOfCells);
-    this->m_NumberOfCells = static_cast< unsigned long int >( numberOfCells );
+    this->m_NumberOfCells = static_cast< SizeValueType >( numberOfCells );
 
     itk::uint32_t numberOfValuesPerPoint;
     m_InputFile.read( (char *)( &numberOfValuesPerPoint ), sizeof( numberOfValuesPerPoint ) );
     itk::ByteSwapper< itk::uint32_t >::SwapFromSystemToBigEndian(&numberOfValuesPerPoint);
+
+    m_DataStartPosition = m_InputFile.tellg();
+    this->SetBinarySectionLayout(POINTDATA_SECTION, FLOAT, 1, true);
     }
   else
     {
@@ -219,11 +219,10 @@ void FreeSurferBinaryMeshIO::ReadMeshInformation()
 
 void FreeSurferBinaryMeshIO::ReadPoints(void *buffer)
 {
-  // Number of data array
-  float *data = static_cast< float * >( buffer );
-
-  m_InputFile.read( static_cast< char * >( buffer ), this->m_NumberOfPoints * this->m_PointDimension * sizeof( float ) );
-  itk::ByteSwapper< float >::SwapRangeFromSystemToBigEndian(data, this->m_NumberOfPoints * this->m_PointDimension);
+  // The file stays open after ReadMeshInformation(), and is read at fixed
+  // positions, so that the sections may be read concurrently
+  this->ReadBufferRangeAsBinary(m_InputFile, buffer, m_DataStartPosition, FLOAT, 0,
+                                this->m_NumberOfPoints * this->m_PointDimension);
 
   return;
 }
@@ -233,25 +232,28 @@ void FreeSurferBinaryMeshIO::ReadCells(void *buffer)
   const unsigned int numberOfCellPoints = 3;
   itk::uint32_t *    data = new itk::uint32_t[this->m_NumberOfCells * numberOfCellPoints];
 
-  m_InputFile.read( reinterpret_cast< char * >( data ), this->m_NumberOfCells * numberOfCellPoints * sizeof( itk::uint32_t ) );
-  itk::ByteSwapper< itk::uint32_t >::SwapRangeFromSystemToBigEndian(data, this->m_NumberOfCells * numberOfCellPoints);
+  // The triangles follow the points
+  try
+    {
+    this->ReadBufferRangeAsBinary(m_InputFile, data, this->GetCellsStartPosition(), UINT, 0,
+                                  this->m_NumberOfCells * numberOfCellPoints);
+    }
+  catch ( ... )
+    {
+    delete[] data;
+    throw;
+    }
 
   this->WriteCellsBuffer(data, static_cast< unsigned int * >( buffer ), TRIANGLE_CELL, 3, this->m_NumberOfCells);
   delete[] data;
 
-  CloseFile();
-
   return;
 }
 
 void FreeSurferBinaryMeshIO::ReadPointData(void *buffer)
 {
-  float *data = static_cast< float * >( buffer );
-
-  m_InputFile.read( reinterpret_cast< char * >( data ), this->m_NumberOfPoints * sizeof( float ) );
-  itk::ByteSwapper< float >::SwapRangeFromSystemToBigEndian(data, this->m_NumberOfPoints);
+  this->ReadBufferRangeAsBinary(m_InputFile, buffer, m_DataStartPosition, FLOAT, 0, this->m_NumberOfPoints);
 
-  CloseFile();
   return;
 }
 
@@ -260,26 +262,83 @@ void FreeSurferBinaryMeshIO::ReadCellData(void *buffer)
   return;
 }
 
+bool FreeSurferBinaryMeshIO::SupportsRandomAccess(SectionType section) const
+{
+  if ( m_FileTypeIdentifier == ( -2 & 0x00ffffff ) )
+    {
+    return section == POINTS_SECTION || section == CELLS_SECTION;
+    }
+  if ( m_FileTypeIdentifier == ( -1 & 0x00ffffff ) )
+    {
+    return section == POINTDATA_SECTION;
+    }
+  return false;
+}
+
+void FreeSurferBinaryMeshIO::ReadPointsRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints)
+{
+  if ( !this->SupportsRandomAccess(POINTS_SECTION) )
+    {
+    itkExceptionMacro(<< this->m_FileName << " is not a FreeSurfer surface");
+    }
+  this->VerifyRange(firstPoint, numberOfPoints, this->m_NumberOfPoints);
+
+  this->ReadBufferRangeAsBinary(m_InputFile, buffer, m_DataStartPosition, FLOAT,
+                                firstPoint * this->m_PointDimension, numberOfPoints * this->m_PointDimension);
+}
+
+void FreeSurferBinaryMeshIO::ReadCellsRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells)
+{
+  if ( !this->SupportsRandomAccess(CELLS_SECTION) )
+    {
+    itkExceptionMacro(<< this->m_FileName << " is not a FreeSurfer surface");
+    }
+  this->VerifyRange(firstCell, numberOfCells, this->m_NumberOfCells);
+
+  const unsigned int           numberOfCellPoints = 3;
+  std::vector< itk::uint32_t > data(numberOfCells * numberOfCellPoints);
+  if ( data.empty() )
+    {
+    return;
+    }
+
+  this->ReadBufferRangeAsBinary(m_InputFile, &data[0], this->GetCellsStartPosition(), UINT,
+                                firstCell * numberOfCellPoints, numberOfCells * numberOfCellPoints);
+  this->WriteCellsBuffer(&data[0], static_cast< unsigned int * >( buffer ), TRIANGLE_CELL, numberOfCellPoints,
+                         numberOfCells);
+}
+
+void FreeSurferBinaryMeshIO::ReadPointDataRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints)
+{
+  if ( !this->SupportsRandomAccess(POINTDATA_SECTION) )
+    {
+    itkExceptionMacro(<< this->m_FileName << " is not a FreeSurfer curvature");
+    }
+  this->VerifyRange(firstPoint, numberOfPoints, this->m_NumberOfPoints);
+
+  this->ReadBufferRangeAsBinary(m_InputFile, buffer, m_DataStartPosition, FLOAT, firstPoint, numberOfPoints);
+}
+
 void FreeSurferBinaryMeshIO::WriteMeshInformation()
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios::out | std::ios::binary);
-
-  // Whether output stream opened successfully
-  if ( !outputFile.is_open() )
+  // The FreeSurfer files count the points and cells on 32 bits
+  if ( this->m_NumberOfPoints > NumericTraits< itk::uint32_t >::max()
+       || this->m_NumberOfCells > NumericTraits< itk::uint32_t >::max() )
     {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
+    itkExceptionMacro(<< "FreeSurfer files can not hold more than "
+                      << NumericTraits< itk::uint32_t >::max() << " points or cells");
     }
 
+  // The output file stays open until Write()
+  this->OpenOutputFile();
+
   if ( this->m_UpdatePoints && this->m_UpdateCells )
     {
     itk::uint32_t MAGIC_NUMBER = 16777214;
@@ -299,15 +358,15 @@ void FreeSurferBinaryMeshIO::WriteMeshInformation()
       buffer[2] = pv[0];
       }
 
-    outputFile.write(buffer, 3);
+    m_OutputFile.write(buffer, 3);
 
     std::string creator = "Created by ITK  \n\n";
-    outputFile.write( const_cast< char * >( creator.c_str() ), creator.size() );
+    m_OutputFile.write( const_cast< char * >( creator.c_str() ), creator.size() );
 
     itk::uint32_t numberOfPoints = this->m_NumberOfPoints;
     itk::uint32_t numberOfCells = this->m_NumberOfCells;
-    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfPoints, 1, &outputFile);
-    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfCells, 1, &outputFile);
+    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfPoints, 1, &m_OutputFile);
+    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfCells, 1, &m_OutputFile);
     }
   else if ( this->m_UpdatePointData && ( !this->m_UpdatePoints && !this->m_UpdateCells ) )
     {
@@ -328,114 +387,102 @@ void FreeSurferBinaryMeshIO::WriteMeshInformation()
       buffer[2] = pv[0];
       }
 
-    outputFile.write(buffer, 3);
+    m_OutputFile.write(buffer, 3);
     itk::uint32_t numberOfPoints = this->m_NumberOfPoints;
     itk::uint32_t numberOfCells = this->m_NumberOfCells;
     itk::uint32_t numberOfValuesPerPoint = 1;
-    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfPoints, 1, &outputFile);
-    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfCells, 1, &outputFile);
-    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfValuesPerPoint, 1, &outputFile);
+    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfPoints, 1, &m_OutputFile);
+    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfCells, 1, &m_OutputFile);
+    itk::ByteSwapper< itk::uint32_t >::SwapWriteRangeFromSystemToBigEndian(&numberOfValuesPerPoint, 1, &m_OutputFile);
     }
-
-  outputFile.close();
 }
 
 void FreeSurferBinaryMeshIO::WritePoints(void *buffer)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app | std::ios::binary);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(POINTS_SECTION);
+  this->WritePointsChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTS_SECTION);
+}
 
+void FreeSurferBinaryMeshIO::WritePointsChunk(void *buffer, SizeValueType numberOfPoints)
+{
   // Write points
   switch ( this->m_PointComponentType )
     {
     case UCHAR:
       {
-      WritePoints(static_cast< unsigned char * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints);
       break;
       }
     case CHAR:
       {
-      WritePoints(static_cast< char * >( buffer ), outputFile);
+      WritePoints(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case USHORT:
       {
-      WritePoints(static_cast< unsigned short * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case SHORT:
       {
-      WritePoints(static_cast< short * >( buffer ), outputFile);
+      WritePoints(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case UINT:
       {
-      WritePoints(static_cast< unsigned int * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case INT:
       {
-      WritePoints(static_cast< int * >( buffer ), outputFile);
+      WritePoints(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONG:
       {
-      WritePoints(static_cast< unsigned long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONG:
       {
-      WritePoints(static_cast< long * >( buffer ), outputFile);
+      WritePoints(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePoints(static_cast< unsigned long long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONGLONG:
       {
-      WritePoints(static_cast< long long * >( buffer ), outputFile);
+      WritePoints(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case FLOAT:
       {
-      WritePoints(static_cast< float * >( buffer ), outputFile);
+      WritePoints(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case DOUBLE:
       {
-      WritePoints(static_cast< double * >( buffer ), outputFile);
+      WritePoints(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePoints(static_cast< long double * >( buffer ), outputFile);
+      WritePoints(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
@@ -444,96 +491,83 @@ void FreeSurferBinaryMeshIO::WritePoints(void *buffer)
       itkExceptionMacro(<< "Unknown point pixel component type" << std::endl);
       }
     }
-
-  outputFile.close();
-  return;
 }
 
 void FreeSurferBinaryMeshIO::WriteCells(void *buffer)
 {
-  // Check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app | std::ios::binary);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(CELLS_SECTION);
+  this->WriteCellsChunk(buffer, this->m_NumberOfCells);
+  this->EndWriteSection(CELLS_SECTION);
+}
 
+void FreeSurferBinaryMeshIO::WriteCellsChunk(void *buffer, SizeValueType numberOfCells)
+{
   // Write triangles
   switch ( this->m_CellComponentType )
     {
     case UCHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case CHAR:
       {
-      WriteCells(static_cast< char * >( buffer ), outputFile);
+      WriteCells(static_cast< char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case USHORT:
       {
-      WriteCells(static_cast< unsigned short * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case SHORT:
       {
-      WriteCells(static_cast< short * >( buffer ), outputFile);
+      WriteCells(static_cast< short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case UINT:
       {
-      WriteCells(static_cast< unsigned int * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case INT:
       {
-      WriteCells(static_cast< int * >( buffer ), outputFile);
+      WriteCells(static_cast< int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONG:
       {
-      WriteCells(static_cast< unsigned long * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONGLONG:
       {
-      WriteCells(static_cast< unsigned long long * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LONGLONG:
       {
-      WriteCells(static_cast< long long * >( buffer ), outputFile);
+      WriteCells(static_cast< long long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case FLOAT:
       {
-      WriteCells(static_cast< float * >( buffer ), outputFile);
+      WriteCells(static_cast< float * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case DOUBLE:
       {
-      WriteCells(static_cast< double * >( buffer ), outputFile);
+      WriteCells(static_cast< double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LDOUBLE:
       {
-      WriteCells(static_cast< long double * >( buffer ), outputFile);
+      WriteCells(static_cast< long double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     default:
@@ -541,108 +575,94 @@ void FreeSurferBinaryMeshIO::WriteCells(void *buffer)
       itkExceptionMacro(<< "Unknown cell component type" << std::endl);
       }
     }
-
-  outputFile.close();
-
-  return;
 }
 
 void FreeSurferBinaryMeshIO::WritePointData(void *buffer)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile(this->m_FileName.c_str(), std::ios_base::app | std::ios::binary);
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(POINTDATA_SECTION);
+  this->WritePointDataChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTDATA_SECTION);
+}
 
+void FreeSurferBinaryMeshIO::WritePointDataChunk(void *buffer, SizeValueType numberOfPoints)
+{
   // Write points
   switch ( this->m_PointPixelComponentType )
     {
     case UCHAR:
       {
-      WritePointData(static_cast< unsigned char * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints);
       break;
       }
     case CHAR:
       {
-      WritePointData(static_cast< char * >( buffer ), outputFile);
+      WritePointData(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case USHORT:
       {
-      WritePointData(static_cast< unsigned short * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case SHORT:
       {
-      WritePointData(static_cast< short * >( buffer ), outputFile);
+      WritePointData(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case UINT:
       {
-      WritePointData(static_cast< unsigned int * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case INT:
       {
-      WritePointData(static_cast< int * >( buffer ), outputFile);
+      WritePointData(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONG:
       {
-      WritePointData(static_cast< unsigned long * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONG:
       {
-      WritePointData(static_cast< long * >( buffer ), outputFile);
+      WritePointData(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePointData(static_cast< unsigned long long * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONGLONG:
       {
-      WritePointData(static_cast< long long * >( buffer ), outputFile);
+      WritePointData(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case FLOAT:
       {
-      WritePointData(static_cast< float * >( buffer ), outputFile);
+      WritePointData(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case DOUBLE:
       {
-      WritePointData(static_cast< double * >( buffer ), outputFile);
+      WritePointData(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePointData(static_cast< long double * >( buffer ), outputFile);
+      WritePointData(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
@@ -651,18 +671,22 @@ void FreeSurferBinaryMeshIO::WritePointData(void *buffer)
       itkExceptionMacro(<< "Unknown point data pixel component type" << std::endl);
       }
     }
+}
 
-  outputFile.close();
+void FreeSurferBinaryMeshIO::WriteCellData(void *buffer)
+{
   return;
 }
 
-void FreeSurferBinaryMeshIO::WriteCellData(void *buffer)
+void FreeSurferBinaryMeshIO::WriteCellDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
 {
   return;
 }
 
 void FreeSurferBinaryMeshIO::Write()
-{}
+{
+  this->CloseOutputFile();
+}
 
 void FreeSurferBinaryMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
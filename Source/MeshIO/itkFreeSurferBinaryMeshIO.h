@@ -22,7 +22,7 @@
 #pragma warning ( disable : 4786 )
 #endif
 
-#include "itkByteSwapper.h"
+#include "itkMeshByteSwapper.h"
 #include "itkMeshIOBase.h"
 #include "itkIntTypes.h"
 
@@ -54,12 +54,9 @@ public:
 
   /*-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-  * \param FileNameToRead The name of the file to test for reading.
-  * \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-  * \return Returns true if this MeshIO can read the file specified.
-  */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: 100 for the magic numbers of the surface
+   * and curvature files */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
@@ -73,6 +70,20 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
+  /** The points and triangles of surfaces and the point data of curvatures
+   * are read by range at their offset in the file. */
+  virtual bool SupportsRandomAccess(SectionType section) const;
+
+  virtual void ReadPointsRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
+  virtual void ReadCellsRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells);
+
+  virtual void ReadPointDataRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine if the file can be written with this MeshIO implementation.
@@ -97,46 +108,46 @@ public:
 
   virtual void Write();
 
+  /** FreeSurfer binary files are written chunk by chunk, cell data is ignored */
+  virtual bool CanStreamWrite() { return true; }
+
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
 protected:
   /** Write points to output stream */
   template< typename T >
-  void WritePoints(T *buffer, std::ofstream & outputFile)
+  void WritePoints(T *buffer, std::ostream & outputFile, SizeValueType numberOfPoints)
     {
-    float *data = new float[this->m_NumberOfPoints * this->m_PointDimension];
-
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
-      {
-      for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
-        {
-        data[ii * this->m_PointDimension + jj] = static_cast< float >( buffer[ii * this->m_PointDimension + jj] );
-        }
-      }
-
-    itk::ByteSwapper< float >::SwapWriteRangeFromSystemToBigEndian(data, this->m_NumberOfPoints * this->m_PointDimension, &outputFile);
-    delete[] data;
+    MeshByteSwapper::ConvertWriteBigEndian< float >(outputFile, buffer, numberOfPoints * this->m_PointDimension);
     }
 
   /** Write cells to utput stream */
   template< typename T >
-  void WriteCells(T *buffer, std::ofstream & outputFile)
+  void WriteCells(T *buffer, std::ostream & outputFile, SizeValueType numberOfCells)
     {
     const ITK_UINT32 numberOfCellPoints = 3;
 
-    ITK_UINT32 *data = new ITK_UINT32[this->m_NumberOfCells * numberOfCellPoints];
+    ITK_UINT32 *data = new ITK_UINT32[numberOfCells * numberOfCellPoints];
 
-    ReadCellsBuffer(buffer, data);
-    itk::ByteSwapper< ITK_UINT32 >::SwapWriteRangeFromSystemToBigEndian(data, this->m_NumberOfCells * numberOfCellPoints, &outputFile);
+    ReadCellsBuffer(buffer, data, numberOfCells);
+    MeshByteSwapper::WriteBigEndian(outputFile, data, numberOfCells * numberOfCellPoints);
 
     delete[] data;
     }
 
   /** Read cells from a data buffer, used when writting mesh */
   template< typename TInput, typename TOutput >
-  void ReadCellsBuffer(TInput *input, TOutput *output)
+  void ReadCellsBuffer(TInput *input, TOutput *output, SizeValueType numberOfCells)
     {
     if ( input && output )
       {
-      for ( size_t ii = 0; ii < this->m_NumberOfCells; ii++ )
+      for ( size_t ii = 0; ii < numberOfCells; ii++ )
         {
         for ( unsigned int jj = 0; jj < 3; jj++ )
           {
@@ -149,17 +160,9 @@ protected:
 
   /** Write points to output stream */
   template< typename T >
-  void WritePointData(T *buffer, std::ofstream & outputFile)
+  void WritePointData(T *buffer, std::ostream & outputFile, SizeValueType numberOfPoints)
   {
-    float *data = new float[this->m_NumberOfPoints];
-
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
-      {
-      data[ii] = static_cast< float >( buffer[ii] );
-      }
-
-    itk::ByteSwapper< float >::SwapWriteRangeFromSystemToBigEndian(data, this->m_NumberOfPoints, &outputFile);
-    delete[] data;
+    MeshByteSwapper::ConvertWriteBigEndian< float >(outputFile, buffer, numberOfPoints);
   }
 
 protected:
@@ -170,14 +173,20 @@ protected:
 
   void OpenFile();
 
-  void CloseFile();
-
 private:
   FreeSurferBinaryMeshIO(const Self &); // purposely not implemented
   void operator=(const Self &);         // purposely not implemented
 
-  ITK_UINT32    m_FileTypeIdentifier;
-  std::ifstream m_InputFile;
+  /** Position of the triangles, which follow the points of surfaces */
+  StreamOffsetType GetCellsStartPosition() const
+  {
+    return m_DataStartPosition
+           + static_cast< StreamOffsetType >( this->m_NumberOfPoints * this->m_PointDimension * sizeof( float ) );
+  }
+
+  ITK_UINT32          m_FileTypeIdentifier;
+  MeshInputFileStream m_InputFile;
+  StreamOffsetType    m_DataStartPosition; // position of the points of surfaces, the point data of curvatures
 };
 } // end namespace itk
 
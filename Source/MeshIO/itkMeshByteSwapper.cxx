@@ -0,0 +1,320 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshByteSwapper.cxx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-29 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#include "itkMeshByteSwapper.h"
+
+#include <cstring>
+
+// With GCC, Clang and Visual Studio on x86, the SSE2, SSSE3 and AVX2
+// kernels are all compiled, each for its own instruction set, and the one
+// run is chosen from the instructions of the processor. Other compilers
+// only use the instructions they target.
+#if ( defined( __x86_64__ ) || defined( __i386__ ) )                                   \
+  && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) ) ) )
+#define ITK_MESH_BYTE_SWAPPER_DISPATCH
+#define ITK_MESH_BYTE_SWAPPER_TARGET(instructions) __attribute__( ( target(instructions) ) )
+#elif defined( _MSC_VER ) && _MSC_VER >= 1700 && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define ITK_MESH_BYTE_SWAPPER_DISPATCH
+#define ITK_MESH_BYTE_SWAPPER_TARGET(instructions)
+#include <intrin.h>
+#else
+#define ITK_MESH_BYTE_SWAPPER_TARGET(instructions)
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_DISPATCH ) || defined( __AVX2__ )
+#define ITK_MESH_BYTE_SWAPPER_AVX2
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_DISPATCH ) || defined( __SSSE3__ ) || defined( __AVX__ )
+#define ITK_MESH_BYTE_SWAPPER_SSSE3
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_DISPATCH ) || defined( __SSE2__ ) || defined( _M_X64 ) \
+  || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ITK_MESH_BYTE_SWAPPER_SSE2
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_AVX2 )
+#include <immintrin.h>
+#elif defined( ITK_MESH_BYTE_SWAPPER_SSSE3 )
+#include <tmmintrin.h>
+#elif defined( ITK_MESH_BYTE_SWAPPER_SSE2 )
+#include <emmintrin.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+/** Instructions reversing the bytes of the components */
+enum SwapInstructions { SWAP_BYTES, SWAP_SSE2, SWAP_SSSE3, SWAP_AVX2 };
+
+/** Best instructions supported by the processor, among those compiled */
+SwapInstructions GetSwapInstructions()
+{
+#if defined( ITK_MESH_BYTE_SWAPPER_DISPATCH ) && defined( _MSC_VER )
+  int info[4];
+  __cpuid(info, 0);
+  const int numberOfLeaves = info[0];
+
+  __cpuid(info, 1);
+  const bool sse2 = ( info[3] & ( 1 << 26 ) ) != 0;
+  const bool ssse3 = ( info[2] & ( 1 << 9 ) ) != 0;
+
+  // AVX2 also needs the operating system to save the AVX registers
+  bool avx2 = false;
+  if ( numberOfLeaves >= 7 && ( info[2] & ( 1 << 27 ) ) && ( info[2] & ( 1 << 28 ) )
+       && ( _xgetbv(0) & 6 ) == 6 )
+    {
+    __cpuidex(info, 7, 0);
+    avx2 = ( info[1] & ( 1 << 5 ) ) != 0;
+    }
+
+  return avx2 ? SWAP_AVX2 : ( ssse3 ? SWAP_SSSE3 : ( sse2 ? SWAP_SSE2 : SWAP_BYTES ) );
+#elif defined( ITK_MESH_BYTE_SWAPPER_DISPATCH )
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports("avx2") )
+    {
+    return SWAP_AVX2;
+    }
+  if ( __builtin_cpu_supports("ssse3") )
+    {
+    return SWAP_SSSE3;
+    }
+  return __builtin_cpu_supports("sse2") ? SWAP_SSE2 : SWAP_BYTES;
+#elif defined( ITK_MESH_BYTE_SWAPPER_AVX2 )
+  return SWAP_AVX2;
+#elif defined( ITK_MESH_BYTE_SWAPPER_SSSE3 )
+  return SWAP_SSSE3;
+#elif defined( ITK_MESH_BYTE_SWAPPER_SSE2 )
+  return SWAP_SSE2;
+#else
+  return SWAP_BYTES;
+#endif
+}
+
+/** Chosen once, when the library is loaded. A swap run by a static
+ * initializer before it falls back to the bytes, which is slower only. */
+const SwapInstructions Instructions = GetSwapInstructions();
+
+#if defined( ITK_MESH_BYTE_SWAPPER_SSSE3 )
+/** Byte shuffles reversing the components of 2, 4 and 8 bytes of 32 bytes */
+const unsigned char SwapMask2[32] = {
+  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+};
+const unsigned char SwapMask4[32] = {
+  3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+  3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+};
+const unsigned char SwapMask8[32] = {
+  7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+  7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+};
+
+const unsigned char * GetSwapMask(unsigned int componentSize)
+{
+  return componentSize == 2 ? SwapMask2 : ( componentSize == 4 ? SwapMask4 : SwapMask8 );
+}
+
+/** Reverse the bytes of the components of N bytes of the 16 bytes blocks
+ * of size bytes with SSSE3. Returns the number of bytes swapped. The
+ * vectors are loaded before they are stored, so that output may be
+ * input. */
+template< unsigned int N >
+ITK_MESH_BYTE_SWAPPER_TARGET("ssse3")
+std::size_t SwapVectorsSSSE3(unsigned char *output, const unsigned char *input, std::size_t size)
+{
+  const __m128i mask16 = _mm_loadu_si128(reinterpret_cast< const __m128i * >( GetSwapMask(N) ));
+  std::size_t   ii = 0;
+
+  for (; ii + 16 <= size; ii += 16 )
+    {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast< const __m128i * >( input + ii ));
+    _mm_storeu_si128(reinterpret_cast< __m128i * >( output + ii ), _mm_shuffle_epi8(value, mask16));
+    }
+  return ii;
+}
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_AVX2 )
+/** Same with AVX2, by 32 bytes, and the last 16 bytes with SSSE3, which
+ * every AVX2 processor has */
+template< unsigned int N >
+ITK_MESH_BYTE_SWAPPER_TARGET("avx2")
+std::size_t SwapVectorsAVX2(unsigned char *output, const unsigned char *input, std::size_t size)
+{
+  const __m256i mask32 = _mm256_loadu_si256(reinterpret_cast< const __m256i * >( GetSwapMask(N) ));
+  const __m128i mask16 = _mm_loadu_si128(reinterpret_cast< const __m128i * >( GetSwapMask(N) ));
+  std::size_t   ii = 0;
+
+  for (; ii + 32 <= size; ii += 32 )
+    {
+    const __m256i value = _mm256_loadu_si256(reinterpret_cast< const __m256i * >( input + ii ));
+    _mm256_storeu_si256(reinterpret_cast< __m256i * >( output + ii ), _mm256_shuffle_epi8(value, mask32));
+    }
+  if ( ii + 16 <= size )
+    {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast< const __m128i * >( input + ii ));
+    _mm_storeu_si128(reinterpret_cast< __m128i * >( output + ii ), _mm_shuffle_epi8(value, mask16));
+    ii += 16;
+    }
+  return ii;
+}
+#endif
+
+#if defined( ITK_MESH_BYTE_SWAPPER_SSE2 )
+/** Same with SSE2, which has no byte shuffle: the 16 bits words are
+ * reordered, then their bytes swapped. */
+template< unsigned int N >
+ITK_MESH_BYTE_SWAPPER_TARGET("sse2")
+std::size_t SwapVectorsSSE2(unsigned char *output, const unsigned char *input, std::size_t size)
+{
+  std::size_t ii = 0;
+
+  for (; ii + 16 <= size; ii += 16 )
+    {
+    __m128i value = _mm_loadu_si128(reinterpret_cast< const __m128i * >( input + ii ));
+    if ( N == 4 )
+      {
+      value = _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, 0xb1), 0xb1);
+      }
+    else if ( N == 8 )
+      {
+      value = _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, 0x1b), 0x1b);
+      }
+    value = _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+    _mm_storeu_si128(reinterpret_cast< __m128i * >( output + ii ), value);
+    }
+  return ii;
+}
+#endif
+
+/** Reverse the bytes of numberOfComponents components of N bytes, with the
+ * vector instructions of the processor, then one byte at a time. output
+ * may be input. */
+template< unsigned int N >
+void SwapComponents(unsigned char *output, const unsigned char *input, std::size_t numberOfComponents)
+{
+  std::size_t size = numberOfComponents * N;
+  std::size_t swapped = 0;
+
+  switch ( Instructions )
+    {
+#if defined( ITK_MESH_BYTE_SWAPPER_AVX2 )
+    case SWAP_AVX2:
+      swapped = SwapVectorsAVX2< N >(output, input, size);
+      break;
+#endif
+#if defined( ITK_MESH_BYTE_SWAPPER_SSSE3 )
+    case SWAP_SSSE3:
+      swapped = SwapVectorsSSSE3< N >(output, input, size);
+      break;
+#endif
+#if defined( ITK_MESH_BYTE_SWAPPER_SSE2 )
+    case SWAP_SSE2:
+      swapped = SwapVectorsSSE2< N >(output, input, size);
+      break;
+#endif
+    default:
+      break;
+    }
+  size -= swapped;
+  input += swapped;
+  output += swapped;
+
+  for (; size >= N; size -= N, input += N, output += N )
+    {
+    for ( unsigned int jj = 0; jj < N / 2; jj++ )
+      {
+      const unsigned char first = input[jj];
+      const unsigned char last = input[N - 1 - jj];
+      output[jj] = last;
+      output[N - 1 - jj] = first;
+      }
+    }
+}
+
+/** Reverse the bytes of components of any size, one byte at a time */
+void SwapComponents(unsigned char *output, const unsigned char *input, std::size_t componentSize,
+                    std::size_t numberOfComponents)
+{
+  for ( std::size_t ii = 0; ii < numberOfComponents; ii++ )
+    {
+    for ( std::size_t jj = 0; jj < ( componentSize + 1 ) / 2; jj++ )
+      {
+      const unsigned char first = input[jj];
+      const unsigned char last = input[componentSize - 1 - jj];
+      output[jj] = last;
+      output[componentSize - 1 - jj] = first;
+      }
+    input += componentSize;
+    output += componentSize;
+    }
+}
+} // end anonymous namespace
+
+void MeshByteSwapper::SwapCopy(void *output, const void *input, std::size_t componentSize,
+                               std::size_t numberOfComponents)
+{
+  unsigned char *      outputBytes = static_cast< unsigned char * >( output );
+  const unsigned char *inputBytes = static_cast< const unsigned char * >( input );
+
+  switch ( componentSize )
+    {
+    case 1:
+      if ( outputBytes != inputBytes )
+        {
+        std::memcpy(outputBytes, inputBytes, numberOfComponents);
+        }
+      break;
+    case 2:
+      SwapComponents< 2 >(outputBytes, inputBytes, numberOfComponents);
+      break;
+    case 4:
+      SwapComponents< 4 >(outputBytes, inputBytes, numberOfComponents);
+      break;
+    case 8:
+      SwapComponents< 8 >(outputBytes, inputBytes, numberOfComponents);
+      break;
+    default:
+      SwapComponents(outputBytes, inputBytes, componentSize, numberOfComponents);
+      break;
+    }
+}
+
+void MeshByteSwapper::SwapWrite(std::ostream & outputStream, const void *buffer, std::size_t componentSize,
+                                std::size_t numberOfComponents)
+{
+  if ( componentSize == 0 || componentSize > BlockSize )
+    {
+    return;
+    }
+
+  const std::size_t    blockLength = BlockSize / componentSize;
+  const unsigned char *input = static_cast< const unsigned char * >( buffer );
+  unsigned char        block[BlockSize];
+
+  while ( numberOfComponents > 0 )
+    {
+    const std::size_t length = numberOfComponents < blockLength ? numberOfComponents : blockLength;
+    SwapCopy(block, input, componentSize, length);
+    outputStream.write(reinterpret_cast< const char * >( block ), length * componentSize);
+    input += length * componentSize;
+    numberOfComponents -= length;
+    }
+}
+} // end namespace itk
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshByteSwapper.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-29 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshByteSwapper_h
+#define __itkMeshByteSwapper_h
+
+#include "itkMacro.h"
+#include "itkByteSwapper.h"
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace itk
+{
+/** \class MeshByteSwapper
+ * \brief Reverses the bytes of the components of binary mesh sections.
+ *
+ * Unlike ByteSwapper, which swaps one component at a time, SwapCopy()
+ * reverses 2, 4 and 8 byte components with vector instructions: AVX2 or
+ * SSSE3 byte shuffles, and SSE2 shifts and word shuffles on the other x86
+ * processors. With GCC, Clang and Visual Studio the instructions are chosen
+ * at run time from those of the processor, otherwise from those the
+ * compiler targets. Other sizes and processors are swapped one byte at a
+ * time.
+ *
+ * The write functions never modify the buffer written: its components are
+ * swapped, and converted by ConvertWrite(), into a block of BlockSize bytes
+ * on the stack which is written to the stream when full. ConvertRead() and
+ * ConvertCopy() likewise swap and convert the components read through such
+ * a block, without a temporary buffer of the whole section.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshByteSwapper
+{
+public:
+  /** Size of the blocks written to the stream at once */
+  enum { BlockSize = 16384 };
+
+  /** Copy numberOfComponents components of componentSize bytes from input
+   * to output, reversing the bytes of each of them. input and output may be
+   * the same buffer, but must not overlap otherwise. */
+  static void SwapCopy(void *output, const void *input, std::size_t componentSize, std::size_t numberOfComponents);
+
+  /** Reverse the bytes of the components of buffer in place */
+  static void Swap(void *buffer, std::size_t componentSize, std::size_t numberOfComponents)
+    {
+    SwapCopy(buffer, buffer, componentSize, numberOfComponents);
+    }
+
+  /** Write the components of buffer to a stream with their bytes reversed */
+  static void SwapWrite(std::ostream & outputStream, const void *buffer, std::size_t componentSize,
+                        std::size_t numberOfComponents);
+
+  /** Write the components of buffer to a stream as TOutput, reversing their
+   * bytes when swap is true, in a single pass over the buffer. */
+  template< class TOutput, class TInput >
+  static void ConvertWrite(std::ostream & outputStream, const TInput *buffer, std::size_t numberOfComponents, bool swap)
+    {
+    const std::size_t blockLength = BlockSize / sizeof( TOutput );
+    TOutput           block[BlockSize / sizeof( TOutput )];
+
+    while ( numberOfComponents > 0 )
+      {
+      const std::size_t length = numberOfComponents < blockLength ? numberOfComponents : blockLength;
+      for ( std::size_t ii = 0; ii < length; ii++ )
+        {
+        block[ii] = static_cast< TOutput >( buffer[ii] );
+        }
+
+      if ( swap && sizeof( TOutput ) > 1 )
+        {
+        Swap(block, sizeof( TOutput ), length);
+        }
+
+      outputStream.write(reinterpret_cast< const char * >( block ), length * sizeof( TOutput ));
+      buffer += length;
+      numberOfComponents -= length;
+      }
+    }
+
+  /** Read numberOfComponents components of TInput from a stream into
+   * buffer as TOutput, reversing their bytes when swap is true, in a single
+   * pass over the buffer. Stops at the end of the stream. */
+  template< class TInput, class TOutput >
+  static void ConvertRead(std::istream & inputStream, TOutput *buffer, std::size_t numberOfComponents, bool swap)
+    {
+    const std::size_t blockLength = BlockSize / sizeof( TInput );
+    TInput            block[BlockSize / sizeof( TInput )];
+
+    while ( numberOfComponents > 0 )
+      {
+      const std::size_t length = numberOfComponents < blockLength ? numberOfComponents : blockLength;
+      if ( !inputStream.read(reinterpret_cast< char * >( block ), length * sizeof( TInput )) )
+        {
+        return;
+        }
+
+      if ( swap && sizeof( TInput ) > 1 )
+        {
+        Swap(block, sizeof( TInput ), length);
+        }
+
+      for ( std::size_t ii = 0; ii < length; ii++ )
+        {
+        buffer[ii] = static_cast< TOutput >( block[ii] );
+        }
+      buffer += length;
+      numberOfComponents -= length;
+      }
+    }
+
+  /** Copy numberOfComponents components of TInput from input, which needs
+   * not be aligned, to buffer as TOutput, reversing their bytes when swap
+   * is true. */
+  template< class TInput, class TOutput >
+  static void ConvertCopy(TOutput *buffer, const void *input, std::size_t numberOfComponents, bool swap)
+    {
+    const std::size_t    blockLength = BlockSize / sizeof( TInput );
+    TInput               block[BlockSize / sizeof( TInput )];
+    const unsigned char *inputBytes = static_cast< const unsigned char * >( input );
+
+    while ( numberOfComponents > 0 )
+      {
+      const std::size_t length = numberOfComponents < blockLength ? numberOfComponents : blockLength;
+      if ( swap && sizeof( TInput ) > 1 )
+        {
+        SwapCopy(block, inputBytes, sizeof( TInput ), length);
+        }
+      else
+        {
+        std::memcpy(block, inputBytes, length * sizeof( TInput ));
+        }
+
+      for ( std::size_t ii = 0; ii < length; ii++ )
+        {
+        buffer[ii] = static_cast< TOutput >( block[ii] );
+        }
+      inputBytes += length * sizeof( TInput );
+      buffer += length;
+      numberOfComponents -= length;
+      }
+    }
+
+  /** Write the components of buffer to a stream in big endian byte order */
+  template< class T >
+  static void WriteBigEndian(std::ostream & outputStream, const T *buffer, std::size_t numberOfComponents)
+    {
+    if ( sizeof( T ) > 1 && ByteSwapper< T >::SystemIsLittleEndian() )
+      {
+      SwapWrite(outputStream, buffer, sizeof( T ), numberOfComponents);
+      }
+    else
+      {
+      outputStream.write(reinterpret_cast< const char * >( buffer ), numberOfComponents * sizeof( T ));
+      }
+    }
+
+  /** Write the components of buffer to a stream as TOutput in big endian
+   * byte order */
+  template< class TOutput, class TInput >
+  static void ConvertWriteBigEndian(std::ostream & outputStream, const TInput *buffer, std::size_t numberOfComponents)
+    {
+    ConvertWrite< TOutput >(outputStream, buffer, numberOfComponents, ByteSwapper< TOutput >::SystemIsLittleEndian());
+    }
+};
+} // end namespace itk
+
+#endif // __itkMeshByteSwapper_h
@@ -22,6 +22,7 @@
 #include "itkLineCell.h"
 #include "itkMeshIOBase.h"
 #include "itkMeshSource.h"
+#include "itkMultiThreader.h"
 #include "itkPolygonCell.h"
 #include "itkPolylineCell.h"
 #include "itkQuadrilateralCell.h"
@@ -34,6 +35,9 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMeshConvertPixelTraits.h"
 
+#include <string>
+#include <vector>
+
 namespace itk
 {
 /** \class MeshFileReaderException
@@ -84,6 +88,15 @@ public:
  * no accepted suffix, so you will have to
  * manually create the MeshIO instance of the write type.
  *
+ * The mesh may also be read from memory or from a stream, with
+ * SetInputBuffer() or SetInputStream(); the extension of FileName then
+ * hints the format to the factory, which identifies it by its header.
+ *
+ * When the MeshIO supports concurrent reads, the points, cells, point
+ * data and cell data are read and decoded each on a thread of its own, up
+ * to the number of threads of the filter, before the output mesh is
+ * filled.
+ *
  * \sa MeshIOBase
  *
  * \ingroup IOFilters
@@ -139,6 +152,20 @@ public:
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
 
+  /** Read the mesh from the size bytes at buffer rather than from a file.
+   * The buffer stays owned by the caller and must outlive the update: the
+   * MeshIO parses it in place. FileName is then optional, and only hints
+   * the format by its extension. A null buffer reads FileName again. */
+  void SetInputBuffer(const void *buffer, SizeValueType size);
+
+  const void * GetInputBuffer() const { return m_InputBuffer; }
+  SizeValueType GetInputBufferSize() const { return m_InputBufferSize; }
+
+  /** Read the mesh from a stream rather than from a file, like a buffer.
+   * The next update reads the stream to its end, into memory kept as the
+   * input buffer. */
+  void SetInputStream(std::istream *stream);
+
   /** Set/Get the MeshIO helper class. Often this is created via the object
   * factory mechanism that determines whether a particular MeshIO can
   * read a certain file. This method provides a way to get the MeshIO
@@ -185,10 +212,59 @@ protected:
   /** Does the real work. */
   virtual void GenerateData();
 
+  /** Buffers of the sections of the file, filled by ReadSection() */
+  struct SectionBuffers
+    {
+    std::vector< char >                 Points;
+    std::vector< char >                 Cells;
+    std::vector< OutputPointPixelType > PointData;
+    std::vector< OutputCellPixelType >  CellData;
+    };
+
+  /** Read a section of the file into its buffer, without touching the
+   * output mesh, so that the sections may be read on threads of their own */
+  void ReadSection(MeshIOBase::SectionType section, SectionBuffers & buffers);
+
+  /** Read the point data or cell data of the file into a buffer of output
+   * pixels, converting them when the components of the file differ */
+  void ReadPointDataBuffer(OutputPointPixelType *buffer);
+
+  void ReadCellDataBuffer(OutputCellPixelType *buffer);
+
+  /** Copy a buffer of point data or cell data to the output mesh */
+  void SetOutputPointData(const OutputPointPixelType *buffer);
+
+  void SetOutputCellData(const OutputCellPixelType *buffer);
+
+  /** Sections read by the threads of GenerateData(): thread ii reads the
+   * sections ii, ii + NumberOfThreads, ... and keeps their exceptions */
+  struct SectionReadWork
+    {
+    Self *                  Reader;
+    SectionBuffers *        Buffers;
+    MeshIOBase::SectionType Sections[4];
+    unsigned int            NumberOfSections;
+    bool                    Failed[4];
+    ExceptionObject         Exceptions[4];
+    };
+
+  static ITK_THREAD_RETURN_TYPE ReadSectionsCallback(void *arg);
+
   MeshIOBase::Pointer m_MeshIO;
   bool                m_UserSpecifiedMeshIO; // keep track whether the MeshIO is
                                              // user specified
   std::string m_FileName;                    // The file to be read
+
+  /** Memory or stream read instead of FileName, and the content read from
+    the stream */
+  const void *   m_InputBuffer;
+  SizeValueType  m_InputBufferSize;
+  std::istream * m_InputStream;
+  std::string    m_InputStreamContent;
+
+  /** Whether the file of m_MeshIO is open, from ReadMeshInformation() in
+    GenerateOutputInformation() to the end of GenerateData() */
+  bool m_InputFileOpen;
 private:
   MeshFileReader(const Self &); // purposely not implemented
   void operator=(const Self &); // purposely not implemented
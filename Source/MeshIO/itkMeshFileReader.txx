@@ -27,7 +27,9 @@
 #include "itkPixelTraits.h"
 
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 
 namespace itk
 {
@@ -37,6 +39,10 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::
   m_MeshIO = 0;
   m_FileName = "";
   m_UserSpecifiedMeshIO = false;
+  m_InputFileOpen = false;
+  m_InputBuffer = 0;
+  m_InputBufferSize = 0;
+  m_InputStream = 0;
 }
 
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
@@ -56,6 +62,40 @@ void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTrait
 
   os << indent << "UserSpecifiedMeshIO flag: " << m_UserSpecifiedMeshIO << "\n";
   os << indent << "m_FileName: " << m_FileName << "\n";
+  os << indent << "m_InputBuffer: " << m_InputBuffer << " (" << m_InputBufferSize << " bytes)\n";
+  os << indent << "m_InputStream: " << m_InputStream << "\n";
+}
+
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::SetInputBuffer(const void *buffer, SizeValueType size)
+{
+  if ( buffer == m_InputBuffer && size == m_InputBufferSize && m_InputStream == 0 )
+    {
+    return;
+    }
+
+  m_InputBuffer = buffer;
+  m_InputBufferSize = buffer ? size : 0;
+  m_InputStream = 0;
+  std::string().swap(m_InputStreamContent);
+  this->Modified();
+}
+
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::SetInputStream(std::istream *stream)
+{
+  if ( stream == m_InputStream )
+    {
+    return;
+    }
+
+  m_InputBuffer = 0;
+  m_InputBufferSize = 0;
+  m_InputStream = stream;
+  std::string().swap(m_InputStreamContent);
+  this->Modified();
 }
 
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
@@ -341,177 +381,173 @@ void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTrait
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
 void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::ReadPointData()
 {
-  typename TOutputMesh::Pointer output = this->GetOutput();
-
-  char *                inputPointDataBuffer = 0;
-  OutputPointPixelType *outputPointDataBuffer = new OutputPointPixelType[m_MeshIO->GetNumberOfPoints()];
+  std::vector< OutputPointPixelType > outputPointDataBuffer( m_MeshIO->GetNumberOfPoints() );
 
-  try
+  if ( !outputPointDataBuffer.empty() )
     {
-    if ( ( m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetPointPixelComponentType() ) !=
-          typeid( ITK_TYPENAME ConvertPointPixelTraits::ComponentType ) )
-        || ( m_MeshIO->GetNumberOfPointPixelComponents() != ConvertPointPixelTraits::GetNumberOfComponents() ) )
-      {
-      // the pixel types don't match so a type conversion needs to be performed
-      itkDebugMacro( << "Buffer conversion required from: "
-                     << m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetPointPixelComponentType() ).name()
-                     << " to: "
-                     << typeid( ITK_TYPENAME ConvertPointPixelTraits::ComponentType ).name() );
-
-      inputPointDataBuffer =
-        new char[m_MeshIO->GetNumberOfPointPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetPointPixelComponentType() )
-                 * m_MeshIO->GetNumberOfPoints()];
-      m_MeshIO->ReadPointData( static_cast< void * >( inputPointDataBuffer ) );
-
-      this->ConvertPointPixelBuffer( static_cast< void * >( inputPointDataBuffer ), outputPointDataBuffer, m_MeshIO->GetNumberOfPoints() );
-      }
-    else
-      {
-      itkDebugMacro(<< "No buffer conversion required.");
-      m_MeshIO->ReadPointData( static_cast< void * >( outputPointDataBuffer ) );
-      }
+    this->ReadPointDataBuffer(&outputPointDataBuffer[0]);
+    this->SetOutputPointData(&outputPointDataBuffer[0]);
     }
-  catch ( ... )
-    {
-    // if an exception is thrown catch it
-    if ( inputPointDataBuffer )
-      {
-      // clean up
-      delete[] inputPointDataBuffer;
-      inputPointDataBuffer = 0;
-      }
-
-    if ( outputPointDataBuffer )
-      {
-      // clean up
-      delete[] outputPointDataBuffer;
-      outputPointDataBuffer = 0;
-      }
+}
 
-    // then rethrow
-    throw;
-    }
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::ReadCellData()
+{
+  std::vector< OutputCellPixelType > outputCellDataBuffer( m_MeshIO->GetNumberOfCells() );
 
-  // clean up
-  if ( inputPointDataBuffer )
+  if ( !outputCellDataBuffer.empty() )
     {
-    delete[] inputPointDataBuffer;
-    inputPointDataBuffer = 0;
+    this->ReadCellDataBuffer(&outputCellDataBuffer[0]);
+    this->SetOutputCellData(&outputCellDataBuffer[0]);
     }
+}
 
-  for ( OutputPointIdentifier id = 0; id < m_MeshIO->GetNumberOfPoints(); id++ )
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadPointDataBuffer(OutputPointPixelType *outputPointDataBuffer)
+{
+  // The layout of the section tells whether the MeshIO fills the output
+  // buffer itself, copying, swapping or decoding the file
+  const MeshIOBase::ReadPathType readPath =
+    m_MeshIO->GetReadPath( MeshIOBase::POINTDATA_SECTION, typeid( ITK_TYPENAME ConvertPointPixelTraits::ComponentType ),
+                           ConvertPointPixelTraits::GetNumberOfComponents() );
+  if ( readPath == MeshIOBase::CONVERT_READ )
     {
-    output->SetPointData(id, outputPointDataBuffer[id]);
-    }
+    // the pixel types don't match so a type conversion needs to be performed
+    itkDebugMacro( << "Buffer conversion required from: "
+                   << m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetPointPixelComponentType() ).name()
+                   << " to: "
+                   << typeid( ITK_TYPENAME ConvertPointPixelTraits::ComponentType ).name() );
+
+    std::vector< char > inputPointDataBuffer( m_MeshIO->GetNumberOfPointPixelComponents()
+                                              * m_MeshIO->GetComponentSize( m_MeshIO->GetPointPixelComponentType() )
+                                              * m_MeshIO->GetNumberOfPoints() );
+    m_MeshIO->ReadPointData( static_cast< void * >( &inputPointDataBuffer[0] ) );
 
-  if ( outputPointDataBuffer )
+    this->ConvertPointPixelBuffer( static_cast< void * >( &inputPointDataBuffer[0] ), outputPointDataBuffer,
+                                   m_MeshIO->GetNumberOfPoints() );
+    }
+  else
     {
-    delete[] outputPointDataBuffer;
-    outputPointDataBuffer = 0;
+    itkDebugMacro(<< "No buffer conversion required, read path " << readPath);
+    m_MeshIO->ReadPointData( static_cast< void * >( outputPointDataBuffer ) );
     }
 }
 
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
-void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::ReadCellData()
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadCellDataBuffer(OutputCellPixelType *outputCellDataBuffer)
 {
-  typename TOutputMesh::Pointer output = this->GetOutput();
-
-  char *               inputCellDataBuffer = 0;
-  OutputCellPixelType *outputCellDataBuffer = new OutputCellPixelType[m_MeshIO->GetNumberOfCells()];
-
-  try
+  // The layout of the section tells whether the MeshIO fills the output
+  // buffer itself, copying, swapping or decoding the file
+  const MeshIOBase::ReadPathType readPath =
+    m_MeshIO->GetReadPath( MeshIOBase::CELLDATA_SECTION, typeid( ITK_TYPENAME ConvertCellPixelTraits::ComponentType ),
+                           ConvertCellPixelTraits::GetNumberOfComponents() );
+  if ( readPath == MeshIOBase::CONVERT_READ )
     {
-    if ( ( m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetCellPixelComponentType() ) !=
-          typeid( ITK_TYPENAME ConvertCellPixelTraits::ComponentType ) )
-        || ( m_MeshIO->GetNumberOfCellPixelComponents() != ConvertCellPixelTraits::GetNumberOfComponents() ) )
-      {
-      // the pixel types don't match so a type conversion needs to be performed
-      itkDebugMacro( << "Buffer conversion required from: "
-                     << m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetCellPixelComponentType() ).name()
-                     << " to: "
-                     << typeid( ITK_TYPENAME ConvertCellPixelTraits::ComponentType ).name() );
-
-      inputCellDataBuffer =
-        new char[m_MeshIO->GetNumberOfCellPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetCellPixelComponentType() )
-                 * m_MeshIO->GetNumberOfCells()];
-      m_MeshIO->ReadCellData( static_cast< void * >( inputCellDataBuffer ) );
-
-      this->ConvertCellPixelBuffer( static_cast< void * >( inputCellDataBuffer ), outputCellDataBuffer, m_MeshIO->GetNumberOfCells() );
-      }
-    else
-      {
-      itkDebugMacro(<< "No buffer conversion required.");
-      m_MeshIO->ReadCellData( static_cast< void * >( outputCellDataBuffer ) );
-      }
-    }
-  catch ( ... )
-    {
-    // if an exception is thrown catch it
+    // the pixel types don't match so a type conversion needs to be performed
+    itkDebugMacro( << "Buffer conversion required from: "
+                   << m_MeshIO->GetComponentTypeInfo( m_MeshIO->GetCellPixelComponentType() ).name()
+                   << " to: "
+                   << typeid( ITK_TYPENAME ConvertCellPixelTraits::ComponentType ).name() );
 
-    if ( inputCellDataBuffer )
-      {
-      // clean up
-      delete[] inputCellDataBuffer;
-      inputCellDataBuffer = 0;
-      }
-
-    if ( outputCellDataBuffer )
-      {
-      // clean up
-      delete[] outputCellDataBuffer;
-      outputCellDataBuffer = 0;
-      }
+    std::vector< char > inputCellDataBuffer( m_MeshIO->GetNumberOfCellPixelComponents()
+                                             * m_MeshIO->GetComponentSize( m_MeshIO->GetCellPixelComponentType() )
+                                             * m_MeshIO->GetNumberOfCells() );
+    m_MeshIO->ReadCellData( static_cast< void * >( &inputCellDataBuffer[0] ) );
 
-    // then rethrow
-    throw;
+    this->ConvertCellPixelBuffer( static_cast< void * >( &inputCellDataBuffer[0] ), outputCellDataBuffer,
+                                  m_MeshIO->GetNumberOfCells() );
     }
-
-  // clean up
-  if ( inputCellDataBuffer )
+  else
     {
-    delete[] inputCellDataBuffer;
-    inputCellDataBuffer = 0;
+    itkDebugMacro(<< "No buffer conversion required, read path " << readPath);
+    m_MeshIO->ReadCellData( static_cast< void * >( outputCellDataBuffer ) );
     }
+}
 
-  for ( OutputCellIdentifier id = 0; id < m_MeshIO->GetNumberOfCells(); id++ )
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::SetOutputPointData(const OutputPointPixelType *buffer)
+{
+  typename TOutputMesh::Pointer output = this->GetOutput();
+
+  for ( OutputPointIdentifier id = 0; id < m_MeshIO->GetNumberOfPoints(); id++ )
     {
-    output->SetCellData(id, outputCellDataBuffer[id]);
+    output->SetPointData(id, buffer[id]);
     }
+}
 
-  if ( outputCellDataBuffer )
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::SetOutputCellData(const OutputCellPixelType *buffer)
+{
+  typename TOutputMesh::Pointer output = this->GetOutput();
+
+  for ( OutputCellIdentifier id = 0; id < m_MeshIO->GetNumberOfCells(); id++ )
     {
-    delete[] outputCellDataBuffer;
-    outputCellDataBuffer = 0;
+    output->SetCellData(id, buffer[id]);
     }
 }
 
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
 void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::GenerateOutputInformation()
 {
-  if ( m_FileName == "" )
+  // A stream is read once, then read from memory like a buffer
+  if ( m_InputStream )
     {
-    throw MeshFileReaderException(__FILE__, __LINE__, "FileName must be specified", ITK_LOCATION);
+    m_InputStreamContent.assign( ( std::istreambuf_iterator< char >(*m_InputStream) ),
+                                 std::istreambuf_iterator< char >() );
+    if ( m_InputStream->bad() )
+      {
+      throw MeshFileReaderException(__FILE__, __LINE__, "Unable to read the input stream", ITK_LOCATION);
+      }
+    m_InputStream = 0;
+    m_InputBuffer = m_InputStreamContent.data();
+    m_InputBufferSize = m_InputStreamContent.size();
     }
 
-  try
+  if ( m_FileName == "" && m_InputBuffer == 0 )
     {
-    m_ExceptionMessage = "";
-    this->TestFileExistanceAndReadability();
+    throw MeshFileReaderException(__FILE__, __LINE__, "FileName must be specified", ITK_LOCATION);
     }
-  catch ( itk::ExceptionObject & err )
+
+  m_ExceptionMessage = "";
+  if ( m_InputBuffer == 0 )
     {
-    m_ExceptionMessage = err.GetDescription();
+    try
+      {
+      this->TestFileExistanceAndReadability();
+      }
+    catch ( itk::ExceptionObject & err )
+      {
+      m_ExceptionMessage = err.GetDescription();
+      }
     }
 
   if ( m_UserSpecifiedMeshIO == false ) // try creating via factory
     {
-    m_MeshIO = MeshIOFactory::CreateMeshIO(m_FileName.c_str(), MeshIOFactory::ReadMode);
+    if ( m_InputBuffer )
+      {
+      m_MeshIO = MeshIOFactory::CreateMeshIO(m_InputBuffer, m_InputBufferSize, m_FileName.c_str());
+      }
+    else
+      {
+      m_MeshIO = MeshIOFactory::CreateMeshIO(m_FileName.c_str(), MeshIOFactory::ReadMode);
+      }
     }
 
   if ( m_MeshIO.IsNull() )
     {
     OStringStream msg;
-    msg << " Could not create IO object for file " << m_FileName.c_str() << std::endl;
+    if ( m_InputBuffer )
+      {
+      msg << " Could not create IO object for the input buffer of " << m_InputBufferSize << " bytes" << std::endl;
+      }
+    else
+      {
+      msg << " Could not create IO object for file " << m_FileName.c_str() << std::endl;
+      }
     if ( m_ExceptionMessage.size() )
       {
       msg << m_ExceptionMessage;
@@ -535,14 +571,70 @@ void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTrait
     }
 	
   m_MeshIO->SetFileName( m_FileName.c_str() );
+  m_MeshIO->SetInputBuffer(m_InputBuffer, m_InputBufferSize);
   m_MeshIO->ReadMeshInformation();
+  m_InputFileOpen = true;
 }
 
 template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
-void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::GenerateData()
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadSection(MeshIOBase::SectionType section, SectionBuffers & buffers)
 {
-  typename TOutputMesh::Pointer output = this->GetOutput();
+  switch ( section )
+    {
+    case MeshIOBase::POINTS_SECTION:
+      m_MeshIO->ReadPoints( static_cast< void * >( &buffers.Points[0] ) );
+      break;
+    case MeshIOBase::CELLS_SECTION:
+      m_MeshIO->ReadCells( static_cast< void * >( &buffers.Cells[0] ) );
+      break;
+    case MeshIOBase::POINTDATA_SECTION:
+      this->ReadPointDataBuffer(&buffers.PointData[0]);
+      break;
+    case MeshIOBase::CELLDATA_SECTION:
+      this->ReadCellDataBuffer(&buffers.CellData[0]);
+      break;
+    }
+}
+
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+ITK_THREAD_RETURN_TYPE MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadSectionsCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  SectionReadWork *                work = static_cast< SectionReadWork * >( info->UserData );
 
+  // The exceptions are kept for GenerateData(), which rethrows them on the
+  // calling thread
+  for ( unsigned int ii = info->ThreadID; ii < work->NumberOfSections; ii += info->NumberOfThreads )
+    {
+    try
+      {
+      work->Reader->ReadSection(work->Sections[ii], *work->Buffers);
+      }
+    catch ( ExceptionObject & err )
+      {
+      work->Exceptions[ii] = err;
+      work->Failed[ii] = true;
+      }
+    catch ( std::exception & err )
+      {
+      work->Exceptions[ii] = ExceptionObject(__FILE__, __LINE__, err.what(), ITK_LOCATION);
+      work->Failed[ii] = true;
+      }
+    catch ( ... )
+      {
+      work->Exceptions[ii] = ExceptionObject(__FILE__, __LINE__, "Unknown exception while reading a section",
+                                             ITK_LOCATION);
+      work->Failed[ii] = true;
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TOutputMesh, class ConvertPointPixelTraits, class ConvertCellPixelTraits >
+void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >::GenerateData()
+{
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -550,266 +642,152 @@ void MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTrait
   // reports file error if no MeshIO is loaded.
 
   // Test existance and readability of input file 
-  try
+  m_ExceptionMessage = "";
+  if ( m_InputBuffer == 0 )
     {
-    m_ExceptionMessage = "";
-    this->TestFileExistanceAndReadability();
-    }
-  catch ( itk::ExceptionObject & err )
-    {
-    m_ExceptionMessage = err.GetDescription();
+    try
+      {
+      this->TestFileExistanceAndReadability();
+      }
+    catch ( itk::ExceptionObject & err )
+      {
+      m_ExceptionMessage = err.GetDescription();
+      }
     }
 
   // Tell the MeshIO to read the file 
   m_MeshIO->SetFileName( m_FileName.c_str() );
 
-  // Get mesh information
-  //  m_MeshIO->ReadMeshInformation();
+  // The file closed by a previous execution is read again
+  if ( !m_InputFileOpen )
+    {
+    m_MeshIO->ReadMeshInformation();
+    m_InputFileOpen = true;
+    }
+
+  // Allocate the buffers of the sections to read
+  SectionBuffers  buffers;
+  SectionReadWork work;
+  work.Reader = this;
+  work.Buffers = &buffers;
+  work.NumberOfSections = 0;
 
-  // Read points 
-  if ( m_MeshIO->GetUpdatePoints() )
+  if ( m_MeshIO->GetUpdatePoints() && m_MeshIO->GetNumberOfPoints() )
     {
-    switch ( m_MeshIO->GetPointComponentType() )
-      {
-      case MeshIOBase::CHAR:
-        {
-        char *pointsBuffer = new char[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::UCHAR:
-        {
-        unsigned char *pointsBuffer = new unsigned char[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::SHORT:
-        {
-        short *pointsBuffer = new short[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::USHORT:
-        {
-        unsigned short *pointsBuffer = new unsigned short[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::INT:
-        {
-        int *pointsBuffer = new int[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::UINT:
-        {
-        unsigned int *pointsBuffer = new unsigned int[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::LONG:
-        {
-        long *pointsBuffer = new long[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::ULONG:
-        {
-        unsigned long *pointsBuffer = new unsigned long[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::LONGLONG:
-        {
-        long long *pointsBuffer = new long long[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::ULONGLONG:
-        {
-        unsigned long long *pointsBuffer = new unsigned long long[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::FLOAT:
-        {
-        float *pointsBuffer = new float[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::DOUBLE:
-        {
-        double *pointsBuffer = new double[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::LDOUBLE:
-        {
-        long double *pointsBuffer = new long double[m_MeshIO->GetNumberOfPoints() * OutputPointDimension];
-        m_MeshIO->ReadPoints( static_cast< void * >( pointsBuffer ) );
-        ReadPoints(pointsBuffer);
-        delete[] pointsBuffer;
-        break;
-        }
-      case MeshIOBase::UNKNOWNCOMPONENTTYPE:
-      default:
-        {
-        itkExceptionMacro(<< "Unknown point component type");
-        }
-      }
+    buffers.Points.resize( m_MeshIO->GetNumberOfPoints() * OutputPointDimension
+                           * m_MeshIO->GetComponentSize( m_MeshIO->GetPointComponentType() ) );
+    work.Sections[work.NumberOfSections++] = MeshIOBase::POINTS_SECTION;
     }
 
-  // Read cells
-  if ( m_MeshIO->GetUpdateCells() )
+  if ( m_MeshIO->GetUpdateCells() && m_MeshIO->GetCellBufferSize() )
     {
-    switch ( m_MeshIO->GetCellComponentType() )
+    buffers.Cells.resize( m_MeshIO->GetCellBufferSize()
+                          * m_MeshIO->GetComponentSize( m_MeshIO->GetCellComponentType() ) );
+    work.Sections[work.NumberOfSections++] = MeshIOBase::CELLS_SECTION;
+    }
+
+  if ( m_MeshIO->GetUpdatePointData() && m_MeshIO->GetNumberOfPoints() )
+    {
+    buffers.PointData.resize( m_MeshIO->GetNumberOfPoints() );
+    work.Sections[work.NumberOfSections++] = MeshIOBase::POINTDATA_SECTION;
+    }
+
+  if ( m_MeshIO->GetUpdateCellData() && m_MeshIO->GetNumberOfCells() )
+    {
+    buffers.CellData.resize( m_MeshIO->GetNumberOfCells() );
+    work.Sections[work.NumberOfSections++] = MeshIOBase::CELLDATA_SECTION;
+    }
+
+  for ( unsigned int ii = 0; ii < work.NumberOfSections; ii++ )
+    {
+    work.Failed[ii] = false;
+    }
+
+  // Read and decode the sections, each on a thread of its own when the
+  // MeshIO allows it. Only the filling of the output mesh below is serial.
+  unsigned int numberOfThreads = 1;
+  if ( m_MeshIO->SupportsConcurrentReads() && this->GetNumberOfThreads() > 1 )
+    {
+    numberOfThreads = std::min( static_cast< unsigned int >( this->GetNumberOfThreads() ), work.NumberOfSections );
+    }
+
+  if ( work.NumberOfSections )
+    {
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(ReadSectionsCallback, &work);
+    threader->SingleMethodExecute();
+    }
+
+  // The sections are in the buffers: release the mapping or the inflated
+  // content of the file, which the MeshIO would keep until it is destroyed
+  m_MeshIO->CloseInputFile();
+  m_InputFileOpen = false;
+
+  for ( unsigned int ii = 0; ii < work.NumberOfSections; ii++ )
+    {
+    if ( work.Failed[ii] )
       {
-      case MeshIOBase::CHAR:
-        {
-        char *cellsBuffer = new char[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::UCHAR:
-        {
-        unsigned char *cellsBuffer = new unsigned char[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::SHORT:
-        {
-        short *cellsBuffer = new short[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::USHORT:
-        {
-        unsigned short *cellsBuffer = new unsigned short[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::INT:
-        {
-        int *cellsBuffer = new int[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::UINT:
-        {
-        unsigned int *cellsBuffer = new unsigned int[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::LONG:
-        {
-        long *cellsBuffer = new long[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::ULONG:
-        {
-        unsigned long *cellsBuffer = new unsigned long[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::LONGLONG:
-        {
-        long long *cellsBuffer = new long long[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::ULONGLONG:
-        {
-        unsigned long long *cellsBuffer = new unsigned long long[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::FLOAT:
-        {
-        float *cellsBuffer = new float[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::DOUBLE:
-        {
-        double *cellsBuffer = new double[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::LDOUBLE:
-        {
-        long double *cellsBuffer = new long double[m_MeshIO->GetCellBufferSize()];
-        m_MeshIO->ReadCells( static_cast< void * >( cellsBuffer ) );
-        ReadCells(cellsBuffer);
-        delete[] cellsBuffer;
-        break;
-        }
-      case MeshIOBase::UNKNOWNCOMPONENTTYPE:
-      default:
-        {
-        itkExceptionMacro(<< "Unknown cell component type");
-        }
+      throw work.Exceptions[ii];
       }
     }
 
-  // Read Point Data 
-  if ( m_MeshIO->GetUpdatePointData() )
+  // Create a macro as the cases only differ by the component type
+#define ITK_MESH_FILE_READER_CASE(componentType, type, method, buffer) \
+  case MeshIOBase::componentType:                                       \
+    this->method( reinterpret_cast< type * >( &buffer[0] ) );           \
+    break;
+
+#define ITK_MESH_FILE_READER_SWITCH(typeOfComponents, method, buffer, message)     \
+  switch ( typeOfComponents )                                                       \
+    {                                                                               \
+    ITK_MESH_FILE_READER_CASE(CHAR, char, method, buffer)                           \
+    ITK_MESH_FILE_READER_CASE(UCHAR, unsigned char, method, buffer)                 \
+    ITK_MESH_FILE_READER_CASE(SHORT, short, method, buffer)                         \
+    ITK_MESH_FILE_READER_CASE(USHORT, unsigned short, method, buffer)               \
+    ITK_MESH_FILE_READER_CASE(INT, int, method, buffer)                             \
+    ITK_MESH_FILE_READER_CASE(UINT, unsigned int, method, buffer)                   \
+    ITK_MESH_FILE_READER_CASE(LONG, long, method, buffer)                           \
+    ITK_MESH_FILE_READER_CASE(ULONG, unsigned long, method, buffer)                 \
+    ITK_MESH_FILE_READER_CASE(LONGLONG, long long, method, buffer)                  \
+    ITK_MESH_FILE_READER_CASE(ULONGLONG, unsigned long long, method, buffer)        \
+    ITK_MESH_FILE_READER_CASE(FLOAT, float, method, buffer)                         \
+    ITK_MESH_FILE_READER_CASE(DOUBLE, double, method, buffer)                       \
+    ITK_MESH_FILE_READER_CASE(LDOUBLE, long double, method, buffer)                 \
+    case MeshIOBase::UNKNOWNCOMPONENTTYPE:                                          \
+    default:                                                                        \
+      {                                                                             \
+      itkExceptionMacro(<< message);                                                \
+      }                                                                             \
+    }
+
+  // Fill points
+  if ( !buffers.Points.empty() )
+    {
+    ITK_MESH_FILE_READER_SWITCH(m_MeshIO->GetPointComponentType(), ReadPoints, buffers.Points,
+                                "Unknown point component type")
+    }
+
+  // Fill cells
+  if ( !buffers.Cells.empty() )
+    {
+    ITK_MESH_FILE_READER_SWITCH(m_MeshIO->GetCellComponentType(), ReadCells, buffers.Cells,
+                                "Unknown cell component type")
+    }
+
+#undef ITK_MESH_FILE_READER_SWITCH
+#undef ITK_MESH_FILE_READER_CASE
+
+  // Fill point data
+  if ( !buffers.PointData.empty() )
     {
-    ReadPointData();
+    this->SetOutputPointData(&buffers.PointData[0]);
     }
 
-  // Read Cell Data 
-  if ( m_MeshIO->GetUpdateCellData() )
+  // Fill cell data
+  if ( !buffers.CellData.empty() )
     {
-    ReadCellData();
+    this->SetOutputCellData(&buffers.CellData[0]);
     }
 }
 
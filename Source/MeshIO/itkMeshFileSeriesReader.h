@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileSeriesReader.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-24 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshFileSeriesReader_h
+#define __itkMeshFileSeriesReader_h
+
+#include "itkObject.h"
+#include "itkMeshFileReader.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class MeshFileSeriesReader
+ * \brief Reads the frames of a time series written by MeshFileSeriesWriter.
+ *
+ * The manifest FileName lists the frame files with their time steps and,
+ * for the frames sharing their topology, the topology file in a "topology"
+ * attribute. ReadFrame() puts a frame back together: the points and point
+ * data of its frame file, with the cells and cell data of its topology
+ * file. The topology file last read is kept, and its containers are shared
+ * by the frames using it.
+ *
+ * \sa MeshFileSeriesWriter MeshFileReader
+ *
+ * \ingroup IOFilters
+ */
+template< class TOutputMesh >
+class ITK_EXPORT MeshFileSeriesReader:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef MeshFileSeriesReader       Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MeshFileSeriesReader, Object);
+
+  /** Some convenient typedefs. */
+  typedef TOutputMesh                      OutputMeshType;
+  typedef typename OutputMeshType::Pointer OutputMeshPointer;
+
+  /** Specify the name of the manifest file. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Read the list of the frames from the manifest. Called by the methods
+   * below when the manifest was not read yet. */
+  void ReadManifest();
+
+  /** Get the number of frames listed in the manifest. */
+  unsigned int GetNumberOfFrames();
+
+  /** Get the time step of a frame. */
+  double GetFrameTime(unsigned int frame);
+
+  /** Read a frame, with the cells and cell data of its topology file. */
+  OutputMeshPointer ReadFrame(unsigned int frame);
+
+protected:
+  MeshFileSeriesReader();
+  ~MeshFileSeriesReader() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** A frame listed in the manifest */
+  struct FrameInformation
+  {
+    double      m_Time;
+    std::string m_FileName;
+    std::string m_TopologyFileName;
+  };
+
+  /** Value of the attribute name of an element of the manifest, false when
+   * the element has no such attribute */
+  static bool GetAttribute(const std::string & element, const char *name, std::string & value);
+
+  OutputMeshPointer ReadMesh(const std::string & fileName) const;
+
+private:
+  MeshFileSeriesReader(const Self &); // purposely not implemented
+  void operator=(const Self &);       // purposely not implemented
+
+  std::string m_FileName;
+  bool        m_ManifestRead;
+
+  std::vector< FrameInformation > m_Frames;
+
+  /** The topology file last read */
+  std::string       m_TopologyFileName;
+  OutputMeshPointer m_Topology;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMeshFileSeriesReader.txx"
+#endif
+
+#endif // __itkMeshFileSeriesReader_h
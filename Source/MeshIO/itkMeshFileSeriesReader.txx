@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileSeriesReader.txx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-24 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshFileSeriesReader_txx
+#define __itkMeshFileSeriesReader_txx
+
+#include "itkMeshFileSeriesReader.h"
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <sstream>
+
+namespace itk
+{
+template< class TOutputMesh >
+MeshFileSeriesReader< TOutputMesh >
+::MeshFileSeriesReader()
+{
+  m_ManifestRead = false;
+}
+
+template< class TOutputMesh >
+void
+MeshFileSeriesReader< TOutputMesh >
+::ReadManifest()
+{
+  if ( m_FileName == "" )
+    {
+    throw MeshFileReaderException(__FILE__, __LINE__, "FileName must be specified", ITK_LOCATION);
+    }
+
+  std::ifstream inputFile(m_FileName.c_str(), std::ios::in);
+  if ( !inputFile.is_open() )
+    {
+    itkExceptionMacro("Unable to open file\n"
+                      "inputFilename= " << m_FileName);
+    }
+
+  std::ostringstream content;
+  content << inputFile.rdbuf();
+  const std::string manifest = content.str();
+
+  m_Frames.clear();
+  m_TopologyFileName = "";
+  m_Topology = 0;
+
+  // Each frame is an empty DataSet element
+  std::string::size_type position = manifest.find("<DataSet");
+  while ( position != std::string::npos )
+    {
+    const std::string::size_type end = manifest.find("/>", position);
+    if ( end == std::string::npos )
+      {
+      itkExceptionMacro(<< "Unterminated DataSet element in " << m_FileName);
+      }
+    const std::string element = manifest.substr(position, end - position);
+
+    FrameInformation frame;
+    std::string      time;
+    if ( !GetAttribute(element, "file", frame.m_FileName) || !GetAttribute(element, "timestep", time) )
+      {
+      itkExceptionMacro(<< "DataSet element without file or timestep in " << m_FileName);
+      }
+    std::istringstream timeStream(time);
+    timeStream >> frame.m_Time;
+    GetAttribute(element, "topology", frame.m_TopologyFileName);
+    m_Frames.push_back(frame);
+
+    position = manifest.find("<DataSet", end);
+    }
+
+  m_ManifestRead = true;
+}
+
+template< class TOutputMesh >
+unsigned int
+MeshFileSeriesReader< TOutputMesh >
+::GetNumberOfFrames()
+{
+  if ( !m_ManifestRead )
+    {
+    this->ReadManifest();
+    }
+  return static_cast< unsigned int >( m_Frames.size() );
+}
+
+template< class TOutputMesh >
+double
+MeshFileSeriesReader< TOutputMesh >
+::GetFrameTime(unsigned int frame)
+{
+  if ( frame >= this->GetNumberOfFrames() )
+    {
+    itkExceptionMacro(<< "Frame " << frame << " beyond the " << m_Frames.size() << " frames of " << m_FileName);
+    }
+  return m_Frames[frame].m_Time;
+}
+
+template< class TOutputMesh >
+typename MeshFileSeriesReader< TOutputMesh >::OutputMeshPointer
+MeshFileSeriesReader< TOutputMesh >
+::ReadFrame(unsigned int frame)
+{
+  if ( frame >= this->GetNumberOfFrames() )
+    {
+    itkExceptionMacro(<< "Frame " << frame << " beyond the " << m_Frames.size() << " frames of " << m_FileName);
+    }
+
+  const FrameInformation & information = m_Frames[frame];
+  OutputMeshPointer        mesh = this->ReadMesh(information.m_FileName);
+  if ( information.m_TopologyFileName.empty() )
+    {
+    return mesh;
+    }
+
+  if ( information.m_TopologyFileName != m_TopologyFileName )
+    {
+    m_Topology = this->ReadMesh(information.m_TopologyFileName);
+    m_TopologyFileName = information.m_TopologyFileName;
+    }
+
+  // The cells of the topology are deleted by the last mesh holding them
+  OutputMeshPointer output = OutputMeshType::New();
+  output->SetPoints( mesh->GetPoints() );
+  output->SetPointData( mesh->GetPointData() );
+  output->SetCellsAllocationMethod( m_Topology->GetCellsAllocationMethod() );
+  output->SetCells( m_Topology->GetCells() );
+  output->SetCellData( m_Topology->GetCellData() );
+
+  return output;
+}
+
+template< class TOutputMesh >
+bool
+MeshFileSeriesReader< TOutputMesh >
+::GetAttribute(const std::string & element, const char *name, std::string & value)
+{
+  const std::string             attribute = std::string(" ") + name + "=\"";
+  const std::string::size_type begin = element.find(attribute);
+
+  if ( begin == std::string::npos )
+    {
+    return false;
+    }
+
+  const std::string::size_type valueBegin = begin + attribute.size();
+  const std::string::size_type valueEnd = element.find('"', valueBegin);
+  if ( valueEnd == std::string::npos )
+    {
+    return false;
+    }
+  value = element.substr(valueBegin, valueEnd - valueBegin);
+  return true;
+}
+
+template< class TOutputMesh >
+typename MeshFileSeriesReader< TOutputMesh >::OutputMeshPointer
+MeshFileSeriesReader< TOutputMesh >
+::ReadMesh(const std::string & fileName) const
+{
+  // The files of the series are named relative to the manifest
+  const std::string directory = itksys::SystemTools::GetFilenamePath(m_FileName);
+  const std::string prefix = directory.empty() ? std::string() : directory + "/";
+
+  typename MeshFileReader< OutputMeshType >::Pointer reader = MeshFileReader< OutputMeshType >::New();
+  reader->SetFileName( ( prefix + fileName ).c_str() );
+  reader->Update();
+
+  return reader->GetOutput();
+}
+
+template< class TOutputMesh >
+void
+MeshFileSeriesReader< TOutputMesh >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "File Name: " << m_FileName << "\n";
+  os << indent << "NumberOfFrames: " << m_Frames.size() << "\n";
+  os << indent << "Topology File Name: " << m_TopologyFileName << "\n";
+}
+} // end namespace itk
+
+#endif
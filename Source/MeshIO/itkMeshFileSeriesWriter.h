@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileSeriesWriter.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-24 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshFileSeriesWriter_h
+#define __itkMeshFileSeriesWriter_h
+
+#include "itkObject.h"
+#include "itkMeshFileWriter.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class MeshFileSeriesWriter
+ * \brief Writes the frames of a time series of meshes sharing their topology.
+ *
+ * Each call to WriteFrame() writes one frame of the series and rewrites
+ * the manifest FileName, a ParaView collection file (".pvd") listing the
+ * frame files with their time steps.
+ *
+ * With ShareTopology on (the default), the cells and cell data are written
+ * to a topology file, together with the points of the frame, only when they
+ * differ from those of the previous frame: a different cells or cell data
+ * container, a container modified since, or a different number of cells.
+ * The frame files only hold the points and point data, and each manifest
+ * entry names the topology file of its frame in a "topology" attribute.
+ * This attribute is not part of the VTK collection format: ParaView and
+ * the other readers of ".pvd" files ignore it and load each frame as a
+ * point cloud. MeshFileSeriesReader reads the frames back with the cells
+ * of their topology files. With ShareTopology off, every frame file holds
+ * the complete mesh, and the series is read by any reader of the format.
+ *
+ * The cells are not compared: a change that does not modify the containers,
+ * such as new point identifiers set on a cell in place, or values written
+ * through the STL container, is not seen. TopologyModified() must then be
+ * called before writing the frame.
+ *
+ * The files are named after FileName: for "heart.pvd", the frames are
+ * "heart_0000.vtk", "heart_0001.vtk", ... and the topology files
+ * "heart_topology_0000.vtk", ...
+ *
+ * \sa MeshFileWriter MeshFileSeriesReader
+ *
+ * \ingroup IOFilters
+ */
+template< class TInputMesh >
+class ITK_EXPORT MeshFileSeriesWriter:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef MeshFileSeriesWriter       Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MeshFileSeriesWriter, Object);
+
+  /** Some convenient typedefs. */
+  typedef TInputMesh                      InputMeshType;
+  typedef typename InputMeshType::Pointer InputMeshPointer;
+
+  /** Specify the name of the manifest file, which also names the frame and
+   * topology files. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Set/Get the extension of the frame and topology files, which selects
+   * their MeshIO. ".vtk" by default. */
+  itkSetStringMacro(FrameFileExtension);
+  itkGetStringMacro(FrameFileExtension);
+
+  /** Set/Get whether the frames share the topology files. On by default. */
+  itkSetMacro(ShareTopology, bool);
+  itkGetConstMacro(ShareTopology, bool);
+  itkBooleanMacro(ShareTopology);
+
+  /** Settings of the MeshFileWriter writing each file. */
+  void SetFileTypeAsASCII(){ m_FileTypeIsBINARY = false; }
+  void SetFileTypeAsBINARY(){ m_FileTypeIsBINARY = true; }
+
+  itkSetMacro(UseCompression, bool);
+  itkGetConstMacro(UseCompression, bool);
+  itkBooleanMacro(UseCompression);
+
+  itkSetMacro(UseStreaming, bool);
+  itkGetConstMacro(UseStreaming, bool);
+  itkBooleanMacro(UseStreaming);
+
+  /** Write the next frame of the series, at the given time, and update the
+   * manifest. */
+  void WriteFrame(const InputMeshType *mesh, double time);
+
+  /** Get the number of frames written. */
+  unsigned int GetNumberOfFrames() const
+    {
+    return static_cast< unsigned int >( m_Frames.size() );
+    }
+
+  /** Have the next frame written with a new topology file, for changes of
+   * the cells or cell data that are not seen otherwise. */
+  void TopologyModified()
+    {
+    m_TopologyChanged = true;
+    }
+
+  /** Forget the frames written, so that the next frame starts a new series. */
+  void Reset();
+
+protected:
+  MeshFileSeriesWriter();
+  ~MeshFileSeriesWriter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** A frame written, as listed in the manifest */
+  struct FrameInformation
+  {
+    double      m_Time;
+    std::string m_FileName;
+    std::string m_TopologyFileName;
+  };
+
+  /** Name of a file of the series, without its directory */
+  std::string GetSeriesFileName(const std::string & suffix, unsigned int index) const;
+
+  /** Whether the cells or cell data differ from the last topology file, as
+   * far as seen without comparing the cells */
+  bool IsTopologyModified(const InputMeshType *mesh) const;
+
+  void WriteMesh(const InputMeshType *mesh, const std::string & fileName) const;
+
+  void WriteManifest() const;
+
+private:
+  MeshFileSeriesWriter(const Self &); // purposely not implemented
+  void operator=(const Self &);       // purposely not implemented
+
+  std::string m_FileName;
+  std::string m_FrameFileExtension;
+  bool        m_ShareTopology;
+  bool        m_FileTypeIsBINARY;
+  bool        m_UseCompression;
+  bool        m_UseStreaming;
+
+  std::vector< FrameInformation > m_Frames;
+
+  /** The containers written to the last topology file, their modified
+   * times and number of cells then, and whether TopologyModified() was
+   * called since */
+  unsigned int  m_NumberOfTopologies;
+  bool          m_TopologyChanged;
+  const void *  m_TopologyCells;
+  unsigned long m_TopologyCellsMTime;
+  unsigned long m_TopologyNumberOfCells;
+  const void *  m_TopologyCellData;
+  unsigned long m_TopologyCellDataMTime;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMeshFileSeriesWriter.txx"
+#endif
+
+#endif // __itkMeshFileSeriesWriter_h
@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileSeriesWriter.txx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-24 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshFileSeriesWriter_txx
+#define __itkMeshFileSeriesWriter_txx
+
+#include "itkMeshFileSeriesWriter.h"
+#include <itksys/SystemTools.hxx>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace itk
+{
+template< class TInputMesh >
+MeshFileSeriesWriter< TInputMesh >
+::MeshFileSeriesWriter()
+{
+  m_FrameFileExtension = ".vtk";
+  m_ShareTopology = true;
+  m_FileTypeIsBINARY = false;
+  m_UseCompression = false;
+  m_UseStreaming = false;
+
+  this->Reset();
+}
+
+template< class TInputMesh >
+void
+MeshFileSeriesWriter< TInputMesh >
+::Reset()
+{
+  m_Frames.clear();
+  m_NumberOfTopologies = 0;
+  m_TopologyChanged = false;
+  m_TopologyCells = 0;
+  m_TopologyCellsMTime = 0;
+  m_TopologyNumberOfCells = 0;
+  m_TopologyCellData = 0;
+  m_TopologyCellDataMTime = 0;
+}
+
+template< class TInputMesh >
+void
+MeshFileSeriesWriter< TInputMesh >
+::WriteFrame(const InputMeshType *mesh, double time)
+{
+  if ( mesh == 0 )
+    {
+    itkExceptionMacro(<< "No input to writer!");
+    }
+
+  if ( m_FileName == "" )
+    {
+    throw MeshFileWriterException(__FILE__, __LINE__, "FileName must be specified", ITK_LOCATION);
+    }
+
+  const std::string directory = itksys::SystemTools::GetFilenamePath(m_FileName);
+  const std::string prefix = directory.empty() ? std::string() : directory + "/";
+
+  FrameInformation frame;
+  frame.m_Time = time;
+  frame.m_FileName = this->GetSeriesFileName( "", static_cast< unsigned int >( m_Frames.size() ) );
+
+  if ( !m_ShareTopology )
+    {
+    this->WriteMesh(mesh, prefix + frame.m_FileName);
+    }
+  else
+    {
+    // NOTE: the containers are shared with the meshes written, which only
+    // read them, hence the const_cast<>.
+    if ( m_NumberOfTopologies == 0 || this->IsTopologyModified(mesh) )
+      {
+      InputMeshPointer topology = InputMeshType::New();
+      topology->SetPoints( const_cast< typename InputMeshType::PointsContainer * >( mesh->GetPoints() ) );
+      topology->SetCells( const_cast< typename InputMeshType::CellsContainer * >( mesh->GetCells() ) );
+      topology->SetCellData( const_cast< typename InputMeshType::CellDataContainer * >( mesh->GetCellData() ) );
+      this->WriteMesh( topology, prefix + this->GetSeriesFileName("topology", m_NumberOfTopologies) );
+
+      m_NumberOfTopologies++;
+      m_TopologyChanged = false;
+      m_TopologyCells = mesh->GetCells();
+      m_TopologyCellsMTime = mesh->GetCells() ? mesh->GetCells()->GetMTime() : 0;
+      m_TopologyNumberOfCells = mesh->GetNumberOfCells();
+      m_TopologyCellData = mesh->GetCellData();
+      m_TopologyCellDataMTime = mesh->GetCellData() ? mesh->GetCellData()->GetMTime() : 0;
+      }
+    frame.m_TopologyFileName = this->GetSeriesFileName("topology", m_NumberOfTopologies - 1);
+
+    InputMeshPointer points = InputMeshType::New();
+    points->SetPoints( const_cast< typename InputMeshType::PointsContainer * >( mesh->GetPoints() ) );
+    points->SetPointData( const_cast< typename InputMeshType::PointDataContainer * >( mesh->GetPointData() ) );
+    this->WriteMesh(points, prefix + frame.m_FileName);
+    }
+
+  m_Frames.push_back(frame);
+  this->WriteManifest();
+}
+
+template< class TInputMesh >
+std::string
+MeshFileSeriesWriter< TInputMesh >
+::GetSeriesFileName(const std::string & suffix, unsigned int index) const
+{
+  std::ostringstream name;
+
+  name << itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) << "_";
+  if ( !suffix.empty() )
+    {
+    name << suffix << "_";
+    }
+  name << std::setw(4) << std::setfill('0') << index << m_FrameFileExtension;
+
+  return name.str();
+}
+
+template< class TInputMesh >
+bool
+MeshFileSeriesWriter< TInputMesh >
+::IsTopologyModified(const InputMeshType *mesh) const
+{
+  if ( m_TopologyChanged || mesh->GetNumberOfCells() != m_TopologyNumberOfCells )
+    {
+    return true;
+    }
+
+  // A container allocated at the address of a released one is newer than
+  // the modified time recorded
+  if ( mesh->GetCells() != m_TopologyCells
+       || ( mesh->GetCells() && mesh->GetCells()->GetMTime() != m_TopologyCellsMTime ) )
+    {
+    return true;
+    }
+
+  return mesh->GetCellData() != m_TopologyCellData
+         || ( mesh->GetCellData() && mesh->GetCellData()->GetMTime() != m_TopologyCellDataMTime );
+}
+
+template< class TInputMesh >
+void
+MeshFileSeriesWriter< TInputMesh >
+::WriteMesh(const InputMeshType *mesh, const std::string & fileName) const
+{
+  typename MeshFileWriter< InputMeshType >::Pointer writer = MeshFileWriter< InputMeshType >::New();
+  writer->SetFileName( fileName.c_str() );
+  writer->SetInput(mesh);
+  if ( m_FileTypeIsBINARY )
+    {
+    writer->SetFileTypeAsBINARY();
+    }
+  writer->SetUseCompression(m_UseCompression);
+  writer->SetUseStreaming(m_UseStreaming);
+  writer->Write();
+}
+
+template< class TInputMesh >
+void
+MeshFileSeriesWriter< TInputMesh >
+::WriteManifest() const
+{
+  std::ofstream outputFile(m_FileName.c_str(), std::ios::out);
+  if ( !outputFile.is_open() )
+    {
+    itkExceptionMacro("Unable to open file\n"
+                      "outputFilename= " << m_FileName);
+    }
+
+  outputFile.precision(17);
+  outputFile << "<?xml version=\"1.0\"?>\n";
+  outputFile << "<VTKFile type=\"Collection\" version=\"0.1\">\n";
+  outputFile << "  <Collection>\n";
+  for ( typename std::vector< FrameInformation >::const_iterator it = m_Frames.begin(); it != m_Frames.end(); ++it )
+    {
+    outputFile << "    <DataSet timestep=\"" << it->m_Time << "\" part=\"0\" file=\"" << it->m_FileName << "\"";
+    if ( !it->m_TopologyFileName.empty() )
+      {
+      outputFile << " topology=\"" << it->m_TopologyFileName << "\"";
+      }
+    outputFile << "/>\n";
+    }
+  outputFile << "  </Collection>\n";
+  outputFile << "</VTKFile>\n";
+
+  outputFile.close();
+  if ( outputFile.fail() )
+    {
+    itkExceptionMacro("Error writing file\n"
+                      "outputFilename= " << m_FileName);
+    }
+}
+
+template< class TInputMesh >
+void
+MeshFileSeriesWriter< TInputMesh >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "File Name: " << m_FileName << "\n";
+  os << indent << "FrameFileExtension: " << m_FrameFileExtension << "\n";
+  os << indent << "ShareTopology: " << ( m_ShareTopology ? "On" : "Off" ) << "\n";
+  os << indent << "FileTypeIsBINARY: " << ( m_FileTypeIsBINARY ? "On" : "Off" ) << "\n";
+  os << indent << "UseCompression: " << ( m_UseCompression ? "On" : "Off" ) << "\n";
+  os << indent << "UseStreaming: " << ( m_UseStreaming ? "On" : "Off" ) << "\n";
+  os << indent << "NumberOfFrames: " << m_Frames.size() << "\n";
+  os << indent << "NumberOfTopologies: " << m_NumberOfTopologies << "\n";
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,1079 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileStreams.cxx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-22 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#if defined( _MSC_VER )
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "itkMeshFileStreams.h"
+#include "itkMultiThreader.h"
+
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <iterator>
+
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+#include "itkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+// Each member of a block compressed file starts with a gzip header holding
+// an extra field: subfield "IT" with the little endian size of the member
+const unsigned int GzipBlockHeaderSize = 20;
+const unsigned int GzipBlockTrailerSize = 8;
+
+void PutUInt32(unsigned char *buffer, unsigned long value)
+{
+  buffer[0] = static_cast< unsigned char >( value & 0xff );
+  buffer[1] = static_cast< unsigned char >( ( value >> 8 ) & 0xff );
+  buffer[2] = static_cast< unsigned char >( ( value >> 16 ) & 0xff );
+  buffer[3] = static_cast< unsigned char >( ( value >> 24 ) & 0xff );
+}
+
+unsigned long GetUInt32(const unsigned char *buffer)
+{
+  return static_cast< unsigned long >( buffer[0] )
+         | ( static_cast< unsigned long >( buffer[1] ) << 8 )
+         | ( static_cast< unsigned long >( buffer[2] ) << 16 )
+         | ( static_cast< unsigned long >( buffer[3] ) << 24 );
+}
+
+// Deflate one block into a complete gzip member
+bool CompressBlock(const char *data, std::streamsize size, std::string & member)
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  if ( deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK )
+    {
+    return false;
+    }
+
+  member.resize( GzipBlockHeaderSize + deflateBound( &stream, static_cast< uLong >( size ) ) + GzipBlockTrailerSize );
+  unsigned char *buffer = reinterpret_cast< unsigned char * >( &member[0] );
+
+  stream.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( data ) );
+  stream.avail_in = static_cast< uInt >( size );
+  stream.next_out = buffer + GzipBlockHeaderSize;
+  stream.avail_out = static_cast< uInt >( member.size() - GzipBlockHeaderSize - GzipBlockTrailerSize );
+  const int status = deflate(&stream, Z_FINISH);
+  const unsigned long compressedSize = stream.total_out;
+  deflateEnd(&stream);
+  if ( status != Z_STREAM_END )
+    {
+    return false;
+    }
+
+  const unsigned long memberSize = GzipBlockHeaderSize + compressedSize + GzipBlockTrailerSize;
+  const unsigned char header[16] = { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 8, 0, 'I', 'T', 4, 0 };
+  std::copy(header, header + 16, buffer);
+  PutUInt32(buffer + 16, memberSize);
+
+  unsigned char *trailer = buffer + GzipBlockHeaderSize + compressedSize;
+  PutUInt32( trailer, crc32( crc32(0, Z_NULL, 0), reinterpret_cast< const Bytef * >( data ), static_cast< uInt >( size ) ) );
+  PutUInt32( trailer + 4, static_cast< unsigned long >( size ) );
+
+  member.resize(memberSize);
+  return true;
+}
+
+// Inflate one gzip member written by CompressBlock() into its place
+bool InflateBlock(const unsigned char *member, std::size_t memberSize, char *data, std::size_t size)
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = const_cast< Bytef * >( member + GzipBlockHeaderSize );
+  stream.avail_in = static_cast< uInt >( memberSize - GzipBlockHeaderSize - GzipBlockTrailerSize );
+  if ( inflateInit2(&stream, -MAX_WBITS) != Z_OK )
+    {
+    return false;
+    }
+
+  stream.next_out = reinterpret_cast< Bytef * >( data );
+  stream.avail_out = static_cast< uInt >( size );
+  const int status = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+
+  const unsigned char *trailer = member + memberSize - GzipBlockTrailerSize;
+  return status == Z_STREAM_END && stream.total_out == size
+         && crc32( crc32(0, Z_NULL, 0), reinterpret_cast< const Bytef * >( data ), static_cast< uInt >( size ) )
+         == GetUInt32(trailer);
+}
+
+// Whether a gzip member starts with the header written by CompressBlock()
+bool IsBlockHeader(const unsigned char *member, std::size_t available)
+{
+  return available >= GzipBlockHeaderSize + GzipBlockTrailerSize
+         && member[0] == 0x1f && member[1] == 0x8b && member[2] == 8 && ( member[3] & 4 )
+         && member[10] == 8 && member[11] == 0 && member[12] == 'I' && member[13] == 'T'
+         && member[14] == 4 && member[15] == 0;
+}
+
+// Inflate gzip data of any number of members, as gzread() does: anything
+// following the last member which does not start another one is ignored
+bool InflateMembers(const unsigned char *input, std::size_t inputSize, std::string & data)
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = Z_NULL;
+  stream.avail_in = 0;
+  if ( inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK )
+    {
+    return false;
+    }
+
+  data.clear();
+  char        chunk[64 * 1024];
+  std::size_t consumed = 0;
+  int         status = Z_OK;
+  for (;; )
+    {
+    // The input is fed in pieces which fit the counts of zlib
+    if ( stream.avail_in == 0 && consumed < inputSize )
+      {
+      const std::size_t piece = std::min( inputSize - consumed, static_cast< std::size_t >( 1 ) << 30 );
+      stream.next_in = const_cast< Bytef * >( input + consumed );
+      stream.avail_in = static_cast< uInt >( piece );
+      consumed += piece;
+      }
+
+    stream.next_out = reinterpret_cast< Bytef * >( chunk );
+    stream.avail_out = sizeof( chunk );
+    status = inflate(&stream, Z_NO_FLUSH);
+    data.append(chunk, sizeof( chunk ) - stream.avail_out);
+
+    if ( status == Z_STREAM_END )
+      {
+      const std::size_t offset = consumed - stream.avail_in;
+      if ( inputSize - offset < 2 || input[offset] != 0x1f || input[offset + 1] != 0x8b )
+        {
+        break;
+        }
+      status = inflateReset(&stream);
+      }
+    if ( status != Z_OK )
+      {
+      break;
+      }
+    }
+  inflateEnd(&stream);
+
+  return status == Z_STREAM_END;
+}
+
+// Work shared by the threads compressing or inflating blocks, which take
+// the blocks ThreadID, ThreadID + NumberOfThreads, ...
+struct BlockCompressionData
+{
+  const char *                Data;
+  std::streamsize             Size;
+  std::vector< std::string > *Members;
+  bool                        Failed;
+};
+
+ITK_THREAD_RETURN_TYPE CompressBlocksCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  BlockCompressionData *           work = static_cast< BlockCompressionData * >( info->UserData );
+
+  for ( std::size_t ii = info->ThreadID; ii < work->Members->size(); ii += info->NumberOfThreads )
+    {
+    const std::streamsize offset = static_cast< std::streamsize >( ii ) * GzipOutputStreamBuffer::BlockSize;
+    const std::streamsize size = std::min(GzipOutputStreamBuffer::BlockSize, work->Size - offset);
+    if ( !CompressBlock( work->Data + offset, size, ( *work->Members )[ii] ) )
+      {
+      work->Failed = true;
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+struct BlockInflationData
+{
+  const unsigned char *          Input;
+  std::vector< std::size_t > *   MemberOffsets;
+  std::vector< std::size_t > *   DataOffsets;
+  char *                         Data;
+  bool                           Failed;
+};
+
+ITK_THREAD_RETURN_TYPE InflateBlocksCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  BlockInflationData *             work = static_cast< BlockInflationData * >( info->UserData );
+
+  const std::vector< std::size_t > & members = *work->MemberOffsets;
+  const std::vector< std::size_t > & offsets = *work->DataOffsets;
+  for ( std::size_t ii = info->ThreadID; ii + 1 < members.size(); ii += info->NumberOfThreads )
+    {
+    if ( !InflateBlock(work->Input + members[ii], members[ii + 1] - members[ii],
+                       work->Data + offsets[ii], offsets[ii + 1] - offsets[ii]) )
+      {
+      work->Failed = true;
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+}
+
+const std::streamsize GzipOutputStreamBuffer::BlockSize = 1024 * 1024;
+
+GzipOutputStreamBuffer::GzipOutputStreamBuffer():
+  m_File(0),
+  m_Target(0),
+  m_NumberOfThreads(1),
+  m_Buffer(0),
+  m_BufferSize(0)
+{}
+
+GzipOutputStreamBuffer::~GzipOutputStreamBuffer()
+{
+  this->close();
+}
+
+GzipOutputStreamBuffer * GzipOutputStreamBuffer::open(const char *fileName, bool append)
+{
+  if ( this->is_open() )
+    {
+    return 0;
+    }
+
+  // The block-parallel mode buffers one block per thread
+  if ( m_NumberOfThreads > 1 )
+    {
+    std::ios::openmode mode = std::ios::out | std::ios::binary;
+    if ( append )
+      {
+      mode |= std::ios::app;
+      }
+    if ( m_BlockFile.open(fileName, mode) == 0 )
+      {
+      return 0;
+      }
+    m_Target = &m_BlockFile;
+    this->SetBlockBuffer();
+    return this;
+    }
+
+  m_File = gzopen(fileName, append ? "ab" : "wb");
+  if ( m_File == 0 )
+    {
+    return 0;
+    }
+
+  if ( m_Buffer == 0 )
+    {
+    m_OwnBuffer.resize(64 * 1024);
+    m_Buffer = &m_OwnBuffer[0];
+    m_BufferSize = static_cast< std::streamsize >( m_OwnBuffer.size() );
+    }
+  this->setp(m_Buffer, m_Buffer + m_BufferSize);
+
+  return this;
+}
+
+GzipOutputStreamBuffer * GzipOutputStreamBuffer::open(std::streambuf *target)
+{
+  if ( this->is_open() || target == 0 )
+    {
+    return 0;
+    }
+
+  // Without a file for zlib, the data are always compressed in blocks,
+  // which a single thread compresses in turn
+  m_Target = target;
+  this->SetBlockBuffer();
+  return this;
+}
+
+void GzipOutputStreamBuffer::SetBlockBuffer()
+{
+  if ( !m_OwnBuffer.empty() && m_Buffer == &m_OwnBuffer[0] )
+    {
+    m_Buffer = 0;
+    }
+  m_OwnBuffer.resize(BlockSize * m_NumberOfThreads);
+  this->setp( &m_OwnBuffer[0], &m_OwnBuffer[0] + m_OwnBuffer.size() );
+}
+
+GzipOutputStreamBuffer * GzipOutputStreamBuffer::close()
+{
+  if ( !this->is_open() )
+    {
+    return 0;
+    }
+
+  bool written = this->WriteBuffer();
+  if ( m_Target == &m_BlockFile )
+    {
+    if ( m_BlockFile.close() == 0 )
+      {
+      written = false;
+      }
+    m_Target = 0;
+    }
+  else if ( m_Target )
+    {
+    if ( m_Target->pubsync() == -1 )
+      {
+      written = false;
+      }
+    m_Target = 0;
+    }
+  else
+    {
+    if ( gzclose( static_cast< gzFile >( m_File ) ) != Z_OK )
+      {
+      written = false;
+      }
+    m_File = 0;
+    }
+  this->setp(0, 0);
+
+  return written ? this : 0;
+}
+
+void GzipOutputStreamBuffer::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  if ( !this->is_open() )
+    {
+    m_NumberOfThreads = numberOfThreads > 0 ? numberOfThreads : 1;
+    }
+}
+
+std::streambuf * GzipOutputStreamBuffer::setbuf(char *buffer, std::streamsize size)
+{
+  // Only honoured before the file is opened, like std::filebuf
+  if ( !this->is_open() && buffer && size > 0 )
+    {
+    m_Buffer = buffer;
+    m_BufferSize = size;
+    }
+  return this;
+}
+
+GzipOutputStreamBuffer::int_type GzipOutputStreamBuffer::overflow(int_type c)
+{
+  if ( !this->is_open() || !this->WriteBuffer() )
+    {
+    return traits_type::eof();
+    }
+
+  if ( !traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+    *this->pptr() = traits_type::to_char_type(c);
+    this->pbump(1);
+    }
+  return traits_type::not_eof(c);
+}
+
+int GzipOutputStreamBuffer::sync()
+{
+  return this->WriteBuffer() ? 0 : -1;
+}
+
+bool GzipOutputStreamBuffer::WriteBuffer()
+{
+  if ( m_Target )
+    {
+    return this->WriteBlocks();
+    }
+
+  const int size = static_cast< int >( this->pptr() - this->pbase() );
+
+  if ( size > 0 )
+    {
+    if ( gzwrite(static_cast< gzFile >( m_File ), this->pbase(), static_cast< unsigned int >( size ) ) != size )
+      {
+      return false;
+      }
+    this->setp(m_Buffer, m_Buffer + m_BufferSize);
+    }
+  return true;
+}
+
+bool GzipOutputStreamBuffer::WriteBlocks()
+{
+  const std::streamsize size = this->pptr() - this->pbase();
+
+  if ( size == 0 )
+    {
+    return true;
+    }
+
+  std::vector< std::string > members( ( size + BlockSize - 1 ) / BlockSize );
+  BlockCompressionData       work;
+  work.Data = this->pbase();
+  work.Size = size;
+  work.Members = &members;
+  work.Failed = false;
+
+  MultiThreader::Pointer threader = MultiThreader::New();
+  threader->SetNumberOfThreads( std::min( m_NumberOfThreads, static_cast< unsigned int >( members.size() ) ) );
+  threader->SetSingleMethod(CompressBlocksCallback, &work);
+  threader->SingleMethodExecute();
+  if ( work.Failed )
+    {
+    return false;
+    }
+
+  for ( std::size_t ii = 0; ii < members.size(); ii++ )
+    {
+    const std::streamsize memberSize = static_cast< std::streamsize >( members[ii].size() );
+    if ( m_Target->sputn(members[ii].data(), memberSize) != memberSize )
+      {
+      return false;
+      }
+    }
+
+  this->setp( &m_OwnBuffer[0], &m_OwnBuffer[0] + m_OwnBuffer.size() );
+  return true;
+}
+
+MeshOutputFileStream::MeshOutputFileStream():
+  std::ostream(0),
+  m_Sink(0),
+  m_Buffer(0),
+  m_BufferSize(0)
+{
+  this->rdbuf(&m_FileBuffer);
+}
+
+void MeshOutputFileStream::SetBuffer(char *buffer, std::streamsize size)
+{
+  m_Buffer = buffer;
+  m_BufferSize = size;
+}
+
+void MeshOutputFileStream::SetNumberOfCompressionThreads(unsigned int numberOfThreads)
+{
+  m_GzipBuffer.SetNumberOfThreads(numberOfThreads);
+}
+
+void MeshOutputFileStream::open(const char *fileName, std::ios::openmode mode, bool compress)
+{
+  bool opened = false;
+
+  if ( compress )
+    {
+    if ( m_Buffer )
+      {
+      m_GzipBuffer.pubsetbuf(m_Buffer, m_BufferSize);
+      }
+    opened = m_GzipBuffer.open( fileName, ( mode & std::ios::app ) != 0 ) != 0;
+    this->rdbuf(&m_GzipBuffer);
+    }
+  else
+    {
+    if ( m_Buffer )
+      {
+      m_FileBuffer.pubsetbuf(m_Buffer, m_BufferSize);
+      }
+    opened = m_FileBuffer.open(fileName, mode | std::ios::out) != 0;
+    this->rdbuf(&m_FileBuffer);
+    }
+
+  if ( !opened )
+    {
+    this->setstate(std::ios::failbit);
+    }
+}
+
+void MeshOutputFileStream::open(std::streambuf *sink, bool compress)
+{
+  bool opened = false;
+
+  if ( !this->is_open() && sink )
+    {
+    if ( compress )
+      {
+      opened = m_GzipBuffer.open(sink) != 0;
+      this->rdbuf(&m_GzipBuffer);
+      }
+    else
+      {
+      // The sink is written directly, with its own buffering
+      opened = true;
+      this->rdbuf(sink);
+      }
+    }
+
+  if ( opened )
+    {
+    m_Sink = sink;
+    }
+  else
+    {
+    this->setstate(std::ios::failbit);
+    }
+}
+
+bool MeshOutputFileStream::is_open() const
+{
+  return m_FileBuffer.is_open() || m_GzipBuffer.is_open() || m_Sink != 0;
+}
+
+void MeshOutputFileStream::close()
+{
+  bool closed = true;
+
+  if ( m_GzipBuffer.is_open() )
+    {
+    closed = m_GzipBuffer.close() != 0;
+    }
+  else if ( m_FileBuffer.is_open() )
+    {
+    closed = m_FileBuffer.close() != 0;
+    }
+  else if ( m_Sink )
+    {
+    closed = m_Sink->pubsync() != -1;
+    }
+  else
+    {
+    closed = false;
+    }
+
+  // A sink is no longer written once closed
+  if ( m_Sink )
+    {
+    m_Sink = 0;
+    this->rdbuf(&m_FileBuffer);
+    }
+
+  if ( !closed )
+    {
+    this->setstate(std::ios::failbit);
+    }
+}
+
+MemoryStreamBuffer::MemoryStreamBuffer()
+{
+  this->setg(0, 0, 0);
+}
+
+void MemoryStreamBuffer::SetRegion(const char *data, std::size_t size)
+{
+  // The get area is only read, never written back
+  char *begin = const_cast< char * >( data );
+
+  this->setg(begin, begin, begin + size);
+}
+
+const char * MemoryStreamBuffer::Consume(std::size_t size)
+{
+  if ( static_cast< std::size_t >( this->egptr() - this->gptr() ) < size )
+    {
+    return 0;
+    }
+
+  const char *data = this->gptr();
+  this->setg(this->eback(), this->gptr() + size, this->egptr());
+  return data;
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekoff(off_type offset, std::ios::seekdir direction,
+                                                         std::ios::openmode which)
+{
+  if ( !( which & std::ios::in ) )
+    {
+    return pos_type( off_type(-1) );
+    }
+
+  off_type position = offset;
+  if ( direction == std::ios::cur )
+    {
+    position += this->gptr() - this->eback();
+    }
+  else if ( direction == std::ios::end )
+    {
+    position += this->egptr() - this->eback();
+    }
+
+  if ( position < 0 || position > this->egptr() - this->eback() )
+    {
+    return pos_type( off_type(-1) );
+    }
+
+  this->setg(this->eback(), this->eback() + position, this->egptr());
+  return pos_type(position);
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos(pos_type position, std::ios::openmode which)
+{
+  return this->seekoff(off_type(position), std::ios::beg, which);
+}
+
+std::streamsize MemoryStreamBuffer::showmanyc()
+{
+  return this->egptr() > this->gptr() ? this->egptr() - this->gptr() : -1;
+}
+
+MemoryOutputStreamBuffer::MemoryOutputStreamBuffer():
+  m_Output(0)
+{}
+
+void MemoryOutputStreamBuffer::SetOutput(std::string *output)
+{
+  this->sync();
+
+  // The put area starts empty at the end of the content, the first write
+  // grows the string
+  m_Output = output;
+  if ( m_Output )
+    {
+    char *end = m_Output->empty() ? 0 : &( *m_Output )[0] + m_Output->size();
+    this->setp(end, end);
+    }
+  else
+    {
+    this->setp(0, 0);
+    }
+}
+
+std::size_t MemoryOutputStreamBuffer::GetLength() const
+{
+  if ( m_Output == 0 || this->pptr() == 0 )
+    {
+    return m_Output ? m_Output->size() : 0;
+    }
+  return static_cast< std::size_t >( this->pptr() - &( *m_Output )[0] );
+}
+
+MemoryOutputStreamBuffer::int_type MemoryOutputStreamBuffer::overflow(int_type c)
+{
+  if ( m_Output == 0 )
+    {
+    return traits_type::eof();
+    }
+
+  if ( !traits_type::eq_int_type( c, traits_type::eof() ) )
+    {
+    const std::size_t length = this->GetLength();
+    m_Output->resize( std::max( 2 * length, length + 64 * 1024 ) );
+
+    char *begin = &( *m_Output )[0];
+    this->setp( begin + length, begin + m_Output->size() );
+    *this->pptr() = traits_type::to_char_type(c);
+    this->pbump(1);
+    }
+  return traits_type::not_eof(c);
+}
+
+int MemoryOutputStreamBuffer::sync()
+{
+  if ( m_Output )
+    {
+    const std::size_t length = this->GetLength();
+    m_Output->resize(length);
+    char *end = length ? &( *m_Output )[0] + length : 0;
+    this->setp(end, end);
+    }
+  return 0;
+}
+
+MeshFileMapping::MeshFileMapping():
+  m_MappedData(0),
+  m_MappedSize(0),
+  m_ViewedData(0),
+  m_ViewedSize(0),
+  m_Open(false),
+  m_Compressed(false)
+{}
+
+MeshFileMapping::~MeshFileMapping()
+{
+  this->Close();
+}
+
+bool MeshFileMapping::Open(const char *fileName)
+{
+  this->Close();
+
+  if ( MeshInputFileStream::IsGzipFile(fileName) )
+    {
+    m_Compressed = MeshInputFileStream::InflateFile(fileName, m_Buffer);
+    m_Open = m_Compressed;
+    return m_Open;
+    }
+
+  if ( this->Map(fileName) )
+    {
+    m_Open = true;
+    return true;
+    }
+
+  // Files that cannot be mapped, such as empty files or pipes, are read
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  if ( !file.is_open() )
+    {
+    return false;
+    }
+  m_Buffer.assign( ( std::istreambuf_iterator< char >(file) ), std::istreambuf_iterator< char >() );
+  m_Open = !file.bad();
+  return m_Open;
+}
+
+bool MeshFileMapping::Open(const char *data, std::size_t size)
+{
+  this->Close();
+
+  if ( data == 0 && size > 0 )
+    {
+    return false;
+    }
+
+  if ( MeshInputFileStream::IsGzipBuffer(data, size) )
+    {
+    m_Compressed = MeshInputFileStream::InflateBuffer(data, size, m_Buffer);
+    m_Open = m_Compressed;
+    return m_Open;
+    }
+
+  m_ViewedData = data;
+  m_ViewedSize = size;
+  m_Open = true;
+  return true;
+}
+
+bool MeshFileMapping::Map(const char *fileName)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, 0);
+  if ( file == INVALID_HANDLE_VALUE )
+    {
+    return false;
+    }
+
+  LARGE_INTEGER size;
+  if ( !GetFileSizeEx(file, &size) || size.QuadPart == 0
+       || static_cast< unsigned long long >( size.QuadPart ) > static_cast< std::size_t >( -1 ) )
+    {
+    CloseHandle(file);
+    return false;
+    }
+
+  // The view keeps the mapping open once the handles are closed
+  HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+  void * data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : 0;
+  if ( mapping )
+    {
+    CloseHandle(mapping);
+    }
+  CloseHandle(file);
+  if ( data == 0 )
+    {
+    return false;
+    }
+  m_MappedSize = static_cast< std::size_t >( size.QuadPart );
+#else
+  int fd = open(fileName, O_RDONLY);
+  if ( fd < 0 )
+    {
+    return false;
+    }
+
+  struct stat status;
+  if ( fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size == 0
+       || static_cast< unsigned long long >( status.st_size ) > static_cast< std::size_t >( -1 ) )
+    {
+    close(fd);
+    return false;
+    }
+
+  // The mapping stays valid once the file is closed
+  void *data = mmap(0, static_cast< std::size_t >( status.st_size ), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( data == MAP_FAILED )
+    {
+    return false;
+    }
+  m_MappedSize = static_cast< std::size_t >( status.st_size );
+#ifdef MADV_SEQUENTIAL
+  madvise(data, m_MappedSize, MADV_SEQUENTIAL);
+#endif
+#endif
+
+  m_MappedData = data;
+  return true;
+}
+
+void MeshFileMapping::Close()
+{
+  if ( m_MappedData )
+    {
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+    UnmapViewOfFile(m_MappedData);
+#else
+    munmap(m_MappedData, m_MappedSize);
+#endif
+    m_MappedData = 0;
+    m_MappedSize = 0;
+    }
+
+  m_ViewedData = 0;
+  m_ViewedSize = 0;
+  std::string().swap(m_Buffer);
+  m_Open = false;
+  m_Compressed = false;
+}
+
+const char * MeshFileMapping::GetData() const
+{
+  if ( m_MappedData )
+    {
+    return static_cast< const char * >( m_MappedData );
+    }
+  return m_ViewedData ? m_ViewedData : m_Buffer.data();
+}
+
+std::size_t MeshFileMapping::GetSize() const
+{
+  if ( m_MappedData )
+    {
+    return m_MappedSize;
+    }
+  return m_ViewedData ? m_ViewedSize : m_Buffer.size();
+}
+
+MeshInputFileStream::MeshInputFileStream():
+  std::istream(0),
+  m_Source(0)
+{
+  this->rdbuf(&m_MemoryBuffer);
+}
+
+bool MeshInputFileStream::IsGzipFile(const char *fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  unsigned char magic[2] = { 0, 0 };
+
+  file.read(reinterpret_cast< char * >( magic ), 2);
+  return file.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+bool MeshInputFileStream::IsGzipBuffer(const char *data, std::size_t size)
+{
+  const unsigned char *magic = reinterpret_cast< const unsigned char * >( data );
+
+  return size >= 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+void MeshInputFileStream::open(const char *fileName, std::ios::openmode itkNotUsed(mode))
+{
+  this->close();
+  this->clear();
+
+  // Compressed files are inflated once into memory, where the readers can
+  // seek freely
+  if ( !m_Mapping.Open(fileName) )
+    {
+    this->setstate(std::ios::failbit);
+    return;
+    }
+
+  m_MemoryBuffer.SetRegion( m_Mapping.GetData(), m_Mapping.GetSize() );
+}
+
+void MeshInputFileStream::open(const MeshInputFileStream & file)
+{
+  this->close();
+  this->clear();
+
+  if ( !file.is_open() || &file == this )
+    {
+    this->setstate(std::ios::failbit);
+    return;
+    }
+
+  // Share the content of the file rather than its position
+  m_Source = file.m_Source ? file.m_Source : &file;
+  m_MemoryBuffer.SetRegion( m_Source->GetData(), m_Source->GetSize() );
+}
+
+void MeshInputFileStream::OpenBuffer(const char *data, std::size_t size)
+{
+  this->close();
+  this->clear();
+
+  if ( !m_Mapping.Open(data, size) )
+    {
+    this->setstate(std::ios::failbit);
+    return;
+    }
+
+  m_MemoryBuffer.SetRegion( m_Mapping.GetData(), m_Mapping.GetSize() );
+}
+
+bool MeshInputFileStream::InflateFile(const char *fileName, std::string & data)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  std::string   input( ( std::istreambuf_iterator< char >(file) ), std::istreambuf_iterator< char >() );
+  if ( file.bad() )
+    {
+    return false;
+    }
+
+  return InflateBuffer(input.data(), input.size(), data);
+}
+
+bool MeshInputFileStream::InflateBuffer(const char *input, std::size_t inputSize, std::string & data)
+{
+  // Index the members of a block compressed file, any other gzip data is
+  // inflated by zlib in one go
+  const unsigned char *      bytes = reinterpret_cast< const unsigned char * >( input );
+  std::vector< std::size_t > memberOffsets(1, 0);
+  std::vector< std::size_t > dataOffsets(1, 0);
+  bool                       blocks = true;
+  while ( blocks && memberOffsets.back() < inputSize )
+    {
+    const std::size_t offset = memberOffsets.back();
+    const std::size_t memberSize = IsBlockHeader(bytes + offset, inputSize - offset) ? GetUInt32(bytes + offset + 16) : 0;
+    if ( memberSize < GzipBlockHeaderSize + GzipBlockTrailerSize || memberSize > inputSize - offset )
+      {
+      blocks = false;
+      break;
+      }
+    memberOffsets.push_back(offset + memberSize);
+    dataOffsets.push_back( dataOffsets.back() + GetUInt32(bytes + offset + memberSize - 4) );
+    }
+
+  if ( blocks )
+    {
+    data.resize( dataOffsets.back() );
+
+    BlockInflationData work;
+    work.Input = bytes;
+    work.MemberOffsets = &memberOffsets;
+    work.DataOffsets = &dataOffsets;
+    work.Data = data.empty() ? 0 : &data[0];
+    work.Failed = false;
+
+    const unsigned int     numberOfBlocks = static_cast< unsigned int >( memberOffsets.size() - 1 );
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads( std::max( 1u, std::min( static_cast< unsigned int >(
+                                                            MultiThreader::GetGlobalDefaultNumberOfThreads() ),
+                                                          numberOfBlocks ) ) );
+    threader->SetSingleMethod(InflateBlocksCallback, &work);
+    threader->SingleMethodExecute();
+    return !work.Failed;
+    }
+
+  return InflateMembers(bytes, inputSize, data);
+}
+
+bool MeshInputFileStream::ReadFileHeader(const char *fileName, std::size_t length, std::string & header)
+{
+  // zlib reads the files which are not compressed as they are
+  gzFile gzfile = gzopen(fileName, "rb");
+  if ( gzfile == 0 )
+    {
+    return false;
+    }
+
+  header.resize(length);
+  const int count = length ? gzread( gzfile, &header[0], static_cast< unsigned int >( length ) ) : 0;
+  gzclose(gzfile);
+
+  header.resize(count > 0 ? count : 0);
+  return count >= 0;
+}
+
+bool MeshInputFileStream::ReadBufferHeader(const char *data, std::size_t size, std::size_t length,
+                                           std::string & header)
+{
+  if ( !IsGzipBuffer(data, size) )
+    {
+    header.assign( data, std::min(size, length) );
+    return true;
+    }
+
+  // Only the start of compressed data is inflated
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( data ) );
+  stream.avail_in = static_cast< uInt >( std::min( size, static_cast< std::size_t >( 1 ) << 30 ) );
+  if ( inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK )
+    {
+    return false;
+    }
+
+  header.resize(length);
+  stream.next_out = length ? reinterpret_cast< Bytef * >( &header[0] ) : Z_NULL;
+  stream.avail_out = static_cast< uInt >( length );
+  const int status = length ? inflate(&stream, Z_SYNC_FLUSH) : Z_OK;
+  header.resize(length - stream.avail_out);
+  inflateEnd(&stream);
+
+  return status == Z_OK || status == Z_STREAM_END || status == Z_BUF_ERROR;
+}
+
+bool MeshInputFileStream::is_open() const
+{
+  return m_Source != 0 || m_Mapping.IsOpen();
+}
+
+void MeshInputFileStream::close()
+{
+  m_MemoryBuffer.SetRegion(0, 0);
+  m_Mapping.Close();
+  m_Source = 0;
+}
+
+bool MeshInputFileStream::IsCompressed() const
+{
+  return m_Source ? m_Source->IsCompressed() : m_Mapping.IsCompressed();
+}
+
+const char * MeshInputFileStream::GetData() const
+{
+  return m_Source ? m_Source->GetData() : m_Mapping.GetData();
+}
+
+std::size_t MeshInputFileStream::GetSize() const
+{
+  return m_Source ? m_Source->GetSize() : m_Mapping.GetSize();
+}
+
+const char * MeshInputFileStream::GetData(std::streamoff position, std::size_t size) const
+{
+  const std::size_t fileSize = this->GetSize();
+
+  if ( !this->is_open() || position < 0 || static_cast< unsigned long long >( position ) > fileSize
+       || size > fileSize - static_cast< std::size_t >( position ) )
+    {
+    return 0;
+    }
+  return this->GetData() + position;
+}
+} // end namespace itk
@@ -0,0 +1,352 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshFileStreams.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-22 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshFileStreams_h
+#define __itkMeshFileStreams_h
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class GzipOutputStreamBuffer
+ * \brief Stream buffer writing a gzip compressed file with zlib.
+ *
+ * With more than one thread, the data is cut into blocks of BlockSize bytes
+ * which are deflated concurrently, each into its own gzip member. The
+ * concatenated members are still read by gzip and zlib. The header of each
+ * member records its compressed size in an extra field (subfield "IT"),
+ * which lets MeshInputFileStream inflate the members concurrently. The
+ * members may also be written to another stream buffer, rather than to a
+ * file.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT GzipOutputStreamBuffer:public std::streambuf
+{
+public:
+  GzipOutputStreamBuffer();
+  ~GzipOutputStreamBuffer();
+
+  /** Open a file for writing, or for appending a gzip member. Returns a
+   * null pointer on failure, like std::filebuf. */
+  GzipOutputStreamBuffer * open(const char *fileName, bool append = false);
+
+  /** Write the compressed members to target, which must outlive the
+   * stream buffer, rather than to a file */
+  GzipOutputStreamBuffer * open(std::streambuf *target);
+
+  /** Compress the buffered characters and close the file, or flush the
+   * target. Returns a null pointer on failure. */
+  GzipOutputStreamBuffer * close();
+
+  bool is_open() const { return m_File != 0 || m_Target != 0; }
+
+  /** Set the number of threads compressing blocks, before open(). */
+  void SetNumberOfThreads(unsigned int numberOfThreads);
+
+  /** Size of the uncompressed blocks of the block-parallel mode */
+  static const std::streamsize BlockSize;
+
+protected:
+  virtual std::streambuf * setbuf(char *buffer, std::streamsize size);
+
+  virtual int_type overflow(int_type c);
+
+  virtual int sync();
+
+private:
+  GzipOutputStreamBuffer(const GzipOutputStreamBuffer &); // purposely not implemented
+  void operator=(const GzipOutputStreamBuffer &);         // purposely not implemented
+
+  bool WriteBuffer();
+
+  bool WriteBlocks();
+
+  /** Put area of the block-parallel mode */
+  void SetBlockBuffer();
+
+  /** gzFile, kept opaque so that zlib is not needed by this header */
+  void *m_File;
+
+  /** Output of the block-parallel mode, the file or another target */
+  std::filebuf     m_BlockFile;
+  std::streambuf * m_Target;
+  unsigned int     m_NumberOfThreads;
+
+  /** The put area, either set by pubsetbuf() or owned by the stream buffer */
+  char *              m_Buffer;
+  std::streamsize     m_BufferSize;
+  std::vector< char > m_OwnBuffer;
+};
+
+/** \class MeshOutputFileStream
+ * \brief Output file stream writing either plain or gzip compressed files.
+ *
+ * MeshOutputFileStream offers the open(), is_open() and close() methods of
+ * std::ofstream, and writes through a std::filebuf or, when compression is
+ * requested, a GzipOutputStreamBuffer. It may also write to the stream
+ * buffer of another stream, or of a memory buffer, rather than a file.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshOutputFileStream:public std::ostream
+{
+public:
+  MeshOutputFileStream();
+
+  /** Use the given buffer for the next opened file. */
+  void SetBuffer(char *buffer, std::streamsize size);
+
+  /** Set the number of threads compressing the next opened file. */
+  void SetNumberOfCompressionThreads(unsigned int numberOfThreads);
+
+  void open(const char *fileName, std::ios::openmode mode, bool compress = false);
+
+  /** Write to sink, which must outlive the stream, rather than a file.
+   * close() flushes the sink. */
+  void open(std::streambuf *sink, bool compress = false);
+
+  bool is_open() const;
+
+  void close();
+
+private:
+  MeshOutputFileStream(const MeshOutputFileStream &); // purposely not implemented
+  void operator=(const MeshOutputFileStream &);       // purposely not implemented
+
+  std::filebuf           m_FileBuffer;
+  GzipOutputStreamBuffer m_GzipBuffer;
+  std::streambuf *       m_Sink;
+  char *                 m_Buffer;
+  std::streamsize        m_BufferSize;
+};
+
+/** \class MemoryOutputStreamBuffer
+ * \brief Stream buffer appending characters to a string in memory.
+ *
+ * The string grows geometrically and is itself the put area, so that the
+ * characters are written in place; it is cut to the characters written by
+ * pubsync().
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MemoryOutputStreamBuffer:public std::streambuf
+{
+public:
+  MemoryOutputStreamBuffer();
+
+  /** Append to output, which must outlive the writes, or stop writing
+   * with a null output. The previous output is cut to the characters
+   * written first. */
+  void SetOutput(std::string *output);
+
+  std::string * GetOutput() const { return m_Output; }
+
+protected:
+  virtual int_type overflow(int_type c);
+
+  virtual int sync();
+
+private:
+  MemoryOutputStreamBuffer(const MemoryOutputStreamBuffer &); // purposely not implemented
+  void operator=(const MemoryOutputStreamBuffer &);           // purposely not implemented
+
+  /** Number of characters of the output written */
+  std::size_t GetLength() const;
+
+  std::string *m_Output;
+};
+
+/** \class MemoryStreamBuffer
+ * \brief Stream buffer reading characters straight from memory.
+ *
+ * The whole region is the get area, so that the formatted input of the
+ * streams scans the memory without copying it, and seeking is immediate.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MemoryStreamBuffer:public std::streambuf
+{
+public:
+  MemoryStreamBuffer();
+
+  /** Read the given region, which must outlive the stream buffer. */
+  void SetRegion(const char *data, std::size_t size);
+
+  /** Return the next size characters and skip them, or a null pointer when
+   * fewer are left. */
+  const char * Consume(std::size_t size);
+
+  /** The characters left to read are [GetCurrent(), GetEnd()) */
+  const char * GetCurrent() const { return this->gptr(); }
+
+  const char * GetEnd() const { return this->egptr(); }
+
+protected:
+  virtual pos_type seekoff(off_type offset, std::ios::seekdir direction, std::ios::openmode which);
+
+  virtual pos_type seekpos(pos_type position, std::ios::openmode which);
+
+  virtual std::streamsize showmanyc();
+
+private:
+  MemoryStreamBuffer(const MemoryStreamBuffer &); // purposely not implemented
+  void operator=(const MemoryStreamBuffer &);     // purposely not implemented
+};
+
+/** \class MeshFileMapping
+ * \brief Read only view of the whole content of a file in memory.
+ *
+ * Plain files are memory mapped, with sequential access advised to the
+ * system, or read into a buffer where they cannot be mapped. Gzip
+ * compressed files are inflated into the buffer. The content may also be
+ * given in memory, which is viewed in place.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshFileMapping
+{
+public:
+  MeshFileMapping();
+  ~MeshFileMapping();
+
+  /** Map or read a file, returns false on failure. */
+  bool Open(const char *fileName);
+
+  /** View the size bytes at data, which must outlive the mapping, or
+   * inflate them when they are gzip compressed. */
+  bool Open(const char *data, std::size_t size);
+
+  void Close();
+
+  bool IsOpen() const { return m_Open; }
+
+  /** Content of the file */
+  const char * GetData() const;
+
+  std::size_t GetSize() const;
+
+  /** Whether the file is memory mapped rather than read into a buffer */
+  bool IsMapped() const { return m_MappedData != 0; }
+
+  /** Whether the file is gzip compressed */
+  bool IsCompressed() const { return m_Compressed; }
+
+private:
+  MeshFileMapping(const MeshFileMapping &); // purposely not implemented
+  void operator=(const MeshFileMapping &);  // purposely not implemented
+
+  bool Map(const char *fileName);
+
+  void *      m_MappedData;
+  std::size_t m_MappedSize;
+  const char *m_ViewedData;
+  std::size_t m_ViewedSize;
+  std::string m_Buffer;
+  bool        m_Open;
+  bool        m_Compressed;
+};
+
+/** \class MeshInputFileStream
+ * \brief Input file stream reading mesh files from memory.
+ *
+ * MeshInputFileStream offers the open(), is_open() and close() methods of
+ * std::ifstream. The file is held in memory by a MeshFileMapping and read
+ * through a MemoryStreamBuffer: a file starting with the gzip magic bytes
+ * is inflated when it is opened, so that the readers can still seek in it.
+ * The binary sections can be taken straight from GetData() at the offset
+ * given by tellg().
+ *
+ * A stream opened on another open stream reads the same memory with a
+ * position of its own, without mapping or inflating the file again: the
+ * reads of several threads each use such a context on the one stream
+ * opened by ReadMeshInformation(), which must stay open meanwhile.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshInputFileStream:public std::istream
+{
+public:
+  MeshInputFileStream();
+
+  /** Open a file. The mode is accepted for compatibility with
+   * std::ifstream, the file is always read as binary. */
+  void open(const char *fileName, std::ios::openmode mode = std::ios::in);
+
+  /** Read the content of another open stream from its start. */
+  void open(const MeshInputFileStream & file);
+
+  /** Read the size bytes at data in place, rather than a file. They must
+   * outlive the stream, and are inflated when they are gzip compressed. */
+  void OpenBuffer(const char *data, std::size_t size);
+
+  bool is_open() const;
+
+  void close();
+
+  /** Whether the open file is gzip compressed */
+  bool IsCompressed() const;
+
+  /** Content of the open file */
+  const char * GetData() const;
+
+  std::size_t GetSize() const;
+
+  /** Return the size characters at position, or a null pointer when the
+   * file is shorter. Unlike seekg() and read(), this leaves the position
+   * of the stream alone, so that several threads may share the stream. */
+  const char * GetData(std::streamoff position, std::size_t size) const;
+
+  /** Whether a file starts with the gzip magic bytes */
+  static bool IsGzipFile(const char *fileName);
+
+  /** Whether a buffer starts with the gzip magic bytes */
+  static bool IsGzipBuffer(const char *data, std::size_t size);
+
+  /** Inflate a gzip file. Files written in blocks by GzipOutputStreamBuffer
+   * are inflated by several threads. */
+  static bool InflateFile(const char *fileName, std::string & data);
+
+  /** Inflate gzip data held in memory, like InflateFile(). */
+  static bool InflateBuffer(const char *input, std::size_t inputSize, std::string & data);
+
+  /** Read the first length bytes of a file, or the whole file when it is
+   * shorter, inflated when it is gzip compressed. Returns false when the
+   * file cannot be read. */
+  static bool ReadFileHeader(const char *fileName, std::size_t length, std::string & header);
+
+  /** Same as ReadFileHeader(), for a file held in memory */
+  static bool ReadBufferHeader(const char *data, std::size_t size, std::size_t length, std::string & header);
+
+private:
+  MeshInputFileStream(const MeshInputFileStream &); // purposely not implemented
+  void operator=(const MeshInputFileStream &);      // purposely not implemented
+
+  MeshFileMapping    m_Mapping;
+  MemoryStreamBuffer m_MemoryBuffer;
+
+  /** Stream whose content is read, when opened on another stream */
+  const MeshInputFileStream *m_Source;
+};
+} // end namespace itk
+
+#endif // __itkMeshFileStreams_h
@@ -20,6 +20,11 @@
 #include "itkProcessObject.h"
 #include "itkMeshIOBase.h"
 #include "itkExceptionObject.h"
+#include "itkNumericTraits.h"
+#include "itkVectorContainer.h"
+
+#include <string>
+#include <vector>
 
 namespace itk
 {
@@ -91,6 +96,7 @@ public:
   typedef typename InputMeshType::RegionType InputMeshRegionType;
   typedef typename InputMeshType::PixelType  InputMeshPixelType;
   typedef typename InputMeshType::CellType   InputMeshCellType;
+  typedef MeshIOBase::SizeValueType          SizeValueType;
 
   /** Set/Get the mesh input of this writer.  */
   void  SetInput(const InputMeshType *input);
@@ -103,6 +109,22 @@ public:
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
 
+  /** Write the mesh into a memory buffer rather than to a file. The file
+   * encoded replaces the content of the string, which grows as it is
+   * written and must outlive the update. The format is chosen explicitly,
+   * by SetMeshIO() or by the extension of FileName, such as ".vtk" or
+   * ".vtk.gz", which then names no file. A null buffer writes FileName
+   * again. */
+  void SetOutputBuffer(std::string *buffer);
+
+  std::string * GetOutputBuffer() const { return m_OutputBuffer; }
+
+  /** Write the mesh to a stream, from its current position, rather than
+   * to a file, like an output buffer. */
+  void SetOutputStream(std::ostream *stream);
+
+  std::ostream * GetOutputStream() const { return m_OutputStream; }
+
   /** Set/Get the MeshIO helper class. Usually this is created via the object
   * factory mechanism that determines whether a particular MeshIO can
   * write a certain file. This method provides a way to get the MeshIO
@@ -143,6 +165,58 @@ public:
   itkSetMacro(UseCompression, bool);
   itkGetConstReferenceMacro(UseCompression, bool);
   itkBooleanMacro(UseCompression);
+
+  /** Set/Get the number of threads compressing the file. With more than one,
+   * large files are compressed in blocks that are deflated in parallel. */
+  itkSetClampMacro( NumberOfCompressionThreads, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro(NumberOfCompressionThreads, unsigned int);
+
+  /** Set/Get the precision of the floating point numbers of ASCII files. 0,
+   * the default, writes decimals which read back exactly, usually the
+   * shortest ones. */
+  itkSetMacro(AsciiPrecision, unsigned int);
+  itkGetConstMacro(AsciiPrecision, unsigned int);
+
+  /** Set/Get streamed writing. When it is on and the MeshIO supports it,
+   * the points, cells, point data and cell data are copied and written
+   * ChunkSize points or cells at a time, so that the memory used by the
+   * writer does not grow with the size of the mesh. */
+  itkSetMacro(UseStreaming, bool);
+  itkGetConstReferenceMacro(UseStreaming, bool);
+  itkBooleanMacro(UseStreaming);
+
+  /** Set/Get the number of points or cells written at a time when
+   * streaming. */
+  itkSetClampMacro( ChunkSize, SizeValueType, 1, NumericTraits< SizeValueType >::max() );
+  itkGetConstMacro(ChunkSize, SizeValueType);
+
+  /** Set/Get the size in bytes of the buffer of the output file, which is
+   * opened once for the whole Write() and flushed when it is closed. */
+  itkSetMacro(WriteBufferSize, SizeValueType);
+  itkGetConstMacro(WriteBufferSize, SizeValueType);
+
+  /** Set/Get whether the mesh is written to a temporary file which is
+   * renamed to FileName once the whole mesh is written, so that a partially
+   * written file is never seen under FileName. The temporary file is deleted
+   * if writing fails. On by default. */
+  itkSetMacro(UseTemporaryFile, bool);
+  itkGetConstMacro(UseTemporaryFile, bool);
+  itkBooleanMacro(UseTemporaryFile);
+
+  /** Set/Get whether the file is flushed to the storage device before it is
+   * renamed. Off by default. */
+  itkSetMacro(SyncOutputFile, bool);
+  itkGetConstMacro(SyncOutputFile, bool);
+  itkBooleanMacro(SyncOutputFile);
+
+  /** Set/Get whether the point data and cell data of the input are appended
+   * to the existing FileName, whose points and cells are left untouched.
+   * The number of points and cells of the data must match those of the
+   * file. The names of the appended arrays are taken from the meta data
+   * dictionary of the MeshIO, as when writing. Off by default. */
+  itkSetMacro(AppendData, bool);
+  itkGetConstMacro(AppendData, bool);
+  itkBooleanMacro(AppendData);
 protected:
   MeshFileWriter();
   ~MeshFileWriter();
@@ -151,8 +225,11 @@ protected:
   template< class Output >
   void CopyPointsToBuffer(Output *data);
 
+  /** Copy the cells into the cell buffer, sized exactly by a counting
+   * traversal, and set the cell buffer size and the per cell type
+   * statistics of the MeshIO. */
   template< class Output >
-  void CopyCellsToBuffer(Output *data);
+  void CopyCellsToBuffer(std::vector< Output > & data);
 
   template< class Output >
   void CopyPointDataToBuffer(Output *data);
@@ -160,6 +237,23 @@ protected:
   template< class Output >
   void CopyCellDataToBuffer(Output *data);
 
+  /** Map the type of a mesh cell to the type of a MeshIO cell */
+  MeshIOBase::CellGeometryType GetCellGeometryType(const InputMeshCellType *cell) const;
+
+  /** Return the storage of a VectorContainer, whose elements are stored
+   * contiguously. Any other container returns a null pointer. */
+  template< class TElementIdentifier, class TElement >
+  static const void * GetContiguousBuffer(const VectorContainer< TElementIdentifier, TElement > *container)
+    {
+    return &( container->CastToSTLConstContainer()[0] );
+    }
+
+  template< class TContainer >
+  static const void * GetContiguousBuffer(const TContainer *itkNotUsed(container))
+    {
+    return 0;
+    }
+
   void WritePoints();
 
   void WriteCells();
@@ -168,6 +262,21 @@ protected:
 
   void WriteCellData();
 
+  /** Streamed counterparts of WritePoints(), WriteCells(), WritePointData()
+   * and WriteCellData(), which only hold one chunk in memory. */
+  void StreamPoints();
+
+  void StreamCells();
+
+  template< class TContainer >
+  void StreamData(const TContainer *data, MeshIOBase::SectionType section);
+
+  void WriteDataChunk(void *buffer, SizeValueType numberOfPixels, MeshIOBase::SectionType section);
+
+  /** Set the cell buffer size and the cell type statistics of the MeshIO
+   * without building the cell buffer */
+  void UpdateCellTypeStatistics();
+
 private:
   MeshFileWriter(const Self &); // purposely not implemented
   void operator=(const Self &); // purposely not implemented
@@ -179,7 +288,17 @@ private:
   bool                m_FactorySpecifiedMeshIO; // track whether the factory
                                                 // mechanism set the MeshIO
   bool                m_UseCompression;
+  unsigned int        m_NumberOfCompressionThreads;
+  unsigned int        m_AsciiPrecision;
   bool                m_FileTypeIsBINARY;
+  bool                m_UseStreaming;
+  SizeValueType       m_ChunkSize;
+  SizeValueType       m_WriteBufferSize;
+  bool                m_UseTemporaryFile;
+  bool                m_SyncOutputFile;
+  bool                m_AppendData;
+  std::string *       m_OutputBuffer;
+  std::ostream *      m_OutputStream;
 };
 } // end namespace itk
 
@@ -26,6 +26,8 @@
 
 #include "vnl/vnl_vector.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template< class TInputMesh >
@@ -34,9 +36,19 @@ MeshFileWriter< TInputMesh >
 {
   m_MeshIO = 0;
   m_UseCompression = false;
+  m_NumberOfCompressionThreads = 1;
+  m_AsciiPrecision = 0;
   m_FactorySpecifiedMeshIO = false;
   m_UserSpecifiedMeshIO = false;
   m_FileTypeIsBINARY = false;
+  m_UseStreaming = false;
+  m_ChunkSize = 65536;
+  m_WriteBufferSize = 1024 * 1024;
+  m_UseTemporaryFile = true;
+  m_SyncOutputFile = false;
+  m_AppendData = false;
+  m_OutputBuffer = 0;
+  m_OutputStream = 0;
 }
 
 template< class TInputMesh >
@@ -52,6 +64,32 @@ MeshFileWriter< TInputMesh >
   this->ProcessObject::SetNthInput( 0, const_cast< TInputMesh * >( input ) );
 }
 
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::SetOutputBuffer(std::string *buffer)
+{
+  if ( buffer != m_OutputBuffer || m_OutputStream != 0 )
+    {
+    m_OutputBuffer = buffer;
+    m_OutputStream = 0;
+    this->Modified();
+    }
+}
+
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::SetOutputStream(std::ostream *stream)
+{
+  if ( stream != m_OutputStream || m_OutputBuffer != 0 )
+    {
+    m_OutputBuffer = 0;
+    m_OutputStream = stream;
+    this->Modified();
+    }
+}
+
 template< class TInputMesh >
 const typename MeshFileWriter< TInputMesh >::InputMeshType *
 MeshFileWriter< TInputMesh >
@@ -88,11 +126,19 @@ MeshFileWriter< TInputMesh >
     itkExceptionMacro(<< "No input to writer!");
     }
 
-  // Make sure that we can write the file given the name
-  if ( m_FileName == "" )
+  // Make sure that we can write the file given the name. Without a file,
+  // either a MeshIO or the extension of FileName gives the format
+  const bool toSink = m_OutputBuffer || m_OutputStream;
+  if ( m_FileName == "" && !toSink )
     {
     throw MeshFileWriterException(__FILE__, __LINE__, "FileName must be specified", ITK_LOCATION);
     }
+  if ( m_FileName == "" && ( m_MeshIO.IsNull() || m_FactorySpecifiedMeshIO ) )
+    {
+    throw MeshFileWriterException(__FILE__, __LINE__,
+                                  "A MeshIO, or a FileName whose extension names the format, must be specified",
+                                  ITK_LOCATION);
+    }
 
   if ( !( m_UserSpecifiedMeshIO && !m_MeshIO.IsNull() ) )
     {
@@ -151,9 +197,35 @@ MeshFileWriter< TInputMesh >
 
   // Setup the MeshIO
   m_MeshIO->SetFileName( m_FileName.c_str() );
+  if ( m_OutputStream )
+    {
+    m_MeshIO->SetOutputStream(m_OutputStream);
+    }
+  else
+    {
+    m_MeshIO->SetOutputBuffer(m_OutputBuffer);
+    }
+  m_MeshIO->SetUseCompression(m_UseCompression);
+  m_MeshIO->SetNumberOfCompressionThreads(m_NumberOfCompressionThreads);
+  m_MeshIO->SetAsciiPrecision(m_AsciiPrecision);
+  m_MeshIO->SetWriteBufferSize(m_WriteBufferSize);
+  m_MeshIO->SetUseTemporaryFile(m_UseTemporaryFile);
+  m_MeshIO->SetSyncOutputFile(m_SyncOutputFile);
+
+  // Only the point data and cell data are appended to an existing file
+  if ( m_AppendData && !m_MeshIO->CanAppendData() )
+    {
+    itkExceptionMacro(<< m_MeshIO->GetNameOfClass() << " cannot append data to " << m_FileName);
+    }
+  m_MeshIO->SetAppendData(m_AppendData);
+  if ( m_AppendData )
+    {
+    m_MeshIO->SetUpdatePoints(false);
+    m_MeshIO->SetUpdateCells(false);
+    }
 
   // Whether write points
-  if ( input->GetPoints() && input->GetNumberOfPoints() )
+  if ( !m_AppendData && input->GetPoints() && input->GetNumberOfPoints() )
     {
     m_MeshIO->SetUpdatePoints(true);
     m_MeshIO->SetNumberOfPoints( input->GetNumberOfPoints() );
@@ -215,7 +287,7 @@ MeshFileWriter< TInputMesh >
     }
 
   // Whether write cells
-  if ( input->GetCells() && input->GetNumberOfCells() )
+  if ( !m_AppendData && input->GetCells() && input->GetNumberOfCells() )
     {
     m_MeshIO->SetUpdateCells(true);
     m_MeshIO->SetNumberOfCells( input->GetNumberOfCells() );
@@ -403,36 +475,45 @@ MeshFileWriter< TInputMesh >
 
   this->InvokeEvent( StartEvent() );
 
-  // Write mesh information
-  m_MeshIO->WriteMeshInformation();
-
-  // write points
-  if ( input->GetPoints() && input->GetNumberOfPoints() )
+  try
     {
-    WritePoints();
-    }
+    // Write mesh information
+    m_MeshIO->WriteMeshInformation();
 
-  // Write cells
-  if ( input->GetCells() && input->GetNumberOfCells() )
-    {
-    WriteCells();
-    }
+    // write points
+    if ( !m_AppendData && input->GetPoints() && input->GetNumberOfPoints() )
+      {
+      WritePoints();
+      }
 
-  // Write point data
-  if ( input->GetPointData() && input->GetPointData()->Size() )
-    {
-    WritePointData();
-    }
+    // Write cells
+    if ( !m_AppendData && input->GetCells() && input->GetNumberOfCells() )
+      {
+      WriteCells();
+      }
 
-  // Write cell data
-  if ( input->GetCellData() && input->GetCellData()->Size() )
+    // Write point data
+    if ( input->GetPointData() && input->GetPointData()->Size() )
+      {
+      WritePointData();
+      }
+
+    // Write cell data
+    if ( input->GetCellData() && input->GetCellData()->Size() )
+      {
+      WriteCellData();
+      }
+
+    // Write to disk
+    m_MeshIO->Write();
+    }
+  catch ( ... )
     {
-    WriteCellData();
+    // Delete the partially written file, then rethrow
+    m_MeshIO->AbortOutputFile();
+    throw;
     }
 
-  // Write to disk
-  m_MeshIO->Write();
-
   // Notify end event observers
   this->InvokeEvent( EndEvent() );
 
@@ -449,6 +530,22 @@ MeshFileWriter< TInputMesh >
 
   itkDebugMacro(<< "Writing points: " << m_FileName);
 
+  if ( m_UseStreaming && m_MeshIO->CanStreamWrite() )
+    {
+    this->StreamPoints();
+    return;
+    }
+
+  // The points of a VectorContainer are already laid out as the points
+  // buffer, so they are handed to the MeshIO without a copy
+  const void *points = GetContiguousBuffer( input->GetPoints() );
+  if ( points && sizeof( typename TInputMesh::PointType )
+       == TInputMesh::PointDimension * sizeof( typename TInputMesh::PointType::ValueType ) )
+    {
+    m_MeshIO->WritePoints( const_cast< void * >( points ) );
+    return;
+    }
+
   std::string type( typeid( typename TInputMesh::PointType::ValueType ).name() );
   if ( type == std::string( typeid( unsigned char ).name() ) )
     {
@@ -552,106 +649,95 @@ MeshFileWriter< TInputMesh >
 
   itkDebugMacro(<< "Writing cells: " << m_FileName);
 
-  unsigned long cellsBufferSize = 2 * input->GetNumberOfCells();
-  for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin(); ct != input->GetCells()->End(); ++ct )
+  if ( m_UseStreaming && m_MeshIO->CanStreamWrite() )
     {
-    cellsBufferSize += ct->Value()->GetNumberOfPoints();
+    this->StreamCells();
+    return;
     }
 
-  m_MeshIO->SetCellBufferSize(cellsBufferSize);
-
+  // The cell buffer is sized exactly before it is filled, and summarized
+  // per cell type while it is filled, see CopyCellsToBuffer()
   std::string type( typeid( typename TInputMesh::PointIdentifier ).name() );
   if ( type == std::string( typeid( unsigned char ).name() ) )
     {
-    unsigned char *buffer = new unsigned char[cellsBufferSize];
+    std::vector< unsigned char > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( char ).name() ) )
     {
-    char *buffer = new char[cellsBufferSize];
+    std::vector< char > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( unsigned short ).name() ) )
     {
-    unsigned short *buffer = new unsigned short[cellsBufferSize];
+    std::vector< unsigned short > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( short ).name() ) )
     {
-    short *buffer = new short[cellsBufferSize];
+    std::vector< short > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( unsigned int ).name() ) )
     {
-    unsigned int *buffer = new unsigned int[cellsBufferSize];
+    std::vector< unsigned int > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( int ).name() ) )
     {
-    int *buffer = new int[cellsBufferSize];
+    std::vector< int > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( unsigned long ).name() ) )
     {
-    unsigned long *buffer = new unsigned long[cellsBufferSize];
+    std::vector< unsigned long > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( long ).name() ) )
     {
-    long *buffer = new long[cellsBufferSize];
+    std::vector< long > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( unsigned long long ).name() ) )
     {
-    unsigned long long *buffer = new unsigned long long[cellsBufferSize];
+    std::vector< unsigned long long > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( long long ).name() ) )
     {
-    long long *buffer = new long long[cellsBufferSize];
+    std::vector< long long > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( float ).name() ) )
     {
-    float *buffer = new float[cellsBufferSize];
+    std::vector< float > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( double ).name() ) )
     {
-    double *buffer = new double[cellsBufferSize];
+    std::vector< double > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
   else if ( type == std::string( typeid( long double ).name() ) )
     {
-    long double *buffer = new long double[cellsBufferSize];
+    std::vector< long double > buffer;
     CopyCellsToBuffer(buffer);
-    m_MeshIO->WriteCells(buffer);
-    delete[] buffer;
+    m_MeshIO->WriteCells(&buffer[0]);
     }
+
+  m_MeshIO->ClearCellTypeStatistics();
 }
 
 template< class TInputMesh >
@@ -663,11 +749,30 @@ MeshFileWriter< TInputMesh >
 
   itkDebugMacro(<< "Writing point data: " << m_FileName);
 
+  if ( m_UseStreaming && m_MeshIO->CanStreamWrite() )
+    {
+    this->StreamData(input->GetPointData(), MeshIOBase::POINTDATA_SECTION);
+    return;
+    }
+
   if ( input->GetPointData()->Size() )
     {
     unsigned long numberOfComponents = input->GetPointData()->Size()
                                        * MeshConvertPixelTraits< typename TInputMesh::PixelType >::GetNumberOfComponents(
        input->GetPointData()->ElementAt(0) );
+
+    // Fixed size pixels stored in a VectorContainer are already laid out as
+    // the point data buffer, so they are handed to the MeshIO without a copy
+    typedef MeshConvertPixelTraits< typename TInputMesh::PixelType > PixelTraits;
+    const void *pointData = GetContiguousBuffer( input->GetPointData() );
+    if ( pointData && PixelTraits::GetNumberOfComponents() != 0
+         && sizeof( typename TInputMesh::PixelType ) == PixelTraits::GetNumberOfComponents()
+         * sizeof( typename itk::NumericTraits< typename TInputMesh::PixelType >::ValueType ) )
+      {
+      m_MeshIO->WritePointData( const_cast< void * >( pointData ) );
+      return;
+      }
+
     std::string type( typeid( typename itk::NumericTraits< typename TInputMesh::PixelType >::ValueType ).name() );
     if ( type == std::string( typeid( unsigned char ).name() ) )
       {
@@ -772,11 +877,30 @@ MeshFileWriter< TInputMesh >
 
   itkDebugMacro(<< "Writing cell data: " << m_FileName);
 
+  if ( m_UseStreaming && m_MeshIO->CanStreamWrite() )
+    {
+    this->StreamData(input->GetCellData(), MeshIOBase::CELLDATA_SECTION);
+    return;
+    }
+
   if ( input->GetCellData()->Size() )
     {
     unsigned long numberOfComponents = input->GetCellData()->Size()
                                        * MeshConvertPixelTraits< typename TInputMesh::CellPixelType >::GetNumberOfComponents(
        input->GetCellData()->ElementAt(0) );
+
+    // Fixed size pixels stored in a VectorContainer are already laid out as
+    // the cell data buffer, so they are handed to the MeshIO without a copy
+    typedef MeshConvertPixelTraits< typename TInputMesh::CellPixelType > PixelTraits;
+    const void *cellData = GetContiguousBuffer( input->GetCellData() );
+    if ( cellData && PixelTraits::GetNumberOfComponents() != 0
+         && sizeof( typename TInputMesh::CellPixelType ) == PixelTraits::GetNumberOfComponents()
+         * sizeof( typename itk::NumericTraits< typename TInputMesh::CellPixelType >::ValueType ) )
+      {
+      m_MeshIO->WriteCellData( const_cast< void * >( cellData ) );
+      return;
+      }
+
     std::string type( typeid( typename itk::NumericTraits< typename TInputMesh::CellPixelType >::ValueType ).name() );
     if ( type == std::string( typeid( unsigned char ).name() ) )
       {
@@ -891,67 +1015,60 @@ void MeshFileWriter< TInputMesh >::CopyPointsToBuffer(Output *data)
 
 template< class TInputMesh >
 template< class Output >
-void MeshFileWriter< TInputMesh >::CopyCellsToBuffer(Output *data)
+void MeshFileWriter< TInputMesh >::CopyCellsToBuffer(std::vector< Output > & data)
 {
   // Get input mesh pointer
   const InputMeshType *input = this->GetInput();
 
-  // Define required variables
-  typename TInputMesh::PointIdentifier const  *ptIds;
-  typename TInputMesh::CellAutoPointer cellPtr;
-
-  // Traverse each cell 
-  typename TInputMesh::CellIdentifier ind = NumericTraits< typename TInputMesh::CellIdentifier >::Zero;
-  for ( typename TInputMesh::CellIdentifier id = 0; id < input->GetNumberOfCells(); id++ )
-    {
-    input->GetCell(id, cellPtr);
-    // Write the cell type 
-    switch ( cellPtr->GetType() )
-      {
-      case InputMeshCellType::VERTEX_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::VERTEX_CELL );
-        break;
-      case InputMeshCellType::LINE_CELL:
-        // data[ind++] = static_cast< Output >( MeshIOBase::LINE_CELL );
-        data[ind++] = static_cast< Output >( MeshIOBase::POLYLINE_CELL );
-        break;
-      case InputMeshCellType::TRIANGLE_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::TRIANGLE_CELL );
-        // data[ind++] = static_cast<Output>(MeshIOBase::POLYGON_CELL);
-        break;
-      case InputMeshCellType::QUADRILATERAL_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::QUADRILATERAL_CELL );
-        break;
-      case InputMeshCellType::POLYGON_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::POLYGON_CELL );
-        break;
-      case InputMeshCellType::TETRAHEDRON_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::TETRAHEDRON_CELL );
-        break;
-      case InputMeshCellType::HEXAHEDRON_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::HEXAHEDRON_CELL );
-        break;
-      case InputMeshCellType::QUADRATIC_EDGE_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::QUADRATIC_EDGE_CELL );
-        break;
-      case InputMeshCellType::QUADRATIC_TRIANGLE_CELL:
-        data[ind++] = static_cast< Output >( MeshIOBase::QUADRATIC_TRIANGLE_CELL );
-        break;
-      default:
-        itkExceptionMacro(<< "Unknown mesh cell");
-      }
+  // The cell buffer is sized exactly by a first traversal, which only adds
+  // up the numbers of points of the cells: a size guessed from a few cells
+  // may be wrong by any factor, and growing the buffer would copy it and
+  // double the peak memory
+  SizeValueType cellBufferSize = 0;
+  for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+        ct != input->GetCells()->End(); ++ct )
+    {
+    cellBufferSize += 2 + ct->Value()->GetNumberOfPoints();
+    }
+
+  data.clear();
+  data.reserve( static_cast< std::size_t >( cellBufferSize ) );
+
+  MeshIOBase::SizeValueType numberOfCellsOfType[MeshIOBase::LAST_ITK_CELL];
+  MeshIOBase::SizeValueType numberOfCellPointsOfType[MeshIOBase::LAST_ITK_CELL];
+  for ( unsigned int ii = 0; ii < MeshIOBase::LAST_ITK_CELL; ii++ )
+    {
+    numberOfCellsOfType[ii] = NumericTraits< MeshIOBase::SizeValueType >::Zero;
+    numberOfCellPointsOfType[ii] = NumericTraits< MeshIOBase::SizeValueType >::Zero;
+    }
+
+  // The second traversal copies the cells and gathers the per cell type
+  // statistics
+  for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+        ct != input->GetCells()->End(); ++ct )
+    {
+    const InputMeshCellType *cellPtr = ct->Value();
+
+    // Write the cell type
+    const MeshIOBase::CellGeometryType cellType = this->GetCellGeometryType(cellPtr);
+    data.push_back( static_cast< Output >( cellType ) );
 
     // The second element is number of points for each cell
-    data[ind++] = cellPtr->GetNumberOfPoints();
+    const unsigned int numberOfPoints = cellPtr->GetNumberOfPoints();
+    data.push_back( static_cast< Output >( numberOfPoints ) );
+    numberOfCellsOfType[cellType]++;
+    numberOfCellPointsOfType[cellType] += numberOfPoints;
 
-    // Others are point identifiers in the cell 
-    ptIds = cellPtr->GetPointIds();
-    unsigned int numberOfPoints = cellPtr->GetNumberOfPoints();
+    // Others are point identifiers in the cell
+    const typename TInputMesh::PointIdentifier *ptIds = cellPtr->GetPointIds();
     for ( unsigned int ii = 0; ii < numberOfPoints; ii++ )
       {
-      data[ind++] = static_cast< Output >( ptIds[ii] );
+      data.push_back( static_cast< Output >( ptIds[ii] ) );
       }
     }
+
+  m_MeshIO->SetCellBufferSize(cellBufferSize);
+  m_MeshIO->SetCellTypeStatistics(numberOfCellsOfType, numberOfCellPointsOfType);
 }
 
 template< class TInputMesh >
@@ -1004,6 +1121,202 @@ void MeshFileWriter< TInputMesh >::CopyCellDataToBuffer(Output *data)
     }
 }
 
+template< class TInputMesh >
+MeshIOBase::CellGeometryType
+MeshFileWriter< TInputMesh >
+::GetCellGeometryType(const InputMeshCellType *cell) const
+{
+  switch ( cell->GetType() )
+    {
+    case InputMeshCellType::VERTEX_CELL:
+      return MeshIOBase::VERTEX_CELL;
+    case InputMeshCellType::LINE_CELL:
+      return MeshIOBase::POLYLINE_CELL;
+    case InputMeshCellType::TRIANGLE_CELL:
+      return MeshIOBase::TRIANGLE_CELL;
+    case InputMeshCellType::QUADRILATERAL_CELL:
+      return MeshIOBase::QUADRILATERAL_CELL;
+    case InputMeshCellType::POLYGON_CELL:
+      return MeshIOBase::POLYGON_CELL;
+    case InputMeshCellType::TETRAHEDRON_CELL:
+      return MeshIOBase::TETRAHEDRON_CELL;
+    case InputMeshCellType::HEXAHEDRON_CELL:
+      return MeshIOBase::HEXAHEDRON_CELL;
+    case InputMeshCellType::QUADRATIC_EDGE_CELL:
+      return MeshIOBase::QUADRATIC_EDGE_CELL;
+    case InputMeshCellType::QUADRATIC_TRIANGLE_CELL:
+      return MeshIOBase::QUADRATIC_TRIANGLE_CELL;
+    default:
+      itkExceptionMacro(<< "Unknown mesh cell");
+    }
+  return MeshIOBase::LAST_ITK_CELL;
+}
+
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::StreamPoints()
+{
+  typedef typename TInputMesh::PointType::ValueType ValueType;
+  const unsigned int dimension = TInputMesh::PointDimension;
+
+  const InputMeshType *input = this->GetInput();
+  std::vector< ValueType > buffer( std::min( m_ChunkSize, static_cast< SizeValueType >( input->GetNumberOfPoints() ) )
+                                   * dimension );
+
+  m_MeshIO->BeginWriteSection(MeshIOBase::POINTS_SECTION);
+  SizeValueType numberOfPoints = 0;
+  for ( typename TInputMesh::PointsContainer::ConstIterator pt = input->GetPoints()->Begin();
+        pt != input->GetPoints()->End(); ++pt )
+    {
+    for ( unsigned int jj = 0; jj < dimension; jj++ )
+      {
+      buffer[numberOfPoints * dimension + jj] = static_cast< ValueType >( pt.Value()[jj] );
+      }
+    if ( ++numberOfPoints == m_ChunkSize )
+      {
+      m_MeshIO->WritePointsChunk(&buffer[0], numberOfPoints);
+      numberOfPoints = 0;
+      }
+    }
+  if ( numberOfPoints )
+    {
+    m_MeshIO->WritePointsChunk(&buffer[0], numberOfPoints);
+    }
+  m_MeshIO->EndWriteSection(MeshIOBase::POINTS_SECTION);
+}
+
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::StreamCells()
+{
+  typedef typename TInputMesh::PointIdentifier ValueType;
+
+  const InputMeshType *input = this->GetInput();
+
+  // Formats grouping the cells by type need the statistics up front
+  this->UpdateCellTypeStatistics();
+
+  std::vector< ValueType > buffer;
+  const unsigned int numberOfPasses = m_MeshIO->GetNumberOfCellsWritePasses();
+  for ( unsigned int pass = 0; pass < numberOfPasses; pass++ )
+    {
+    m_MeshIO->BeginWriteSection(MeshIOBase::CELLS_SECTION, pass);
+    SizeValueType numberOfCells = 0;
+    buffer.clear();
+    for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+          ct != input->GetCells()->End(); ++ct )
+      {
+      const InputMeshCellType *cellPtr = ct->Value();
+      const unsigned int       numberOfPoints = cellPtr->GetNumberOfPoints();
+      const typename TInputMesh::PointIdentifier *ptIds = cellPtr->GetPointIds();
+
+      buffer.push_back( static_cast< ValueType >( this->GetCellGeometryType(cellPtr) ) );
+      buffer.push_back( static_cast< ValueType >( numberOfPoints ) );
+      for ( unsigned int ii = 0; ii < numberOfPoints; ii++ )
+        {
+        buffer.push_back( static_cast< ValueType >( ptIds[ii] ) );
+        }
+
+      if ( ++numberOfCells == m_ChunkSize )
+        {
+        m_MeshIO->WriteCellsChunk(&buffer[0], numberOfCells);
+        numberOfCells = 0;
+        buffer.clear();
+        }
+      }
+    if ( numberOfCells )
+      {
+      m_MeshIO->WriteCellsChunk(&buffer[0], numberOfCells);
+      }
+    m_MeshIO->EndWriteSection(MeshIOBase::CELLS_SECTION, pass);
+    }
+
+  m_MeshIO->ClearCellTypeStatistics();
+}
+
+template< class TInputMesh >
+template< class TContainer >
+void
+MeshFileWriter< TInputMesh >
+::StreamData(const TContainer *data, MeshIOBase::SectionType section)
+{
+  typedef typename TContainer::Element                   PixelType;
+  typedef typename NumericTraits< PixelType >::ValueType ValueType;
+  typedef MeshConvertPixelTraits< PixelType >            PixelTraits;
+
+  const unsigned int numberOfComponents = PixelTraits::GetNumberOfComponents( data->Begin().Value() );
+  std::vector< ValueType > buffer( std::min( m_ChunkSize, static_cast< SizeValueType >( data->Size() ) )
+                                   * numberOfComponents );
+
+  m_MeshIO->BeginWriteSection(section);
+  SizeValueType numberOfPixels = 0;
+  for ( typename TContainer::ConstIterator it = data->Begin(); it != data->End(); ++it )
+    {
+    for ( unsigned int jj = 0; jj < numberOfComponents; jj++ )
+      {
+      buffer[numberOfPixels * numberOfComponents + jj] =
+        static_cast< ValueType >( PixelTraits::GetNthComponent( jj, it.Value() ) );
+      }
+    if ( ++numberOfPixels == m_ChunkSize )
+      {
+      this->WriteDataChunk(&buffer[0], numberOfPixels, section);
+      numberOfPixels = 0;
+      }
+    }
+  if ( numberOfPixels )
+    {
+    this->WriteDataChunk(&buffer[0], numberOfPixels, section);
+    }
+  m_MeshIO->EndWriteSection(section);
+}
+
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::WriteDataChunk(void *buffer, SizeValueType numberOfPixels, MeshIOBase::SectionType section)
+{
+  if ( section == MeshIOBase::POINTDATA_SECTION )
+    {
+    m_MeshIO->WritePointDataChunk(buffer, numberOfPixels);
+    }
+  else
+    {
+    m_MeshIO->WriteCellDataChunk(buffer, numberOfPixels);
+    }
+}
+
+template< class TInputMesh >
+void
+MeshFileWriter< TInputMesh >
+::UpdateCellTypeStatistics()
+{
+  const InputMeshType *input = this->GetInput();
+
+  MeshIOBase::SizeValueType numberOfCellsOfType[MeshIOBase::LAST_ITK_CELL];
+  MeshIOBase::SizeValueType numberOfCellPointsOfType[MeshIOBase::LAST_ITK_CELL];
+  for ( unsigned int ii = 0; ii < MeshIOBase::LAST_ITK_CELL; ii++ )
+    {
+    numberOfCellsOfType[ii] = NumericTraits< MeshIOBase::SizeValueType >::Zero;
+    numberOfCellPointsOfType[ii] = NumericTraits< MeshIOBase::SizeValueType >::Zero;
+    }
+
+  SizeValueType cellBufferSize = 0;
+  for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin();
+        ct != input->GetCells()->End(); ++ct )
+    {
+    const MeshIOBase::CellGeometryType cellType = this->GetCellGeometryType( ct->Value() );
+    const unsigned int                 numberOfPoints = ct->Value()->GetNumberOfPoints();
+    numberOfCellsOfType[cellType]++;
+    numberOfCellPointsOfType[cellType] += numberOfPoints;
+    cellBufferSize += 2 + numberOfPoints;
+    }
+
+  m_MeshIO->SetCellBufferSize(cellBufferSize);
+  m_MeshIO->SetCellTypeStatistics(numberOfCellsOfType, numberOfCellPointsOfType);
+}
+
 template< class TInputMesh >
 void
 MeshFileWriter< TInputMesh >
@@ -1033,6 +1346,17 @@ MeshFileWriter< TInputMesh >
     os << indent << "Compression: Off\n";
     }
 
+  os << indent << "NumberOfCompressionThreads: " << m_NumberOfCompressionThreads << "\n";
+  os << indent << "AsciiPrecision: " << m_AsciiPrecision << "\n";
+  os << indent << "UseStreaming: " << ( m_UseStreaming ? "On" : "Off" ) << "\n";
+  os << indent << "ChunkSize: " << m_ChunkSize << "\n";
+  os << indent << "WriteBufferSize: " << m_WriteBufferSize << "\n";
+  os << indent << "UseTemporaryFile: " << ( m_UseTemporaryFile ? "On" : "Off" ) << "\n";
+  os << indent << "SyncOutputFile: " << ( m_SyncOutputFile ? "On" : "Off" ) << "\n";
+  os << indent << "AppendData: " << ( m_AppendData ? "On" : "Off" ) << "\n";
+  os << indent << "OutputBuffer: " << m_OutputBuffer << "\n";
+  os << indent << "OutputStream: " << m_OutputStream << "\n";
+
   if ( m_FactorySpecifiedMeshIO )
     {
     os << indent << "FactorySpecifiedMeshIO: On\n";
@@ -19,12 +19,35 @@
 #endif
 
 #include "itkMeshIOBase.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <cerrno>
+#include <cstdio>
+#include <iterator>
+#include <sstream>
+
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+#include "itkWindows.h"
+#include <io.h>
+#include <process.h>
+#include <fcntl.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
 
 namespace itk
 {
 MeshIOBase::MeshIOBase():
   m_ByteOrder(OrderNotApplicable),
   m_FileType(ASCII),
+  m_InputBuffer(0),
+  m_InputBufferSize(0),
+  m_InputStream(0),
   m_PointComponentType(UNKNOWNCOMPONENTTYPE),
   m_CellComponentType(UNKNOWNCOMPONENTTYPE),
   m_PointPixelComponentType(UNKNOWNCOMPONENTTYPE),
@@ -37,12 +60,771 @@ MeshIOBase::MeshIOBase():
   m_NumberOfPoints(itk::NumericTraits< SizeValueType >::Zero),
   m_NumberOfCells(itk::NumericTraits< SizeValueType >::Zero),
   m_CellBufferSize(itk::NumericTraits< SizeValueType >::Zero),
+  m_CellTypeStatisticsAvailable(false),
   m_UpdatePoints(false),
   m_UpdateCells(false),
   m_UpdatePointData(false),
-  m_UpdateCellData(false)
+  m_UpdateCellData(false),
+  m_OutputBuffer(0),
+  m_OutputStream(0),
+  m_OutputToSink(false),
+  m_WriteBufferSize(1024 * 1024),
+  m_UseTemporaryFile(true),
+  m_SyncOutputFile(false),
+  m_OutputFileAppended(false),
+  m_OriginalFileLength(0),
+  m_UseCompression(false),
+  m_NumberOfCompressionThreads(1),
+  m_AsciiPrecision(0),
+  m_AppendData(false),
+  m_SelectedPointDataArray(0),
+  m_SelectedCellDataArray(0)
+{
+  this->ClearCellTypeStatistics();
+  this->ResetSectionLayouts();
+}
+
+void MeshIOBase::SetCellTypeStatistics(const SizeValueType *numberOfCells, const SizeValueType *numberOfCellPoints)
+{
+  for ( unsigned int ii = 0; ii < LAST_ITK_CELL; ii++ )
+    {
+    m_NumberOfCellsOfType[ii] = numberOfCells[ii];
+    m_NumberOfCellPointsOfType[ii] = numberOfCellPoints[ii];
+    }
+
+  m_CellTypeStatisticsAvailable = true;
+}
+
+void MeshIOBase::ClearCellTypeStatistics()
+{
+  for ( unsigned int ii = 0; ii < LAST_ITK_CELL; ii++ )
+    {
+    m_NumberOfCellsOfType[ii] = itk::NumericTraits< SizeValueType >::Zero;
+    m_NumberOfCellPointsOfType[ii] = itk::NumericTraits< SizeValueType >::Zero;
+    }
+
+  m_CellTypeStatisticsAvailable = false;
+}
+
+MeshIOBase::SizeValueType MeshIOBase::GetNumberOfCellsOfType(CellGeometryType cellType) const
+{
+  if ( cellType < VERTEX_CELL || cellType >= LAST_ITK_CELL )
+    {
+    itkExceptionMacro ("Unknown cell type: " << cellType);
+    }
+
+  return m_NumberOfCellsOfType[cellType];
+}
+
+MeshIOBase::SizeValueType MeshIOBase::GetNumberOfCellPointsOfType(CellGeometryType cellType) const
+{
+  if ( cellType < VERTEX_CELL || cellType >= LAST_ITK_CELL )
+    {
+    itkExceptionMacro ("Unknown cell type: " << cellType);
+    }
+
+  return m_NumberOfCellPointsOfType[cellType];
+}
+
+void MeshIOBase::BeginWriteSection(SectionType itkNotUsed(section), unsigned int itkNotUsed(pass))
+{
+  // Check file name
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
+    {
+    itkExceptionMacro("No Input FileName");
+    }
+
+  if ( !this->CanStreamWrite() )
+    {
+    itkExceptionMacro(<< this->GetNameOfClass() << " does not support streamed writing");
+    }
+
+  // The output file normally stays open from WriteMeshInformation(), a
+  // MeshIO driven directly may still write its sections one by one
+  if ( !m_OutputFile.is_open() )
+    {
+    this->OpenOutputFile(true);
+    }
+}
+
+void MeshIOBase::EndWriteSection(SectionType itkNotUsed(section), unsigned int itkNotUsed(pass))
 {}
 
+namespace
+{
+// Flush the data of a closed file to the storage device
+bool SyncFile(const std::string & fileName)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  int fd = _open(fileName.c_str(), _O_RDWR | _O_BINARY);
+  if ( fd < 0 )
+    {
+    return false;
+    }
+  bool synced = ( _commit(fd) == 0 );
+  _close(fd);
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if ( fd < 0 )
+    {
+    return false;
+    }
+  bool synced = ( fsync(fd) == 0 );
+  close(fd);
+#endif
+  return synced;
+}
+
+// Flush the directory entry of a renamed file to the storage device, so
+// that the rename outlives a crash
+bool SyncDirectory(const std::string & fileName)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  // MOVEFILE_WRITE_THROUGH already flushes the rename
+  (void)fileName;
+  return true;
+#else
+  std::string directory = itksys::SystemTools::GetFilenamePath(fileName);
+  if ( directory.empty() )
+    {
+    directory = ".";
+    }
+  int fd = open(directory.c_str(), O_RDONLY);
+  if ( fd < 0 )
+    {
+    return false;
+    }
+  // Some file systems do not sync directories
+  bool synced = ( fsync(fd) == 0 || errno == EINVAL );
+  close(fd);
+  return synced;
+#endif
+}
+
+// Number of the temporary files named by this process, so that writers of
+// the same file on several threads never share a temporary file
+SimpleFastMutexLock TemporaryFileCountLock;
+unsigned long       TemporaryFileCount = 0;
+
+unsigned long NextTemporaryFileNumber()
+{
+  TemporaryFileCountLock.Lock();
+  const unsigned long number = ++TemporaryFileCount;
+  TemporaryFileCountLock.Unlock();
+  return number;
+}
+
+// Give fileName the permissions of an existing targetFileName, which the
+// rename would otherwise replace by the default permissions of new files
+bool CopyFileMode(const std::string & targetFileName, const std::string & fileName)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  // The files take the permissions of their directory
+  (void)targetFileName;
+  (void)fileName;
+  return true;
+#else
+  struct stat targetStatus;
+  if ( stat(targetFileName.c_str(), &targetStatus) != 0 )
+    {
+    return true;
+    }
+  return chmod(fileName.c_str(), targetStatus.st_mode & 07777) == 0;
+#endif
+}
+
+// Replace newFileName by oldFileName
+bool ReplaceFile(const std::string & oldFileName, const std::string & newFileName)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  return MoveFileExA(oldFileName.c_str(), newFileName.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  return std::rename( oldFileName.c_str(), newFileName.c_str() ) == 0;
+#endif
+}
+
+// Length of a file, beyond the 4 GB which itksys reports on Windows
+MeshIOBase::StreamOffsetType GetFileLength(const std::string & fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  file.seekg(0, std::ios::end);
+  const MeshIOBase::StreamOffsetType length = file.tellg();
+  return length > 0 ? length : 0;
+}
+
+// Cut a file back to the given length
+bool TruncateFile(const std::string & fileName, MeshIOBase::StreamOffsetType length)
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  int fd = _open(fileName.c_str(), _O_RDWR | _O_BINARY);
+  if ( fd < 0 )
+    {
+    return false;
+    }
+  bool truncated = ( _chsize_s( fd, static_cast< __int64 >( length ) ) == 0 );
+  _close(fd);
+  return truncated;
+#else
+  return truncate( fileName.c_str(), static_cast< off_t >( length ) ) == 0;
+#endif
+}
+}
+
+void MeshIOBase::SetOutputBuffer(std::string *buffer)
+{
+  if ( buffer == m_OutputBuffer && m_OutputStream == 0 )
+    {
+    return;
+    }
+
+  m_OutputBuffer = buffer;
+  m_OutputStream = 0;
+  this->Modified();
+}
+
+void MeshIOBase::SetOutputStream(std::ostream *stream)
+{
+  if ( stream == m_OutputStream && m_OutputBuffer == 0 )
+    {
+    return;
+    }
+
+  m_OutputBuffer = 0;
+  m_OutputStream = stream;
+  this->Modified();
+}
+
+void MeshIOBase::OpenOutputFile(bool append)
+{
+  // A file left open by an exception is abandoned
+  this->AbortOutputFile();
+
+  const bool compress = m_UseCompression
+                        || itksys::SystemTools::GetFilenameLastExtension(this->m_FileName) == ".gz";
+
+  // The output buffer or stream is written in place, without a temporary
+  // file; the buffer grows by itself
+  if ( this->HasOutputSink() )
+    {
+    std::streambuf *sink = m_OutputStream ? m_OutputStream->rdbuf() : &m_OutputBufferSink;
+    if ( m_OutputBuffer )
+      {
+      if ( !append )
+        {
+        m_OutputBuffer->clear();
+        }
+      m_OriginalFileLength = static_cast< StreamOffsetType >( m_OutputBuffer->size() );
+      m_OutputBufferSink.SetOutput(m_OutputBuffer);
+      }
+
+    m_OutputFile.SetNumberOfCompressionThreads(m_NumberOfCompressionThreads);
+    m_OutputFile.open(sink, compress);
+    if ( !m_OutputFile.is_open() )
+      {
+      m_OutputBufferSink.SetOutput(0);
+      itkExceptionMacro("Unable to write to the output " << ( m_OutputStream ? "stream" : "buffer" ) );
+      }
+    m_OutputToSink = true;
+    return;
+    }
+
+  // The buffer has to be set before the file is opened to be honoured
+  if ( m_WriteBufferSize > 0 )
+    {
+    m_WriteBuffer.resize(m_WriteBufferSize);
+    m_OutputFile.SetBuffer( &m_WriteBuffer[0], static_cast< std::streamsize >( m_WriteBufferSize ) );
+    }
+  else
+    {
+    m_OutputFile.SetBuffer(0, 0);
+    }
+
+  std::ios::openmode mode = append ? std::ios::app : std::ios::out;
+  if ( this->m_FileType == BINARY )
+    {
+    mode |= std::ios::binary;
+    }
+
+  // The temporary file sits in the directory of the output file, so that
+  // renaming it is atomic, and is unique to this write
+  m_OutputFileName = this->m_FileName;
+  if ( m_UseTemporaryFile && !append )
+    {
+    std::ostringstream name;
+    name << this->m_FileName << "." << getpid() << "." << NextTemporaryFileNumber() << ".tmp";
+    m_OutputFileName = name.str();
+    }
+
+  m_OutputFileAppended = append && itksys::SystemTools::FileExists( m_OutputFileName.c_str() );
+  m_OriginalFileLength = m_OutputFileAppended ? GetFileLength(m_OutputFileName) : 0;
+  m_OutputFile.SetNumberOfCompressionThreads(m_NumberOfCompressionThreads);
+  m_OutputFile.open(m_OutputFileName.c_str(), mode, compress);
+  if ( !m_OutputFile.is_open() )
+    {
+    itkExceptionMacro("Unable to open file\n"
+                      "outputFilename= " << m_OutputFileName);
+    }
+}
+
+void MeshIOBase::CloseOutputFile()
+{
+  if ( !m_OutputFile.is_open() )
+    {
+    return;
+    }
+
+  m_OutputFile.close();
+  if ( m_OutputToSink )
+    {
+    if ( m_OutputFile.fail() )
+      {
+      this->AbortOutputFile();
+      itkExceptionMacro("Error writing the output " << ( m_OutputStream ? "stream" : "buffer" ) );
+      }
+    m_OutputBufferSink.SetOutput(0);
+    m_OutputToSink = false;
+    return;
+    }
+
+  if ( m_OutputFile.fail() )
+    {
+    this->AbortOutputFile();
+    itkExceptionMacro("Error writing file\n"
+                      "outputFilename= " << m_OutputFileName);
+    }
+
+  if ( m_SyncOutputFile && !SyncFile(m_OutputFileName) )
+    {
+    this->AbortOutputFile();
+    itkExceptionMacro("Unable to sync file\n"
+                      "outputFilename= " << m_OutputFileName);
+    }
+
+  if ( m_OutputFileName != this->m_FileName )
+    {
+    if ( !CopyFileMode(this->m_FileName, m_OutputFileName) )
+      {
+      this->AbortOutputFile();
+      itkExceptionMacro("Unable to set the permissions of " << this->m_FileName << " on " << m_OutputFileName);
+      }
+    if ( !ReplaceFile(m_OutputFileName, this->m_FileName) )
+      {
+      this->AbortOutputFile();
+      itkExceptionMacro("Unable to rename " << m_OutputFileName << " to " << this->m_FileName);
+      }
+    if ( m_SyncOutputFile && !SyncDirectory(this->m_FileName) )
+      {
+      m_OutputFileName = "";
+      itkExceptionMacro("Unable to sync the directory of file\n"
+                        "outputFilename= " << this->m_FileName);
+      }
+    }
+  m_OutputFileName = "";
+  m_OutputFileAppended = false;
+}
+
+void MeshIOBase::AbortOutputFile()
+{
+  if ( m_OutputFile.is_open() )
+    {
+    m_OutputFile.close();
+    }
+  m_OutputFile.clear();
+
+  // The data written to the output buffer are cut off
+  if ( m_OutputToSink )
+    {
+    std::string *output = m_OutputBufferSink.GetOutput();
+    m_OutputBufferSink.SetOutput(0);
+    if ( output )
+      {
+      output->resize( static_cast< std::size_t >( m_OriginalFileLength ) );
+      }
+    m_OutputToSink = false;
+    return;
+    }
+
+  // Only the temporary file is removed, never the output file itself, and
+  // the data appended to the output file are cut off
+  if ( m_OutputFileAppended )
+    {
+    TruncateFile(m_OutputFileName, m_OriginalFileLength);
+    }
+  else if ( !m_OutputFileName.empty() && m_OutputFileName != this->m_FileName )
+    {
+    std::remove( m_OutputFileName.c_str() );
+    }
+  m_OutputFileName = "";
+  m_OutputFileAppended = false;
+}
+
+void MeshIOBase::ReadPointsRange(void *itkNotUsed(buffer), SizeValueType itkNotUsed(firstPoint),
+                                 SizeValueType itkNotUsed(numberOfPoints))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support ranged reading of the points");
+}
+
+void MeshIOBase::ReadCellsRange(void *itkNotUsed(buffer), SizeValueType itkNotUsed(firstCell),
+                                SizeValueType itkNotUsed(numberOfCells))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support ranged reading of the cells");
+}
+
+void MeshIOBase::ReadPointDataRange(void *itkNotUsed(buffer), SizeValueType itkNotUsed(firstPoint),
+                                    SizeValueType itkNotUsed(numberOfPoints))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support ranged reading of the point data");
+}
+
+void MeshIOBase::ReadCellDataRange(void *itkNotUsed(buffer), SizeValueType itkNotUsed(firstCell),
+                                   SizeValueType itkNotUsed(numberOfCells))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support ranged reading of the cell data");
+}
+
+void MeshIOBase::ReadPointDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers)
+{
+  if ( names.size() != buffers.size() )
+    {
+    itkExceptionMacro(<< names.size() << " point data arrays to read into " << buffers.size() << " buffers");
+    }
+
+  const unsigned int selected = m_SelectedPointDataArray;
+  for ( std::size_t ii = 0; ii < names.size(); ii++ )
+    {
+    this->UsePointDataArray( this->FindDataArray(m_PointDataArrays, names[ii]) );
+    this->ReadPointData(buffers[ii]);
+    }
+  this->UsePointDataArray(selected);
+}
+
+void MeshIOBase::ReadCellDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers)
+{
+  if ( names.size() != buffers.size() )
+    {
+    itkExceptionMacro(<< names.size() << " cell data arrays to read into " << buffers.size() << " buffers");
+    }
+
+  const unsigned int selected = m_SelectedCellDataArray;
+  for ( std::size_t ii = 0; ii < names.size(); ii++ )
+    {
+    this->UseCellDataArray( this->FindDataArray(m_CellDataArrays, names[ii]) );
+    this->ReadCellData(buffers[ii]);
+    }
+  this->UseCellDataArray(selected);
+}
+
+void MeshIOBase::SelectDataArrays()
+{
+  if ( !m_PointDataArrays.empty() )
+    {
+    this->UsePointDataArray( m_PointDataArrayName.empty() ? 0 : this->FindDataArray(m_PointDataArrays, m_PointDataArrayName) );
+    }
+
+  if ( !m_CellDataArrays.empty() )
+    {
+    this->UseCellDataArray( m_CellDataArrayName.empty() ? 0 : this->FindDataArray(m_CellDataArrays, m_CellDataArrayName) );
+    }
+}
+
+void MeshIOBase::UsePointDataArray(unsigned int index)
+{
+  if ( index < m_PointDataArrays.size() )
+    {
+    const DataArrayInformation & array = m_PointDataArrays[index];
+    m_SelectedPointDataArray = index;
+    m_PointPixelType = array.PixelType;
+    m_PointPixelComponentType = array.ComponentType;
+    m_NumberOfPointPixelComponents = array.NumberOfComponents;
+    m_UpdatePointData = true;
+    }
+}
+
+void MeshIOBase::UseCellDataArray(unsigned int index)
+{
+  if ( index < m_CellDataArrays.size() )
+    {
+    const DataArrayInformation & array = m_CellDataArrays[index];
+    m_SelectedCellDataArray = index;
+    m_CellPixelType = array.PixelType;
+    m_CellPixelComponentType = array.ComponentType;
+    m_NumberOfCellPixelComponents = array.NumberOfComponents;
+    m_UpdateCellData = true;
+    }
+}
+
+unsigned int MeshIOBase::FindDataArray(const DataArrayInformationContainer & arrays, const std::string & name) const
+{
+  for ( unsigned int ii = 0; ii < arrays.size(); ii++ )
+    {
+    if ( arrays[ii].Name == name )
+      {
+      return ii;
+      }
+    }
+
+  itkExceptionMacro(<< this->m_FileName << " has no data array named " << name);
+  return 0;
+}
+
+const MeshIOBase::SectionLayout & MeshIOBase::GetSectionLayout(SectionType section) const
+{
+  return m_SectionLayouts[section];
+}
+
+MeshIOBase::ReadPathType MeshIOBase::GetReadPath(SectionType section, const std::type_info & componentType,
+                                                 unsigned int numberOfComponents) const
+{
+  IOComponentType fileComponentType = m_PointComponentType;
+  unsigned int    fileNumberOfComponents = m_PointDimension;
+
+  switch ( section )
+    {
+    case CELLS_SECTION:
+      fileComponentType = m_CellComponentType;
+      fileNumberOfComponents = numberOfComponents;
+      break;
+    case POINTDATA_SECTION:
+      fileComponentType = m_PointPixelComponentType;
+      fileNumberOfComponents = m_NumberOfPointPixelComponents;
+      break;
+    case CELLDATA_SECTION:
+      fileComponentType = m_CellPixelComponentType;
+      fileNumberOfComponents = m_NumberOfCellPixelComponents;
+      break;
+    default:
+      break;
+    }
+
+  if ( this->GetComponentTypeInfo(fileComponentType) != componentType || fileNumberOfComponents != numberOfComponents )
+    {
+    return CONVERT_READ;
+    }
+
+  const SectionLayout & layout = m_SectionLayouts[section];
+  if ( !layout.Contiguous )
+    {
+    return DECODE_READ;
+    }
+
+  return layout.NativeByteOrder ? DIRECT_READ : SWAP_READ;
+}
+
+void MeshIOBase::ResetSectionLayouts()
+{
+  for ( unsigned int ii = 0; ii < 4; ii++ )
+    {
+    m_SectionLayouts[ii].Stride = 0;
+    m_SectionLayouts[ii].Contiguous = false;
+    m_SectionLayouts[ii].NativeByteOrder = false;
+    m_SectionLayouts[ii].UniformCellArity = 0;
+    }
+}
+
+void MeshIOBase::SetBinarySectionLayout(SectionType section, IOComponentType componentType,
+                                        unsigned int numberOfComponents, bool contiguous)
+{
+  const unsigned int componentSize = this->GetComponentSize(componentType);
+  SectionLayout &    layout = m_SectionLayouts[section];
+
+  layout.Stride = static_cast< SizeValueType >( componentSize ) * numberOfComponents;
+  layout.Contiguous = contiguous;
+  layout.NativeByteOrder = componentSize <= 1 || !this->IsFileByteOrderSwapped();
+}
+
+void MeshIOBase::ReadBufferRangeAsBinary(const MeshInputFileStream & inputFile, void *buffer,
+                                         StreamOffsetType dataPosition, IOComponentType componentType,
+                                         SizeValueType firstComponent, SizeValueType numberOfComponents) const
+{
+  const unsigned int componentSize = this->GetComponentSize(componentType);
+  const char *       data = inputFile.GetData(dataPosition + static_cast< StreamOffsetType >( firstComponent * componentSize ),
+                                              static_cast< std::size_t >( numberOfComponents * componentSize ) );
+
+  if ( data == 0 )
+    {
+    itkExceptionMacro(<< "Unable to read components " << firstComponent << " to "
+                      << firstComponent + numberOfComponents << " of " << this->m_FileName);
+    }
+
+  if ( componentSize > 1 && this->IsFileByteOrderSwapped() )
+    {
+    MeshByteSwapper::SwapCopy(buffer, data, componentSize, numberOfComponents);
+    }
+  else
+    {
+    std::memcpy(buffer, data, static_cast< std::size_t >( numberOfComponents * componentSize ) );
+    }
+}
+
+void MeshIOBase::SetInputBuffer(const void *buffer, SizeValueType size)
+{
+  if ( buffer == m_InputBuffer && size == m_InputBufferSize && m_InputStream == 0 )
+    {
+    return;
+    }
+
+  m_InputBuffer = buffer;
+  m_InputBufferSize = buffer ? size : 0;
+  m_InputStream = 0;
+  std::string().swap(m_InputStreamContent);
+  this->Modified();
+}
+
+void MeshIOBase::SetInputStream(std::istream *stream)
+{
+  if ( stream == m_InputStream )
+    {
+    return;
+    }
+
+  m_InputBuffer = 0;
+  m_InputBufferSize = 0;
+  m_InputStream = stream;
+  std::string().swap(m_InputStreamContent);
+  this->Modified();
+}
+
+void MeshIOBase::OpenInputFile(MeshInputFileStream & inputFile)
+{
+  // A stream is read once, later reads view its content
+  if ( m_InputStream )
+    {
+    m_InputStreamContent.assign( ( std::istreambuf_iterator< char >(*m_InputStream) ),
+                                 std::istreambuf_iterator< char >() );
+    if ( m_InputStream->bad() )
+      {
+      itkExceptionMacro("Unable to read the input stream");
+      }
+    m_InputStream = 0;
+    m_InputBuffer = m_InputStreamContent.data();
+    m_InputBufferSize = m_InputStreamContent.size();
+    }
+
+  if ( m_InputBuffer )
+    {
+    if ( m_InputBufferSize > static_cast< std::size_t >( -1 ) )
+      {
+      itkExceptionMacro("The input buffer of " << m_InputBufferSize << " bytes exceeds the address space");
+      }
+    inputFile.OpenBuffer( static_cast< const char * >( m_InputBuffer ), static_cast< std::size_t >( m_InputBufferSize ) );
+    if ( !inputFile.is_open() )
+      {
+      itkExceptionMacro("Unable to read the input buffer of " << m_InputBufferSize << " bytes");
+      }
+    return;
+    }
+
+  if ( this->m_FileName.empty() )
+    {
+    itkExceptionMacro("No input FileName");
+    }
+
+  if ( !itksys::SystemTools::FileExists( m_FileName.c_str() ) )
+    {
+    itkExceptionMacro("File " << this->m_FileName << " does not exist");
+    }
+
+  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
+  if ( !inputFile.is_open() )
+    {
+    itkExceptionMacro("Unable to open file " << this->m_FileName);
+    }
+}
+
+void MeshIOBase::OpenReadContext(MeshInputFileStream & inputFile, const MeshInputFileStream & file) const
+{
+  inputFile.open(file);
+  if ( !inputFile.is_open() )
+    {
+    itkExceptionMacro(<< "The file " << this->m_FileName << " is not open, ReadMeshInformation() must read it first");
+    }
+}
+
+void MeshIOBase::VerifyRange(SizeValueType first, SizeValueType count, SizeValueType size) const
+{
+  if ( first > size || count > size - first )
+    {
+    itkExceptionMacro(<< "Range [" << first << ", " << first + count << ") exceeds the " << size << " elements");
+    }
+}
+
+void MeshIOBase::WritePointsChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfPoints))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support streamed writing");
+}
+
+void MeshIOBase::WriteCellsChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support streamed writing");
+}
+
+void MeshIOBase::WritePointDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfPoints))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support streamed writing");
+}
+
+void MeshIOBase::WriteCellDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
+{
+  itkExceptionMacro(<< this->GetNameOfClass() << " does not support streamed writing");
+}
+
+std::string MeshIOBase::GetFileNameExtension(const std::string & fileName)
+{
+  std::string extension = itksys::SystemTools::GetFilenameLastExtension(fileName);
+
+  if ( extension == ".gz" )
+    {
+    extension = itksys::SystemTools::GetFilenameLastExtension(
+      itksys::SystemTools::GetFilenameWithoutLastExtension(fileName) );
+    }
+  return extension;
+}
+
+bool MeshIOBase::CanReadFile(const char *fileName)
+{
+  std::string header;
+
+  if ( !ReadFileHeader(fileName, header) )
+    {
+    return false;
+    }
+
+  return this->ScoreFile(fileName, header) > 0;
+}
+
+bool MeshIOBase::ReadFileHeader(const char *fileName, std::string & header)
+{
+  return MeshInputFileStream::ReadFileHeader(fileName, FileHeaderLength, header);
+}
+
+bool MeshIOBase::ReadBufferHeader(const void *buffer, std::size_t size, std::string & header)
+{
+  return MeshInputFileStream::ReadBufferHeader(static_cast< const char * >( buffer ), size, FileHeaderLength, header);
+}
+
+unsigned int MeshIOBase::ScoreFileHeader(const std::string & itkNotUsed(header)) const
+{
+  return 0;
+}
+
+unsigned int MeshIOBase::ScoreFile(const char *fileName, const std::string & header) const
+{
+  unsigned int      score = this->ScoreFileHeader(header);
+  const std::string extension = GetFileNameExtension(fileName);
+
+  for ( std::size_t ii = 0; ii < m_SupportedReadExtensions.size(); ii++ )
+    {
+    if ( m_SupportedReadExtensions[ii] == extension )
+      {
+      score += 50;
+      break;
+      }
+    }
+
+  return score;
+}
+
 const MeshIOBase::ArrayOfExtensionsType & MeshIOBase::GetSupportedReadExtensions() const
 {
   return this->m_SupportedReadExtensions;
@@ -254,6 +1036,8 @@ void MeshIOBase::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
 
   os << indent << "FileName: " << this->m_FileName << std::endl;
+  os << indent << "Input buffer: " << m_InputBuffer << " (" << m_InputBufferSize << " bytes)" << std::endl;
+  os << indent << "Input stream: " << m_InputStream << std::endl;
   os << indent << "FileType: " << GetFileTypeAsString(m_FileType) << std::endl;
   os << indent << "ByteOrder: " << GetByteOrderAsString(m_ByteOrder) << std::endl;
   os << indent << "Point dimension: " << m_PointDimension << std::endl;
@@ -263,9 +1047,39 @@ void MeshIOBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Number of cell  pixel components: " << m_NumberOfCellPixelComponents << std::endl;
   os << indent << "Number of points: " << m_NumberOfPoints << std::endl;
   os << indent << "Number of cells: " << m_NumberOfCells << std::endl;
+  os << indent << "Cell buffer size: " << m_CellBufferSize << std::endl;
+  os << indent << "Cell type statistics available: " << m_CellTypeStatisticsAvailable << std::endl;
   os << indent << "Point pixel type: " << GetPixelTypeAsString(m_PointPixelType) << std::endl;
   os << indent << "Cell  pixel type: " << GetPixelTypeAsString(m_CellPixelType) << std::endl;
   os << indent << "Point pixel component type: " << GetComponentTypeAsString(m_PointPixelComponentType) << std::endl;
   os << indent << "Cell  pixel component type: " << GetComponentTypeAsString(m_CellPixelComponentType) << std::endl;
+  os << indent << "Write buffer size: " << m_WriteBufferSize << std::endl;
+  os << indent << "Output buffer: " << m_OutputBuffer << std::endl;
+  os << indent << "Output stream: " << m_OutputStream << std::endl;
+  os << indent << "Use temporary file: " << m_UseTemporaryFile << std::endl;
+  os << indent << "Sync output file: " << m_SyncOutputFile << std::endl;
+  os << indent << "Use compression: " << m_UseCompression << std::endl;
+  os << indent << "Number of compression threads: " << m_NumberOfCompressionThreads << std::endl;
+  os << indent << "Ascii precision: " << m_AsciiPrecision << std::endl;
+  os << indent << "Append data: " << m_AppendData << std::endl;
+  os << indent << "Point data array name: " << m_PointDataArrayName << std::endl;
+  os << indent << "Cell data array name: " << m_CellDataArrayName << std::endl;
+  for ( unsigned int ii = 0; ii < m_PointDataArrays.size(); ii++ )
+    {
+    os << indent << "Point data array: " << m_PointDataArrays[ii].Name << std::endl;
+    }
+  for ( unsigned int ii = 0; ii < m_CellDataArrays.size(); ii++ )
+    {
+    os << indent << "Cell data array: " << m_CellDataArrays[ii].Name << std::endl;
+    }
+
+  const char *sectionNames[4] = { "Points", "Cells", "Point data", "Cell data" };
+  for ( unsigned int ii = 0; ii < 4; ii++ )
+    {
+    os << indent << sectionNames[ii] << " layout: stride " << m_SectionLayouts[ii].Stride
+       << ", contiguous " << m_SectionLayouts[ii].Contiguous
+       << ", native byte order " << m_SectionLayouts[ii].NativeByteOrder << std::endl;
+    }
+  os << indent << "Uniform cell arity: " << m_SectionLayouts[CELLS_SECTION].UniformCellArity << std::endl;
 }
 } // namespace itk end
@@ -24,6 +24,10 @@
 #include "itkIntTypes.h"
 #include "itkLightProcessObject.h"
 #include "itkMatrix.h"
+#include "itkMeshByteSwapper.h"
+#include "itkMeshFileStreams.h"
+#include "itkMeshNumberFormatter.h"
+#include "itkMeshNumberParser.h"
 #include "itkRGBPixel.h"
 #include "itkRGBAPixel.h"
 #include "itkSymmetricSecondRankTensor.h"
@@ -33,7 +37,9 @@
 
 #include <string>
 #include <complex>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 namespace itk
 {
@@ -76,7 +82,10 @@ public:
   /** Type for representing size of bytes, and or positions along a file */
   typedef std::streamoff StreamOffsetType;
 
-  typedef unsigned long SizeValueType;
+  /** Type for the numbers of points, cells and components, and the offsets
+   * in the buffers. It has 64 bits on every platform, so that meshes with
+   * more than 2^32 connectivity entries can be read and written. */
+  typedef unsigned long long SizeValueType;
 
   /**
     * \class UnknownType
@@ -91,6 +100,23 @@ public:
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
 
+  /** Set/Get a memory buffer of size bytes to read the mesh from, rather
+   * than FileName, which then only hints the format by its extension. The
+   * buffer stays owned by the caller and must outlive the reads: the
+   * sections are parsed in place, unless the buffer is gzip compressed and
+   * inflated. A null buffer reads FileName again. */
+  void SetInputBuffer(const void *buffer, SizeValueType size);
+
+  const void * GetInputBuffer() const { return m_InputBuffer; }
+  SizeValueType GetInputBufferSize() const { return m_InputBufferSize; }
+
+  /** Set a stream to read the mesh from, rather than FileName. The next
+   * ReadMeshInformation() reads the stream to its end, into memory kept as
+   * the input buffer. */
+  void SetInputStream(std::istream *stream);
+
+  std::istream * GetInputStream() const { return m_InputStream; }
+
   /** Enums used to manipulate the point/cell pixel type. The pixel type provides
      * context for automatic data conversions (for instance, RGB to
      * SCALAR, VECTOR to SCALAR). */
@@ -119,6 +145,43 @@ public:
                  QUADRATIC_EDGE_CELL, QUADRATIC_TRIANGLE_CELL, POLYLINE_CELL,
                  LAST_ITK_CELL, MAX_ITK_CELLS = 255}  CellGeometryType;
 
+  /** Enums used to specify the section of a mesh file being written */
+  typedef  enum {POINTS_SECTION, CELLS_SECTION, POINTDATA_SECTION,
+                 CELLDATA_SECTION}  SectionType;
+
+  /** \brief Description of one of the named point data or cell data arrays
+   * of a file. Offset is the position of its data in the file, -1 when the
+   * format does not locate it. */
+  struct DataArrayInformation
+    {
+    std::string      Name;
+    IOPixelType      PixelType;
+    IOComponentType  ComponentType;
+    unsigned int     NumberOfComponents;
+    StreamOffsetType Offset;
+    };
+  typedef std::vector< DataArrayInformation > DataArrayInformationContainer;
+
+  /** \brief Layout of the data of a section in the file. Stride is the
+   * number of bytes of each element of a binary section, 0 when they vary
+   * or the section is text. Contiguous tells whether the section is a
+   * single block of the components of its buffer, NativeByteOrder whether
+   * they are in the byte order of the system. UniformCellArity is the
+   * number of points of every cell, 0 when it varies or is not known. */
+  struct SectionLayout
+    {
+    SizeValueType Stride;
+    bool          Contiguous;
+    bool          NativeByteOrder;
+    unsigned int  UniformCellArity;
+    };
+
+  /** Enums used to specify how the buffer of a section is filled: copied
+   * from the file, copied reversing the bytes of the components, decoded
+   * from text or records by the MeshIO, or read as other components which
+   * the caller converts */
+  typedef  enum {DIRECT_READ, SWAP_READ, DECODE_READ, CONVERT_READ} ReadPathType;
+
   /** Set/Get the type of the point/cell pixel. The PixelTypes provides context
     * to the IO mechanisms for data conversions.  PixelTypes can be
     * SCALAR, RGB, RGBA, VECTOR, COVARIANTVECTOR, POINT, INDEX. If
@@ -378,12 +441,12 @@ public:
   itkGetConstMacro(NumberOfCellPixelComponents, unsigned int);
   itkSetMacro(PointDimension, unsigned int);
   itkGetConstMacro(PointDimension, unsigned int);
-  itkSetMacro(NumberOfPoints, unsigned int);
-  itkGetConstMacro(NumberOfPoints, unsigned int);
-  itkSetMacro(NumberOfCells, unsigned int);
-  itkGetConstMacro(NumberOfCells, unsigned int);
-  itkSetMacro(CellBufferSize, unsigned int);
-  itkGetConstMacro(CellBufferSize, unsigned int);
+  itkSetMacro(NumberOfPoints, SizeValueType);
+  itkGetConstMacro(NumberOfPoints, SizeValueType);
+  itkSetMacro(NumberOfCells, SizeValueType);
+  itkGetConstMacro(NumberOfCells, SizeValueType);
+  itkSetMacro(CellBufferSize, SizeValueType);
+  itkGetConstMacro(CellBufferSize, SizeValueType);
   itkSetMacro(UpdatePoints, bool);
   itkGetConstMacro(UpdatePoints, bool);
   itkSetMacro(UpdateCells, bool);
@@ -393,6 +456,21 @@ public:
   itkSetMacro(UpdateCellData, bool);
   itkGetConstMacro(UpdateCellData, bool);
 
+  /** Set/Get the number of cells and the number of point identifiers of each
+   * cell geometry type in the cell buffer. These are filled by
+   * MeshFileWriter while it copies the cells, so that MeshIOs which group
+   * cells by type do not need to scan the cell buffer again. Both arrays must
+   * have LAST_ITK_CELL entries. */
+  void SetCellTypeStatistics(const SizeValueType *numberOfCells, const SizeValueType *numberOfCellPoints);
+
+  void ClearCellTypeStatistics();
+
+  itkGetConstMacro(CellTypeStatisticsAvailable, bool);
+
+  SizeValueType GetNumberOfCellsOfType(CellGeometryType cellType) const;
+
+  SizeValueType GetNumberOfCellPointsOfType(CellGeometryType cellType) const;
+
   unsigned int GetComponentSize(IOComponentType componentType) const;
 
   /** Convenience method returns the IOComponentType as a string. This can be
@@ -452,14 +530,43 @@ public:
 
   /*-------- This part of the interfaces deals with reading data ----- */
   /** Determine the file type. Returns true if this MeshIO can read the
-     * file specified. */
-  virtual bool CanReadFile(const char *) = 0;
+     * file specified. The default scores the header of the file and its
+     * extension with ScoreFile(). */
+  virtual bool CanReadFile(const char *fileName);
+
+  /** Number of bytes at the start of a file read to identify its format */
+  itkStaticConstMacro(FileHeaderLength, unsigned int, 512);
+
+  /** Read the first FileHeaderLength bytes of a file, inflated when it is
+   * gzip compressed. Returns false when the file cannot be read. */
+  static bool ReadFileHeader(const char *fileName, std::string & header);
+
+  /** Same as ReadFileHeader(), for a file held in the size bytes at buffer */
+  static bool ReadBufferHeader(const void *buffer, std::size_t size, std::string & header);
+
+  /** Score how well the header of a file, read by ReadFileHeader(), fits
+   * the format of this MeshIO: 100 for its magic number, less for a
+   * guess, 0 when the header tells nothing. The default tells nothing. */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
+
+  /** Score of a file with the given header: the score of the header, plus
+   * 50 when the file has one of the supported read extensions. The factory
+   * creates the MeshIO scoring a file highest, and no MeshIO for files
+   * scoring 0. */
+  unsigned int ScoreFile(const char *fileName, const std::string & header) const;
+
+  /** Return the last extension of a file name, skipping a ".gz" suffix, so
+   * that "mesh.vtk.gz" gives ".vtk" */
+  static std::string GetFileNameExtension(const std::string & fileName);
 
   /** Determin the required information and whether need to ReadPoints,
     ReadCells, ReadPointData and ReadCellData */
   virtual void ReadMeshInformation() = 0;
 
-  /** Reads the data from disk into the memory buffer provided. */
+  /** Reads the data from disk into the memory buffer provided. Once
+   * ReadMeshInformation() returned, the reads of the sections, whole or by
+   * range, leave the MeshIO unchanged and may be called concurrently, for
+   * instance to read the points and the cells on two threads. */
   virtual void ReadPoints(void *buffer) = 0;
 
   virtual void ReadCells(void *buffer) = 0;
@@ -468,6 +575,77 @@ public:
 
   virtual void ReadCellData(void *buffer) = 0;
 
+  /** Determine whether the reads of the sections may run concurrently on
+   * this MeshIO, as MeshFileReader does on a thread per section. */
+  virtual bool SupportsConcurrentReads() const { return false; }
+
+  /** Close the file opened by ReadMeshInformation(), releasing its mapping
+   * or its inflated content. The sections are not read afterwards, until
+   * ReadMeshInformation() opens the file again. */
+  virtual void CloseInputFile() {}
+
+  /*-------- This part of the interfaces deals with ranged reading ----- */
+
+  /** Determine whether a range of the points, cells, point data or cell
+   * data of the file read by ReadMeshInformation() can be read on its own,
+   * with a single seek and read, without the records before it. */
+  virtual bool SupportsRandomAccess(SectionType) const { return false; }
+
+  /** Read the given number of points or cells, starting at the first one,
+   * into the buffer provided. The buffers are laid out as the buffers of
+   * ReadPoints(), ReadCells(), ReadPointData() and ReadCellData(), but only
+   * hold the range. */
+  virtual void ReadPointsRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
+  virtual void ReadCellsRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells);
+
+  virtual void ReadPointDataRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
+  virtual void ReadCellDataRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells);
+
+  /*-------- This part of the interfaces deals with section layouts ----- */
+
+  /** Layout of a section of the file read by ReadMeshInformation(). The
+   * layouts not described by a MeshIO are not contiguous. */
+  const SectionLayout & GetSectionLayout(SectionType section) const;
+
+  /** How a buffer of numberOfComponents components of componentType per
+   * element is filled for a section of the file read by
+   * ReadMeshInformation(): CONVERT_READ when the section holds other
+   * components, which are read into a buffer of their own and converted,
+   * the path of the MeshIO filling the buffer directly otherwise */
+  ReadPathType GetReadPath(SectionType section, const std::type_info & componentType,
+                           unsigned int numberOfComponents) const;
+
+  /*-------- This part of the interfaces deals with named data arrays ----- */
+
+  /** Point data and cell data arrays found by ReadMeshInformation(), in
+   * the order of the file. Formats without named arrays list none and read
+   * their single array with ReadPointData() and ReadCellData(). */
+  const DataArrayInformationContainer & GetPointDataArrays() const { return m_PointDataArrays; }
+
+  const DataArrayInformationContainer & GetCellDataArrays() const { return m_CellDataArrays; }
+
+  /** Set/Get the name of the point data array read by ReadPointData(). The
+   * point pixel type, component type and number of components describe
+   * that array after ReadMeshInformation(). Empty, the default, selects the
+   * first array of the file. */
+  itkSetStringMacro(PointDataArrayName);
+  itkGetStringMacro(PointDataArrayName);
+
+  /** Set/Get the name of the cell data array read by ReadCellData() */
+  itkSetStringMacro(CellDataArrayName);
+  itkGetStringMacro(CellDataArrayName);
+
+  /** Read the named point data or cell data arrays into the buffers, one per
+   * name, each laid out as the buffer of ReadPointData() or ReadCellData()
+   * for that array. Formats locating their arrays read them in a single
+   * pass over the file, seeking past the others; the default reads them one
+   * by one. */
+  virtual void ReadPointDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers);
+
+  virtual void ReadCellDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers);
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Writes the data to disk from the memory buffer provided. Make sure
@@ -486,6 +664,114 @@ public:
 
   virtual void Write() = 0;
 
+  /*-------- This part of the interfaces deals with streamed writing ----- */
+
+  /** Determine whether this MeshIO can write each section as a sequence of
+   * chunks. A section is then written by BeginWriteSection(), any number of
+   * Write*Chunk() calls and EndWriteSection(), so that a buffer holding the
+   * whole section is never needed. */
+  virtual bool CanStreamWrite() { return false; }
+
+  /** Number of times the cells have to be streamed. Formats grouping the
+   * cells by type write one group per pass, and the cells section is begun
+   * and ended once per pass. Cell type statistics must be available. */
+  virtual unsigned int GetNumberOfCellsWritePasses() { return 1; }
+
+  /** Write the header of a section to the output file opened by
+   * WriteMeshInformation(). The pass is only used by the cells section. */
+  virtual void BeginWriteSection(SectionType section, unsigned int pass = 0);
+
+  /** Write the trailer of a section. */
+  virtual void EndWriteSection(SectionType section, unsigned int pass = 0);
+
+  /** Write a chunk of the current section. The buffers are laid out as the
+   * buffers of WritePoints(), WriteCells(), WritePointData() and
+   * WriteCellData(), but only hold the given number of points or cells. */
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
+  /** Set/Get the size in bytes of the buffer of the output file stream.
+   * The output file is opened once by WriteMeshInformation(), shared by all
+   * sections and flushed and closed by Write(). */
+  itkSetMacro(WriteBufferSize, SizeValueType);
+  itkGetConstMacro(WriteBufferSize, SizeValueType);
+
+  /** Set/Get a memory buffer to write the mesh into, rather than FileName:
+   * the file encoded replaces the content of the string, which grows as it
+   * is written and must outlive Write(). FileName is then optional, and
+   * only requests compression by a ".gz" extension. A null buffer writes
+   * FileName again. */
+  void SetOutputBuffer(std::string *buffer);
+
+  std::string * GetOutputBuffer() const { return m_OutputBuffer; }
+
+  /** Set/Get a stream to write the mesh to, from its current position,
+   * rather than FileName, like an output buffer. The stream is flushed by
+   * Write(); a failed write may leave part of the file in it. */
+  void SetOutputStream(std::ostream *stream);
+
+  std::ostream * GetOutputStream() const { return m_OutputStream; }
+
+  /** Set/Get whether the output is written to a temporary file next to
+   * FileName, which replaces FileName only once Write() succeeded. Readers
+   * then never see a partially written file. Each write has its own
+   * temporary file, which takes the permissions of an existing FileName.
+   * On by default, and ignored by the output buffers and streams. */
+  itkSetMacro(UseTemporaryFile, bool);
+  itkGetConstMacro(UseTemporaryFile, bool);
+  itkBooleanMacro(UseTemporaryFile);
+
+  /** Set/Get whether the output file is flushed to the storage device
+   * before it is closed (and renamed), and its directory once the temporary
+   * file is renamed, where the platform allows it. Off by default. */
+  itkSetMacro(SyncOutputFile, bool);
+  itkGetConstMacro(SyncOutputFile, bool);
+  itkBooleanMacro(SyncOutputFile);
+
+  /** Set/Get whether the output file is gzip compressed. A file name ending
+   * in ".gz" is always compressed. Compressed input files are recognized by
+   * their content and read transparently. */
+  itkSetMacro(UseCompression, bool);
+  itkGetConstMacro(UseCompression, bool);
+  itkBooleanMacro(UseCompression);
+
+  /** Set/Get the number of threads compressing the output file. With more
+   * than one, the file is compressed in independent blocks of 1 MiB, which
+   * compress and decompress in parallel. 1 by default. */
+  itkSetMacro(NumberOfCompressionThreads, unsigned int);
+  itkGetConstMacro(NumberOfCompressionThreads, unsigned int);
+
+  /** Set/Get the precision of the floating point numbers of ASCII files. 0,
+   * the default, writes decimals which read back to the same value, usually
+   * the shortest ones; n > 0 writes n digits in the notation of the format, like the
+   * streams. */
+  itkSetMacro(AsciiPrecision, unsigned int);
+  itkGetConstMacro(AsciiPrecision, unsigned int);
+
+  /** Determine whether this MeshIO can append point data and cell data
+   * arrays to an existing file. */
+  virtual bool CanAppendData() { return false; }
+
+  /** Set/Get whether WriteMeshInformation() opens the existing FileName to
+   * append the point data and cell data to it, instead of writing a new
+   * file. The points and cells of the file are left as they are, and the
+   * number of points and cells of the data must match theirs. A failed
+   * append truncates the file back to its original length. Off by
+   * default. */
+  itkSetMacro(AppendData, bool);
+  itkGetConstMacro(AppendData, bool);
+  itkBooleanMacro(AppendData);
+
+  /** Close the output file after a failed write and delete the temporary
+   * file, or truncate an appended file, leaving any existing FileName as it
+   * was. An output buffer is cut back to its content before the write. */
+  void AbortOutputFile();
+
   /** This method returns an array with the list of filename extensions
    * supported for reading by this MeshIO class. This is intended to
    * facilitate GUI and application level integration.
@@ -504,93 +790,173 @@ protected:
 
   void PrintSelf(std::ostream & os, Indent indent) const;
 
+  /** Whether the mesh is written to an output buffer or stream rather
+   * than to FileName */
+  bool HasOutputSink() const { return m_OutputBuffer != 0 || m_OutputStream != 0; }
+
+  /** Open the output file with a buffer of WriteBufferSize bytes, either
+   * truncating it or appending to it. A file left open is closed first.
+   * The output buffer or stream is opened instead of FileName when set.
+   * Unless appending, the temporary file is opened when UseTemporaryFile is
+   * on, otherwise the length of the file is kept for AbortOutputFile(). */
+  void OpenOutputFile(bool append = false);
+
+  /** Flush and close the output file, checking that all writes succeeded,
+   * and rename the temporary file over FileName */
+  void CloseOutputFile();
+
   /** Insert an extension to the list of supported extensions for reading. */
   void AddSupportedReadExtension(const char *extension);
 
   /** Insert an extension to the list of supported extensions for writing. */
   void AddSupportedWriteExtension(const char *extension);
 
-  /** Read data from input file stream to buffer with ascii style */
+  /** Read data from input file stream to buffer with ascii style. The
+   * numbers are parsed by MeshNumberParser, straight from memory for the
+   * MeshInputFileStream. */
   template< class T >
-  void ReadBufferAsAscii(T *buffer, std::ifstream & inputFile, SizeValueType numberOfComponents)
+  void ReadBufferAsAscii(T *buffer, std::istream & inputFile, SizeValueType numberOfComponents)
     {
-    for ( SizeValueType i = 0; i < numberOfComponents; i++ )
-      {
-      inputFile >> buffer[i];
-      }
+    MeshNumberParser::Read(inputFile, buffer, numberOfComponents);
     }
 
-  /** Read data from input file to buffer with binary style */
+  /** Read data from input file to buffer with binary style. The data of a
+   * stream reading memory, such as a MeshInputFileStream, are byte swapped
+   * straight from the memory into the buffer. */
   template< class T >
-  void ReadBufferAsBinary(T *buffer, std::ifstream & inputFile, SizeValueType numberOfComponents)
+  void ReadBufferAsBinary(T *buffer, std::istream & inputFile, SizeValueType numberOfComponents)
     {
+    MemoryStreamBuffer *memoryBuffer = dynamic_cast< MemoryStreamBuffer * >( inputFile.rdbuf() );
+    const char *        data = memoryBuffer ? memoryBuffer->Consume(numberOfComponents * sizeof( T ) ) : 0;
+    if ( data )
+      {
+      this->CopyBufferFromFileByteOrder(buffer, data, numberOfComponents);
+      return;
+      }
+
     inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
 
-    if ( m_ByteOrder == BigEndian )
+    if ( sizeof( T ) > 1 && this->IsFileByteOrderSwapped() )
       {
-      if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-        }
+      MeshByteSwapper::Swap(buffer, sizeof( T ), numberOfComponents);
       }
-    else if ( m_ByteOrder == LittleEndian )
+    }
+
+  /** Read numberOfComponents components of componentType, starting at
+   * component firstComponent of the binary section at dataPosition, and
+   * reverse their bytes when the byte order of the file differs from the
+   * byte order of the system. The components are copied from the memory of
+   * the file without moving its position, so that concurrent reads may
+   * share the file. */
+  void ReadBufferRangeAsBinary(const MeshInputFileStream & inputFile, void *buffer, StreamOffsetType dataPosition,
+                               IOComponentType componentType, SizeValueType firstComponent,
+                               SizeValueType numberOfComponents) const;
+
+  /** Open inputFile on the input buffer, the input stream or FileName,
+   * which ReadMeshInformation() reads. Throws when none can be read. */
+  void OpenInputFile(MeshInputFileStream & inputFile);
+
+  /** Open inputFile on file, the input file opened by
+   * ReadMeshInformation(), with a position of its own. The reads following
+   * ReadMeshInformation() each read through such a context rather than
+   * through file itself, and write no member, so that they may run
+   * concurrently on one MeshIO. */
+  void OpenReadContext(MeshInputFileStream & inputFile, const MeshInputFileStream & file) const;
+
+  /** Select the point data and cell data arrays named by PointDataArrayName
+   * and CellDataArrayName, or the first ones, among the arrays found by
+   * ReadMeshInformation(), which calls it once they are listed */
+  void SelectDataArrays();
+
+  /** Describe the point data or cell data by one of their arrays */
+  void UsePointDataArray(unsigned int index);
+
+  void UseCellDataArray(unsigned int index);
+
+  /** Index of the named array, which must exist */
+  unsigned int FindDataArray(const DataArrayInformationContainer & arrays, const std::string & name) const;
+
+  /** Forget the layouts of the sections of a previous file, at the start
+   * of ReadMeshInformation() */
+  void ResetSectionLayouts();
+
+  /** Describe a binary section of numberOfComponents components of
+   * componentType per element, in the byte order of the file. Contiguous
+   * when they are the components of the buffer of the section. */
+  void SetBinarySectionLayout(SectionType section, IOComponentType componentType, unsigned int numberOfComponents,
+                              bool contiguous);
+
+  /** Throw unless [first, first + count) lies in [0, size) */
+  void VerifyRange(SizeValueType first, SizeValueType count, SizeValueType size) const;
+
+  /** Copy data stored in the byte order of the file to buffer, reversing
+   * the bytes of each component on the way when it differs from the byte
+   * order of the system */
+  template< class T >
+  void CopyBufferFromFileByteOrder(T *buffer, const char *data, SizeValueType numberOfComponents)
+    {
+    if ( sizeof( T ) > 1 && this->IsFileByteOrderSwapped() )
       {
-      if ( itk::ByteSwapper< T >::SystemIsBigEndian() )
-        {
-        itk::ByteSwapper< T >::SwapRangeFromSystemToLittleEndian(buffer, numberOfComponents);
-        }
+      MeshByteSwapper::SwapCopy(buffer, data, sizeof( T ), numberOfComponents);
       }
+    else
+      {
+      std::memcpy(buffer, data, numberOfComponents * sizeof( T ) );
+      }
+    }
+
+  /** Return the component type of the cell buffers filled by the readers:
+   * unsigned int, unless the point identifiers exceed its range */
+  IOComponentType GetCellIdentifierComponentType() const
+    {
+    return m_NumberOfPoints > NumericTraits< unsigned int >::max() ? ULONGLONG : UINT;
+    }
+
+  /** Return whether the byte order of the file differs from the byte order
+   * of the system */
+  bool IsFileByteOrderSwapped() const
+    {
+    return ( m_ByteOrder == BigEndian && itk::ByteSwapper< int >::SystemIsLittleEndian() )
+           || ( m_ByteOrder == LittleEndian && itk::ByteSwapper< int >::SystemIsBigEndian() );
     }
 
-  /** Write buffer to output file stream with ascii style */
+  /** Write buffer to output file stream with ascii style, formatted by a
+   * MeshNumberFormatter with the AsciiPrecision */
   template< class T >
-  void WriteBufferAsAscii(T *buffer, std::ofstream & outputFile, SizeValueType numberOfLines, SizeValueType numberOfComponents)
+  void WriteBufferAsAscii(T *buffer, std::ostream & outputFile, SizeValueType numberOfLines, SizeValueType numberOfComponents)
     {
+    MeshNumberFormatter formatter(outputFile, m_AsciiPrecision);
+
     for ( SizeValueType ii = 0; ii < numberOfLines; ii++ )
       {
       for ( SizeValueType jj = 0; jj < numberOfComponents; jj++ )
         {
-        outputFile << buffer[ii * numberOfComponents + jj] << "  ";
+        formatter << buffer[ii * numberOfComponents + jj] << "  ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
-  /** Write buffer to output file stream with binary style */
+  /** Write buffer to output file stream with binary style. The buffer is
+   * never modified, since it may be the storage of the mesh being written:
+   * its components are converted to TOutput and byte swapped block by block
+   * by MeshByteSwapper. */
   template< class TOutput, class TInput >
-  void WriteBufferAsBinary(TInput *buffer, std::ofstream & outputFile, SizeValueType numberOfComponents)
+  void WriteBufferAsBinary(TInput *buffer, std::ostream & outputFile, SizeValueType numberOfComponents)
     {
-    if ( typeid( TInput ) == typeid( TOutput ) )
-      {
-      if ( m_ByteOrder == BigEndian && itk::ByteSwapper< TInput >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< TInput >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-        }
-      else if ( m_ByteOrder == LittleEndian && itk::ByteSwapper< TInput >::SystemIsBigEndian() )
-        {
-        itk::ByteSwapper< TInput >::SwapRangeFromSystemToLittleEndian(buffer, numberOfComponents);
-        }
+    const bool swap = sizeof( TOutput ) > 1 && this->IsFileByteOrderSwapped();
 
-      outputFile.write(reinterpret_cast< char * >( buffer ), numberOfComponents);
+    if ( typeid( TInput ) != typeid( TOutput ) )
+      {
+      MeshByteSwapper::ConvertWrite< TOutput >(outputFile, buffer, numberOfComponents, swap);
+      }
+    else if ( swap )
+      {
+      MeshByteSwapper::SwapWrite(outputFile, buffer, sizeof( TOutput ), numberOfComponents);
       }
     else
       {
-      TOutput *data = new TOutput[numberOfComponents];
-      for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
-        {
-        data[ii] = static_cast< TOutput >( buffer[ii] );
-        }
-
-      if ( m_ByteOrder == BigEndian && itk::ByteSwapper< TOutput >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< TOutput >::SwapRangeFromSystemToBigEndian(data, numberOfComponents);
-        }
-      else if ( m_ByteOrder == LittleEndian && itk::ByteSwapper< TOutput >::SystemIsBigEndian() )
-        {
-        itk::ByteSwapper< TOutput >::SwapRangeFromSystemToLittleEndian(data, numberOfComponents);
-        }
-
-      outputFile.write(reinterpret_cast< char * >( data ), numberOfComponents);
+      outputFile.write(reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( TInput ));
       }
     }
 
@@ -698,6 +1064,13 @@ protected:
   /** Filename to read */
   std::string m_FileName;
 
+  /** Memory or stream read instead of FileName, and the content read from
+    the stream */
+  const void *   m_InputBuffer;
+  SizeValueType  m_InputBufferSize;
+  std::istream * m_InputStream;
+  std::string    m_InputStreamContent;
+
   /** Used internally to keep track of the type of the component. */
   IOComponentType m_PointComponentType;
   IOComponentType m_CellComponentType;
@@ -723,12 +1096,60 @@ protected:
   /** The buffer size of cells */
   SizeValueType m_CellBufferSize;
 
+  /** Per cell type statistics of the cell buffer, valid only when
+    m_CellTypeStatisticsAvailable is true */
+  SizeValueType m_NumberOfCellsOfType[LAST_ITK_CELL];
+  SizeValueType m_NumberOfCellPointsOfType[LAST_ITK_CELL];
+  bool          m_CellTypeStatisticsAvailable;
+
   /** Flags indicate whether read or write points, cells, point data and cell
     data */
   bool m_UpdatePoints;
   bool m_UpdateCells;
   bool m_UpdatePointData;
   bool m_UpdateCellData;
+
+  /** Memory or stream written instead of FileName, and the stream buffer
+    growing the memory */
+  std::string *            m_OutputBuffer;
+  std::ostream *           m_OutputStream;
+  MemoryOutputStreamBuffer m_OutputBufferSink;
+  bool                     m_OutputToSink;
+
+  /** Output stream shared by all sections between WriteMeshInformation()
+    and Write(), and its buffer */
+  MeshOutputFileStream m_OutputFile;
+  SizeValueType        m_WriteBufferSize;
+  std::vector< char >  m_WriteBuffer;
+  std::string          m_OutputFileName;
+  bool                 m_UseTemporaryFile;
+  bool                 m_SyncOutputFile;
+  bool                 m_OutputFileAppended;
+  StreamOffsetType     m_OriginalFileLength;
+
+  /** Whether the output file is gzip compressed, and by how many threads */
+  bool         m_UseCompression;
+  unsigned int m_NumberOfCompressionThreads;
+
+  /** Precision of the floating point numbers of ASCII files, 0 for
+   * decimals reading back exactly */
+  unsigned int m_AsciiPrecision;
+
+  /** Whether the point data and cell data are appended to an existing file */
+  bool m_AppendData;
+
+  /** Named point data and cell data arrays of the file read, and the ones
+    read by ReadPointData() and ReadCellData() */
+  DataArrayInformationContainer m_PointDataArrays;
+  DataArrayInformationContainer m_CellDataArrays;
+  std::string                   m_PointDataArrayName;
+  std::string                   m_CellDataArrayName;
+  unsigned int                  m_SelectedPointDataArray;
+  unsigned int                  m_SelectedCellDataArray;
+
+  /** Layouts of the points, cells, point data and cell data of the file
+    read, indexed by SectionType */
+  SectionLayout m_SectionLayouts[4];
 private:
   MeshIOBase(const Self &);     // purposely not implemented
   void operator=(const Self &); // purposely not implemented
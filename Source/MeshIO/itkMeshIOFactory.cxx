@@ -28,22 +28,103 @@
 #include "itkMutexLockHolder.h"
 #include "itkVTKPolyDataMeshIOFactory.h"
 
+#include <map>
+#include <vector>
+
 namespace itk
 {
-MeshIOBase::Pointer MeshIOFactory::CreateMeshIO(const char *path, FileModeType mode)
+namespace
+{
+/** Snapshot of the registered MeshIOs: one prototype of each, which scores
+ * the files and creates the MeshIO chosen, and the prototypes indexed by
+ * the extensions they read and write. A registry is not modified once it
+ * is in use, and is deleted by its last user once replaced. */
+class MeshIORegistry:public LightObject
 {
-  RegisterBuiltInFactories();
+public:
+  typedef MeshIORegistry                                       Self;
+  typedef SmartPointer< Self >                                 Pointer;
+  typedef std::map< std::string, std::vector< unsigned int > > ExtensionIndexType;
 
-  std::list< MeshIOBase::Pointer >  possibleMeshIO;
-  std::list< LightObject::Pointer > allobjects = ObjectFactoryBase::CreateAllInstance("itkMeshIOBase");
+  itkFactorylessNewMacro(Self);
+
+  std::vector< MeshIOBase::Pointer > Prototypes;
+  ExtensionIndexType                 ReadExtensions;
+  ExtensionIndexType                 WriteExtensions;
+
+protected:
+  MeshIORegistry() {}
+  ~MeshIORegistry() {}
+
+private:
+  MeshIORegistry(const Self &);  // purposely not implemented
+  void operator=(const Self &);  // purposely not implemented
+};
+
+/** Current registry, with the registered factories it was built from.
+ * The lock guards the state and the registration of the built-in
+ * factories. */
+struct MeshIORegistryState
+{
+  SimpleMutexLock         Lock;
+  MeshIORegistry::Pointer Current;
+  std::size_t             NumberOfFactories;
+  ObjectFactoryBase *     LastFactory;
+  bool                    BuiltInFactoriesRegistered;
+
+  MeshIORegistryState():NumberOfFactories(0), LastFactory(0), BuiltInFactoriesRegistered(false) {}
+};
+
+MeshIORegistryState & GetRegistryState()
+{
+  static MeshIORegistryState state;
+
+  return state;
+}
 
+/** Register the built-in factories once. Called with the lock held. */
+void RegisterBuiltInFactoriesLocked(MeshIORegistryState & state)
+{
+  if ( state.BuiltInFactoriesRegistered )
+    {
+    return;
+    }
+
+  ObjectFactoryBase::RegisterFactory( BYUMeshIOFactory::New() );
+  ObjectFactoryBase::RegisterFactory( FreeSurferAsciiMeshIOFactory::New() );
+  ObjectFactoryBase::RegisterFactory( FreeSurferBinaryMeshIOFactory::New() );
+  ObjectFactoryBase::RegisterFactory( OBJMeshIOFactory::New() );
+  ObjectFactoryBase::RegisterFactory( OFFMeshIOFactory::New() );
+  ObjectFactoryBase::RegisterFactory( VTKPolyDataMeshIOFactory::New() );
+
+  state.BuiltInFactoriesRegistered = true;
+}
+
+void IndexExtensions(const MeshIOBase::ArrayOfExtensionsType & extensions, unsigned int index,
+                     MeshIORegistry::ExtensionIndexType & extensionIndex)
+{
+  for ( std::size_t ii = 0; ii < extensions.size(); ii++ )
+    {
+    extensionIndex[extensions[ii]].push_back(index);
+    }
+}
+
+/** Registry of the MeshIOs created by the registered factories */
+MeshIORegistry::Pointer BuildRegistry()
+{
+  MeshIORegistry::Pointer registry = MeshIORegistry::New();
+
+  std::list< LightObject::Pointer > allobjects = ObjectFactoryBase::CreateAllInstance("itkMeshIOBase");
   for ( std::list< LightObject::Pointer >::iterator it = allobjects.begin(); it != allobjects.end(); ++it )
     {
     MeshIOBase *io = dynamic_cast< MeshIOBase * >( it->GetPointer() );
 
     if ( io )
       {
-      possibleMeshIO.push_back(io);
+      const unsigned int index = static_cast< unsigned int >( registry->Prototypes.size() );
+      registry->Prototypes.push_back(io);
+      IndexExtensions(io->GetSupportedReadExtensions(), index, registry->ReadExtensions);
+      IndexExtensions(io->GetSupportedWriteExtensions(), index, registry->WriteExtensions);
       }
     else
       {
@@ -53,20 +134,129 @@ MeshIOBase::Pointer MeshIOFactory::CreateMeshIO(const char *path, FileModeType m
       }
     }
 
-  for ( std::list< MeshIOBase::Pointer >::iterator k = possibleMeshIO.begin(); k != possibleMeshIO.end(); ++k )
+  return registry;
+}
+
+/** Registry of the registered factories. It is built on first use, with
+ * the built-in factories registered, and rebuilt when a factory was
+ * registered or unregistered since, as seen from the number of factories
+ * and the last one. The lock is only held to get the registry, which its
+ * users keep alive by their reference. */
+MeshIORegistry::Pointer GetRegistry()
+{
+  MeshIORegistryState &              state = GetRegistryState();
+  MutexLockHolder< SimpleMutexLock > mutexHolder(state.Lock);
+
+  RegisterBuiltInFactoriesLocked(state);
+
+  const std::list< ObjectFactoryBase * > factories = ObjectFactoryBase::GetRegisteredFactories();
+  ObjectFactoryBase *                    lastFactory = factories.empty() ? 0 : factories.back();
+  if ( state.Current.IsNull() || factories.size() != state.NumberOfFactories || lastFactory != state.LastFactory )
+    {
+    state.Current = BuildRegistry();
+    state.NumberOfFactories = factories.size();
+    state.LastFactory = lastFactory;
+    }
+
+  return state.Current;
+}
+
+/** New MeshIO of the class of a prototype */
+MeshIOBase::Pointer CreateFromPrototype(const MeshIOBase *prototype)
+{
+  LightObject::Pointer another = prototype->CreateAnother();
+  return dynamic_cast< MeshIOBase * >( another.GetPointer() );
+}
+
+/** Prototype scoring a file with the given header and name highest, none
+ * when all of them score 0 */
+const MeshIOBase * FindReadPrototype(const MeshIORegistry & registry, const char *path, const std::string & header)
+{
+  // A MeshIO reading the extension of the file and recognizing its header
+  // is chosen without scoring the others
+  MeshIORegistry::ExtensionIndexType::const_iterator indexed =
+    registry.ReadExtensions.find( MeshIOBase::GetFileNameExtension(path) );
+  if ( indexed != registry.ReadExtensions.end() )
     {
-    if ( mode == ReadMode )
+    for ( std::size_t ii = 0; ii < indexed->second.size(); ii++ )
       {
-      if ( ( *k )->CanReadFile(path) )
+      const MeshIOBase *prototype = registry.Prototypes[indexed->second[ii]];
+      if ( prototype->ScoreFile(path, header) >= 150 )
         {
-        return *k;
+        return prototype;
         }
       }
-    else if ( mode == WriteMode )
+    }
+
+  const MeshIOBase *bestPrototype = 0;
+  unsigned int      bestScore = 0;
+  for ( std::size_t ii = 0; ii < registry.Prototypes.size(); ii++ )
+    {
+    const unsigned int score = registry.Prototypes[ii]->ScoreFile(path, header);
+    if ( score > bestScore )
+      {
+      bestPrototype = registry.Prototypes[ii];
+      bestScore = score;
+      }
+    }
+  return bestPrototype;
+}
+} // end anonymous namespace
+
+MeshIOBase::Pointer MeshIOFactory::CreateMeshIO(const char *path, FileModeType mode)
+{
+  const MeshIORegistry::Pointer                      reference = GetRegistry();
+  const MeshIORegistry &                             registry = *reference;
+  MeshIORegistry::ExtensionIndexType::const_iterator indexed;
+
+  if ( mode == ReadMode )
+    {
+    // The header of the file is read once and scored by the prototypes,
+    // with its extension
+    std::string header;
+    if ( !MeshIOBase::ReadFileHeader(path, header) )
+      {
+      return 0;
+      }
+
+    const MeshIOBase *bestPrototype = FindReadPrototype(registry, path, header);
+    if ( bestPrototype )
+      {
+      return CreateFromPrototype(bestPrototype);
+      }
+
+    // MeshIOs scoring no file may still read it
+    for ( std::size_t ii = 0; ii < registry.Prototypes.size(); ii++ )
+      {
+      MeshIOBase::Pointer io = CreateFromPrototype(registry.Prototypes[ii]);
+      if ( io.IsNotNull() && io->CanReadFile(path) )
+        {
+        return io;
+        }
+      }
+    }
+  else if ( mode == WriteMode )
+    {
+    // The MeshIOs writing the extension of the file are asked first
+    indexed = registry.WriteExtensions.find( MeshIOBase::GetFileNameExtension(path) );
+    if ( indexed != registry.WriteExtensions.end() )
       {
-      if ( ( *k )->CanWriteFile(path) )
+      for ( std::size_t ii = 0; ii < indexed->second.size(); ii++ )
         {
-        return *k;
+        MeshIOBase::Pointer io = CreateFromPrototype(registry.Prototypes[indexed->second[ii]]);
+        if ( io.IsNotNull() && io->CanWriteFile(path) )
+          {
+          return io;
+          }
+        }
+      }
+
+    for ( std::size_t ii = 0; ii < registry.Prototypes.size(); ii++ )
+      {
+      MeshIOBase::Pointer io = CreateFromPrototype(registry.Prototypes[ii]);
+      if ( io.IsNotNull() && io->CanWriteFile(path) )
+        {
+        return io;
         }
       }
     }
@@ -74,30 +264,37 @@ MeshIOBase::Pointer MeshIOFactory::CreateMeshIO(const char *path, FileModeType m
   return 0;
 }
 
+MeshIOBase::Pointer MeshIOFactory::CreateMeshIO(const void *buffer, MeshIOBase::SizeValueType size,
+                                                const char *formatHint)
+{
+  std::string header;
+  if ( ( buffer == 0 && size > 0 ) || size > static_cast< std::size_t >( -1 )
+       || !MeshIOBase::ReadBufferHeader(buffer, static_cast< std::size_t >( size ), header) )
+    {
+    return 0;
+    }
+
+  // Without a file to open, only the header and the hint identify the format
+  const MeshIORegistry::Pointer registry = GetRegistry();
+  const MeshIOBase *            bestPrototype = FindReadPrototype(*registry, formatHint ? formatHint : "", header);
+  return bestPrototype ? CreateFromPrototype(bestPrototype) : MeshIOBase::Pointer();
+}
 
 void MeshIOFactory::RegisterBuiltInFactories()
 {
-  static bool firstTime = true;
-
-  static SimpleMutexLock mutex;
+  MeshIORegistryState &              state = GetRegistryState();
+  MutexLockHolder< SimpleMutexLock > mutexHolder(state.Lock);
 
-    {
-    // This helper class makes sure the Mutex is unlocked
-    // in the event an exception is thrown.
-    MutexLockHolder< SimpleMutexLock > mutexHolder(mutex);
-    if ( firstTime )
-      {
-      ObjectFactoryBase::RegisterFactory( BYUMeshIOFactory::New() );
-      ObjectFactoryBase::RegisterFactory( FreeSurferAsciiMeshIOFactory::New() );
-      ObjectFactoryBase::RegisterFactory( FreeSurferBinaryMeshIOFactory::New() );
-      ObjectFactoryBase::RegisterFactory( OBJMeshIOFactory::New() );
-      ObjectFactoryBase::RegisterFactory( OFFMeshIOFactory::New() );
-      ObjectFactoryBase::RegisterFactory( VTKPolyDataMeshIOFactory::New() );
-
-      firstTime = false;
-      }
-    }
+  RegisterBuiltInFactoriesLocked(state);
 }
 
+void MeshIOFactory::ReHash()
+{
+  MeshIORegistryState &              state = GetRegistryState();
+  MutexLockHolder< SimpleMutexLock > mutexHolder(state.Lock);
+
+  // The registry replaced is deleted by its last user
+  state.Current = 0;
+}
 
 } // end namespace itk
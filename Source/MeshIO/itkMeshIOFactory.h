@@ -49,9 +49,22 @@ public:
   /** Create the appropriate MeshIO depending on the particulars of the file. */
   static MeshIOBasePointer CreateMeshIO(const char *path, FileModeType mode);
 
+  /** Create the MeshIO reading a file held in the size bytes at buffer. The
+   * file is identified by its header and by the extension of formatHint, a
+   * file name or an extension such as ".vtk", which may be null. */
+  static MeshIOBasePointer CreateMeshIO(const void *buffer, MeshIOBase::SizeValueType size,
+                                        const char *formatHint);
+
   /** Register Built-in factories */
   static void RegisterBuiltInFactories();
 
+  /** Rebuild the list of MeshIOs from the registered factories. The list is
+   * built by the first CreateMeshIO(), and rebuilt when the number of
+   * registered factories or the last one differ. Changes not seen this way,
+   * such as overrides enabled or disabled, or a factory unregistered and
+   * another one registered in its place, need a call to ReHash(). */
+  static void ReHash();
+
 protected:
   MeshIOFactory();
   ~MeshIOFactory();
@@ -0,0 +1,350 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshIOTranscoder.cxx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-12 10:04:37 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#if defined( _MSC_VER )
+#pragma warning ( disable : 4786 )
+#endif
+
+#include "itkMeshIOTranscoder.h"
+#include "itkMeshIOFactory.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+namespace
+{
+// Read a whole section into buffer
+void ReadSection(MeshIOBase *io, MeshIOBase::SectionType section, void *buffer)
+{
+  switch ( section )
+    {
+    case MeshIOBase::POINTS_SECTION:
+      io->ReadPoints(buffer);
+      break;
+    case MeshIOBase::CELLS_SECTION:
+      io->ReadCells(buffer);
+      break;
+    case MeshIOBase::POINTDATA_SECTION:
+      io->ReadPointData(buffer);
+      break;
+    case MeshIOBase::CELLDATA_SECTION:
+      io->ReadCellData(buffer);
+      break;
+    }
+}
+
+// Read count points or cells of a section, starting at first, into buffer
+void ReadSectionRange(MeshIOBase *io, MeshIOBase::SectionType section, void *buffer,
+                      MeshIOBase::SizeValueType first, MeshIOBase::SizeValueType count)
+{
+  switch ( section )
+    {
+    case MeshIOBase::POINTS_SECTION:
+      io->ReadPointsRange(buffer, first, count);
+      break;
+    case MeshIOBase::CELLS_SECTION:
+      io->ReadCellsRange(buffer, first, count);
+      break;
+    case MeshIOBase::POINTDATA_SECTION:
+      io->ReadPointDataRange(buffer, first, count);
+      break;
+    case MeshIOBase::CELLDATA_SECTION:
+      io->ReadCellDataRange(buffer, first, count);
+      break;
+    }
+}
+
+// Write a whole section from buffer
+void WriteSection(MeshIOBase *io, MeshIOBase::SectionType section, void *buffer)
+{
+  switch ( section )
+    {
+    case MeshIOBase::POINTS_SECTION:
+      io->WritePoints(buffer);
+      break;
+    case MeshIOBase::CELLS_SECTION:
+      io->WriteCells(buffer);
+      break;
+    case MeshIOBase::POINTDATA_SECTION:
+      io->WritePointData(buffer);
+      break;
+    case MeshIOBase::CELLDATA_SECTION:
+      io->WriteCellData(buffer);
+      break;
+    }
+}
+
+// Write count points or cells of the section begun
+void WriteSectionChunk(MeshIOBase *io, MeshIOBase::SectionType section, void *buffer,
+                       MeshIOBase::SizeValueType count)
+{
+  switch ( section )
+    {
+    case MeshIOBase::POINTS_SECTION:
+      io->WritePointsChunk(buffer, count);
+      break;
+    case MeshIOBase::CELLS_SECTION:
+      io->WriteCellsChunk(buffer, count);
+      break;
+    case MeshIOBase::POINTDATA_SECTION:
+      io->WritePointDataChunk(buffer, count);
+      break;
+    case MeshIOBase::CELLDATA_SECTION:
+      io->WriteCellDataChunk(buffer, count);
+      break;
+    }
+}
+} // end anonymous namespace
+
+MeshIOTranscoder
+::MeshIOTranscoder()
+{
+  m_FactorySpecifiedInputMeshIO = false;
+  m_FactorySpecifiedOutputMeshIO = false;
+  m_FileTypeIsBINARY = false;
+  m_UseCompression = false;
+  m_ChunkSize = 65536;
+}
+
+void
+MeshIOTranscoder
+::GenerateData()
+{
+  this->SetupMeshIOs();
+
+  m_InputMeshIO->ReadMeshInformation();
+  this->CopyMeshInformation();
+
+  const bool updatePoints = m_OutputMeshIO->GetUpdatePoints();
+  const bool updateCells = m_OutputMeshIO->GetUpdateCells();
+  const bool updatePointData = m_OutputMeshIO->GetUpdatePointData();
+  const bool updateCellData = m_OutputMeshIO->GetUpdateCellData();
+  const float numberOfSections = static_cast< float >( updatePoints + updateCells + updatePointData
+                                                       + updateCellData );
+  unsigned int numberOfSectionsDone = 0;
+
+  try
+    {
+    m_OutputMeshIO->WriteMeshInformation();
+
+    if ( updatePoints )
+      {
+      this->TranscodeSection( MeshIOBase::POINTS_SECTION, m_InputMeshIO->GetNumberOfPoints(),
+                              m_InputMeshIO->GetPointDimension()
+                              * m_InputMeshIO->GetComponentSize( m_InputMeshIO->GetPointComponentType() ) );
+      this->UpdateProgress(++numberOfSectionsDone / numberOfSections);
+      }
+
+    if ( updateCells )
+      {
+      this->TranscodeCells();
+      this->UpdateProgress(++numberOfSectionsDone / numberOfSections);
+      }
+
+    if ( updatePointData )
+      {
+      this->TranscodeSection( MeshIOBase::POINTDATA_SECTION, m_InputMeshIO->GetNumberOfPoints(),
+                              m_InputMeshIO->GetNumberOfPointPixelComponents()
+                              * m_InputMeshIO->GetComponentSize( m_InputMeshIO->GetPointPixelComponentType() ) );
+      this->UpdateProgress(++numberOfSectionsDone / numberOfSections);
+      }
+
+    if ( updateCellData )
+      {
+      this->TranscodeSection( MeshIOBase::CELLDATA_SECTION, m_InputMeshIO->GetNumberOfCells(),
+                              m_InputMeshIO->GetNumberOfCellPixelComponents()
+                              * m_InputMeshIO->GetComponentSize( m_InputMeshIO->GetCellPixelComponentType() ) );
+      this->UpdateProgress(++numberOfSectionsDone / numberOfSections);
+      }
+
+    // The sections are read: release the mapping or the inflated content of
+    // the input file, which the input MeshIO would keep until destroyed
+    m_InputMeshIO->CloseInputFile();
+
+    m_OutputMeshIO->Write();
+    }
+  catch ( ... )
+    {
+    // Delete the partially written file, then rethrow
+    m_InputMeshIO->CloseInputFile();
+    m_OutputMeshIO->AbortOutputFile();
+    throw;
+    }
+}
+
+void
+MeshIOTranscoder
+::SetupMeshIOs()
+{
+  if ( m_InputMeshIO.IsNull() || m_FactorySpecifiedInputMeshIO )
+    {
+    if ( m_InputFileName == "" )
+      {
+      itkExceptionMacro(<< "An input FileName or an input MeshIO must be specified");
+      }
+    m_InputMeshIO = MeshIOFactory::CreateMeshIO(m_InputFileName.c_str(), MeshIOFactory::ReadMode);
+    m_FactorySpecifiedInputMeshIO = true;
+    if ( m_InputMeshIO.IsNull() )
+      {
+      itkExceptionMacro(<< "Could not create IO object for reading file " << m_InputFileName);
+      }
+    }
+  if ( m_InputFileName != "" )
+    {
+    m_InputMeshIO->SetFileName( m_InputFileName.c_str() );
+    }
+
+  if ( m_OutputMeshIO.IsNull() || m_FactorySpecifiedOutputMeshIO )
+    {
+    if ( m_OutputFileName == "" )
+      {
+      itkExceptionMacro(<< "An output FileName or an output MeshIO must be specified");
+      }
+    m_OutputMeshIO = MeshIOFactory::CreateMeshIO(m_OutputFileName.c_str(), MeshIOFactory::WriteMode);
+    m_FactorySpecifiedOutputMeshIO = true;
+    if ( m_OutputMeshIO.IsNull() )
+      {
+      itkExceptionMacro(<< "Could not create IO object for writing file " << m_OutputFileName);
+      }
+    }
+  if ( m_OutputFileName != "" )
+    {
+    m_OutputMeshIO->SetFileName( m_OutputFileName.c_str() );
+    }
+
+  if ( m_InputMeshIO == m_OutputMeshIO )
+    {
+    itkExceptionMacro(<< "The input MeshIO and the output MeshIO must differ");
+    }
+}
+
+void
+MeshIOTranscoder
+::CopyMeshInformation()
+{
+  const MeshIOBase *input = m_InputMeshIO;
+  MeshIOBase       *output = m_OutputMeshIO;
+
+  if ( m_FileTypeIsBINARY )
+    {
+    output->SetFileType(MeshIOBase::BINARY);
+    }
+  output->SetUseCompression(m_UseCompression);
+  output->SetAppendData(false);
+
+  // Only the sections found in the input file are written
+  output->SetUpdatePoints( input->GetUpdatePoints() && input->GetNumberOfPoints() );
+  output->SetUpdateCells( input->GetUpdateCells() && input->GetCellBufferSize() );
+  output->SetUpdatePointData( input->GetUpdatePointData() && input->GetNumberOfPoints() );
+  output->SetUpdateCellData( input->GetUpdateCellData() && input->GetNumberOfCells() );
+
+  output->SetNumberOfPoints( input->GetNumberOfPoints() );
+  output->SetPointDimension( input->GetPointDimension() );
+  output->SetPointComponentType( input->GetPointComponentType() );
+
+  // The statistics of an earlier mesh must not describe these cells, the
+  // output MeshIO gathers them from the cell buffer
+  output->SetNumberOfCells( input->GetNumberOfCells() );
+  output->SetCellComponentType( input->GetCellComponentType() );
+  output->SetCellBufferSize( input->GetCellBufferSize() );
+  output->ClearCellTypeStatistics();
+
+  output->SetPointPixelType( input->GetPointPixelType() );
+  output->SetPointPixelComponentType( input->GetPointPixelComponentType() );
+  output->SetNumberOfPointPixelComponents( input->GetNumberOfPointPixelComponents() );
+
+  output->SetCellPixelType( input->GetCellPixelType() );
+  output->SetCellPixelComponentType( input->GetCellPixelComponentType() );
+  output->SetNumberOfCellPixelComponents( input->GetNumberOfCellPixelComponents() );
+}
+
+void
+MeshIOTranscoder
+::TranscodeSection(MeshIOBase::SectionType section, SizeValueType numberOfElements, SizeValueType elementSize)
+{
+  if ( !m_InputMeshIO->SupportsRandomAccess(section) || !m_OutputMeshIO->CanStreamWrite() )
+    {
+    std::vector< char > buffer( static_cast< std::size_t >( numberOfElements * elementSize ) );
+    ReadSection(m_InputMeshIO, section, &buffer[0]);
+    WriteSection(m_OutputMeshIO, section, &buffer[0]);
+    return;
+    }
+
+  // Each chunk is read by a single seek and read, and written at once
+  const SizeValueType chunkSize = std::min(m_ChunkSize, numberOfElements);
+  std::vector< char > buffer( static_cast< std::size_t >( chunkSize * elementSize ) );
+
+  m_OutputMeshIO->BeginWriteSection(section);
+  for ( SizeValueType first = 0; first < numberOfElements; first += chunkSize )
+    {
+    const SizeValueType count = std::min(chunkSize, numberOfElements - first);
+    ReadSectionRange(m_InputMeshIO, section, &buffer[0], first, count);
+    WriteSectionChunk(m_OutputMeshIO, section, &buffer[0], count);
+    }
+  m_OutputMeshIO->EndWriteSection(section);
+}
+
+void
+MeshIOTranscoder
+::TranscodeCells()
+{
+  // The length of a range of cells in the buffer is only known once it is
+  // read, so the cells are passed whole, and the output MeshIO groups them
+  // by type itself
+  std::vector< char > buffer( static_cast< std::size_t >( m_InputMeshIO->GetCellBufferSize()
+                                                          * m_InputMeshIO->GetComponentSize(
+                                                            m_InputMeshIO->GetCellComponentType() ) ) );
+  ReadSection(m_InputMeshIO, MeshIOBase::CELLS_SECTION, &buffer[0]);
+  WriteSection(m_OutputMeshIO, MeshIOBase::CELLS_SECTION, &buffer[0]);
+}
+
+void
+MeshIOTranscoder
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Input File Name: "
+     << ( m_InputFileName.data() ? m_InputFileName.data() : "(none)" ) << std::endl;
+  os << indent << "Output File Name: "
+     << ( m_OutputFileName.data() ? m_OutputFileName.data() : "(none)" ) << std::endl;
+
+  os << indent << "Input MeshIO: ";
+  if ( m_InputMeshIO.IsNull() )
+    {
+    os << "(none)\n";
+    }
+  else
+    {
+    os << m_InputMeshIO << "\n";
+    }
+  os << indent << "Output MeshIO: ";
+  if ( m_OutputMeshIO.IsNull() )
+    {
+    os << "(none)\n";
+    }
+  else
+    {
+    os << m_OutputMeshIO << "\n";
+    }
+
+  os << indent << "FileTypeIsBINARY: " << ( m_FileTypeIsBINARY ? "On" : "Off" ) << "\n";
+  os << indent << "UseCompression: " << ( m_UseCompression ? "On" : "Off" ) << "\n";
+  os << indent << "ChunkSize: " << m_ChunkSize << "\n";
+}
+} // end namespace itk
@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshIOTranscoder.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-12 10:04:37 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshIOTranscoder_h
+#define __itkMeshIOTranscoder_h
+
+#include "itkLightProcessObject.h"
+#include "itkMeshIOBase.h"
+#include "itkNumericTraits.h"
+
+#include <string>
+
+namespace itk
+{
+/** \class MeshIOTranscoder
+ * \brief Converts a mesh file from one format to another without building
+ * a mesh.
+ *
+ * MeshIOTranscoder reads the points, cells, point data and cell data of a
+ * file with one MeshIO and writes them with another, passing the buffers
+ * of the sections from one to the other as they are, in the component
+ * types of the input file. No itk::Mesh, and no cell object, is built.
+ *
+ * The points, point data and cell data are passed ChunkSize points or
+ * cells at a time when the input MeshIO reads them by range and the output
+ * MeshIO writes them by chunks, so that the memory used does not grow with
+ * their size; the other sections, and the cells, whose records vary in
+ * length, are passed whole. Only the first point data and cell data arrays
+ * of the input file are converted.
+ *
+ * Either MeshIO may be set, or created by the factory from InputFileName
+ * and OutputFileName.
+ *
+ * \sa MeshIOBase MeshFileReader MeshFileWriter
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshIOTranscoder:public LightProcessObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef MeshIOTranscoder           Self;
+  typedef LightProcessObject         Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MeshIOTranscoder, LightProcessObject);
+
+  typedef MeshIOBase::SizeValueType SizeValueType;
+
+  /** Specify the names of the file to convert and of the file written */
+  itkSetStringMacro(InputFileName);
+  itkGetStringMacro(InputFileName);
+  itkSetStringMacro(OutputFileName);
+  itkGetStringMacro(OutputFileName);
+
+  /** Set/Get the MeshIO reading the input file and the MeshIO writing the
+   * output file. Left unset, they are created by the factory from the file
+   * names at each Update(), and can be retrieved afterwards. */
+  void SetInputMeshIO(MeshIOBase *io)
+    {
+    if ( this->m_InputMeshIO != io )
+      {
+      this->Modified();
+      this->m_InputMeshIO = io;
+      }
+    m_FactorySpecifiedInputMeshIO = false;
+    }
+
+  itkGetObjectMacro(InputMeshIO, MeshIOBase);
+
+  void SetOutputMeshIO(MeshIOBase *io)
+    {
+    if ( this->m_OutputMeshIO != io )
+      {
+      this->Modified();
+      this->m_OutputMeshIO = io;
+      }
+    m_FactorySpecifiedOutputMeshIO = false;
+    }
+
+  itkGetObjectMacro(OutputMeshIO, MeshIOBase);
+
+  void SetFileTypeAsASCII(){m_FileTypeIsBINARY = false; }
+  void SetFileTypeAsBINARY(){m_FileTypeIsBINARY = true; }
+
+  /** Set the compression of the output file On or Off */
+  itkSetMacro(UseCompression, bool);
+  itkGetConstReferenceMacro(UseCompression, bool);
+  itkBooleanMacro(UseCompression);
+
+  /** Set/Get the number of points or cells passed at a time from the input
+   * MeshIO to the output MeshIO, when both support it. */
+  itkSetClampMacro( ChunkSize, SizeValueType, 1, NumericTraits< SizeValueType >::max() );
+  itkGetConstMacro(ChunkSize, SizeValueType);
+
+protected:
+  MeshIOTranscoder();
+  ~MeshIOTranscoder() {}
+
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** Read the input file and write the output file */
+  void GenerateData();
+
+  /** Create the MeshIOs missing and give them their files */
+  void SetupMeshIOs();
+
+  /** Copy the mesh information read from the input file to the output
+   * MeshIO */
+  void CopyMeshInformation();
+
+  /** Pass the points, point data or cell data, whose numberOfElements
+   * elements hold elementSize bytes each, from the input MeshIO to the
+   * output MeshIO, by chunks when both support it */
+  void TranscodeSection(MeshIOBase::SectionType section, SizeValueType numberOfElements, SizeValueType elementSize);
+
+  /** Pass the whole cell buffer */
+  void TranscodeCells();
+
+private:
+  MeshIOTranscoder(const Self &); // purposely not implemented
+  void operator=(const Self &);   // purposely not implemented
+
+  std::string         m_InputFileName;
+  std::string         m_OutputFileName;
+  MeshIOBase::Pointer m_InputMeshIO;
+  MeshIOBase::Pointer m_OutputMeshIO;
+  bool                m_FactorySpecifiedInputMeshIO;  // track whether the
+                                                      // factory mechanism
+                                                      // set the MeshIOs
+  bool                m_FactorySpecifiedOutputMeshIO;
+  bool                m_FileTypeIsBINARY;
+  bool                m_UseCompression;
+  SizeValueType       m_ChunkSize;
+};
+} // end namespace itk
+
+#endif // __itkMeshIOTranscoder_h
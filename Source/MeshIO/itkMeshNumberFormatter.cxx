@@ -0,0 +1,649 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshNumberFormatter.cxx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-28 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#include "itkMeshNumberFormatter.h"
+#include "itkIntTypes.h"
+
+#include <cstring>
+#include <limits>
+
+namespace itk
+{
+namespace
+{
+/** Floating point number f * 2^e with a 64 bits significand */
+struct DiyFloat
+{
+  unsigned long long f;
+  int                e;
+
+  DiyFloat(unsigned long long significand, int exponent):f(significand), e(exponent) {}
+};
+
+DiyFloat Subtract(const DiyFloat & x, const DiyFloat & y)
+{
+  return DiyFloat(x.f - y.f, x.e);
+}
+
+/** Upper 64 bits of the product of the significands, rounded */
+DiyFloat Multiply(const DiyFloat & x, const DiyFloat & y)
+{
+  const unsigned long long mask = 0xffffffffUL;
+  const unsigned long long xLow = x.f & mask;
+  const unsigned long long xHigh = x.f >> 32;
+  const unsigned long long yLow = y.f & mask;
+  const unsigned long long yHigh = y.f >> 32;
+
+  const unsigned long long lowLow = xLow * yLow;
+  const unsigned long long lowHigh = xLow * yHigh;
+  const unsigned long long highLow = xHigh * yLow;
+  const unsigned long long highHigh = xHigh * yHigh;
+
+  unsigned long long middle = ( lowLow >> 32 ) + ( lowHigh & mask ) + ( highLow & mask );
+  middle += static_cast< unsigned long long >( 1 ) << 31;
+
+  return DiyFloat(highHigh + ( lowHigh >> 32 ) + ( highLow >> 32 ) + ( middle >> 32 ), x.e + y.e + 64);
+}
+
+DiyFloat Normalize(DiyFloat x)
+{
+  while ( ( x.f >> 63 ) == 0 )
+    {
+    x.f <<= 1;
+    x.e--;
+    }
+  return x;
+}
+
+DiyFloat NormalizeTo(const DiyFloat & x, int exponent)
+{
+  return DiyFloat(x.f << ( x.e - exponent ), exponent);
+}
+
+/** The value and the boundaries half way to its neighbours, all normalized
+ * to the exponent of the upper boundary */
+struct Boundaries
+{
+  DiyFloat m_Value;
+  DiyFloat m_Lower;
+  DiyFloat m_Upper;
+
+  Boundaries(const DiyFloat & value, const DiyFloat & lower, const DiyFloat & upper):
+    m_Value(value), m_Lower(lower), m_Upper(upper) {}
+};
+
+template< class T >
+struct FloatingPointBits;
+
+template< >
+struct FloatingPointBits< float >
+{
+  typedef uint32_t BitsType;
+};
+
+template< >
+struct FloatingPointBits< double >
+{
+  typedef uint64_t BitsType;
+};
+
+/** Boundaries of a positive finite number */
+template< class T >
+Boundaries ComputeBoundaries(T value)
+{
+  typedef typename FloatingPointBits< T >::BitsType BitsType;
+
+  const int                precision = std::numeric_limits< T >::digits;
+  const int                bias = std::numeric_limits< T >::max_exponent - 1 + ( precision - 1 );
+  const int                minimumExponent = 1 - bias;
+  const unsigned long long hiddenBit = static_cast< unsigned long long >( 1 ) << ( precision - 1 );
+
+  BitsType bits;
+  std::memcpy( &bits, &value, sizeof( T ) );
+  const unsigned long long exponentBits = static_cast< unsigned long long >( bits ) >> ( precision - 1 );
+  const unsigned long long fractionBits = static_cast< unsigned long long >( bits ) & ( hiddenBit - 1 );
+
+  const DiyFloat v = ( exponentBits == 0 )
+                     ? DiyFloat(fractionBits, minimumExponent)
+                     : DiyFloat( fractionBits + hiddenBit, static_cast< int >( exponentBits ) - bias );
+
+  // Below a power of two, the neighbour is half as far
+  const bool     lowerIsCloser = ( fractionBits == 0 && exponentBits > 1 );
+  const DiyFloat upper(2 * v.f + 1, v.e - 1);
+  const DiyFloat lower = lowerIsCloser ? DiyFloat(4 * v.f - 1, v.e - 2) : DiyFloat(2 * v.f - 1, v.e - 1);
+
+  const DiyFloat normalizedUpper = Normalize(upper);
+  // The significand of the upper boundary has one more bit than that of the
+  // value, both normalize to the same exponent
+  return Boundaries( Normalize(v), NormalizeTo(lower, normalizedUpper.e), normalizedUpper );
+}
+
+/** Normalized 10^k, for k = -300, -292, ..., 340 */
+struct CachedPower
+{
+  unsigned long m_High;
+  unsigned long m_Low;
+  int           m_BinaryExponent;
+  int           m_DecimalExponent;
+};
+
+const CachedPower CachedPowers[] = {
+  { 0xAB70FE17UL, 0xC79AC6CAUL, -1060, -300 },
+  { 0xFF77B1FCUL, 0xBEBCDC4FUL, -1034, -292 },
+  { 0xBE5691EFUL, 0x416BD60CUL, -1007, -284 },
+  { 0x8DD01FADUL, 0x907FFC3CUL,  -980, -276 },
+  { 0xD3515C28UL, 0x31559A83UL,  -954, -268 },
+  { 0x9D71AC8FUL, 0xADA6C9B5UL,  -927, -260 },
+  { 0xEA9C2277UL, 0x23EE8BCBUL,  -901, -252 },
+  { 0xAECC4991UL, 0x4078536DUL,  -874, -244 },
+  { 0x823C1279UL, 0x5DB6CE57UL,  -847, -236 },
+  { 0xC2109436UL, 0x4DFB5637UL,  -821, -228 },
+  { 0x9096EA6FUL, 0x3848984FUL,  -794, -220 },
+  { 0xD77485CBUL, 0x25823AC7UL,  -768, -212 },
+  { 0xA086CFCDUL, 0x97BF97F4UL,  -741, -204 },
+  { 0xEF340A98UL, 0x172AACE5UL,  -715, -196 },
+  { 0xB23867FBUL, 0x2A35B28EUL,  -688, -188 },
+  { 0x84C8D4DFUL, 0xD2C63F3BUL,  -661, -180 },
+  { 0xC5DD4427UL, 0x1AD3CDBAUL,  -635, -172 },
+  { 0x936B9FCEUL, 0xBB25C996UL,  -608, -164 },
+  { 0xDBAC6C24UL, 0x7D62A584UL,  -582, -156 },
+  { 0xA3AB6658UL, 0x0D5FDAF6UL,  -555, -148 },
+  { 0xF3E2F893UL, 0xDEC3F126UL,  -529, -140 },
+  { 0xB5B5ADA8UL, 0xAAFF80B8UL,  -502, -132 },
+  { 0x87625F05UL, 0x6C7C4A8BUL,  -475, -124 },
+  { 0xC9BCFF60UL, 0x34C13053UL,  -449, -116 },
+  { 0x964E858CUL, 0x91BA2655UL,  -422, -108 },
+  { 0xDFF97724UL, 0x70297EBDUL,  -396, -100 },
+  { 0xA6DFBD9FUL, 0xB8E5B88FUL,  -369,  -92 },
+  { 0xF8A95FCFUL, 0x88747D94UL,  -343,  -84 },
+  { 0xB9447093UL, 0x8FA89BCFUL,  -316,  -76 },
+  { 0x8A08F0F8UL, 0xBF0F156BUL,  -289,  -68 },
+  { 0xCDB02555UL, 0x653131B6UL,  -263,  -60 },
+  { 0x993FE2C6UL, 0xD07B7FACUL,  -236,  -52 },
+  { 0xE45C10C4UL, 0x2A2B3B06UL,  -210,  -44 },
+  { 0xAA242499UL, 0x697392D3UL,  -183,  -36 },
+  { 0xFD87B5F2UL, 0x8300CA0EUL,  -157,  -28 },
+  { 0xBCE50864UL, 0x92111AEBUL,  -130,  -20 },
+  { 0x8CBCCC09UL, 0x6F5088CCUL,  -103,  -12 },
+  { 0xD1B71758UL, 0xE219652CUL,   -77,   -4 },
+  { 0x9C400000UL, 0x00000000UL,   -50,    4 },
+  { 0xE8D4A510UL, 0x00000000UL,   -24,   12 },
+  { 0xAD78EBC5UL, 0xAC620000UL,     3,   20 },
+  { 0x813F3978UL, 0xF8940984UL,    30,   28 },
+  { 0xC097CE7BUL, 0xC90715B3UL,    56,   36 },
+  { 0x8F7E32CEUL, 0x7BEA5C70UL,    83,   44 },
+  { 0xD5D238A4UL, 0xABE98068UL,   109,   52 },
+  { 0x9F4F2726UL, 0x179A2245UL,   136,   60 },
+  { 0xED63A231UL, 0xD4C4FB27UL,   162,   68 },
+  { 0xB0DE6538UL, 0x8CC8ADA8UL,   189,   76 },
+  { 0x83C7088EUL, 0x1AAB65DBUL,   216,   84 },
+  { 0xC45D1DF9UL, 0x42711D9AUL,   242,   92 },
+  { 0x924D692CUL, 0xA61BE758UL,   269,  100 },
+  { 0xDA01EE64UL, 0x1A708DEAUL,   295,  108 },
+  { 0xA26DA399UL, 0x9AEF774AUL,   322,  116 },
+  { 0xF209787BUL, 0xB47D6B85UL,   348,  124 },
+  { 0xB454E4A1UL, 0x79DD1877UL,   375,  132 },
+  { 0x865B8692UL, 0x5B9BC5C2UL,   402,  140 },
+  { 0xC83553C5UL, 0xC8965D3DUL,   428,  148 },
+  { 0x952AB45CUL, 0xFA97A0B3UL,   455,  156 },
+  { 0xDE469FBDUL, 0x99A05FE3UL,   481,  164 },
+  { 0xA59BC234UL, 0xDB398C25UL,   508,  172 },
+  { 0xF6C69A72UL, 0xA3989F5CUL,   534,  180 },
+  { 0xB7DCBF53UL, 0x54E9BECEUL,   561,  188 },
+  { 0x88FCF317UL, 0xF22241E2UL,   588,  196 },
+  { 0xCC20CE9BUL, 0xD35C78A5UL,   614,  204 },
+  { 0x98165AF3UL, 0x7B2153DFUL,   641,  212 },
+  { 0xE2A0B5DCUL, 0x971F303AUL,   667,  220 },
+  { 0xA8D9D153UL, 0x5CE3B396UL,   694,  228 },
+  { 0xFB9B7CD9UL, 0xA4A7443CUL,   720,  236 },
+  { 0xBB764C4CUL, 0xA7A44410UL,   747,  244 },
+  { 0x8BAB8EEFUL, 0xB6409C1AUL,   774,  252 },
+  { 0xD01FEF10UL, 0xA657842CUL,   800,  260 },
+  { 0x9B10A4E5UL, 0xE9913129UL,   827,  268 },
+  { 0xE7109BFBUL, 0xA19C0C9DUL,   853,  276 },
+  { 0xAC2820D9UL, 0x623BF429UL,   880,  284 },
+  { 0x80444B5EUL, 0x7AA7CF85UL,   907,  292 },
+  { 0xBF21E440UL, 0x03ACDD2DUL,   933,  300 },
+  { 0x8E679C2FUL, 0x5E44FF8FUL,   960,  308 },
+  { 0xD433179DUL, 0x9C8CB841UL,   986,  316 },
+  { 0x9E19DB92UL, 0xB4E31BA9UL,  1013,  324 },
+  { 0xEB96BF6EUL, 0xBADF77D9UL,  1039,  332 },
+  { 0xAF87023BUL, 0x9BF0EE6BUL,  1066,  340 }
+};
+
+/** The products with the cached power have binary exponents in
+ * [Alpha, Gamma], so that their integral part holds in 32 bits */
+const int Alpha = -60;
+const int Gamma = -32;
+
+/** Cached power c = 10^k such that the exponent of x * c is in
+ * [Alpha, Gamma] */
+const CachedPower & GetCachedPower(int binaryExponent)
+{
+  // k = ceil((Alpha - e - 1) * log10(2)), 78913 / 2^18 approximating log10(2)
+  const int f = Alpha - binaryExponent - 1;
+  const int k = ( f * 78913 ) / ( 1 << 18 ) + ( f > 0 );
+
+  return CachedPowers[( 300 + k + 7 ) / 8];
+}
+
+/** Number of decimal digits of n, and the largest power of ten not above n */
+int FindLargestPowerOfTen(uint32_t n, uint32_t & powerOfTen)
+{
+  int digits = 10;
+
+  powerOfTen = 1000000000UL;
+  while ( digits > 1 && n < powerOfTen )
+    {
+    powerOfTen /= 10;
+    digits--;
+    }
+  return digits;
+}
+
+/** Move the last digit towards the value, while it stays in the rounding
+ * interval */
+void RoundDigits(char *digits, int length, unsigned long long distance, unsigned long long delta,
+                 unsigned long long rest, unsigned long long tenToK)
+{
+  while ( rest < distance && delta - rest >= tenToK
+          && ( rest + tenToK < distance || distance - rest > rest + tenToK - distance ) )
+    {
+    digits[length - 1]--;
+    rest += tenToK;
+    }
+}
+
+/** Generate the shortest digits of the interval [lower, upper] close to
+ * value, with value = digits * 10^decimalExponent */
+int GenerateDigits(char *digits, int & decimalExponent, const DiyFloat & lower, const DiyFloat & value,
+                   const DiyFloat & upper)
+{
+  unsigned long long delta = Subtract(upper, lower).f;
+  unsigned long long distance = Subtract(upper, value).f;
+
+  const DiyFloat one(static_cast< unsigned long long >( 1 ) << -upper.e, upper.e);
+
+  uint32_t           integral = static_cast< uint32_t >( upper.f >> -one.e );
+  unsigned long long fractional = upper.f & ( one.f - 1 );
+
+  int      length = 0;
+  uint32_t powerOfTen;
+  int      remainingDigits = FindLargestPowerOfTen(integral, powerOfTen);
+  while ( remainingDigits > 0 )
+    {
+    digits[length++] = static_cast< char >( '0' + integral / powerOfTen );
+    integral %= powerOfTen;
+    remainingDigits--;
+
+    const unsigned long long rest = ( static_cast< unsigned long long >( integral ) << -one.e ) + fractional;
+    if ( rest <= delta )
+      {
+      decimalExponent += remainingDigits;
+      RoundDigits(digits, length, distance, delta, rest, static_cast< unsigned long long >( powerOfTen ) << -one.e);
+      return length;
+      }
+    powerOfTen /= 10;
+    }
+
+  int fractionalDigits = 0;
+  for (;; )
+    {
+    fractional *= 10;
+    digits[length++] = static_cast< char >( '0' + ( fractional >> -one.e ) );
+    fractional &= one.f - 1;
+    fractionalDigits++;
+
+    delta *= 10;
+    distance *= 10;
+    if ( fractional <= delta )
+      {
+      break;
+      }
+    }
+
+  decimalExponent -= fractionalDigits;
+  RoundDigits(digits, length, distance, delta, fractional, one.f);
+  return length;
+}
+
+/** Digits of a positive finite number reading back exactly, usually the
+ * shortest ones */
+template< class T >
+int Grisu2(char *digits, int & decimalExponent, T value)
+{
+  const Boundaries boundaries = ComputeBoundaries(value);
+
+  const CachedPower & cached = GetCachedPower(boundaries.m_Upper.e);
+  const DiyFloat      power( ( static_cast< unsigned long long >( cached.m_High ) << 32 ) | cached.m_Low,
+                             cached.m_BinaryExponent );
+
+  const DiyFloat w = Multiply(boundaries.m_Value, power);
+  const DiyFloat lower = Multiply(boundaries.m_Lower, power);
+  const DiyFloat upper = Multiply(boundaries.m_Upper, power);
+
+  // Keep clear of the boundaries, which the products only approximate
+  decimalExponent = -cached.m_DecimalExponent;
+  return GenerateDigits( digits, decimalExponent, DiyFloat(lower.f + 1, lower.e), w, DiyFloat(upper.f - 1, upper.e) );
+}
+
+char * WriteExponent(char *output, int exponent)
+{
+  *output++ = 'e';
+  if ( exponent < 0 )
+    {
+    *output++ = '-';
+    exponent = -exponent;
+    }
+  else
+    {
+    *output++ = '+';
+    }
+
+  if ( exponent >= 100 )
+    {
+    *output++ = static_cast< char >( '0' + exponent / 100 );
+    exponent %= 100;
+    }
+  *output++ = static_cast< char >( '0' + exponent / 10 );
+  *output++ = static_cast< char >( '0' + exponent % 10 );
+  return output;
+}
+
+/** Lay out the digits in fixed notation for decimal points in
+ * (MinimumFixedPoint, MaximumFixedPoint], in scientific notation otherwise,
+ * like the %g format */
+char * WriteDigits(char *output, const char *digits, int length, int decimalExponent)
+{
+  const int MinimumFixedPoint = -4;
+  const int MaximumFixedPoint = 17;
+  const int point = length + decimalExponent;
+
+  if ( length <= point && point <= MaximumFixedPoint )
+    {
+    // 12300
+    std::memcpy(output, digits, length);
+    std::memset(output + length, '0', point - length);
+    return output + point;
+    }
+
+  if ( 0 < point && point <= MaximumFixedPoint )
+    {
+    // 12.3
+    std::memcpy(output, digits, point);
+    output[point] = '.';
+    std::memcpy(output + point + 1, digits + point, length - point);
+    return output + length + 1;
+    }
+
+  if ( MinimumFixedPoint < point && point <= 0 )
+    {
+    // 0.00123
+    output[0] = '0';
+    output[1] = '.';
+    std::memset(output + 2, '0', -point);
+    std::memcpy(output + 2 - point, digits, length);
+    return output + 2 - point + length;
+    }
+
+  // 1.23e+45
+  *output++ = digits[0];
+  if ( length > 1 )
+    {
+    *output++ = '.';
+    std::memcpy(output, digits + 1, length - 1);
+    output += length - 1;
+    }
+  return WriteExponent(output, point - 1);
+}
+
+template< class T >
+char * FormatFloatingPoint(char *output, T value)
+{
+  if ( value != value )
+    {
+    std::memcpy(output, "nan", 3);
+    return output + 3;
+    }
+
+  // The sign bit, of the zeros too
+  typedef typename FloatingPointBits< T >::BitsType BitsType;
+  BitsType bits;
+  std::memcpy( &bits, &value, sizeof( T ) );
+  if ( ( bits >> ( sizeof( T ) * 8 - 1 ) ) != 0 )
+    {
+    *output++ = '-';
+    value = -value;
+    }
+
+  if ( value == 0 )
+    {
+    *output = '0';
+    return output + 1;
+    }
+  if ( value > std::numeric_limits< T >::max() )
+    {
+    std::memcpy(output, "inf", 3);
+    return output + 3;
+    }
+
+  char digits[20];
+  int  decimalExponent = 0;
+  const int length = Grisu2(digits, decimalExponent, value);
+  return WriteDigits(output, digits, length, decimalExponent);
+}
+
+template< class T >
+char * FormatUnsigned(char *output, T value)
+{
+  char  digits[24];
+  char *digit = digits + sizeof( digits );
+
+  do
+    {
+    *--digit = static_cast< char >( '0' + value % 10 );
+    value /= 10;
+    }
+  while ( value != 0 );
+
+  const std::size_t length = digits + sizeof( digits ) - digit;
+  std::memcpy(output, digit, length);
+  return output + length;
+}
+
+template< class T >
+char * FormatInteger(char *output, T value)
+{
+  if ( value < 0 )
+    {
+    *output++ = '-';
+
+    // The magnitude of the minimum does not hold in T
+    return FormatUnsigned(output, 0 - static_cast< unsigned long long >( value ));
+    }
+  return FormatUnsigned(output, static_cast< unsigned long long >( value ));
+}
+} // end namespace
+
+MeshNumberFormatter::MeshNumberFormatter(std::ostream & outputStream, unsigned int precision):
+  m_Stream(outputStream),
+  m_Precision(precision),
+  m_StreamPrecision( outputStream.precision() ),
+  m_Block(BlockSize)
+{
+  m_Position = &m_Block[0];
+  m_End = m_Position + m_Block.size();
+
+  if ( m_Precision > 0 )
+    {
+    m_Stream.precision(m_Precision);
+    }
+}
+
+MeshNumberFormatter::~MeshNumberFormatter()
+{
+  this->Flush();
+  m_Stream.precision(m_StreamPrecision);
+}
+
+char * MeshNumberFormatter::Format(char *output, float value)
+{
+  return FormatFloatingPoint(output, value);
+}
+
+char * MeshNumberFormatter::Format(char *output, double value)
+{
+  return FormatFloatingPoint(output, value);
+}
+
+void MeshNumberFormatter::Flush()
+{
+  if ( m_Position != &m_Block[0] )
+    {
+    m_Stream.write( &m_Block[0], m_Position - &m_Block[0] );
+    m_Position = &m_Block[0];
+    }
+}
+
+template< class T >
+void MeshNumberFormatter::WriteWithStream(T value)
+{
+  this->Flush();
+  m_Stream << value;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(float value)
+{
+  if ( m_Precision > 0 )
+    {
+    this->WriteWithStream(value);
+    return *this;
+    }
+  this->Reserve(MaximumLength);
+  m_Position = FormatFloatingPoint(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(double value)
+{
+  if ( m_Precision > 0 )
+    {
+    this->WriteWithStream(value);
+    return *this;
+    }
+  this->Reserve(MaximumLength);
+  m_Position = FormatFloatingPoint(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(long double value)
+{
+  // Beyond the precision of double, the shortest decimals are left to the
+  // stream
+  if ( m_Precision == 0 )
+    {
+    m_Stream.precision(std::numeric_limits< long double >::digits10 + 3);
+    }
+  this->WriteWithStream(value);
+  if ( m_Precision == 0 )
+    {
+    m_Stream.precision(m_StreamPrecision);
+    }
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(char value)
+{
+  this->Reserve(1);
+  *m_Position++ = value;
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(signed char value)
+{
+  return *this << static_cast< char >( value );
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(unsigned char value)
+{
+  return *this << static_cast< char >( value );
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(short value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatInteger(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(unsigned short value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatUnsigned(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(int value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatInteger(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(unsigned int value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatUnsigned(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(long value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatInteger(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(unsigned long value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatUnsigned(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(long long value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatInteger(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(unsigned long long value)
+{
+  this->Reserve(MaximumLength);
+  m_Position = FormatUnsigned(m_Position, value);
+  return *this;
+}
+
+MeshNumberFormatter & MeshNumberFormatter::operator<<(const char *text)
+{
+  for (; *text != '\0'; ++text )
+    {
+    *this << *text;
+    }
+  return *this;
+}
+} // end namespace itk
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshNumberFormatter.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-28 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshNumberFormatter_h
+#define __itkMeshNumberFormatter_h
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+/** \class MeshNumberFormatter
+ * \brief Writes the numbers of ASCII mesh files through a block buffer.
+ *
+ * The numbers and separators inserted with operator<< are formatted into a
+ * buffer of BlockSize characters, which is written to the stream when it is
+ * full, on Flush() and on destruction.
+ *
+ * With a precision of 0, the default, floating point numbers are written
+ * with decimals that read back to exactly the same value, generated with
+ * the Grisu2 algorithm of F. Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers", PLDI 2010. The decimals are
+ * usually the shortest ones, but Grisu2 does not guarantee it: for a few
+ * values, one digit more than needed is written. With a precision n > 0,
+ * they are written by the stream with n digits and the stream's notation,
+ * as before this class. Integers are always written by the formatter, and
+ * the character types as characters, like the streams do.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshNumberFormatter
+{
+public:
+  /** Longest number written by Format() */
+  enum { MaximumLength = 32 };
+
+  /** Size of the buffer written to the stream at once */
+  enum { BlockSize = 65536 };
+
+  MeshNumberFormatter(std::ostream & outputStream, unsigned int precision = 0);
+  ~MeshNumberFormatter();
+
+  /** Write decimals reading back exactly to value at output, usually the
+   * shortest ones, and return the end of the characters written. */
+  static char * Format(char *output, float value);
+
+  static char * Format(char *output, double value);
+
+  /** Write the characters formatted so far to the stream */
+  void Flush();
+
+  MeshNumberFormatter & operator<<(float value);
+
+  MeshNumberFormatter & operator<<(double value);
+
+  MeshNumberFormatter & operator<<(long double value);
+
+  MeshNumberFormatter & operator<<(char value);
+
+  MeshNumberFormatter & operator<<(signed char value);
+
+  MeshNumberFormatter & operator<<(unsigned char value);
+
+  MeshNumberFormatter & operator<<(short value);
+
+  MeshNumberFormatter & operator<<(unsigned short value);
+
+  MeshNumberFormatter & operator<<(int value);
+
+  MeshNumberFormatter & operator<<(unsigned int value);
+
+  MeshNumberFormatter & operator<<(long value);
+
+  MeshNumberFormatter & operator<<(unsigned long value);
+
+  MeshNumberFormatter & operator<<(long long value);
+
+  MeshNumberFormatter & operator<<(unsigned long long value);
+
+  MeshNumberFormatter & operator<<(const char *text);
+
+private:
+  MeshNumberFormatter(const MeshNumberFormatter &); // purposely not implemented
+  void operator=(const MeshNumberFormatter &);      // purposely not implemented
+
+  /** Make room for a number */
+  void Reserve(std::size_t size)
+    {
+    if ( static_cast< std::size_t >( m_End - m_Position ) < size )
+      {
+      this->Flush();
+      }
+    }
+
+  template< class T >
+  void WriteWithStream(T value);
+
+  std::ostream &      m_Stream;
+  unsigned int        m_Precision;
+  std::streamsize     m_StreamPrecision;
+  std::vector< char > m_Block;
+  char *              m_Position;
+  char *              m_End;
+};
+} // end namespace itk
+
+#endif // __itkMeshNumberFormatter_h
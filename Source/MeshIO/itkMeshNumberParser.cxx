@@ -0,0 +1,820 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshNumberParser.cxx,v $
+  Language:  C++
+  Date:      $Date: 2010-09-27 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#include "itkMeshNumberParser.h"
+#include "itkMeshFileStreams.h"
+#include "itkIntTypes.h"
+
+#include <cmath>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace itk
+{
+namespace
+{
+inline bool IsSpace(char c)
+{
+  // ' ', '\t', '\n', '\v', '\f' and '\r', the white space of the classic locale
+  return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+inline bool IsDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+inline const char * SkipSpace(const char *position, const char *end)
+{
+  while ( position != end && IsSpace(*position) )
+    {
+    ++position;
+    }
+  return position;
+}
+
+/** Decimal number mantissa * 10^exponent, with at most MaximumDigits
+ * significant digits in the mantissa */
+struct Decimal
+{
+  enum { MaximumDigits = 19 };
+
+  bool               m_Negative;
+  unsigned long long m_Mantissa;
+  int                m_Digits;
+  int                m_Exponent;
+
+  /** Whether non zero digits were left out of the mantissa */
+  bool m_Truncated;
+};
+
+/** Scan the decimal number starting at begin, return its end or a null
+ * pointer when there is no number */
+const char * ScanDecimal(const char *begin, const char *end, Decimal & decimal)
+{
+  const char *position = begin;
+
+  decimal.m_Negative = false;
+  decimal.m_Mantissa = 0;
+  decimal.m_Digits = 0;
+  decimal.m_Exponent = 0;
+  decimal.m_Truncated = false;
+
+  if ( position != end && ( *position == '-' || *position == '+' ) )
+    {
+    decimal.m_Negative = ( *position == '-' );
+    ++position;
+    }
+
+  bool hasDigits = false;
+  for (; position != end && IsDigit(*position); ++position )
+    {
+    hasDigits = true;
+    if ( decimal.m_Digits < Decimal::MaximumDigits )
+      {
+      if ( decimal.m_Mantissa != 0 || *position != '0' )
+        {
+        decimal.m_Mantissa = decimal.m_Mantissa * 10 + ( *position - '0' );
+        decimal.m_Digits++;
+        }
+      }
+    else
+      {
+      decimal.m_Exponent++;
+      decimal.m_Truncated = decimal.m_Truncated || *position != '0';
+      }
+    }
+
+  if ( position != end && *position == '.' )
+    {
+    for ( ++position; position != end && IsDigit(*position); ++position )
+      {
+      hasDigits = true;
+      if ( decimal.m_Digits < Decimal::MaximumDigits )
+        {
+        if ( decimal.m_Mantissa != 0 || *position != '0' )
+          {
+          decimal.m_Mantissa = decimal.m_Mantissa * 10 + ( *position - '0' );
+          decimal.m_Digits++;
+          }
+        decimal.m_Exponent--;
+        }
+      else
+        {
+        decimal.m_Truncated = decimal.m_Truncated || *position != '0';
+        }
+      }
+    }
+
+  if ( !hasDigits )
+    {
+    return 0;
+    }
+
+  // An exponent without digits makes the number malformed, as operator>>
+  // fails on "1e" and "1e+" rather than reading 1
+  if ( position != end && ( *position == 'e' || *position == 'E' ) )
+    {
+    const char *exponentPosition = position + 1;
+    bool        negativeExponent = false;
+    if ( exponentPosition != end && ( *exponentPosition == '-' || *exponentPosition == '+' ) )
+      {
+      negativeExponent = ( *exponentPosition == '-' );
+      ++exponentPosition;
+      }
+
+    if ( exponentPosition != end && IsDigit(*exponentPosition) )
+      {
+      int exponent = 0;
+      for (; exponentPosition != end && IsDigit(*exponentPosition); ++exponentPosition )
+        {
+        // Far beyond the range of any floating point type
+        if ( exponent < 100000 )
+          {
+          exponent = exponent * 10 + ( *exponentPosition - '0' );
+          }
+        }
+      decimal.m_Exponent += negativeExponent ? -exponent : exponent;
+      position = exponentPosition;
+      }
+    else
+      {
+      return 0;
+      }
+    }
+
+  return position;
+}
+
+/** Unsigned integer large enough to hold the decimal numbers of the range of
+ * double, scaled to compare them exactly with a rounding boundary */
+class BigInteger
+{
+public:
+  explicit BigInteger(unsigned long long value):
+    m_Size(0),
+    m_Overflow(false)
+    {
+    while ( value != 0 )
+      {
+      m_Words[m_Size++] = static_cast< uint32_t >( value & 0xffffffffUL );
+      value >>= 32;
+      }
+    }
+
+  void MultiplyBy(uint32_t factor)
+    {
+    unsigned long long carry = 0;
+
+    for ( unsigned int i = 0; i < m_Size; i++ )
+      {
+      carry += static_cast< unsigned long long >( m_Words[i] ) * factor;
+      m_Words[i] = static_cast< uint32_t >( carry & 0xffffffffUL );
+      carry >>= 32;
+      }
+    if ( carry != 0 )
+      {
+      this->Append( static_cast< uint32_t >( carry ) );
+      }
+    }
+
+  void MultiplyByPowerOfFive(unsigned int exponent)
+    {
+    // 5^13 is the largest power of five of 32 bits
+    for (; exponent >= 13; exponent -= 13 )
+      {
+      this->MultiplyBy(1220703125UL);
+      }
+
+    uint32_t factor = 1;
+    for (; exponent > 0; exponent-- )
+      {
+      factor *= 5;
+      }
+    this->MultiplyBy(factor);
+    }
+
+  void ShiftLeft(unsigned int bits)
+    {
+    if ( m_Size == 0 || bits == 0 )
+      {
+      return;
+      }
+
+    const unsigned int words = bits / 32;
+    const unsigned int shift = bits % 32;
+    if ( m_Size + words + 1 > Capacity )
+      {
+      m_Overflow = true;
+      return;
+      }
+
+    m_Words[m_Size] = 0;
+    for ( unsigned int i = m_Size + 1; i > 0; i-- )
+      {
+      const unsigned int source = i - 1;
+      uint32_t           word = m_Words[source] << shift;
+      if ( shift != 0 && source > 0 )
+        {
+        word |= m_Words[source - 1] >> ( 32 - shift );
+        }
+      m_Words[source + words] = word;
+      }
+    for ( unsigned int i = 0; i < words; i++ )
+      {
+      m_Words[i] = 0;
+      }
+
+    m_Size += words + 1;
+    while ( m_Size > 0 && m_Words[m_Size - 1] == 0 )
+      {
+      m_Size--;
+      }
+    }
+
+  /** Return -1, 0 or 1 when this integer is less than, equal to or greater
+   * than the other one */
+  int Compare(const BigInteger & other) const
+    {
+    if ( m_Size != other.m_Size )
+      {
+      return m_Size < other.m_Size ? -1 : 1;
+      }
+    for ( unsigned int i = m_Size; i > 0; i-- )
+      {
+      if ( m_Words[i - 1] != other.m_Words[i - 1] )
+        {
+        return m_Words[i - 1] < other.m_Words[i - 1] ? -1 : 1;
+        }
+      }
+    return 0;
+    }
+
+  bool GetOverflow() const { return m_Overflow; }
+
+private:
+  void Append(uint32_t word)
+    {
+    if ( m_Size == Capacity )
+      {
+      m_Overflow = true;
+      return;
+      }
+    m_Words[m_Size++] = word;
+    }
+
+  // 1280 bits, the comparisons for double take less than 1000
+  enum { Capacity = 40 };
+
+  uint32_t     m_Words[Capacity];
+  unsigned int m_Size;
+  bool         m_Overflow;
+};
+
+/** Compare the decimal with boundary * 2^binaryExponent, set overflow when
+ * the numbers are too large to be compared */
+int CompareWithBoundary(const Decimal & decimal, unsigned long long boundary, int binaryExponent, bool & overflow)
+{
+  BigInteger decimalValue(decimal.m_Mantissa);
+  BigInteger boundaryValue(boundary);
+
+  // Cancel the powers of five of 10^exponent, then those of two
+  if ( decimal.m_Exponent >= 0 )
+    {
+    decimalValue.MultiplyByPowerOfFive(decimal.m_Exponent);
+    }
+  else
+    {
+    boundaryValue.MultiplyByPowerOfFive(-decimal.m_Exponent);
+    }
+
+  const int shift = decimal.m_Exponent - binaryExponent;
+  if ( shift > 0 )
+    {
+    decimalValue.ShiftLeft(shift);
+    }
+  else
+    {
+    boundaryValue.ShiftLeft(-shift);
+    }
+
+  overflow = decimalValue.GetOverflow() || boundaryValue.GetOverflow();
+  return decimalValue.Compare(boundaryValue);
+}
+
+/** Binary format of the floating point types. The numbers are
+ * significand * 2^exponent, with an integer significand of MantissaBits. */
+template< class T >
+struct FloatingPointFormat;
+
+template< >
+struct FloatingPointFormat< double >
+{
+  enum { MantissaBits = 53 };
+  enum { MinimumExponent = -1074 };
+  enum { MaximumExponent = 971 };
+
+  /** 10^n is exact for n <= MaximumExactPowerOfTen */
+  enum { MaximumExactPowerOfTen = 22 };
+
+  /** Numbers below 10^MinimumDecimalExponent round to zero, numbers of
+   * 10^(MaximumDecimalExponent + 1) and above overflow */
+  enum { MinimumDecimalExponent = -324 };
+  enum { MaximumDecimalExponent = 308 };
+};
+
+template< >
+struct FloatingPointFormat< float >
+{
+  enum { MantissaBits = 24 };
+  enum { MinimumExponent = -149 };
+  enum { MaximumExponent = 104 };
+  enum { MaximumExactPowerOfTen = 10 };
+  enum { MinimumDecimalExponent = -46 };
+  enum { MaximumDecimalExponent = 38 };
+};
+
+const double PowersOfTen[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** Convert with a single floating point operation, which is correctly
+ * rounded when both operands are exact (Clinger's fast path) */
+template< class T >
+bool ConvertExactly(unsigned long long mantissa, int exponent, T & value)
+{
+  typedef FloatingPointFormat< T > Format;
+
+  if ( mantissa > ( static_cast< unsigned long long >( 1 ) << Format::MantissaBits )
+       || exponent < -Format::MaximumExactPowerOfTen || exponent > Format::MaximumExactPowerOfTen )
+    {
+    return false;
+    }
+
+  const T significand = static_cast< T >( mantissa );
+  const T power = static_cast< T >( PowersOfTen[exponent < 0 ? -exponent : exponent] );
+  value = exponent < 0 ? significand / power : significand * power;
+  return true;
+}
+
+/** Floating point type of at least 64 bits of mantissa, when available,
+ * holding any mantissa exactly */
+template< class T >
+struct WiderFloatingPointType;
+
+template< >
+struct WiderFloatingPointType< float >
+{
+  typedef double Type;
+  enum { MantissaBits = 53 };
+  enum { MaximumExactPowerOfTen = 22 };
+};
+
+template< >
+struct WiderFloatingPointType< double >
+{
+  typedef long double Type;
+  enum { MantissaBits = std::numeric_limits< long double >::digits };
+  enum { MaximumExactPowerOfTen = ( std::numeric_limits< long double >::digits >= 64 ) ? 27 : -1 };
+};
+
+const long double ExtendedPowersOfTen[] = {
+  1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+  1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+  1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+/** Convert with a single exact operation in the wider type. Rounding its
+ * result again is only wrong when the result falls exactly half way between
+ * two numbers of the narrower type, which is detected. */
+template< class T >
+bool ConvertThroughWiderType(unsigned long long mantissa, int exponent, T & value)
+{
+  typedef WiderFloatingPointType< T > Wider;
+  typedef typename Wider::Type        WiderType;
+
+  const int mantissaBits = Wider::MantissaBits;
+  if ( ( mantissaBits < 64 && mantissa > ( static_cast< unsigned long long >( 1 ) << ( mantissaBits % 64 ) ) )
+       || exponent < -Wider::MaximumExactPowerOfTen || exponent > Wider::MaximumExactPowerOfTen )
+    {
+    return false;
+    }
+
+  const WiderType significand = static_cast< WiderType >( mantissa );
+  const WiderType power = static_cast< WiderType >( ExtendedPowersOfTen[exponent < 0 ? -exponent : exponent] );
+  const WiderType result = exponent < 0 ? significand / power : significand * power;
+
+  if ( result > static_cast< WiderType >( std::numeric_limits< T >::max() ) )
+    {
+    return false;
+    }
+
+  // The result is half way when its reflection about the nearest number of
+  // T is a number of T too
+  const T         nearest = static_cast< T >( result );
+  const WiderType reflection = 2 * result - static_cast< WiderType >( nearest );
+  if ( reflection != static_cast< WiderType >( nearest )
+       && static_cast< WiderType >( static_cast< T >( reflection ) ) == reflection )
+    {
+    return false;
+    }
+
+  value = nearest;
+  return true;
+}
+
+/** Convert by correcting an approximation, comparing the decimal with the
+ * boundaries half way to the neighbours of the candidate */
+template< class T >
+bool ConvertByComparison(const Decimal & decimal, T & value)
+{
+  typedef FloatingPointFormat< T > Format;
+
+  const unsigned long long hiddenBit = static_cast< unsigned long long >( 1 ) << ( Format::MantissaBits - 1 );
+
+  // Within a few units in the last place with an extended long double, the
+  // candidate may only need a step or two
+  const long double approximation =
+    static_cast< long double >( decimal.m_Mantissa ) * std::pow(10.0L, decimal.m_Exponent);
+  if ( !( approximation <= std::numeric_limits< long double >::max() ) )
+    {
+    return false;
+    }
+
+  int binaryExponent = 0;
+  std::frexp(approximation, &binaryExponent);
+  int exponent = binaryExponent - Format::MantissaBits;
+  if ( exponent < Format::MinimumExponent )
+    {
+    exponent = Format::MinimumExponent;
+    }
+  unsigned long long significand =
+    static_cast< unsigned long long >( std::floor(std::ldexp(approximation, -exponent) + 0.5L) );
+  if ( significand == 2 * hiddenBit )
+    {
+    significand = hiddenBit;
+    exponent++;
+    }
+
+  for ( unsigned int step = 0; step < 8; step++ )
+    {
+    if ( exponent > Format::MaximumExponent )
+      {
+      return false;
+      }
+
+    // Ties go to the even significand
+    bool overflow = false;
+    int  comparison = CompareWithBoundary(decimal, 2 * significand + 1, exponent - 1, overflow);
+    if ( overflow )
+      {
+      return false;
+      }
+    if ( comparison > 0 || ( comparison == 0 && ( significand & 1 ) ) )
+      {
+      if ( ++significand == 2 * hiddenBit )
+        {
+        significand = hiddenBit;
+        exponent++;
+        }
+      continue;
+      }
+
+    if ( significand > 0 )
+      {
+      // Below a power of two, the neighbour is half as far
+      const bool powerOfTwo = ( significand == hiddenBit && exponent > Format::MinimumExponent );
+      comparison = powerOfTwo
+                   ? CompareWithBoundary(decimal, 4 * significand - 1, exponent - 2, overflow)
+                   : CompareWithBoundary(decimal, 2 * significand - 1, exponent - 1, overflow);
+      if ( overflow )
+        {
+        return false;
+        }
+      if ( comparison < 0 || ( comparison == 0 && ( significand & 1 ) ) )
+        {
+        if ( powerOfTwo )
+          {
+          significand = 2 * hiddenBit - 1;
+          exponent--;
+          }
+        else
+          {
+          significand--;
+          }
+        continue;
+        }
+      }
+
+    value = std::ldexp(static_cast< T >( significand ), exponent);
+    return true;
+    }
+
+  return false;
+}
+
+/** Convert a decimal of at most MaximumDigits digits, not out of range */
+template< class T >
+bool Convert(const Decimal & decimal, T & value)
+{
+  return ConvertExactly(decimal.m_Mantissa, decimal.m_Exponent, value)
+         || ConvertThroughWiderType(decimal.m_Mantissa, decimal.m_Exponent, value)
+         || ConvertByComparison(decimal, value);
+}
+
+/** Parse with the streams of the classic locale */
+template< class T >
+bool ParseWithStream(const char *begin, const char *end, T & value)
+{
+  std::istringstream inputStream( std::string(begin, end) );
+
+  inputStream.imbue( std::locale::classic() );
+  inputStream >> value;
+  return !inputStream.fail();
+}
+
+template< class T >
+const char * ParseFloatingPoint(const char *begin, const char *end, T & value)
+{
+  typedef FloatingPointFormat< T > Format;
+
+  const char *start = SkipSpace(begin, end);
+  Decimal     decimal;
+  const char *next = ScanDecimal(start, end, decimal);
+  if ( next == 0 )
+    {
+    return 0;
+    }
+
+  const int magnitude = decimal.m_Exponent + decimal.m_Digits;
+  if ( decimal.m_Mantissa == 0 || magnitude <= Format::MinimumDecimalExponent )
+    {
+    value = decimal.m_Negative ? -static_cast< T >( 0 ) : static_cast< T >( 0 );
+    return next;
+    }
+  if ( magnitude - 1 > Format::MaximumDecimalExponent )
+    {
+    return 0;
+    }
+
+  T converted = 0;
+  if ( !decimal.m_Truncated )
+    {
+    if ( !Convert(decimal, converted) )
+      {
+      return ParseWithStream(start, next, value) ? next : 0;
+      }
+    }
+  else
+    {
+    // The number lies strictly between the truncated mantissa and the next
+    // one, its rounding is known when theirs are the same
+    Decimal above = decimal;
+    above.m_Mantissa++;
+    T convertedAbove = 0;
+    if ( !Convert(decimal, converted) || !Convert(above, convertedAbove) || converted != convertedAbove )
+      {
+      return ParseWithStream(start, next, value) ? next : 0;
+      }
+    }
+
+  value = decimal.m_Negative ? -converted : converted;
+  return next;
+}
+
+template< class T >
+const char * ParseInteger(const char *begin, const char *end, T & value)
+{
+  const char *position = SkipSpace(begin, end);
+  bool        negative = false;
+
+  if ( position != end && ( *position == '-' || *position == '+' ) )
+    {
+    negative = ( *position == '-' );
+    ++position;
+    }
+  if ( position == end || !IsDigit(*position) )
+    {
+    return 0;
+    }
+
+  // The magnitude of the minimum of the signed types is one more than their
+  // maximum. Negative numbers wrap around for unsigned types, as with the
+  // streams.
+  unsigned long long limit = static_cast< unsigned long long >( std::numeric_limits< T >::max() );
+  if ( negative && std::numeric_limits< T >::is_signed )
+    {
+    limit++;
+    }
+
+  unsigned long long magnitude = 0;
+  bool               overflow = false;
+  for (; position != end && IsDigit(*position); ++position )
+    {
+    const unsigned int digit = *position - '0';
+    if ( magnitude > ( limit - digit ) / 10 )
+      {
+      overflow = true;
+      }
+    else
+      {
+      magnitude = magnitude * 10 + digit;
+      }
+    }
+  if ( overflow )
+    {
+    return 0;
+    }
+
+  if ( !negative || magnitude == 0 )
+    {
+    value = static_cast< T >( magnitude );
+    }
+  else if ( std::numeric_limits< T >::is_signed )
+    {
+    value = static_cast< T >( -static_cast< T >( magnitude - 1 ) - 1 );
+    }
+  else
+    {
+    value = static_cast< T >( 0 - magnitude );
+    }
+  return position;
+}
+
+/** Read numbers straight from the memory of a MemoryStreamBuffer, following
+ * the state changes of operator>> */
+template< class T >
+void ReadNumbers(std::istream & inputStream, T *buffer, std::size_t numberOfValues)
+{
+  MemoryStreamBuffer *memoryBuffer = dynamic_cast< MemoryStreamBuffer * >( inputStream.rdbuf() );
+
+  if ( memoryBuffer == 0 )
+    {
+    for ( std::size_t i = 0; i < numberOfValues; i++ )
+      {
+      inputStream >> buffer[i];
+      }
+    return;
+    }
+
+  if ( numberOfValues == 0 )
+    {
+    return;
+    }
+  if ( !inputStream.good() )
+    {
+    inputStream.setstate(std::ios::failbit);
+    return;
+    }
+
+  const char *        begin = memoryBuffer->GetCurrent();
+  const char *        end = memoryBuffer->GetEnd();
+  const char *        position = begin;
+  std::ios::iostate   state = std::ios::goodbit;
+  for ( std::size_t i = 0; i < numberOfValues; i++ )
+    {
+    const char *next = MeshNumberParser::Parse(position, end, buffer[i]);
+    if ( next == 0 )
+      {
+      position = SkipSpace(position, end);
+      state |= std::ios::failbit;
+      break;
+      }
+
+    position = next;
+    if ( position == end )
+      {
+      // Looking past the number hit the end, the next number cannot be read
+      state |= ( i + 1 < numberOfValues ) ? std::ios::failbit : std::ios::goodbit;
+      break;
+      }
+    }
+  if ( position == end )
+    {
+    state |= std::ios::eofbit;
+    }
+
+  memoryBuffer->Consume(position - begin);
+  if ( state != std::ios::goodbit )
+    {
+    inputStream.setstate(state);
+    }
+}
+} // end namespace
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, float & value)
+{
+  return ParseFloatingPoint(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, double & value)
+{
+  return ParseFloatingPoint(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, short & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, unsigned short & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, int & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, unsigned int & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, long & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, unsigned long & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, long long & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+const char * MeshNumberParser::Parse(const char *begin, const char *end, unsigned long long & value)
+{
+  return ParseInteger(begin, end, value);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, float *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, double *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, short *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, unsigned short *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, int *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, unsigned int *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, long *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, unsigned long *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, long long *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+
+void MeshNumberParser::Read(std::istream & inputStream, unsigned long long *buffer, std::size_t numberOfValues)
+{
+  ReadNumbers(inputStream, buffer, numberOfValues);
+}
+} // end namespace itk
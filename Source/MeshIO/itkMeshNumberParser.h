@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkMeshNumberParser.h,v $
+  Language:  C++
+  Date:      $Date: 2010-09-27 00:00:00 $
+  Version:   $Revision: 0.01 $
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkMeshNumberParser_h
+#define __itkMeshNumberParser_h
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <istream>
+
+namespace itk
+{
+/** \class MeshNumberParser
+ * \brief Locale free parser of the numbers of ASCII mesh files.
+ *
+ * Parse() scans a decimal number in memory, after skipping white space,
+ * and accepts what operator>> of the streams accepts in the classic
+ * locale: an optional sign, digits and, for floating point numbers, a
+ * fraction and an exponent. An exponent marker without digits fails, like
+ * operator>>, and the number ends at the first character that cannot
+ * continue it. Floating point numbers are correctly rounded: the usual
+ * decimals are converted with a single exact floating point operation, in
+ * a wider type when needed, and the others are corrected by comparing them
+ * to the rounding boundaries with big integers.
+ *
+ * Read() reads numbers from a stream like operator>>, but parses them
+ * straight from memory when the stream reads a MemoryStreamBuffer, as
+ * MeshInputFileStream does. Other streams, and the character types which
+ * operator>> reads as characters, are read with operator>>.
+ *
+ * \ingroup IOFilters
+ */
+class ITK_EXPORT MeshNumberParser
+{
+public:
+  /** Parse the number starting at the first non white space character of
+   * [begin, end). Return the end of the number, or a null pointer when
+   * there is no number, it is malformed or it is out of the range of the
+   * type. Floating point numbers below the smallest denormal read as zeros
+   * of their sign. */
+  static const char * Parse(const char *begin, const char *end, float & value);
+
+  static const char * Parse(const char *begin, const char *end, double & value);
+
+  static const char * Parse(const char *begin, const char *end, short & value);
+
+  static const char * Parse(const char *begin, const char *end, unsigned short & value);
+
+  static const char * Parse(const char *begin, const char *end, int & value);
+
+  static const char * Parse(const char *begin, const char *end, unsigned int & value);
+
+  static const char * Parse(const char *begin, const char *end, long & value);
+
+  static const char * Parse(const char *begin, const char *end, unsigned long & value);
+
+  static const char * Parse(const char *begin, const char *end, long long & value);
+
+  static const char * Parse(const char *begin, const char *end, unsigned long long & value);
+
+  /** Read numberOfValues numbers from a stream, setting its failbit when
+   * one of them cannot be read, like operator>>. */
+  template< class T >
+  static void Read(std::istream & inputStream, T *buffer, std::size_t numberOfValues)
+    {
+    for ( std::size_t i = 0; i < numberOfValues; i++ )
+      {
+      inputStream >> buffer[i];
+      }
+    }
+
+  static void Read(std::istream & inputStream, float *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, double *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, short *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, unsigned short *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, int *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, unsigned int *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, long *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, unsigned long *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, long long *buffer, std::size_t numberOfValues);
+
+  static void Read(std::istream & inputStream, unsigned long long *buffer, std::size_t numberOfValues);
+
+  /** Read a single number from a stream */
+  template< class T >
+  static void Read(std::istream & inputStream, T & value)
+    {
+    Read(inputStream, &value, 1);
+    }
+};
+} // end namespace itk
+
+#endif // __itkMeshNumberParser_h
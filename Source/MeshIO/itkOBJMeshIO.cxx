@@ -33,29 +33,60 @@
 
 namespace itk
 {
+namespace
+{
+/** Parse the numbers following the type of a line. Like the streams, the
+ * values after the first one which cannot be read are left unchanged. */
+void ParseLineValues(const std::string & line, float *buffer, unsigned int numberOfValues)
+{
+  const char *position = line.c_str();
+  const char *end = position + line.size();
+
+  for ( unsigned int ii = 0; ii < numberOfValues && position != 0; ii++ )
+    {
+    position = MeshNumberParser::Parse(position, end, buffer[ii]);
+    }
+}
+} // end namespace
+
 OBJMeshIO::OBJMeshIO()
 {
   this->AddSupportedWriteExtension(".obj");
+  this->AddSupportedReadExtension(".obj");
 }
 
-bool OBJMeshIO::CanReadFile(const char *fileName)
+unsigned int OBJMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
+  // Skip the comments and blank lines before the first statement
+  std::string::size_type begin = header.find_first_not_of(" \t\r\n");
+  while ( begin != std::string::npos && header[begin] == '#' )
     {
-    return false;
+    const std::string::size_type lineEnd = header.find('\n', begin);
+    begin = lineEnd == std::string::npos ? lineEnd : header.find_first_not_of(" \t\r\n", lineEnd);
     }
 
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".obj" )
+  const std::string::size_type end = header.find_first_of(" \t", begin);
+  if ( begin == std::string::npos || end == std::string::npos )
     {
-    return false;
+    return 0;
     }
 
-  return true;
+  const std::string keyword = header.substr(begin, end - begin);
+  const char *      keywords[] = { "v", "vn", "vt", "vp", "f", "l", "p", "o", "g", "s", "mtllib", "usemtl" };
+  for ( unsigned int ii = 0; ii < sizeof( keywords ) / sizeof( keywords[0] ); ii++ )
+    {
+    if ( keyword == keywords[ii] )
+      {
+      return 30;
+      }
+    }
+
+  return 0;
 }
 
 bool OBJMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".obj" )
+  if ( this->GetFileNameExtension(fileName) != ".obj" )
     {
     return false;
     }
@@ -65,38 +96,11 @@ bool OBJMeshIO::CanWriteFile(const char *fileName)
 
 void OBJMeshIO::OpenFile()
 {
-  if ( this->m_FileName.empty() )
-    {
-    itkExceptionMacro("No input FileName");
-    }
-
-  if ( !itksys::SystemTools::FileExists( m_FileName.c_str() ) )
-    {
-    itkExceptionMacro("File " << this->m_FileName << " does not exist");
-    }
-
-  // Read file as ascii
-  // Due to the windows couldn't work well for tellg() and seekg() for ASCII mode, hence we
-  //open the file with std::ios::binary 
-#ifdef _WIN32
-  m_InputFile.open(this->m_FileName.c_str(), std::ios_base::in | std::ios::binary);
-#else
-  m_InputFile.open(this->m_FileName.c_str(), std::ios_base::in);
-#endif
-
-  // Test whether the file was opened
-  if ( !m_InputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file " << this->m_FileName);
-    }
-
-  // If not set to start of file stream, windows won't work properly
-  m_InputFile.seekg(0, std::ios::beg);
-
-  return;
+  // FileName, or the input buffer or stream set in its place
+  this->OpenInputFile(m_InputFile);
 }
 
-void OBJMeshIO::CloseFile()
+void OBJMeshIO::CloseInputFile()
 {
   if ( m_InputFile.is_open() )
     {
@@ -106,11 +110,16 @@ void OBJMeshIO::CloseFile()
 
 void OBJMeshIO::ReadMeshInformation()
 {
-  // Define input file stream and attach it to input file
+  // Define input file stream and attach it to input file, which stays open
+  // for the reads of the sections
   OpenFile();
 
+  // Count the points and cells afresh when the file is read again
+  this->m_NumberOfPoints = 0;
+  this->m_NumberOfCells = 0;
+
   // Read and analyze the first line in the file
-  unsigned long numberOfCellPoints = 0;
+  SizeValueType numberOfCellPoints = 0;
   std::string   line;
   std::string   inputLine;
   std::string   type;
@@ -192,25 +201,25 @@ void OBJMeshIO::ReadMeshInformation()
   this->m_CellPixelType  = SCALAR;
   this->m_NumberOfCellPixelComponents = itk::NumericTraits< unsigned int >::One;
   this->m_UpdateCellData = false;
-
-  CloseFile();
 }
 
 void OBJMeshIO::ReadPoints(void *buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the sections may be read concurrently
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
   // Number of data array
   float *       data = static_cast< float * >( buffer );
-  unsigned long index = 0;
+  SizeValueType index = 0;
 
   // Read and analyze the first line in the file
   std::string line;
   std::string inputLine;
   std::string type;
   std::locale loc;
-  while ( std::getline(m_InputFile, line, '\n') )
+  while ( std::getline(inputFile, line, '\n') )
     {
     inputLine.clear();
     for ( unsigned int ii = 0; ii < line.size(); ii++ )
@@ -227,34 +236,31 @@ void OBJMeshIO::ReadPoints(void *buffer)
       {
       if ( type == "v" )
         {
-        std::stringstream ss(inputLine);
-        for ( unsigned int ii = 0; ii < this->m_PointDimension; ii++ )
-          {
-          ss >> data[index++];
-          }
+        ParseLineValues(inputLine, data + index, this->m_PointDimension);
+        index += this->m_PointDimension;
         }
       }
     }
 
-  CloseFile();
-
   return;
 }
 
 void OBJMeshIO::ReadCells(void *buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the sections may be read concurrently
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
   // Read and analyze the first line in the file
   long *        data = new long[this->m_CellBufferSize - this->m_NumberOfCells];
-  unsigned long index = 0;
+  SizeValueType index = 0;
 
   std::string line;
   std::string inputLine;
   std::string type;
   std::locale loc;
-  while ( std::getline(m_InputFile, line, '\n') )
+  while ( std::getline(inputFile, line, '\n') )
     {
     inputLine.clear();
     for ( unsigned int ii = 0; ii < line.size(); ii++ )
@@ -271,23 +277,19 @@ void OBJMeshIO::ReadCells(void *buffer)
       {
       if ( type == "f" )
         {
-        std::stringstream   ss(inputLine);
-        std::string         item;
+        const char *        position = inputLine.c_str();
+        const char *        end = position + inputLine.size();
+        long                id = 0;
         std::vector< long > idList;
-        while ( ss >> item )
+        while ( ( position = MeshNumberParser::Parse(position, end, id) ) != 0 )
           {
-          long                   id;
-          std::string::size_type pos = item.find('/');
-          while ( pos != std::string::npos )
+          idList.push_back(id);
+
+          // Skip the texture and normal indices of "v/vt/vn"
+          while ( position != end && !std::isspace(*position, loc) )
             {
-            item.replace(pos, 1, " ");
-            pos = item.find('/', pos);
+            ++position;
             }
-
-          std::stringstream st(item);
-          st >> id;
-
-          idList.push_back(id);
           }
 
         data[index++] = idList.size();
@@ -299,8 +301,6 @@ void OBJMeshIO::ReadCells(void *buffer)
       }
     }
 
-  CloseFile();
-
   this->WriteCellsBuffer(data, static_cast< long * >( buffer ), POLYGON_CELL, this->m_NumberOfCells);
   //this->WriteCellsBuffer(data, static_cast<unsigned int *>(buffer),
   // TRIANGLE_CELL, 3, this->m_NumberOfCells);
@@ -311,19 +311,21 @@ void OBJMeshIO::ReadCells(void *buffer)
 
 void OBJMeshIO::ReadPointData(void *buffer)
 {
-  // Define input file stream and attach it to input file
-  OpenFile();
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the sections may be read concurrently
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
   // Number of data array
   float *       data = static_cast< float * >( buffer );
-  unsigned long index = 0;
+  SizeValueType index = 0;
 
   // Read and analyze the first line in the file
   std::string line;
   std::string inputLine;
   std::string type;
   std::locale loc;
-  while ( std::getline(m_InputFile, line, '\n') )
+  while ( std::getline(inputFile, line, '\n') )
     {
     inputLine.clear();
     for ( unsigned int ii = 0; ii < line.size(); ii++ )
@@ -340,17 +342,12 @@ void OBJMeshIO::ReadPointData(void *buffer)
       {
       if ( type == "vn" )
         {
-        std::stringstream ss(inputLine);
-        for ( unsigned int ii = 0; ii < this->m_PointDimension; ii++ )
-          {
-          ss >> data[index++];
-          }
+        ParseLineValues(inputLine, data + index, this->m_PointDimension);
+        index += this->m_PointDimension;
         }
       }
     }
 
-  CloseFile();
-
   return;
 }
 
@@ -362,131 +359,109 @@ void OBJMeshIO::ReadCellData(void *buffer)
 void OBJMeshIO::WriteMeshInformation()
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Define output stream and open it
-  std::ofstream outputFile;
-  outputFile.open( this->m_FileName.c_str() );
-
-  // Test whether input file was opened successfuly
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  // The output file stays open until Write()
+  this->OpenOutputFile();
 
   // write comments
-  outputFile << "# OBJ file generated by ITK\n";
+  m_OutputFile << "# OBJ file generated by ITK\n";
 
   // Write the number of points and number of cells
-  outputFile << "#  Number of points " << this->m_NumberOfPoints << "\n";
-  outputFile << "#  Number of cells " << this->m_NumberOfCells << "\n";
-  outputFile.close();
+  m_OutputFile << "#  Number of points " << this->m_NumberOfPoints << "\n";
+  m_OutputFile << "#  Number of cells " << this->m_NumberOfCells << "\n";
 }
 
 void OBJMeshIO::WritePoints(void *buffer)
 {
-  // Check file name 
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Define output stream and open it
-  std::ofstream outputFile;
-  outputFile.open(this->m_FileName.c_str(), std::ios_base::app);
-
-  // Test whether input file was opened successfuly
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(POINTS_SECTION);
+  this->WritePointsChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTS_SECTION);
+}
 
+void OBJMeshIO::WritePointsChunk(void *buffer, SizeValueType numberOfPoints)
+{
   // Write points
   switch ( this->m_PointComponentType )
     {
     case UCHAR:
       {
-      WritePoints(static_cast< unsigned char * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints);
       break;
       }
     case CHAR:
       {
-      WritePoints(static_cast< char * >( buffer ), outputFile);
+      WritePoints(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case USHORT:
       {
-      WritePoints(static_cast< unsigned short * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case SHORT:
       {
-      WritePoints(static_cast< short * >( buffer ), outputFile);
+      WritePoints(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case UINT:
       {
-      WritePoints(static_cast< unsigned int * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case INT:
       {
-      WritePoints(static_cast< int * >( buffer ), outputFile);
+      WritePoints(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONG:
       {
-      WritePoints(static_cast< unsigned long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONG:
       {
-      WritePoints(static_cast< long * >( buffer ), outputFile);
+      WritePoints(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePoints(static_cast< unsigned long long * >( buffer ), outputFile);
+      WritePoints(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONGLONG:
       {
-      WritePoints(static_cast< long long * >( buffer ), outputFile);
+      WritePoints(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case FLOAT:
       {
-      WritePoints(static_cast< float * >( buffer ), outputFile);
+      WritePoints(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case DOUBLE:
       {
-      WritePoints(static_cast< double * >( buffer ), outputFile);
+      WritePoints(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePoints(static_cast< long double * >( buffer ), outputFile);
+      WritePoints(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
@@ -495,98 +470,82 @@ void OBJMeshIO::WritePoints(void *buffer)
       itkExceptionMacro(<< "Unknown point component type" << std::endl);
       }
     }
-
-  outputFile.close();
-
-  return;
 }
 
 void OBJMeshIO::WriteCells(void *buffer)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Define output stream and open it
-  std::ofstream outputFile;
-  outputFile.open(this->m_FileName.c_str(), std::ios_base::app);
-
-  // Test whether input file was opened successfuly
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(CELLS_SECTION);
+  this->WriteCellsChunk(buffer, this->m_NumberOfCells);
+  this->EndWriteSection(CELLS_SECTION);
+}
 
+void OBJMeshIO::WriteCellsChunk(void *buffer, SizeValueType numberOfCells)
+{
   switch ( this->m_CellComponentType )
     {
     case UCHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case CHAR:
       {
-      WriteCells(static_cast< unsigned char * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case USHORT:
       {
-      WriteCells(static_cast< unsigned short * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case SHORT:
       {
-      WriteCells(static_cast< short * >( buffer ), outputFile);
+      WriteCells(static_cast< short * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case UINT:
       {
-      WriteCells(static_cast< unsigned int * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case INT:
       {
-      WriteCells(static_cast< int * >( buffer ), outputFile);
+      WriteCells(static_cast< int * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONG:
       {
-      WriteCells(static_cast< unsigned long * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LONG:
       {
-      WriteCells(static_cast< long * >( buffer ), outputFile);
+      WriteCells(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case ULONGLONG:
       {
-      WriteCells(static_cast< unsigned long long * >( buffer ), outputFile);
+      WriteCells(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LONGLONG:
       {
-      WriteCells(static_cast< long long * >( buffer ), outputFile);
+      WriteCells(static_cast< long long * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case FLOAT:
       {
-      WriteCells(static_cast< float * >( buffer ), outputFile);
+      WriteCells(static_cast< float * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case DOUBLE:
       {
-      WriteCells(static_cast< double * >( buffer ), outputFile);
+      WriteCells(static_cast< double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     case LDOUBLE:
       {
-      WriteCells(static_cast< long double * >( buffer ), outputFile);
+      WriteCells(static_cast< long double * >( buffer ), m_OutputFile, numberOfCells);
       break;
       }
     default:
@@ -594,13 +553,16 @@ void OBJMeshIO::WriteCells(void *buffer)
       itkExceptionMacro(<< "Unknown cell component type" << std::endl);
       }
     }
-
-  outputFile.close();
-
-  return;
 }
 
 void OBJMeshIO::WritePointData(void *buffer)
+{
+  this->BeginWriteSection(POINTDATA_SECTION);
+  this->WritePointDataChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTDATA_SECTION);
+}
+
+void OBJMeshIO::WritePointDataChunk(void *buffer, SizeValueType numberOfPoints)
 {
   // Point data must be vector
   if ( !m_UpdatePointData || m_NumberOfPointPixelComponents != m_PointDimension )
@@ -608,102 +570,83 @@ void OBJMeshIO::WritePointData(void *buffer)
     itkExceptionMacro(<< "MNI Mesh required point normals");
     }
 
-  // Check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Define output stream and open it
-  std::ofstream outputFile;
-  outputFile.open(this->m_FileName.c_str(), std::ios_base::app);
-
-  // Test whether input file was opened successfuly
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
-
   // Write point data
   switch ( this->m_PointPixelComponentType )
     {
     case UCHAR:
       {
-      WritePointData(static_cast< unsigned char * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints);
       break;
       }
     case CHAR:
       {
-      WritePointData(static_cast< char * >( buffer ), outputFile);
+      WritePointData(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case USHORT:
       {
-      WritePointData(static_cast< unsigned short * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case SHORT:
       {
-      WritePointData(static_cast< short * >( buffer ), outputFile);
+      WritePointData(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case UINT:
       {
-      WritePointData(static_cast< unsigned int * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case INT:
       {
-      WritePointData(static_cast< int * >( buffer ), outputFile);
+      WritePointData(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONG:
       {
-      WritePointData(static_cast< unsigned long * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONG:
       {
-      WritePointData(static_cast< long * >( buffer ), outputFile);
+      WritePointData(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case ULONGLONG:
       {
-      WritePointData(static_cast< unsigned long long * >( buffer ), outputFile);
+      WritePointData(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LONGLONG:
       {
-      WritePointData(static_cast< long long * >( buffer ), outputFile);
+      WritePointData(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case FLOAT:
       {
-      WritePointData(static_cast< float * >( buffer ), outputFile);
+      WritePointData(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case DOUBLE:
       {
-      WritePointData(static_cast< double * >( buffer ), outputFile);
+      WritePointData(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
     case LDOUBLE:
       {
-      WritePointData(static_cast< long double * >( buffer ), outputFile);
+      WritePointData(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints);
 
       break;
       }
@@ -712,19 +655,22 @@ void OBJMeshIO::WritePointData(void *buffer)
       itkExceptionMacro(<< "Unknown point data pixel component type" << std::endl);
       }
     }
+}
 
-  outputFile.close();
-
+void OBJMeshIO::WriteCellData(void *buffer)
+{
   return;
 }
 
-void OBJMeshIO::WriteCellData(void *buffer)
+void OBJMeshIO::WriteCellDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
 {
   return;
 }
 
 void OBJMeshIO::Write()
-{}
+{
+  this->CloseOutputFile();
+}
 
 void OBJMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -52,12 +52,9 @@ public:
 
   /*-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-  * \param FileNameToRead The name of the file to test for reading.
-  * \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-  * \return Returns true if this MeshIO can read the file specified.
-  */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: OBJ files have no magic number, a first
+   * statement which is an OBJ keyword scores 30 */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
@@ -71,6 +68,10 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine if the file can be written with this MeshIO implementation.
@@ -95,58 +96,72 @@ public:
 
   virtual void Write();
 
+  /** OBJ files are written chunk by chunk, cell data is ignored */
+  virtual bool CanStreamWrite() { return true; }
+
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
 protected:
   /** Write points to output stream */
   template< typename T >
-  void WritePoints(T *buffer, std::ofstream & outputFile)
+  void WritePoints(T *buffer, std::ostream & outputFile, SizeValueType numberOfPoints)
     {
-    unsigned long index = itk::NumericTraits< unsigned long >::Zero;
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = itk::NumericTraits< SizeValueType >::Zero;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+    for ( SizeValueType ii = 0; ii < numberOfPoints; ii++ )
       {
-      outputFile << "v ";
+      formatter << "v ";
       for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
         {
-        outputFile << buffer[index++] << "  ";
+        formatter << buffer[index++] << "  ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
   template< typename T >
-  void WriteCells(T *buffer, std::ofstream & outputFile)
+  void WriteCells(T *buffer, std::ostream & outputFile, SizeValueType numberOfCells)
     {
-    unsigned long index = itk::NumericTraits< unsigned long >::Zero;
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = itk::NumericTraits< SizeValueType >::Zero;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
-      outputFile << "f ";
+      formatter << "f ";
       index++;
       unsigned int numberOfCellPoints = static_cast< unsigned int >( buffer[index++] );
 
       for ( unsigned int jj = 0; jj < numberOfCellPoints; jj++ )
         {
-        outputFile << buffer[index++] + 1 << "  ";
+        formatter << buffer[index++] + 1 << "  ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
   /** Write point data to output stream */
   template< typename T >
-  void WritePointData(T *buffer, std::ofstream & outputFile)
+  void WritePointData(T *buffer, std::ostream & outputFile, SizeValueType numberOfPoints)
     {
-    unsigned long index = itk::NumericTraits< unsigned long >::Zero;
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = itk::NumericTraits< SizeValueType >::Zero;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+    for ( SizeValueType ii = 0; ii < numberOfPoints; ii++ )
       {
-      outputFile << "vn ";
+      formatter << "vn ";
       for ( unsigned int jj = 0; jj < this->m_PointDimension; jj++ )
         {
-        outputFile << buffer[index++] << "  ";
+        formatter << buffer[index++] << "  ";
         }
 
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
@@ -158,14 +173,12 @@ protected:
 
   void OpenFile();
 
-  void CloseFile();
-
 private:
   OBJMeshIO(const Self &);      // purposely not implemented
   void operator=(const Self &); // purposely not implemented
 
-  std::ifstream  m_InputFile;
-  std::streampos m_PointsStartPosition;  // file position for points rlative to std::ios::beg
+  MeshInputFileStream m_InputFile;
+  std::streampos      m_PointsStartPosition;  // file position for points rlative to std::ios::beg
 };
 } // end namespace itk
 
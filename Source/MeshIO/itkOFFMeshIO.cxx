@@ -35,29 +35,37 @@ namespace itk
 OFFMeshIO::OFFMeshIO()
 {
   this->AddSupportedWriteExtension(".off");
+  this->AddSupportedReadExtension(".off");
   this->SetByteOrderToBigEndian();
   m_PointsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
+  m_CellsStartPosition = itk::NumericTraits< StreamOffsetType >::Zero;
   m_TriangleCellType = true;
 }
 
-bool OFFMeshIO::CanReadFile(const char *fileName)
+unsigned int OFFMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
+  const std::string::size_type begin = header.find_first_not_of(" \t\r\n");
+  if ( begin == std::string::npos )
     {
-    return false;
+    return 0;
     }
 
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".off" )
+  const std::string::size_type end = header.find_first_of(" \t\r\n", begin);
+  const std::string            keyword =
+    end == std::string::npos ? header.substr(begin) : header.substr(begin, end - begin);
+
+  if ( keyword.size() < 3 || keyword.compare(keyword.size() - 3, 3, "OFF") != 0
+       || keyword.find_first_not_of("STCN4n") != keyword.size() - 3 )
     {
-    return false;
+    return 0;
     }
 
-  return true;
+  return 100;
 }
 
 bool OFFMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".off" )
+  if ( this->GetFileNameExtension(fileName) != ".off" )
     {
     return false;
     }
@@ -67,35 +75,11 @@ bool OFFMeshIO::CanWriteFile(const char *fileName)
 
 void OFFMeshIO::OpenFile()
 {
-  if ( this->m_FileName.empty() )
-    {
-    itkExceptionMacro("No input FileName");
-    }
-
-  if ( !itksys::SystemTools::FileExists( m_FileName.c_str() ) )
-    {
-    itkExceptionMacro("File " << this->m_FileName << " does not exist");
-    }
-
-  // Read file as ascii
-  // Due to the windows doesn't work well for tellg() and seekg() for ASCII mode, hence we
-  //open the file with std::ios::binary 
-#ifdef _WIN32
-  m_InputFile.open(this->m_FileName.c_str(), std::ios_base::in | std::ios::binary);
-#else
-  m_InputFile.open(this->m_FileName.c_str(), std::ios_base::in);
-#endif
-
-  // Test whether the file was opened
-  if ( !m_InputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file " << this->m_FileName);
-    }
-
-  return;
+  // FileName, or the input buffer or stream set in its place
+  this->OpenInputFile(m_InputFile);
 }
 
-void OFFMeshIO::CloseFile()
+void OFFMeshIO::CloseInputFile()
 {
   if ( m_InputFile.is_open() )
     {
@@ -107,6 +91,8 @@ void OFFMeshIO::ReadMeshInformation()
 {
   // Define input file stream and attach it to input file
   OpenFile();
+  this->ResetSectionLayouts();
+  m_TriangleCellType = true;
 
   // Read and analyze the first line in the file 
   std::string line;
@@ -131,7 +117,7 @@ void OFFMeshIO::ReadMeshInformation()
   // Read and Set point dimension
   if ( line.find("nOFF") != std::string::npos )
     {
-    m_InputFile >> this->m_PointDimension;
+    MeshNumberParser::Read(m_InputFile, this->m_PointDimension);
     m_PointDimension++;
     }
   else if ( line.find("4OFF") != std::string::npos )
@@ -170,19 +156,20 @@ void OFFMeshIO::ReadMeshInformation()
     // Read points start position in the file
     m_PointsStartPosition = m_InputFile.tellg();
 
-    for ( unsigned long id = 0; id < this->m_NumberOfPoints; id++ )
+    for ( SizeValueType id = 0; id < this->m_NumberOfPoints; id++ )
       {
       std::getline(m_InputFile, line, '\n');
       }
+    m_CellsStartPosition = m_InputFile.tellg();
 
     // Set default cell component type 
     this->m_CellBufferSize = this->m_NumberOfCells * 2;
 
     //Read each ecll's number of points and put them to cell buffer size
     unsigned int numberOfCellPoints = 0;
-    for ( unsigned long id = 0; id < this->m_NumberOfCells; id++ )
+    for ( SizeValueType id = 0; id < this->m_NumberOfCells; id++ )
       {
-      m_InputFile >> numberOfCellPoints;
+      MeshNumberParser::Read(m_InputFile, numberOfCellPoints);
       this->m_CellBufferSize += numberOfCellPoints;
       std::getline(m_InputFile, line, '\n');
 
@@ -211,36 +198,45 @@ void OFFMeshIO::ReadMeshInformation()
 
     // Get points start position
     m_PointsStartPosition = m_InputFile.tellg();
+    this->SetBinarySectionLayout(POINTS_SECTION, FLOAT, this->m_PointDimension, true);
 
-    // Read points
-    float *pointsBuffer = new float[this->m_NumberOfPoints * this->m_PointDimension];
-    this->ReadBufferAsBinary(pointsBuffer, m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
-    delete[] pointsBuffer;
+    // Skip the points, which are read by ReadPoints()
+    m_InputFile.seekg(static_cast< std::streamoff >( this->m_NumberOfPoints * this->m_PointDimension * sizeof( float ) ),
+                      std::ios::cur);
+    m_CellsStartPosition = m_InputFile.tellg();
 
     // Set default cell component type
     this->m_CellBufferSize = this->m_NumberOfCells * 2; 
 
-    // Read cells
-    itk::uint32_t  numberOfCellPoints = 0;
-    itk::uint32_t *cellsBuffer = new itk::uint32_t[this->m_NumberOfCells];
-    for ( unsigned long id = 0; id < this->m_NumberOfCells; id++ )
+    // Read the number of points of each cell, and skip its point identifiers
+    itk::uint32_t numberOfCellPoints = 0;
+    for ( SizeValueType id = 0; id < this->m_NumberOfCells && m_InputFile.good(); id++ )
       {
       this->ReadBufferAsBinary(&numberOfCellPoints, m_InputFile, 1);
       this->m_CellBufferSize += numberOfCellPoints;
-      this->ReadBufferAsBinary(cellsBuffer, m_InputFile, numberOfCellPoints);
+      m_InputFile.seekg(static_cast< std::streamoff >( numberOfCellPoints * sizeof( itk::uint32_t ) ), std::ios::cur);
       if ( numberOfCellPoints != 3 )
         {
         m_TriangleCellType = false;
         }
       }
-    delete[] cellsBuffer;
+
+    if ( m_InputFile.fail() )
+      {
+      itkExceptionMacro(<< "The points and cells of " << this->m_FileName << " are truncated");
+      }
     }
 
   // Set default point component type
   this->m_PointComponentType = FLOAT;
 
-  // Set default cell component type
-  this->m_CellComponentType  = UINT;
+  if ( m_TriangleCellType && this->m_NumberOfCells )
+    {
+    this->m_SectionLayouts[CELLS_SECTION].UniformCellArity = 3;
+    }
+
+  // Set default cell component type, wide enough for the point identifiers
+  this->m_CellComponentType  = this->GetCellIdentifierComponentType();
 
   // If number of points is not equal zero, update points
   if ( this->m_NumberOfPoints )
@@ -272,16 +268,18 @@ void OFFMeshIO::ReadMeshInformation()
 void OFFMeshIO::ReadPoints(void *buffer)
 {
   // Set file position to points start position
-  m_InputFile.seekg(m_PointsStartPosition, std::ios::beg);
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
+  inputFile.seekg(m_PointsStartPosition, std::ios::beg);
 
   // Read file according to ASCII or BINARY
   if ( this->m_FileType == ASCII )
     {
-    this->ReadBufferAsAscii(static_cast< float * >( buffer ), m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
+    this->ReadBufferAsAscii(static_cast< float * >( buffer ), inputFile, this->m_NumberOfPoints * this->m_PointDimension);
     }
   else if ( this->m_FileType == BINARY )
     {
-    this->ReadBufferAsBinary(static_cast< float * >( buffer ), m_InputFile, this->m_NumberOfPoints * this->m_PointDimension);
+    this->ReadBufferAsBinary(static_cast< float * >( buffer ), inputFile, this->m_NumberOfPoints * this->m_PointDimension);
     }
   else
     {
@@ -293,34 +291,17 @@ void OFFMeshIO::ReadPoints(void *buffer)
 
 void OFFMeshIO::ReadCells(void *buffer)
 {
-  itk::uint32_t *data = new itk::uint32_t[this->m_CellBufferSize - this->m_NumberOfCells];
-
-  if ( this->m_FileType == ASCII )
+  // The binary files count their points on 32 bits, so that only the ASCII
+  // files may need 64 bits point identifiers
+  if ( this->m_CellComponentType == ULONGLONG )
     {
-    this->ReadCellsBufferAsAscii(data, m_InputFile);
-    }
-  else if ( this->m_FileType == BINARY )
-    {
-    this->ReadBufferAsBinary(data, m_InputFile, this->m_CellBufferSize - this->m_NumberOfCells);
-    }
-  else
-    {
-    itkExceptionMacro(<< "Invalid file type (not ASCII or BINARY)");
-    }
-
-  CloseFile();
-
-  if ( m_TriangleCellType )
-    {
-    this->WriteCellsBuffer(data, static_cast< unsigned int * >( buffer ), TRIANGLE_CELL, this->m_NumberOfCells);
+    this->ReadCellsIntoBuffer( static_cast< unsigned long long * >( buffer ) );
     }
   else
     {
-    this->WriteCellsBuffer(data, static_cast< unsigned int * >( buffer ), POLYGON_CELL, this->m_NumberOfCells);
+    this->ReadCellsIntoBuffer( static_cast< unsigned int * >( buffer ) );
     }
 
-  delete[] data;
-
   return;
 }
 
@@ -337,99 +318,64 @@ void OFFMeshIO::ReadCellData(void *buffer)
 void OFFMeshIO::WriteMeshInformation()
 {
   // Check file name
-  if ( this->m_FileName == "" )
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
     itkExceptionMacro("No Input FileName");
     return;
     }
 
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::out);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::out | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::out);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  // The output file stays open until Write()
+  this->OpenOutputFile();
 
   // Write Object file format header
-  outputFile << "OFF " << std::endl;
+  m_OutputFile << "OFF " << "\n";
 
   //Read points and cells information
   if ( this->m_FileType == ASCII )
     {
     // Write number of points
-    outputFile << this->m_NumberOfPoints << "    ";
+    m_OutputFile << this->m_NumberOfPoints << "    ";
 
     // Write number of cells
-    outputFile << this->m_NumberOfCells << "    ";
+    m_OutputFile << this->m_NumberOfCells << "    ";
 
     // Write number of edges
     unsigned int numberOfEdges = 0;
-    outputFile << numberOfEdges << std::endl;
+    m_OutputFile << numberOfEdges << "\n";
     }
   else if ( this->m_FileType == BINARY )
     {
+    // The binary files count the points and cells on 32 bits
+    if ( this->m_NumberOfPoints > NumericTraits< itk::uint32_t >::max()
+         || this->m_NumberOfCells > NumericTraits< itk::uint32_t >::max() )
+      {
+      itkExceptionMacro(<< "Binary OFF files can not hold more than "
+                        << NumericTraits< itk::uint32_t >::max() << " points or cells");
+      }
+
     // Write number of points
     itk::uint32_t numberOfPoints = this->m_NumberOfPoints;
-    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfPoints ), outputFile, 1);
+    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfPoints ), m_OutputFile, 1);
 
     // Write number of cells
     itk::uint32_t numberOfCells = this->m_NumberOfCells;
-    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfCells ), outputFile, 1);
+    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfCells ), m_OutputFile, 1);
 
     // Write number of edges
     itk::uint32_t numberOfEdges = 0;
-    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfEdges ), outputFile, 1);
+    this->WriteBufferAsBinary< itk::uint32_t >(&( numberOfEdges ), m_OutputFile, 1);
     }
-
-  outputFile.close();
 }
 
 void OFFMeshIO::WritePoints(void *buffer)
 {
-  // check file name 
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(POINTS_SECTION);
+  this->WritePointsChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTS_SECTION);
+}
 
+void OFFMeshIO::WritePointsChunk(void *buffer, SizeValueType numberOfPoints)
+{
   // Write points
   if ( this->m_FileType == ASCII )
     {
@@ -437,78 +383,78 @@ void OFFMeshIO::WritePoints(void *buffer)
       {
       case UCHAR:
         {
-        WriteBufferAsAscii(static_cast< unsigned char * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
         break;
         }
       case CHAR:
         {
-        WriteBufferAsAscii(static_cast< char * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case USHORT:
         {
-        WriteBufferAsAscii(static_cast< unsigned short * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case SHORT:
         {
-        WriteBufferAsAscii(static_cast< short * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case UINT:
         {
-        WriteBufferAsAscii(static_cast< unsigned int * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case INT:
         {
-        WriteBufferAsAscii(static_cast< int * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case ULONG:
         {
-        WriteBufferAsAscii(static_cast< unsigned long * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case LONG:
         {
-        WriteBufferAsAscii(static_cast< long * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case ULONGLONG:
         {
-        WriteBufferAsAscii(static_cast< unsigned long long * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case LONGLONG:
         {
-        WriteBufferAsAscii(static_cast< long long * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case FLOAT:
         {
-        WriteBufferAsAscii(static_cast< float * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case DOUBLE:
         {
-        WriteBufferAsAscii(static_cast< double * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
       case LDOUBLE:
         {
-        WriteBufferAsAscii(static_cast< long double * >( buffer ), outputFile, m_NumberOfPoints, m_PointDimension);
+        WriteBufferAsAscii(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints, m_PointDimension);
 
         break;
         }
@@ -524,78 +470,78 @@ void OFFMeshIO::WritePoints(void *buffer)
       {
       case UCHAR:
         {
-        WriteBufferAsBinary< float >(static_cast< unsigned char * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
         break;
         }
       case CHAR:
         {
-        WriteBufferAsBinary< float >(static_cast< char * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< char * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case USHORT:
         {
-        WriteBufferAsBinary< float >(static_cast< unsigned short * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case SHORT:
         {
-        WriteBufferAsBinary< float >(static_cast< short * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< short * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case UINT:
         {
-        WriteBufferAsBinary< float >(static_cast< unsigned int * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case INT:
         {
-        WriteBufferAsBinary< float >(static_cast< int * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< int * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case ULONG:
         {
-        WriteBufferAsBinary< float >(static_cast< unsigned long * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< unsigned long * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case LONG:
         {
-        WriteBufferAsBinary< float >(static_cast< long * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< long * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case ULONGLONG:
         {
-        WriteBufferAsBinary< float >(static_cast< unsigned long long * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case LONGLONG:
         {
-        WriteBufferAsBinary< float >(static_cast< long long * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< long long * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case FLOAT:
         {
-        WriteBufferAsBinary< float >(static_cast< float * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< float * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case DOUBLE:
         {
-        WriteBufferAsBinary< float >(static_cast< double * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< double * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
       case LDOUBLE:
         {
-        WriteBufferAsBinary< float >(static_cast< long double * >( buffer ), outputFile, m_NumberOfPoints * m_PointDimension);
+        WriteBufferAsBinary< float >(static_cast< long double * >( buffer ), m_OutputFile, numberOfPoints * m_PointDimension);
 
         break;
         }
@@ -605,42 +551,17 @@ void OFFMeshIO::WritePoints(void *buffer)
         }
       }
     }
-
-  outputFile.close();
-  return;
 }
 
 void OFFMeshIO::WriteCells(void *buffer)
 {
-  // Check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+  this->BeginWriteSection(CELLS_SECTION);
+  this->WriteCellsChunk(buffer, this->m_NumberOfCells);
+  this->EndWriteSection(CELLS_SECTION);
+}
 
+void OFFMeshIO::WriteCellsChunk(void *buffer, SizeValueType numberOfCells)
+{
   // Write cells
   if ( this->m_FileType == ASCII )
     {
@@ -648,79 +569,79 @@ void OFFMeshIO::WriteCells(void *buffer)
       {
       case UCHAR:
         {
-        WriteCellsAsAscii(static_cast< unsigned char * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case CHAR:
         {
-        WriteCellsAsAscii(static_cast< unsigned char * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case USHORT:
         {
-        WriteCellsAsAscii(static_cast< unsigned short * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case SHORT:
         {
-        WriteCellsAsAscii(static_cast< short * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< short * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case UINT:
         {
-        WriteCellsAsAscii(static_cast< unsigned int * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case INT:
         {
-        WriteCellsAsAscii(static_cast< int * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< int * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case ULONG:
         {
-        WriteCellsAsAscii(static_cast< long * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LONG:
         {
-        WriteCellsAsAscii(static_cast< long * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case ULONGLONG:
         {
-        WriteCellsAsAscii(static_cast< unsigned long long * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LONGLONG:
         {
-        WriteCellsAsAscii(static_cast< long long * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< long long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case FLOAT:
         {
-        WriteCellsAsAscii(static_cast< float * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< float * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case DOUBLE:
         {
-        WriteCellsAsAscii(static_cast< double * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< double * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LDOUBLE:
         {
-        WriteCellsAsAscii(static_cast< long double * >( buffer ), outputFile);
+        WriteCellsAsAscii(static_cast< long double * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
@@ -736,79 +657,79 @@ void OFFMeshIO::WriteCells(void *buffer)
       {
       case UCHAR:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned char * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned char * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case CHAR:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< char * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< char * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case USHORT:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned short * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned short * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case SHORT:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< short * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< short * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case UINT:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned int * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned int * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case INT:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< int * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< int * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case ULONG:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< long * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LONG:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< long * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case ULONGLONG:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned long long * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< unsigned long long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LONGLONG:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< long long * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< long long * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case FLOAT:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< float * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< float * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case DOUBLE:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< double * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< double * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
       case LDOUBLE:
         {
-        WriteCellsAsBinary< itk::uint32_t >(static_cast< long double * >( buffer ), outputFile);
+        WriteCellsAsBinary< itk::uint32_t >(static_cast< long double * >( buffer ), m_OutputFile, numberOfCells);
 
         break;
         }
@@ -818,24 +739,32 @@ void OFFMeshIO::WriteCells(void *buffer)
         }
       }
     }
+}
 
-  outputFile.close();
+void OFFMeshIO::WritePointData(void *buffer)
+{
+  return;
+}
 
+void OFFMeshIO::WriteCellData(void *buffer)
+{
   return;
 }
 
-void OFFMeshIO::WritePointData(void *buffer)
+void OFFMeshIO::WritePointDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfPoints))
 {
   return;
 }
 
-void OFFMeshIO::WriteCellData(void *buffer)
+void OFFMeshIO::WriteCellDataChunk(void *itkNotUsed(buffer), SizeValueType itkNotUsed(numberOfCells))
 {
   return;
 }
 
 void OFFMeshIO::Write()
-{}
+{
+  this->CloseOutputFile();
+}
 
 void OFFMeshIO::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -54,17 +54,16 @@ public:
 
   /*-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-  * \param FileNameToRead The name of the file to test for reading.
-  * \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-  * \return Returns true if this MeshIO can read the file specified.
-  */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: 100 for the OFF keyword, with its ST, C,
+   * N, 4 and n prefixes */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
 
-  /** Reads the data from disk into the memory buffer provided. */
+  /** Reads the data from disk into the memory buffer provided. The file
+   * opened by ReadMeshInformation() is shared by the reads, which each seek
+   * their own stream on it, so that they may run concurrently. */
   virtual void ReadPoints(void *buffer);
 
   virtual void ReadCells(void *buffer);
@@ -73,6 +72,10 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine if the file can be written with this MeshIO implementation.
@@ -97,23 +100,62 @@ public:
 
   virtual void Write();
 
+  /** OFF files are written chunk by chunk, point and cell data are ignored */
+  virtual bool CanStreamWrite() { return true; }
+
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
 protected:
+  /** Read the cells into a cell buffer of point identifiers of type T */
+  template< typename T >
+  void ReadCellsIntoBuffer(T *buffer)
+    {
+    MeshInputFileStream inputFile;
+    this->OpenReadContext(inputFile, m_InputFile);
+    inputFile.seekg(m_CellsStartPosition, std::ios::beg);
+
+    const SizeValueType numberOfIndices = this->m_CellBufferSize - this->m_NumberOfCells;
+    T *                 data = new T[numberOfIndices];
+
+    if ( this->m_FileType == ASCII )
+      {
+      this->ReadCellsBufferAsAscii(data, inputFile);
+      }
+    else if ( this->m_FileType == BINARY )
+      {
+      this->ReadBufferAsBinary(data, inputFile, numberOfIndices);
+      }
+    else
+      {
+      delete[] data;
+      itkExceptionMacro(<< "Invalid file type (not ASCII or BINARY)");
+      }
+
+    this->WriteCellsBuffer(data, buffer, m_TriangleCellType ? TRIANGLE_CELL : POLYGON_CELL, this->m_NumberOfCells);
+
+    delete[] data;
+    }
+
   /** Read buffer as ascii stream */
   template< typename T >
-  void ReadCellsBufferAsAscii(T *buffer, std::ifstream & inputFile)
+  void ReadCellsBufferAsAscii(T *buffer, std::istream & inputFile)
     {
-    unsigned int index = 0;
-    unsigned int numberOfPoints = 0;
-    std::string  line;
+    SizeValueType index = 0;
+    unsigned int  numberOfPoints = 0;
+    std::string   line;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    for ( SizeValueType ii = 0; ii < this->m_NumberOfCells; ii++ )
       {
-      inputFile >> numberOfPoints;
+      MeshNumberParser::Read(inputFile, numberOfPoints);
       buffer[index++] = static_cast< T >( numberOfPoints );
-      for ( unsigned int jj = 0; jj < numberOfPoints; jj++ )
-        {
-        inputFile >> buffer[index++];
-        }
+      this->ReadBufferAsAscii(buffer + index, inputFile, numberOfPoints);
+      index += numberOfPoints;
       std::getline(inputFile, line, '\n');
       }
     }
@@ -122,13 +164,13 @@ protected:
     write all kind of cells as it is stored in cells container. It is used when
     cells container have only one kind of cells */
   template< typename TInput, typename TOutput >
-  void ReadCellsBuffer(TInput *input, TOutput *output)
+  void ReadCellsBuffer(TInput *input, TOutput *output, SizeValueType numberOfCells)
     {
     if ( input && output )
       {
-      unsigned int indInput = 0;
-      unsigned int indOutput = 0;
-      for ( size_t ii = 0; ii < this->m_NumberOfCells; ii++ )
+      SizeValueType indInput = 0;
+      SizeValueType indOutput = 0;
+      for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
         {
         indInput++; // ignore the cell type
         unsigned int numberOfPoints = static_cast< unsigned int >( input[indInput++] );
@@ -142,32 +184,44 @@ protected:
     }
 
   template< typename T >
-  void WriteCellsAsAscii(T *buffer, std::ofstream & outputFile)
+  void WriteCellsAsAscii(T *buffer, std::ostream & outputFile, SizeValueType numberOfCells)
     {
-    unsigned long index = 0;
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = 0;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
       index++;
       unsigned int numberOfCellPoints = static_cast< unsigned int >( buffer[index++] );
-      outputFile << numberOfCellPoints << "  ";
+      formatter << numberOfCellPoints << "  ";
 
       for ( unsigned int jj = 0; jj < numberOfCellPoints; jj++ )
         {
-        outputFile << buffer[index++] << "  ";
+        formatter << buffer[index++] << "  ";
         }
 
-      outputFile << '\n';
+      formatter << '\n';
       }
     }
 
   template< typename TOutput, typename TInput >
-  void WriteCellsAsBinary(TInput *buffer, std::ofstream & outputFile)
+  void WriteCellsAsBinary(TInput *buffer, std::ostream & outputFile, SizeValueType numberOfCells)
     {
-    TOutput *data = new TOutput[m_CellBufferSize - this->m_NumberOfCells];
+    // The buffer may only hold a chunk of the cells, so the number of
+    // output elements (the cells without their type) is counted here
+    SizeValueType numberOfElements = 0;
+    SizeValueType index = 0;
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
+      {
+      SizeValueType numberOfCellPoints = static_cast< SizeValueType >( buffer[index + 1] );
+      index += numberOfCellPoints + 2;
+      numberOfElements += numberOfCellPoints + 1;
+      }
+
+    TOutput *data = new TOutput[numberOfElements];
 
-    ReadCellsBuffer(buffer, data);
-    WriteBufferAsBinary< TOutput >(data, outputFile, m_CellBufferSize - this->m_NumberOfCells);
+    ReadCellsBuffer(buffer, data, numberOfCells);
+    WriteBufferAsBinary< TOutput >(data, outputFile, numberOfElements);
 
     delete[] data;
     }
@@ -180,15 +234,14 @@ protected:
 
   void OpenFile();
 
-  void CloseFile();
-
 private:
   OFFMeshIO(const Self &);      // purposely not implemented
   void operator=(const Self &); // purposely not implemented
 
-  std::ifstream    m_InputFile;
-  StreamOffsetType m_PointsStartPosition; // file position for points rlative to std::ios::beg
-  bool             m_TriangleCellType;    // if all cells are trinalge it is true. otherwise, it is false.
+  MeshInputFileStream m_InputFile;
+  StreamOffsetType    m_PointsStartPosition; // file position for points rlative to std::ios::beg
+  StreamOffsetType    m_CellsStartPosition;  // file position for cells relative to std::ios::beg
+  bool                m_TriangleCellType;    // if all cells are trinalge it is true. otherwise, it is false.
 };
 } // end namespace itk
 
@@ -19,15 +19,51 @@
 #include "itkVTKPolyDataMeshIO.h"
 
 #include <itksys/SystemTools.hxx>
+#include <algorithm>
 #include <fstream>
 
 namespace itk
 {
+namespace
+{
+/** Component type stored by the binary sections for a component type: the
+ * long doubles, which VTK does not support, are converted to double. The
+ * 64 bits integers are stored as they are, as vtktypeuint64 and
+ * vtktypeint64. */
+MeshIOBase::IOComponentType GetStoredComponentType(MeshIOBase::IOComponentType componentType)
+{
+  switch ( componentType )
+    {
+    case MeshIOBase::LDOUBLE:
+      return MeshIOBase::DOUBLE;
+    default:
+      return componentType;
+    }
+}
+
+/** Whether one of the arrays is named name */
+bool HasDataArray(const MeshIOBase::DataArrayInformationContainer & arrays, const std::string & name)
+{
+  for ( MeshIOBase::DataArrayInformationContainer::const_iterator it = arrays.begin(); it != arrays.end(); ++it )
+    {
+    if ( it->Name == name )
+      {
+      return true;
+      }
+    }
+  return false;
+}
+} // end anonymous namespace
+
 // Constructor
 VTKPolyDataMeshIO::VTKPolyDataMeshIO()
 {
   this->AddSupportedWriteExtension(".vtk");
+  this->AddSupportedReadExtension(".vtk");
   this->m_ByteOrder = BigEndian;
+  m_CellsWriteGroup = POLYGON_CELL;
+  m_LastWriteSection = POINTS_SECTION;
+  m_PointsStartPosition = -1;
 
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
   EncapsulateMetaData< StringType >(metaDic, "pointScalarDataName", "PointScalarData");
@@ -40,24 +76,26 @@ VTKPolyDataMeshIO::VTKPolyDataMeshIO()
   EncapsulateMetaData< StringType >(metaDic, "cellTensorDataName", "CellTensorData");
 }
 
-bool VTKPolyDataMeshIO::CanReadFile(const char *fileName)
+unsigned int VTKPolyDataMeshIO::ScoreFileHeader(const std::string & header) const
 {
-  if ( !itksys::SystemTools::FileExists(fileName, true) )
+  if ( header.compare(0, 14, "# vtk DataFile") != 0 )
     {
-    return false;
+    return 0;
     }
 
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".vtk" )
+  const std::string::size_type dataset = header.find("DATASET");
+  if ( dataset != std::string::npos
+       && header.substr( dataset, header.find('\n', dataset) - dataset ).find("POLYDATA") == std::string::npos )
     {
-    return false;
+    return 0;
     }
 
-  return true;
+  return 100;
 }
 
 bool VTKPolyDataMeshIO::CanWriteFile(const char *fileName)
 {
-  if ( itksys::SystemTools::GetFilenameLastExtension(fileName) != ".vtk" )
+  if ( this->GetFileNameExtension(fileName) != ".vtk" )
     {
     return false;
     }
@@ -65,74 +103,39 @@ bool VTKPolyDataMeshIO::CanWriteFile(const char *fileName)
   return true;
 }
 
-void VTKPolyDataMeshIO::ReadMeshInformation()
+void VTKPolyDataMeshIO::CloseInputFile()
 {
-  // Read input file into a file stream 
-  std::ifstream inputFile;
-
-  // Use default filetype
-  if ( this->m_FileType == ASCII )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
+  if ( m_InputFile.is_open() )
     {
-#ifdef _WIN32
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
+    m_InputFile.close();
     }
+}
 
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-    return;
-    }
+void VTKPolyDataMeshIO::ReadMeshInformation()
+{
+  // Read input file into a file stream, which stays open for the reads of
+  // the sections
+  this->OpenInputFile(m_InputFile);
 
   // Define used variables 
   unsigned    numLine = 0;
   std::string line;
 
   // Read vtk header file(the first 3 lines) 
-  while ( !inputFile.eof() && numLine < 3 )
+  while ( !m_InputFile.eof() && numLine < 3 )
     {
-    std::getline(inputFile, line, '\n');
+    std::getline(m_InputFile, line, '\n');
     ++numLine;
     }
 
   // Determine file type 
   if ( line.find("ASCII") != std::string::npos )
     {
-    if ( this->m_FileType != ASCII )
-      {
-      this->m_FileType = ASCII;
-#ifdef _WIN32
-      inputFile.close();
-      inputFile.open(this->m_FileName.c_str(), std::ios::in);
-      if ( !inputFile.is_open() )
-        {
-        itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-        return;
-        }
-#endif
-      }
+    this->m_FileType = ASCII;
     }
   else if ( line.find("BINARY") != std::string::npos )
     {
-    if ( this->m_FileType != BINARY )
-      {
-      this->m_FileType = BINARY;
-#ifdef _WIN32
-      inputFile.close();
-      inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-      if ( !inputFile.is_open() )
-        {
-        itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-        return;
-        }
-#endif
-      }
+    this->m_FileType = BINARY;
     }
   else
     {
@@ -144,13 +147,20 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
   // Initialize number of cells 
   this->m_NumberOfCells  = 0;
   this->m_CellBufferSize = 0;
+  m_PointsStartPosition = -1;
+  this->ResetSectionLayouts();
+  this->m_PointDataArrays.clear();
+  this->m_CellDataArrays.clear();
+  this->m_UpdatePointData = false;
+  this->m_UpdateCellData = false;
+  SectionType          dataSection = POINTS_SECTION;
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
 
   // Searching the vtk file 
-  while ( !inputFile.eof() )
+  while ( !m_InputFile.eof() )
     {
     //  Read lines from input file 
-    std::getline(inputFile, line, '\n');
+    std::getline(m_InputFile, line, '\n');
     StringType item;
 
     //  If there are points 
@@ -166,66 +176,14 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
       // Get number of Points 
       ss >> this->m_NumberOfPoints;
       this->m_PointDimension = 3; // vtk only support 3 dimensional points
+      m_PointsStartPosition = m_InputFile.tellg();
 
       //Get point component type 
       StringType pointType;
       ss >> pointType;
-      if ( pointType == "unsigned_char" )
-        {
-        this->m_PointComponentType = UCHAR;
-        }
-      else if ( pointType == "char" )
-        {
-        this->m_PointComponentType = CHAR;
-        }
-      else if ( pointType == "unsigned_short" )
-        {
-        this->m_PointComponentType = USHORT;
-        }
-      else if ( pointType == "short" )
-        {
-        this->m_PointComponentType = SHORT;
-        }
-      else if ( pointType == "unsigned_int" )
-        {
-        this->m_PointComponentType = UINT;
-        }
-      else if ( pointType == "int" )
-        {
-        this->m_PointComponentType = INT;
-        }
-      else if ( pointType == "unsigned_long" )
-        {
-        this->m_PointComponentType = ULONG;
-        }
-      else if ( pointType == "long" )
-        {
-        this->m_PointComponentType = LONG;
-        }
-      else if ( pointType == "unsigned_long_long" )
-        {
-        this->m_PointComponentType = ULONGLONG; // not supported by standard vtk format
-        }
-      else if ( pointType == "long_long" )
-        {
-        this->m_PointComponentType = LONGLONG; // not supported by standard vtk format
-        }
-      else if ( pointType == "float" )
-        {
-        this->m_PointComponentType = FLOAT;
-        }
-      else if ( pointType == "double" )
-        {
-        this->m_PointComponentType = DOUBLE;
-        }
-      else if ( pointType == "long_double" )
-        {
-        this->m_PointComponentType = LDOUBLE; // not supported by standard vtk format
-        }
-      else
-        {
-        itkExceptionMacro(<< "Unknown point component type");
-        }
+      this->m_PointComponentType = this->GetComponentTypeFromVTKName(pointType);
+      this->SkipBinaryData(m_PointsStartPosition, this->m_NumberOfPoints * this->m_PointDimension,
+                           GetStoredComponentType(this->m_PointComponentType));
 
       this->m_UpdatePoints = true;
       }
@@ -239,14 +197,14 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
       ss >> item; // should be "VERTICES"
 
       // Get number of Points
-      unsigned int numberOfVertices;
-      unsigned int numberOfVertexIndices;
+      SizeValueType numberOfVertices;
+      SizeValueType numberOfVertexIndices;
       ss >> numberOfVertices;
       ss >> numberOfVertexIndices;
       this->m_NumberOfCells += numberOfVertices;
       this->m_CellBufferSize += numberOfVertexIndices;
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertices", numberOfVertices);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
 
       //Check whether numberOfVertices and numberOfVertexIndices are correct
       if ( numberOfVertices < 1 )
@@ -264,8 +222,9 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
         return;
         }
 
-      // Set cell component type 
-      this->m_CellComponentType = UINT;
+      // The legacy binary files store the cells as 32 bits integers
+      this->SkipBinaryData(m_InputFile.tellg(), numberOfVertexIndices, UINT);
+
       this->m_UpdateCells = true;
       }
     else if ( line.find("LINES") != std::string::npos )
@@ -278,14 +237,14 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
       ss >> item; // should be "LINES"
 
       // Get number of Polylines 
-      unsigned int numberOfLines;
-      unsigned int numberOfLineIndices;
+      SizeValueType numberOfLines;
+      SizeValueType numberOfLineIndices;
       ss >> numberOfLines;
       ss >> numberOfLineIndices;
       this->m_NumberOfCells += numberOfLines;
       this->m_CellBufferSize += numberOfLineIndices;
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLines", numberOfLines);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLineIndices", numberOfLineIndices);
 
       //Check whether numberOfPolylines and numberOfPolylineIndices are correct
       if ( numberOfLines < 1 )
@@ -303,8 +262,9 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
         return;
         }
 
-      // Set cell component type 
-      this->m_CellComponentType = UINT;
+      // The legacy binary files store the cells as 32 bits integers
+      this->SkipBinaryData(m_InputFile.tellg(), numberOfLineIndices, UINT);
+
       this->m_UpdateCells = true;
       }
     else if ( line.find("POLYGONS") != std::string::npos )
@@ -317,14 +277,14 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
       ss >> item; // should be "POLYGONS"
 
       // Get number of Polygons
-      unsigned int numberOfPolygons;
-      unsigned int numberOfPolygonIndices;
+      SizeValueType numberOfPolygons;
+      SizeValueType numberOfPolygonIndices;
       ss >> numberOfPolygons;
       ss >> numberOfPolygonIndices;
       this->m_NumberOfCells += numberOfPolygons;
       this->m_CellBufferSize += numberOfPolygonIndices;
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-      EncapsulateMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygons", numberOfPolygons);
+      EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
 
       //Check whether numberOfPolygons and numberOfPolygonIndices are correct
       if ( numberOfPolygons < 1 )
@@ -342,1183 +302,296 @@ void VTKPolyDataMeshIO::ReadMeshInformation()
         return;
         }
 
-      // Set cell component type
-      this->m_CellComponentType = UINT;
+      // The legacy binary files store the cells as 32 bits integers
+      this->SkipBinaryData(m_InputFile.tellg(), numberOfPolygonIndices, UINT);
+
       this->m_UpdateCells = true;
       }
     else if ( line.find("POINT_DATA") != std::string::npos )
       {
-      // Continue to read line and get data type 
-      if ( !inputFile.eof() )
-        {
-        std::getline(inputFile, line, '\n');
-        }
-      else
-        {
-        itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-      this->m_UpdatePointData = true;
-
-      //  Read point data pixel type
-      if ( line.find("SCALARS") != std::string::npos )
-        {
-        //define string stream and put line into it 
-        StringStreamType ss;
-        ss << line;
-
-        // Get each item
-        ss >> item; // should be "SCALARS"
-
-        if ( item == "SCALARS" )
-          {
-          ss >> item;   // "point data name "
-
-          // Get point data component type 
-          StringType pointDataComponentType;
-          ss >> pointDataComponentType;
-
-          // Set point pixel component type 
-          if ( pointDataComponentType == "unsigned_char" )
-            {
-            this->m_PointPixelComponentType = UCHAR;
-            }
-          else if ( pointDataComponentType == "char" )
-            {
-            this->m_PointPixelComponentType = CHAR;
-            }
-          else if ( pointDataComponentType == "unsigned_short" )
-            {
-            this->m_PointPixelComponentType = USHORT;
-            }
-          else if ( pointDataComponentType == "short" )
-            {
-            this->m_PointPixelComponentType = SHORT;
-            }
-          else if ( pointDataComponentType == "unsigned_int" )
-            {
-            this->m_PointPixelComponentType = UINT;
-            }
-          else if ( pointDataComponentType == "int" )
-            {
-            this->m_PointPixelComponentType = INT;
-            }
-          else if ( pointDataComponentType == "unsigned_long" )
-            {
-            this->m_PointPixelComponentType = ULONG;
-            }
-          else if ( pointDataComponentType == "long" )
-            {
-            this->m_PointPixelComponentType = LONG;
-            }
-          else if ( pointDataComponentType == "unsigned_long_long" )
-            {
-            // not supported by standard vtk format
-            this->m_PointPixelComponentType = ULONGLONG;
-            }
-          else if ( pointDataComponentType == "long_long" )
-            {
-            // not supported by standard vtk format
-            this->m_PointPixelComponentType = LONGLONG;
-            }
-          else if ( pointDataComponentType == "float" )
-            {
-            this->m_PointPixelComponentType = FLOAT;
-            }
-          else if ( pointDataComponentType == "double" )
-            {
-            this->m_PointPixelComponentType = DOUBLE;
-            }
-          else if ( pointDataComponentType == "long_double" )
-            {
-            // not supported by standard vtk format
-            this->m_PointPixelComponentType = LDOUBLE;
-            }
-          else
-            {
-            itkExceptionMacro(<< "Unknown point component type");
-            }
-
-          // Set point pixel type 
-          this->m_PointPixelType  = SCALAR;
-          this->m_NumberOfPointPixelComponents = itk::NumericTraits< unsigned int >::One;
-          this->m_UpdatePointData = true;
-          }
-        }
-
-      // Read point data pixel type 
-      if ( line.find("COLOR_SCALARS") != std::string::npos )
-        {
-        // define string stream and put line into it 
-        StringStreamType ss;
-        ss << line;
-
-        ss >> item;  // should be "COLOR_SCALARS"
-        ss >> item;  // "point data name "
-        ss >> this->m_NumberOfPointPixelComponents;
-
-        // Set point pixel type 
-        this->m_PointPixelType = VARIABLELENGTHVECTOR;
-        if ( this->m_FileType == ASCII )
-          {
-          this->m_PointPixelComponentType = FLOAT;
-          }
-        else
-          {
-          this->m_PointPixelComponentType = UCHAR;
-          }
-
-        this->m_UpdatePointData = true;
-        }
-
-      // Read point vector data 
-      if ( line.find("VECTORS") != std::string::npos || line.find("NORMALS") != std::string::npos )
-        {
-        // define string stream and put line into it
-        StringStreamType ss;
-        ss << line;
-
-        // Get each item 
-        ss >> item; // should be "VECTORS"
-        ss >> item; // "point data name "
-
-        // Get point data component type
-        StringType pointDataComponentType;
-        ss >> pointDataComponentType;
-
-        // Set point pixel component type 
-        if ( pointDataComponentType == "unsigned_char" )
-          {
-          this->m_PointPixelComponentType = UCHAR;
-          }
-        else if ( pointDataComponentType == "char" )
-          {
-          this->m_PointPixelComponentType = CHAR;
-          }
-        else if ( pointDataComponentType == "unsigned_short" )
-          {
-          this->m_PointPixelComponentType = USHORT;
-          }
-        else if ( pointDataComponentType == "short" )
-          {
-          this->m_PointPixelComponentType = SHORT;
-          }
-        else if ( pointDataComponentType == "unsigned_int" )
-          {
-          this->m_PointPixelComponentType = UINT;
-          }
-        else if ( pointDataComponentType == "int" )
-          {
-          this->m_PointPixelComponentType = INT;
-          }
-        else if ( pointDataComponentType == "unsigned_long" )
-          {
-          this->m_PointPixelComponentType = ULONG;
-          }
-        else if ( pointDataComponentType == "long" )
-          {
-          this->m_PointPixelComponentType = LONG;
-          }
-        else if ( pointDataComponentType == "unsigned_long_long" )
-          {
-          this->m_PointPixelComponentType = ULONGLONG; // not supported by standard vtk format
-          }
-        else if ( pointDataComponentType == "long_long" )
-          {
-          this->m_PointPixelComponentType = LONGLONG; // not supported by standard vtk format
-          }
-        else if ( pointDataComponentType == "float" )
-          {
-          this->m_PointPixelComponentType = FLOAT;
-          }
-        else if ( pointDataComponentType == "double" )
-          {
-          this->m_PointPixelComponentType = DOUBLE;
-          }
-        else if ( pointDataComponentType == "long_double" )
-          {
-          this->m_PointPixelComponentType = LDOUBLE; // not supported by standard vtk format
-          }
-        else
-          {
-          itkExceptionMacro(<< "Unknown point component type");
-          }
-
-        // Set point pixel type 
-        this->m_PointPixelType  = VECTOR;
-        this->m_NumberOfPointPixelComponents = this->m_PointDimension;
-        this->m_UpdatePointData = true;
-        }
-      if ( line.find("TENSORS") != std::string::npos )
-        {
-        // define string stream and put line into it
-        StringStreamType ss;
-        ss << line;
-
-        // Get each item 
-        ss >> item; // should be "TENSORS"
-        ss >> item; // "point data name "
-
-        // Get point data component type 
-        StringType pointDataComponentType;
-        ss >> pointDataComponentType;
-
-        // Set point pixel component type 
-        if ( pointDataComponentType == "unsigned_char" )
-          {
-          this->m_PointPixelComponentType = UCHAR;
-          }
-        else if ( pointDataComponentType == "char" )
-          {
-          this->m_PointPixelComponentType = CHAR;
-          }
-        else if ( pointDataComponentType == "unsigned_short" )
-          {
-          this->m_PointPixelComponentType = USHORT;
-          }
-        else if ( pointDataComponentType == "short" )
-          {
-          this->m_PointPixelComponentType = SHORT;
-          }
-        else if ( pointDataComponentType == "unsigned_int" )
-          {
-          this->m_PointPixelComponentType = UINT;
-          }
-        else if ( pointDataComponentType == "int" )
-          {
-          this->m_PointPixelComponentType = INT;
-          }
-        else if ( pointDataComponentType == "unsigned_long" )
-          {
-          this->m_PointPixelComponentType = ULONG;
-          }
-        else if ( pointDataComponentType == "long" )
-          {
-          this->m_PointPixelComponentType = LONG;
-          }
-        else if ( pointDataComponentType == "unsigned_long_long" )
-          {
-          this->m_PointPixelComponentType = ULONGLONG; // not supported by standard vtk format
-          }
-        else if ( pointDataComponentType == "long_long" )
-          {
-          this->m_PointPixelComponentType = LONGLONG; // not supported by standard vtk format
-          }
-        else if ( pointDataComponentType == "float" )
-          {
-          this->m_PointPixelComponentType = FLOAT;
-          }
-        else if ( pointDataComponentType == "double" )
-          {
-          this->m_PointPixelComponentType = DOUBLE;
-          }
-        else if ( pointDataComponentType == "long_double" )
-          {
-          this->m_PointPixelComponentType = LDOUBLE; // not supported by standard vtk format
-          }
-        else
-          {
-          itkExceptionMacro(<< "Unknown point component type");
-          }
-
-        // Set point pixel type 
-        this->m_PointPixelType  = SYMMETRICSECONDRANKTENSOR;
-        this->m_NumberOfPointPixelComponents = this->m_PointDimension * ( this->m_PointDimension + 1 ) / 2;
-        this->m_UpdatePointData = true;
-        }
+      dataSection = POINTDATA_SECTION;
       }
     else if ( line.find("CELL_DATA") != std::string::npos )
       {
-      // Continue to read line and get data type 
-      if ( !inputFile.eof() )
-        {
-        std::getline(inputFile, line, '\n');
-        }
-      else
-        {
-        itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-        }
-
-      this->m_UpdateCellData = true;
-
-      // Read cell data pixel type 
-      if ( line.find("SCALARS") != std::string::npos )
-        {
-        // define string stream and put line into it
-        StringStreamType ss;
-        ss << line;
-
-        // Get each item 
-        ss >> item; //should be "SCALARS"
-
-        if ( item == "SCALARS" )
-          {
-          ss >> item;   // "cell data name "
-
-          //  Get cell data component type 
-          StringType cellDataComponentType;
-          ss >> cellDataComponentType;
-
-          // Set point pixel component type 
-          if ( cellDataComponentType == "unsigned_char" )
-            {
-            this->m_CellPixelComponentType = UCHAR;
-            }
-          else if ( cellDataComponentType == "char" )
-            {
-            this->m_CellPixelComponentType = CHAR;
-            }
-          else if ( cellDataComponentType == "unsigned_short" )
-            {
-            this->m_CellPixelComponentType = USHORT;
-            }
-          else if ( cellDataComponentType == "short" )
-            {
-            this->m_CellPixelComponentType = SHORT;
-            }
-          else if ( cellDataComponentType == "unsigned_int" )
-            {
-            this->m_CellPixelComponentType = UINT;
-            }
-          else if ( cellDataComponentType == "int" )
-            {
-            this->m_CellPixelComponentType = INT;
-            }
-          else if ( cellDataComponentType == "unsigned_long" )
-            {
-            this->m_CellPixelComponentType = ULONG;
-            }
-          else if ( cellDataComponentType == "long" )
-            {
-            this->m_CellPixelComponentType = LONG;
-            }
-          else if ( cellDataComponentType == "unsigned_long_long" )
-            {
-            // not supported by standard vtk format
-            this->m_CellPixelComponentType = ULONGLONG;
-            }
-          else if ( cellDataComponentType == "long_long" )
-            {
-            // not supported by standard vtk format
-            this->m_CellPixelComponentType = LONGLONG;
-            }
-          else if ( cellDataComponentType == "float" )
-            {
-            this->m_CellPixelComponentType = FLOAT;
-            }
-          else if ( cellDataComponentType == "double" )
-            {
-            this->m_CellPixelComponentType = DOUBLE;
-            }
-          else if ( cellDataComponentType == "long_double" )
-            {
-            // not supported by standard vtk format
-            this->m_CellPixelComponentType = LDOUBLE;
-            }
-          else
-            {
-            itkExceptionMacro(<< "Unknown cell component type");
-            }
-
-          // Set cell pixel type 
-          this->m_CellPixelType  = SCALAR;
-          this->m_NumberOfCellPixelComponents = itk::NumericTraits< unsigned int >::One;
-          this->m_UpdateCellData = true;
-          }
-        }
-      if ( line.find("COLOR_SCALARS") != std::string::npos )
-        {
-        // define string stream and put line into it 
-        StringStreamType ss;
-        ss << line;
-
-        ss >> item;  // should be "COLOR_SCALARS"
-        ss >> item;  // "cell data name "
-        ss >> this->m_NumberOfCellPixelComponents;
-
-        // Set cell pixel type 
-        this->m_CellPixelType  = VARIABLELENGTHVECTOR;
-        if ( this->m_FileType == ASCII )
-          {
-          this->m_CellPixelComponentType = FLOAT;
-          }
-        else
-          {
-          this->m_CellPixelComponentType = UCHAR;
-          }
-
-        this->m_UpdateCellData = true;
-        }
-
-      // Read cell vector data 
-      if ( line.find("VECTORS") != std::string::npos || line.find("NORMALS") != std::string::npos )
-        {
-        // define string stream and put line into it
-        StringStreamType ss;
-        ss << line;
-
-        //Get each item 
-        ss >> item; // should be "VECTORS"
-        ss >> item; // "cell data name "
-
-        // Get cell data component type
-        StringType cellDataComponentType;
-        ss >> cellDataComponentType;
-
-        // Set cell pixel component type 
-        if ( cellDataComponentType == "unsigned_char" )
-          {
-          this->m_CellPixelComponentType = UCHAR;
-          }
-        else if ( cellDataComponentType == "char" )
-          {
-          this->m_CellPixelComponentType = CHAR;
-          }
-        else if ( cellDataComponentType == "unsigned_short" )
-          {
-          this->m_CellPixelComponentType = USHORT;
-          }
-        else if ( cellDataComponentType == "short" )
-          {
-          this->m_CellPixelComponentType = SHORT;
-          }
-        else if ( cellDataComponentType == "unsigned_int" )
-          {
-          this->m_CellPixelComponentType = UINT;
-          }
-        else if ( cellDataComponentType == "int" )
-          {
-          this->m_CellPixelComponentType = INT;
-          }
-        else if ( cellDataComponentType == "unsigned_long" )
-          {
-          this->m_CellPixelComponentType = ULONG;
-          }
-        else if ( cellDataComponentType == "long" )
-          {
-          this->m_CellPixelComponentType = LONG;
-          }
-        else if ( cellDataComponentType == "unsigned_long_long" )
-          {
-          this->m_CellPixelComponentType = ULONGLONG;
-          }
-        else if ( cellDataComponentType == "long_long" )
-          {
-          this->m_CellPixelComponentType = LONGLONG;
-          }
-        else if ( cellDataComponentType == "float" )
-          {
-          this->m_CellPixelComponentType = FLOAT;
-          }
-        else if ( cellDataComponentType == "double" )
-          {
-          this->m_CellPixelComponentType = DOUBLE;
-          }
-        else if ( cellDataComponentType == "long_double" )
-          {
-          this->m_CellPixelComponentType = LDOUBLE;
-          }
-        else
-          {
-          itkExceptionMacro(<< "Unknown cell component type");
-          }
-
-        // Set cell pixel type
-        this->m_CellPixelType  = VECTOR;
-        this->m_NumberOfCellPixelComponents = this->m_PointDimension;
-        this->m_UpdateCellData = true;
-        }
-      if ( line.find("TENSORS") != std::string::npos )
+      dataSection = CELLDATA_SECTION;
+      }
+    else if ( dataSection != POINTS_SECTION )
+      {
+      // The attributes following the last POINT_DATA or CELL_DATA keyword
+      // belong to that section
+      DataArrayInformation array;
+      if ( this->ReadDataArrayInformation(m_InputFile, line, array) )
         {
-        // define string stream and put line into it
-        StringStreamType ss;
-        ss << line;
-
-        // Get each item 
-        ss >> item; // should be "TENSORS"
-        ss >> item; // "cell data name "
-
-        // Get cell data component type
-        StringType cellDataComponentType;
-        ss >> cellDataComponentType;
-
-        // Set cell pixel component type
-        if ( cellDataComponentType == "unsigned_char" )
-          {
-          this->m_CellPixelComponentType = UCHAR;
-          }
-        else if ( cellDataComponentType == "char" )
-          {
-          this->m_CellPixelComponentType = CHAR;
-          }
-        else if ( cellDataComponentType == "unsigned_short" )
-          {
-          this->m_CellPixelComponentType = USHORT;
-          }
-        else if ( cellDataComponentType == "short" )
-          {
-          this->m_CellPixelComponentType = SHORT;
-          }
-        else if ( cellDataComponentType == "unsigned_int" )
-          {
-          this->m_CellPixelComponentType = UINT;
-          }
-        else if ( cellDataComponentType == "int" )
-          {
-          this->m_CellPixelComponentType = INT;
-          }
-        else if ( cellDataComponentType == "unsigned_long" )
-          {
-          this->m_CellPixelComponentType = ULONG;
-          }
-        else if ( cellDataComponentType == "long" )
-          {
-          this->m_CellPixelComponentType = LONG;
-          }
-        else if ( cellDataComponentType == "unsigned_long_long" )
-          {
-          this->m_CellPixelComponentType = ULONGLONG;
-          }
-        else if ( cellDataComponentType == "long_long" )
-          {
-          this->m_CellPixelComponentType = LONGLONG;
-          }
-        else if ( cellDataComponentType == "float" )
-          {
-          this->m_CellPixelComponentType = FLOAT;
-          }
-        else if ( cellDataComponentType == "double" )
-          {
-          this->m_CellPixelComponentType = DOUBLE;
-          }
-        else if ( cellDataComponentType == "long_double" )
+        SizeValueType numberOfElements = this->m_NumberOfPoints;
+        if ( dataSection == POINTDATA_SECTION )
           {
-          this->m_CellPixelComponentType = LDOUBLE;
+          this->m_PointDataArrays.push_back(array);
           }
         else
           {
-          itkExceptionMacro(<< "Unknown point component type");
+          this->m_CellDataArrays.push_back(array);
+          numberOfElements = this->m_NumberOfCells;
           }
 
-        // Set cell pixel type
-        this->m_CellPixelType  = SYMMETRICSECONDRANKTENSOR;
-        this->m_NumberOfCellPixelComponents = this->m_PointDimension * ( this->m_PointDimension + 1 ) / 2;
-        this->m_UpdateCellData = true;
+        this->SkipBinaryData(array.Offset, numberOfElements * array.NumberOfComponents,
+                             GetStoredComponentType(array.ComponentType));
         }
       }
     }
 
+  // Data appended to the file continue its last data section
+  m_LastWriteSection = dataSection;
+
   if ( this->m_CellBufferSize )
     {
     this->m_CellBufferSize += this->m_NumberOfCells;
+    this->m_CellComponentType = this->GetCellIdentifierComponentType();
     }
 
-  inputFile.close();
-}
+  // Describe the point data and cell data by the selected arrays
+  this->SelectDataArrays();
 
-void VTKPolyDataMeshIO::ReadPoints(void *buffer)
-{
-  // Read input file
-  std::ifstream inputFile;
-
-  if ( this->m_FileType == ASCII )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
+  // The binary points and data are blocks of big endian components, unless
+  // they are converted from narrower types, and the cells are counts
+  // followed by identifiers
+  if ( this->m_FileType == BINARY )
     {
-#ifdef _WIN32
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
-    }
-
-  // Test whether the file has been opened 
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-    return;
-    }
-
-  // Read points according to filetype as ASCII or BINARY
-  if ( this->m_FileType == ASCII )
-    {
-    switch ( this->m_PointComponentType )
+    if ( m_PointsStartPosition >= 0 )
       {
-      case UCHAR:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned char * >( buffer ) );
-        break;
-        }
-      case CHAR:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< char * >( buffer ) );
-        break;
-        }
-      case USHORT:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned short * >( buffer ) );
-        break;
-        }
-      case SHORT:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< short * >( buffer ) );
-        break;
-        }
-      case UINT:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned int * >( buffer ) );
-        break;
-        }
-      case INT:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< int * >( buffer ) );
-        break;
-        }
-      case ULONG:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned long * >( buffer ) );
-        break;
-        }
-      case LONG:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< long * >( buffer ) );
-        break;
-        }
-      case ULONGLONG:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned long long * >( buffer ) );
-        break;
-        }
-      case LONGLONG:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< long long * >( buffer ) );
-        break;
-        }
-      case FLOAT:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< float * >( buffer ) );
-        break;
-        }
-      case DOUBLE:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< double * >( buffer ) );
-        break;
-        }
-      case LDOUBLE:
-        {
-        ReadPointsBufferAsASCII( inputFile, static_cast< long double * >( buffer ) );
-        break;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown point component type");
-        }
+      const IOComponentType storedType = GetStoredComponentType(this->m_PointComponentType);
+      this->SetBinarySectionLayout(POINTS_SECTION, storedType, this->m_PointDimension,
+                                   storedType == this->m_PointComponentType);
       }
-    }
-  else if ( this->m_FileType == BINARY )
-    {
-    switch ( this->m_PointComponentType )
-      {
-      case UCHAR:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned char * >( buffer ) );
-        break;
-        }
-      case CHAR:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< char * >( buffer ) );
-        break;
-        }
-      case USHORT:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned short * >( buffer ) );
-        break;
-        }
-      case SHORT:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< short * >( buffer ) );
-        break;
-        }
-      case UINT:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned int * >( buffer ) );
-        break;
-        }
-      case INT:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< int * >( buffer ) );
-        break;
-        }
-      case ULONG:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned long * >( buffer ) );
-        break;
-        }
-      case LONG:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< long * >( buffer ) );
-        break;
-        }
-      case ULONGLONG:
-        {
-        unsigned long       numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long *     data = new unsigned long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
 
-        ReadPointsBufferAsBINARY(inputFile, data);
-        delete[] data;
-        break;
-        }
-      case LONGLONG:
-        {
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        long long *   input = static_cast< long long * >( buffer );
-        long *        data = new long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-
-        ReadPointsBufferAsBINARY(inputFile, data);
-        delete[] data;
-        break;
-        }
-      case FLOAT:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< float * >( buffer ) );
-        break;
-        }
-      case DOUBLE:
-        {
-        ReadPointsBufferAsBINARY( inputFile, static_cast< double * >( buffer ) );
-        break;
-        }
-      case LDOUBLE:
-        {
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        long double * input = static_cast< long double * >( buffer );
-        double *      data = new double[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< double >( input[ii] );
-          }
-
-        ReadPointsBufferAsBINARY(inputFile, data);
-        delete[] data;
-        break;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown point component type");
-        }
-      }
-    }
-  else
-    {
-    itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
-    }
-
-  inputFile.close();
-}
-
-void VTKPolyDataMeshIO::ReadCells(void *buffer)
-{
-  // Read input file 
-  std::ifstream inputFile;
-
-  if ( this->m_FileType == ASCII )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
-    }
-
-  // Test whether the file has been opened
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
-    return;
-    }
-
-  // Read cells according to file type
-  if ( this->m_FileType == ASCII )
-    {
-    ReadCellsBufferAsASCII(inputFile, buffer);
-    }
-  else if ( this->m_FileType == BINARY )
-    {
-    ReadCellsBufferAsBINARY(inputFile, buffer);
-    }
-  else
-    {
-    itkExceptionMacro(<< "Unkonw file type");
-    }
-
-  inputFile.close();
-}
-
-void VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void *buffer)
-{
-  std::string   line;
-  unsigned long index = 0;
-  unsigned int  numPoints; // number of point in each cell
-
-  MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-  unsigned int *       data = static_cast< unsigned int * >( buffer );
-
-  while ( !inputFile.eof() )
-    {
-    std::getline(inputFile, line, '\n');
-    if ( line.find("VERTICES") != std::string::npos )
-      {
-      unsigned int numberOfVertices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-
-      for ( unsigned int ii = 0; ii < numberOfVertices; ii++ )
-        {
-        inputFile >> numPoints;
-        data[index++] = MeshIOBase::VERTEX_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
-          {
-          inputFile >> data[index++];
-          }
-        }
-      }
-    else if ( line.find("LINES") != std::string::npos )
-      {
-      unsigned int numberOfLines = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-
-      for ( unsigned int ii = 0; ii < numberOfLines; ii++ )
-        {
-        inputFile >> numPoints;
-        data[index++] = MeshIOBase::POLYLINE_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
-          {
-          inputFile >> data[index++];
-          }
-        }
-      }
-    else if ( line.find("POLYGONS") != std::string::npos )
-      {
-      unsigned int numberOfPolygons = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-
-      for ( unsigned int ii = 0; ii < numberOfPolygons; ii++ )
-        {
-        inputFile >> numPoints;
-
-        data[index++] = MeshIOBase::POLYGON_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
-          {
-          inputFile >> data[index++];
-          }
-        }
-      }
-    }
-
-  return;
-}
-
-void VTKPolyDataMeshIO::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void *buffer)
-{
-  if ( !this->m_CellBufferSize )
-    {
-    return;
-    }
-
-  unsigned int *inputBuffer = new unsigned int[this->m_CellBufferSize - this->m_NumberOfCells];
-  void *        pv = inputBuffer;
-  char *        startBuffer = static_cast< char * >( pv );
-  unsigned int *outputBuffer = static_cast< unsigned int * >( buffer );
-
-  std::string          line;
-  MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-
-  while ( !inputFile.eof() )
-    {
-    std::getline(inputFile, line, '\n');
-    if ( line.find("VERTICES") != std::string::npos )
+    if ( !this->m_PointDataArrays.empty() )
       {
-      unsigned int numberOfVertices = 0;
-      unsigned int numberOfVertexIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
-      inputFile.read( startBuffer, numberOfVertexIndices * sizeof( unsigned int ) );
-
-      pv = startBuffer;
-      unsigned int *data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfVertexIndices);
-        }
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::VERTEX_CELL, numberOfVertices);
-      startBuffer += numberOfVertexIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfVertexIndices + numberOfVertices ) * sizeof( unsigned int );
+      const IOComponentType storedType = GetStoredComponentType(this->m_PointPixelComponentType);
+      this->SetBinarySectionLayout(POINTDATA_SECTION, storedType, this->m_NumberOfPointPixelComponents,
+                                   storedType == this->m_PointPixelComponentType);
       }
-    else if ( line.find("LINES") != std::string::npos )
-      {
-      unsigned int numberOfLines = 0;
-      unsigned int numberOfLineIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
-      inputFile.read( startBuffer, numberOfLineIndices * sizeof( unsigned int ) );
 
-      pv = startBuffer;
-      unsigned int *data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfLineIndices);
-        }
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::POLYLINE_CELL, numberOfLines);
-      startBuffer += numberOfLineIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfLineIndices + numberOfLines ) * sizeof( unsigned int );
-      }
-    else if ( line.find("POLYGONS") != std::string::npos )
+    if ( !this->m_CellDataArrays.empty() )
       {
-      unsigned int numberOfPolygons = 0;
-      unsigned int numberOfPolygonIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
-      inputFile.read( startBuffer, numberOfPolygonIndices * sizeof( unsigned int ) );
-
-      pv = startBuffer;
-      unsigned int *data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfPolygonIndices);
-        }
-
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::POLYGON_CELL, numberOfPolygons);
-      startBuffer += numberOfPolygonIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfPolygonIndices + numberOfPolygons ) * sizeof( unsigned int );
-      }
-    }
-
-  if ( this->m_CellBufferSize )
-    {
-    delete[] inputBuffer;
+      const IOComponentType storedType = GetStoredComponentType(this->m_CellPixelComponentType);
+      this->SetBinarySectionLayout(CELLDATA_SECTION, storedType, this->m_NumberOfCellPixelComponents,
+                                   storedType == this->m_CellPixelComponentType);
+      }
     }
 }
 
-void VTKPolyDataMeshIO::ReadPointData(void *buffer)
+void VTKPolyDataMeshIO::SkipBinaryData(StreamOffsetType position, SizeValueType numberOfComponents,
+                                       IOComponentType componentType)
 {
-  // Read input file
-  std::ifstream inputFile;
-
-  if ( this->m_FileType == ASCII )
+  // Seek past binary data, whose bytes could look like any keyword
+  if ( this->m_FileType == BINARY )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
+    m_InputFile.seekg(position + static_cast< StreamOffsetType >(
+                        numberOfComponents * this->GetComponentSize(componentType) ), std::ios::beg);
     }
+}
 
-  // Test whether the file has been opened 
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
-    return;
-    }
+void VTKPolyDataMeshIO::ReadPoints(void *buffer)
+{
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the sections may be read concurrently
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
 
-  // Read cells according to file type 
+  // Read points according to filetype as ASCII or BINARY
   if ( this->m_FileType == ASCII )
     {
-    switch ( this->m_PointPixelComponentType )
+    switch ( this->m_PointComponentType )
       {
       case UCHAR:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< unsigned char * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned char * >( buffer ) );
         break;
         }
       case CHAR:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< char * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< char * >( buffer ) );
         break;
         }
       case USHORT:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< unsigned short * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned short * >( buffer ) );
         break;
         }
       case SHORT:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< short * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< short * >( buffer ) );
         break;
         }
       case UINT:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< unsigned int * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned int * >( buffer ) );
         break;
         }
       case INT:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< int * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< int * >( buffer ) );
         break;
         }
       case ULONG:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< unsigned long * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned long * >( buffer ) );
         break;
         }
       case LONG:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< long * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< long * >( buffer ) );
         break;
         }
       case ULONGLONG:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< unsigned long long * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< unsigned long long * >( buffer ) );
         break;
         }
       case LONGLONG:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< long long * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< long long * >( buffer ) );
         break;
         }
       case FLOAT:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< float * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< float * >( buffer ) );
         break;
         }
       case DOUBLE:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< double * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< double * >( buffer ) );
         break;
         }
       case LDOUBLE:
         {
-        ReadPointDataBufferAsASCII( inputFile, static_cast< long double * >( buffer ) );
+        ReadPointsBufferAsASCII( inputFile, static_cast< long double * >( buffer ) );
         break;
         }
       default:
         {
-        itkExceptionMacro(<< "Unknown point pixel component");
+        itkExceptionMacro(<< "Unknown point component type");
         }
       }
     }
   else if ( this->m_FileType == BINARY )
     {
-    switch ( this->m_PointPixelComponentType )
+    // The points stored as a narrower type are read from their position
+    // found by ReadMeshInformation(), and converted
+    const SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+    switch ( this->m_PointComponentType )
       {
       case UCHAR:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< unsigned char * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned char * >( buffer ) );
         break;
         }
       case CHAR:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< char * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< char * >( buffer ) );
         break;
         }
       case USHORT:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< unsigned short * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned short * >( buffer ) );
         break;
         }
       case SHORT:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< short * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< short * >( buffer ) );
         break;
         }
       case UINT:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< unsigned int * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned int * >( buffer ) );
         break;
         }
       case INT:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< int * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< int * >( buffer ) );
         break;
         }
       case ULONG:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< unsigned long * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned long * >( buffer ) );
         break;
         }
       case LONG:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< long * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< long * >( buffer ) );
         break;
         }
       case ULONGLONG:
         {
-        unsigned long       numberOfComponents = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long *     data = new unsigned long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
-
-        ReadPointDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        ReadPointsBufferAsBINARY( inputFile, static_cast< unsigned long long * >( buffer ) );
         break;
         }
       case LONGLONG:
         {
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        long long *   input = static_cast< long long * >( buffer );
-        long *        data = new long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-
-        ReadPointDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        ReadPointsBufferAsBINARY( inputFile, static_cast< long long * >( buffer ) );
         break;
         }
       case FLOAT:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< float * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< float * >( buffer ) );
         break;
         }
       case DOUBLE:
         {
-        ReadPointDataBufferAsBINARY( inputFile, static_cast< double * >( buffer ) );
+        ReadPointsBufferAsBINARY( inputFile, static_cast< double * >( buffer ) );
         break;
         }
       case LDOUBLE:
         {
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        long double * input = static_cast< long double * >( buffer );
-        double *      data = new double[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< double >( input[ii] );
-          }
-
-        ReadPointDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        inputFile.seekg(m_PointsStartPosition, std::ios::beg);
+        this->ReadConvertedBufferAsBinary< double >(inputFile, static_cast< long double * >( buffer ),
+                                                     numberOfComponents);
         break;
         }
       default:
         {
-        itkExceptionMacro(<< "Unknown point pixel component");
+        itkExceptionMacro(<< "Unknown point component type");
         }
       }
     }
+  else
+    {
+    itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
+    }
+
+  inputFile.close();
+}
+
+void VTKPolyDataMeshIO::ReadCells(void *buffer)
+{
+  // Read through a stream of its own on the file opened by
+  // ReadMeshInformation(), so that the sections may be read concurrently
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
+
+  // Read cells according to file type, into the cell component type chosen
+  // by ReadMeshInformation()
+  if ( this->m_FileType == ASCII )
+    {
+    if ( this->m_CellComponentType == ULONGLONG )
+      {
+      ReadCellsBufferAsASCII( inputFile, static_cast< unsigned long long * >( buffer ) );
+      }
+    else
+      {
+      ReadCellsBufferAsASCII( inputFile, static_cast< unsigned int * >( buffer ) );
+      }
+    }
+  else if ( this->m_FileType == BINARY )
+    {
+    if ( this->m_CellComponentType == ULONGLONG )
+      {
+      ReadCellsBufferAsBINARY( inputFile, static_cast< unsigned long long * >( buffer ) );
+      }
+    else
+      {
+      ReadCellsBufferAsBINARY( inputFile, static_cast< unsigned int * >( buffer ) );
+      }
+    }
   else
     {
     itkExceptionMacro(<< "Unkonw file type");
@@ -1527,206 +600,234 @@ void VTKPolyDataMeshIO::ReadPointData(void *buffer)
   inputFile.close();
 }
 
+void VTKPolyDataMeshIO::ReadPointData(void *buffer)
+{
+  if ( this->m_PointDataArrays.empty() )
+    {
+    itkExceptionMacro(<< this->m_FileName << " has no point data");
+    }
+
+  std::vector< std::string > names( 1, this->m_PointDataArrays[this->m_SelectedPointDataArray].Name );
+  std::vector< void * >      buffers(1, buffer);
+  this->ReadDataArrays(this->m_PointDataArrays, names, buffers, this->m_NumberOfPoints);
+}
+
 void VTKPolyDataMeshIO::ReadCellData(void *buffer)
 {
-  // Read input file 
-  std::ifstream inputFile;
+  if ( this->m_CellDataArrays.empty() )
+    {
+    itkExceptionMacro(<< this->m_FileName << " has no cell data");
+    }
 
-  if ( this->m_FileType == ASCII )
+  std::vector< std::string > names( 1, this->m_CellDataArrays[this->m_SelectedCellDataArray].Name );
+  std::vector< void * >      buffers(1, buffer);
+  this->ReadDataArrays(this->m_CellDataArrays, names, buffers, this->m_NumberOfCells);
+}
+
+void VTKPolyDataMeshIO::ReadPointDataArrays(const std::vector< std::string > & names,
+                                            const std::vector< void * > & buffers)
+{
+  this->ReadDataArrays(this->m_PointDataArrays, names, buffers, this->m_NumberOfPoints);
+}
+
+void VTKPolyDataMeshIO::ReadCellDataArrays(const std::vector< std::string > & names,
+                                           const std::vector< void * > & buffers)
+{
+  this->ReadDataArrays(this->m_CellDataArrays, names, buffers, this->m_NumberOfCells);
+}
+
+void VTKPolyDataMeshIO::ReadDataArrays(const DataArrayInformationContainer & arrays,
+                                       const std::vector< std::string > & names,
+                                       const std::vector< void * > & buffers, SizeValueType numberOfElements)
+{
+  if ( names.size() != buffers.size() )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    itkExceptionMacro(<< names.size() << " data arrays to read into " << buffers.size() << " buffers");
     }
-  else if ( m_FileType == BINARY )
+
+  // Check all the names before reading anything
+  for ( std::size_t ii = 0; ii < names.size(); ii++ )
     {
-#ifdef _WIN32
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-#else
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-#endif
+    this->FindDataArray(arrays, names[ii]);
     }
 
-  // Test whether the file has been opened 
-  if ( !inputFile.is_open() )
+  MeshInputFileStream inputFile;
+  this->OpenReadContext(inputFile, m_InputFile);
+
+  // The arrays are read in the order of the file, in a single pass seeking
+  // past the arrays not asked for
+  std::vector< bool > read(names.size(), false);
+  for ( unsigned int ii = 0; ii < arrays.size(); ii++ )
     {
-    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
-    return;
+    for ( std::size_t jj = 0; jj < names.size(); jj++ )
+      {
+      if ( !read[jj] && names[jj] == arrays[ii].Name )
+        {
+        this->ReadDataArray(inputFile, buffers[jj], arrays[ii], numberOfElements);
+        read[jj] = true;
+        }
+      }
     }
 
-  // Read cell data according file type 
+  inputFile.close();
+}
+
+void VTKPolyDataMeshIO::ReadDataArray(std::istream & inputFile, void *buffer, const DataArrayInformation & array,
+                                      SizeValueType numberOfElements)
+{
+  const SizeValueType numberOfComponents = numberOfElements * array.NumberOfComponents;
+
+  inputFile.clear();
+  inputFile.seekg(array.Offset, std::ios::beg);
+
   if ( this->m_FileType == ASCII )
     {
-    switch ( this->m_CellPixelComponentType )
+    switch ( array.ComponentType )
       {
       case UCHAR:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< unsigned char * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< unsigned char * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case CHAR:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< char * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< char * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case USHORT:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< unsigned short * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< unsigned short * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case SHORT:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< short * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< short * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case UINT:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< unsigned int * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< unsigned int * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case INT:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< int * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< int * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case ULONG:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< unsigned long * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< unsigned long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LONG:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< long * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case ULONGLONG:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< unsigned long long * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< unsigned long long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LONGLONG:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< long long * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< long long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case FLOAT:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< float * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< float * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case DOUBLE:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< double * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< double * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LDOUBLE:
         {
-        ReadCellDataBufferAsASCII( inputFile, static_cast< long double * >( buffer ) );
+        this->ReadBufferAsAscii(static_cast< long double * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       default:
         {
-        itkExceptionMacro(<< "Unknown cell pixel component");
+        itkExceptionMacro(<< "Unknown component type of data array " << array.Name);
         }
       }
     }
   else if ( this->m_FileType == BINARY )
     {
-    switch ( this->m_CellPixelComponentType )
+    switch ( array.ComponentType )
       {
       case UCHAR:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< unsigned char * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< unsigned char * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case CHAR:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< char * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< char * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case USHORT:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< unsigned short * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< unsigned short * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case SHORT:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< short * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< short * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case UINT:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< unsigned int * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< unsigned int * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case INT:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< int * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< int * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case ULONG:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< unsigned long * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< unsigned long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LONG:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< long * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case ULONGLONG:
         {
-        unsigned long       numberOfComponents = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long *     data = new unsigned long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
-
-        ReadCellDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        this->ReadBufferAsBinary(static_cast< unsigned long long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LONGLONG:
         {
-        unsigned long numberOfComponents = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        long long *   input = static_cast< long long * >( buffer );
-        long *        data = new long[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-
-        ReadCellDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        this->ReadBufferAsBinary(static_cast< long long * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case FLOAT:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< float * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< float * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case DOUBLE:
         {
-        ReadCellDataBufferAsBINARY( inputFile, static_cast< double * >( buffer ) );
+        this->ReadBufferAsBinary(static_cast< double * >( buffer ), inputFile, numberOfComponents);
         break;
         }
       case LDOUBLE:
         {
-        unsigned long numberOfComponents = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        long double * input = static_cast< long double * >( buffer );
-        double *      data = new double[numberOfComponents];
-        for ( unsigned long ii = 0; ii < numberOfComponents; ii++ )
-          {
-          data[ii] = static_cast< double >( input[ii] );
-          }
-
-        ReadCellDataBufferAsBINARY(inputFile, data);
-        delete[] data;
+        this->ReadConvertedBufferAsBinary< double >(inputFile, static_cast< long double * >( buffer ),
+                                                     numberOfComponents);
         break;
         }
       default:
         {
-        itkExceptionMacro(<< "Unknown cell pixel component");
+        itkExceptionMacro(<< "Unknown component type of data array " << array.Name);
         }
       }
     }
@@ -1734,168 +835,415 @@ void VTKPolyDataMeshIO::ReadCellData(void *buffer)
     {
     itkExceptionMacro(<< "Unkonw file type");
     }
+}
 
-  inputFile.close();
+bool VTKPolyDataMeshIO::ReadDataArrayInformation(std::istream & inputFile, const StringType & line,
+                                                 DataArrayInformation & array)
+{
+  StringStreamType ss;
+  StringType       keyword;
+  StringType       componentType;
+
+  ss << line;
+  ss >> keyword;
+  ss >> array.Name;
+
+  if ( keyword == "SCALARS" )
+    {
+    ss >> componentType;
+    array.ComponentType = this->GetComponentTypeFromVTKName(componentType);
+    if ( !( ss >> array.NumberOfComponents ) )
+      {
+      array.NumberOfComponents = 1;
+      }
+    array.PixelType = array.NumberOfComponents == 1 ? SCALAR : VARIABLELENGTHVECTOR;
+
+    // The data of the scalars follow their LOOKUP_TABLE line
+    const std::streampos position = inputFile.tellg();
+    StringType           lookupTable;
+    std::getline(inputFile, lookupTable, '\n');
+    if ( lookupTable.find("LOOKUP_TABLE") == std::string::npos )
+      {
+      inputFile.seekg(position);
+      }
+    }
+  else if ( keyword == "COLOR_SCALARS" )
+    {
+    // Color scalars are floats in ASCII and unsigned char in BINARY
+    ss >> array.NumberOfComponents;
+    array.PixelType = VARIABLELENGTHVECTOR;
+    array.ComponentType = this->m_FileType == ASCII ? FLOAT : UCHAR;
+    }
+  else if ( keyword == "VECTORS" || keyword == "NORMALS" )
+    {
+    ss >> componentType;
+    array.ComponentType = this->GetComponentTypeFromVTKName(componentType);
+    array.PixelType = VECTOR;
+    array.NumberOfComponents = this->m_PointDimension;
+    }
+  else if ( keyword == "TENSORS" )
+    {
+    ss >> componentType;
+    array.ComponentType = this->GetComponentTypeFromVTKName(componentType);
+    array.PixelType = SYMMETRICSECONDRANKTENSOR;
+    array.NumberOfComponents = this->m_PointDimension * ( this->m_PointDimension + 1 ) / 2;
+    }
+  else
+    {
+    return false;
+    }
+
+  array.Offset = inputFile.tellg();
+  return true;
 }
 
-void VTKPolyDataMeshIO::WriteMeshInformation()
+
+bool VTKPolyDataMeshIO::SupportsRandomAccess(SectionType section) const
 {
-  // Check file name
-  if ( this->m_FileName == "" )
+  // Only the binary sections have a fixed stride, and the cells have
+  // variable lengths
+  if ( this->m_FileType != BINARY )
     {
-    itkExceptionMacro("No Input FileName");
-    return;
+    return false;
     }
 
-  // Define output file stream
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
+  switch ( section )
     {
-    outputFile.open(this->m_FileName.c_str(), std::ios::out);
+    case POINTS_SECTION:
+      return m_PointsStartPosition >= 0
+             && GetStoredComponentType(this->m_PointComponentType) == this->m_PointComponentType;
+    case POINTDATA_SECTION:
+      return !this->m_PointDataArrays.empty()
+             && GetStoredComponentType(this->m_PointPixelComponentType) == this->m_PointPixelComponentType;
+    case CELLDATA_SECTION:
+      return !this->m_CellDataArrays.empty()
+             && GetStoredComponentType(this->m_CellPixelComponentType) == this->m_CellPixelComponentType;
+    default:
+      return false;
     }
-  else if ( m_FileType == BINARY )
+}
+
+void VTKPolyDataMeshIO::ReadPointsRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints)
+{
+  this->ReadSectionRange(buffer, POINTS_SECTION, m_PointsStartPosition, this->m_PointComponentType,
+                         this->m_PointDimension, firstPoint, numberOfPoints, this->m_NumberOfPoints);
+}
+
+void VTKPolyDataMeshIO::ReadPointDataRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints)
+{
+  const StreamOffsetType position =
+    this->m_PointDataArrays.empty() ? -1 : this->m_PointDataArrays[this->m_SelectedPointDataArray].Offset;
+
+  this->ReadSectionRange(buffer, POINTDATA_SECTION, position, this->m_PointPixelComponentType,
+                         this->m_NumberOfPointPixelComponents, firstPoint, numberOfPoints, this->m_NumberOfPoints);
+}
+
+void VTKPolyDataMeshIO::ReadCellDataRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells)
+{
+  const StreamOffsetType position =
+    this->m_CellDataArrays.empty() ? -1 : this->m_CellDataArrays[this->m_SelectedCellDataArray].Offset;
+
+  this->ReadSectionRange(buffer, CELLDATA_SECTION, position, this->m_CellPixelComponentType,
+                         this->m_NumberOfCellPixelComponents, firstCell, numberOfCells, this->m_NumberOfCells);
+}
+
+void VTKPolyDataMeshIO::ReadSectionRange(void *buffer, SectionType section, StreamOffsetType position,
+                                         IOComponentType componentType, unsigned int numberOfComponents,
+                                         SizeValueType first, SizeValueType count, SizeValueType size)
+{
+  if ( !this->SupportsRandomAccess(section) )
+    {
+    itkExceptionMacro(<< "No ranged reading of this section of " << this->m_FileName
+                      << ", only the binary points, point data and cell data can be read by range");
+    }
+
+  this->VerifyRange(first, count, size);
+
+  this->ReadBufferRangeAsBinary(m_InputFile, buffer, position, componentType, first * numberOfComponents,
+                                count * numberOfComponents);
+}
+
+void VTKPolyDataMeshIO::WriteMeshInformation()
+{
+  // Check file name
+  if ( this->m_FileName == "" && !this->HasOutputSink() )
     {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::out | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::out);
-#endif
+    itkExceptionMacro("No Input FileName");
+    return;
     }
 
-  if ( !outputFile.is_open() )
+  // Appended data follow the sections of the existing file
+  if ( this->m_AppendData )
     {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
+    this->OpenAppendFile();
     return;
     }
 
+  // The output file stays open until Write()
+  this->OpenOutputFile();
+  m_LastWriteSection = POINTS_SECTION;
+
   // Write VTK header
-  outputFile << "# vtk DataFile Version 2.0" << "\n";
-  outputFile << "File written by itkPolyDataMeshIO" << "\n";
+  m_OutputFile << "# vtk DataFile Version 2.0" << "\n";
+  m_OutputFile << "File written by itkPolyDataMeshIO" << "\n";
   if ( m_FileType == ASCII )
     {
-    outputFile << "ASCII" << "\n";
+    m_OutputFile << "ASCII" << "\n";
     }
   else if ( m_FileType == BINARY )
     {
-    outputFile << "BINARY" << "\n";
+    m_OutputFile << "BINARY" << "\n";
     }
   else
     {
     itkExceptionMacro(<< "Invalid output file type (not ASCII or BINARY)");
     }
 
-  outputFile << "DATASET POLYDATA" << "\n";
-
-  outputFile.close();
+  m_OutputFile << "DATASET POLYDATA" << "\n";
 }
 
-void VTKPolyDataMeshIO::WritePoints(void *buffer)
+void VTKPolyDataMeshIO::OpenAppendFile()
 {
-  // Check file name
-  if ( this->m_FileName == "" )
+  // The sections of an output buffer or stream cannot be read back
+  if ( this->HasOutputSink() )
     {
-    itkExceptionMacro("No Input FileName");
-    return;
+    itkExceptionMacro("Data are only appended to an existing file, not to an output buffer or stream");
     }
 
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
+  // The file is described by a MeshIO of its own, so that the mesh
+  // information of the data appended is kept
+  VTKPolyDataMeshIO::Pointer fileIO = VTKPolyDataMeshIO::New();
+  fileIO->SetFileName(this->m_FileName);
+  fileIO->ReadMeshInformation();
+
+  // The appended data are encoded and compressed like the file, and
+  // continue its last data section
+  this->m_FileType = fileIO->m_FileType;
+  this->m_UseCompression = fileIO->m_InputFile.IsCompressed();
+  m_LastWriteSection = fileIO->m_LastWriteSection;
+
+  if ( this->m_UpdatePointData )
     {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
+    if ( this->m_NumberOfPoints != fileIO->m_NumberOfPoints )
+      {
+      itkExceptionMacro(<< "Cannot append the data of " << this->m_NumberOfPoints << " points to "
+                        << this->m_FileName << ", which has " << fileIO->m_NumberOfPoints << " points");
+      }
+
+    const StringType dataName = this->GetDataAttributeName("point", this->m_PointPixelType);
+    if ( HasDataArray(fileIO->m_PointDataArrays, dataName) )
+      {
+      itkExceptionMacro(<< this->m_FileName << " already has point data named " << dataName);
+      }
     }
-  else if ( m_FileType == BINARY )
+
+  if ( this->m_UpdateCellData )
+    {
+    if ( this->m_NumberOfCells != fileIO->m_NumberOfCells )
+      {
+      itkExceptionMacro(<< "Cannot append the data of " << this->m_NumberOfCells << " cells to "
+                        << this->m_FileName << ", which has " << fileIO->m_NumberOfCells << " cells");
+      }
+
+    const StringType dataName = this->GetDataAttributeName("cell", this->m_CellPixelType);
+    if ( HasDataArray(fileIO->m_CellDataArrays, dataName) )
+      {
+      itkExceptionMacro(<< this->m_FileName << " already has cell data named " << dataName);
+      }
+    }
+
+  // The file is released before it is opened for appending
+  fileIO = 0;
+  this->OpenOutputFile(true);
+}
+
+void VTKPolyDataMeshIO::Write()
+{
+  this->CloseOutputFile();
+}
+
+void VTKPolyDataMeshIO::WritePoints(void *buffer)
+{
+  this->BeginWriteSection(POINTS_SECTION);
+  this->WritePointsChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTS_SECTION);
+}
+
+void VTKPolyDataMeshIO::WriteCells(void *buffer)
+{
+  // Count the vertices, lines and polygons of the cells buffer
+  switch ( this->m_CellComponentType )
+    {
+    case UCHAR:
+      {
+      UpdateCellInformation( static_cast< unsigned char * >( buffer ) );
+      break;
+      }
+    case CHAR:
+      {
+      UpdateCellInformation( static_cast< char * >( buffer ) );
+      break;
+      }
+    case USHORT:
+      {
+      UpdateCellInformation( static_cast< unsigned short * >( buffer ) );
+      break;
+      }
+    case SHORT:
+      {
+      UpdateCellInformation( static_cast< short * >( buffer ) );
+      break;
+      }
+    case UINT:
+      {
+      UpdateCellInformation( static_cast< unsigned int * >( buffer ) );
+      break;
+      }
+    case INT:
+      {
+      UpdateCellInformation( static_cast< int * >( buffer ) );
+      break;
+      }
+    case ULONG:
+      {
+      UpdateCellInformation( static_cast< unsigned long * >( buffer ) );
+      break;
+      }
+    case LONG:
+      {
+      UpdateCellInformation( static_cast< long * >( buffer ) );
+      break;
+      }
+    case ULONGLONG:
+      {
+      UpdateCellInformation( static_cast< unsigned long long * >( buffer ) );
+      break;
+      }
+    case LONGLONG:
+      {
+      UpdateCellInformation( static_cast< long long * >( buffer ) );
+      break;
+      }
+    case FLOAT:
+      {
+      UpdateCellInformation( static_cast< float * >( buffer ) );
+      break;
+      }
+    case DOUBLE:
+      {
+      UpdateCellInformation( static_cast< double * >( buffer ) );
+      break;
+      }
+    case LDOUBLE:
+      {
+      UpdateCellInformation( static_cast< long double * >( buffer ) );
+      break;
+      }
+    default:
+      {
+      itkExceptionMacro(<< "Unknown cell component type");
+      }
+    }
+
+  // Every group of cells is written by its own pass over the buffer
+  const unsigned int numberOfPasses = this->GetNumberOfCellsWritePasses();
+  for ( unsigned int pass = 0; pass < numberOfPasses; pass++ )
     {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
+    this->BeginWriteSection(CELLS_SECTION, pass);
+    this->WriteCellsChunk(buffer, this->m_NumberOfCells);
+    this->EndWriteSection(CELLS_SECTION, pass);
     }
+}
+
+void VTKPolyDataMeshIO::WritePointData(void *buffer)
+{
+  this->BeginWriteSection(POINTDATA_SECTION);
+  this->WritePointDataChunk(buffer, this->m_NumberOfPoints);
+  this->EndWriteSection(POINTDATA_SECTION);
+}
 
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
+void VTKPolyDataMeshIO::WriteCellData(void *buffer)
+{
+  this->BeginWriteSection(CELLDATA_SECTION);
+  this->WriteCellDataChunk(buffer, this->m_NumberOfCells);
+  this->EndWriteSection(CELLDATA_SECTION);
+}
 
-  // Write file according to ASCII or BINARY
+void VTKPolyDataMeshIO::WritePointsChunk(void *buffer, SizeValueType numberOfPoints)
+{
   if ( this->m_FileType == ASCII )
     {
     switch ( this->m_PointComponentType )
       {
       case UCHAR:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfPoints);
         break;
         }
       case CHAR:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< char * >( buffer ), " char");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< char * >( buffer ), numberOfPoints);
         break;
         }
       case USHORT:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfPoints);
         break;
         }
-
       case SHORT:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< short * >( buffer ), " short");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< short * >( buffer ), numberOfPoints);
         break;
         }
-
       case UINT:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfPoints);
         break;
         }
-
       case INT:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< int * >( buffer ), " int");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< int * >( buffer ), numberOfPoints);
         break;
         }
       case ULONG:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfPoints);
         break;
         }
       case LONG:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< long * >( buffer ), " long");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< long * >( buffer ), numberOfPoints);
         break;
         }
       case ULONGLONG:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< unsigned long long * >( buffer ), " unsigned_long");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfPoints);
         break;
         }
       case LONGLONG:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< long long * >( buffer ), " long");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< long long * >( buffer ), numberOfPoints);
         break;
         }
       case FLOAT:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< float * >( buffer ), " float");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< float * >( buffer ), numberOfPoints);
         break;
         }
       case DOUBLE:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< double * >( buffer ), " double");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< double * >( buffer ), numberOfPoints);
         break;
         }
       case LDOUBLE:
         {
-        WritePointsBufferAsASCII(outputFile, static_cast< long double * >( buffer ), " double");
+        WritePointsBufferAsASCII(m_OutputFile, static_cast< long double * >( buffer ), numberOfPoints);
         break;
         }
       default:
+        {
         itkExceptionMacro(<< "Unknonwn point component type");
+        }
       }
     }
   else if ( this->m_FileType == BINARY )
@@ -1904,229 +1252,164 @@ void VTKPolyDataMeshIO::WritePoints(void *buffer)
       {
       case UCHAR:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfPoints);
         break;
         }
       case CHAR:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< char * >( buffer ), " char");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< char * >( buffer ), numberOfPoints);
         break;
         }
       case USHORT:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfPoints);
         break;
         }
-
       case SHORT:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< short * >( buffer ), " short");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< short * >( buffer ), numberOfPoints);
         break;
         }
-
       case UINT:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfPoints);
         break;
         }
-
       case INT:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< int * >( buffer ), " int");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< int * >( buffer ), numberOfPoints);
         break;
         }
       case ULONG:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfPoints);
         break;
         }
       case LONG:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< long * >( buffer ), " long");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< long * >( buffer ), numberOfPoints);
         break;
         }
       case ULONGLONG:
         {
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long       numberOfComponent = this->m_NumberOfPoints * this->m_PointDimension;
-        unsigned long *     data = new unsigned long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
-        WritePointsBufferAsBINARY(outputFile, data, " unsigned_long");
-        delete[] data;
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfPoints);
         break;
         }
       case LONGLONG:
         {
-        long long *   input = static_cast< long long * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfPoints * this->m_PointDimension;
-        long *        data = new long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-        WritePointsBufferAsBINARY(outputFile, data, " long");
-        delete[] data;
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< long long * >( buffer ), numberOfPoints);
         break;
         }
       case FLOAT:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< float * >( buffer ), " float");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< float * >( buffer ), numberOfPoints);
         break;
         }
       case DOUBLE:
         {
-        WritePointsBufferAsBINARY(outputFile, static_cast< double * >( buffer ), " double");
+        WritePointsBufferAsBINARY(m_OutputFile, static_cast< double * >( buffer ), numberOfPoints);
         break;
         }
       case LDOUBLE:
         {
-        long double * input = static_cast< long double * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfPoints * this->m_PointDimension;
-        double *      data = new double[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
+        long double *input = static_cast< long double * >( buffer );
+        SizeValueType numberOfComponents = numberOfPoints * this->m_PointDimension;
+        double *data = new double[numberOfComponents];
+        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
           {
           data[ii] = static_cast< double >( input[ii] );
           }
-        WritePointsBufferAsBINARY(outputFile, data, " double");
+        WritePointsBufferAsBINARY(m_OutputFile, data, numberOfPoints);
         delete[] data;
         break;
         }
       default:
+        {
         itkExceptionMacro(<< "Unknonwn point component type");
+        }
       }
     }
   else
     {
     itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
     }
-
-  outputFile.close();
-
-  return;
 }
 
-void VTKPolyDataMeshIO::WriteCells(void *buffer)
+void VTKPolyDataMeshIO::WriteCellsChunk(void *buffer, SizeValueType numberOfCells)
 {
-  // Check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
-
-  // Write file according to ASCII or BINARY
   if ( this->m_FileType == ASCII )
     {
     switch ( this->m_CellComponentType )
       {
       case UCHAR:
         {
-        UpdateCellInformation( static_cast< unsigned char * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< unsigned char * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfCells);
         break;
         }
       case CHAR:
         {
-        UpdateCellInformation( static_cast< char * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< char * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< char * >( buffer ), numberOfCells);
         break;
         }
       case USHORT:
         {
-        UpdateCellInformation( static_cast< unsigned short * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< unsigned short * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfCells);
         break;
         }
-
       case SHORT:
         {
-        UpdateCellInformation( static_cast< short * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< short * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< short * >( buffer ), numberOfCells);
         break;
         }
-
       case UINT:
         {
-        UpdateCellInformation( static_cast< unsigned int * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< unsigned int * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfCells);
         break;
         }
-
       case INT:
         {
-        UpdateCellInformation( static_cast< int * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< int * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< int * >( buffer ), numberOfCells);
         break;
         }
       case ULONG:
         {
-        UpdateCellInformation( static_cast< unsigned long * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< unsigned long * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfCells);
         break;
         }
       case LONG:
         {
-        UpdateCellInformation( static_cast< long * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< long * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< long * >( buffer ), numberOfCells);
         break;
         }
       case ULONGLONG:
         {
-        UpdateCellInformation( static_cast< unsigned long long * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< unsigned long long * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfCells);
         break;
         }
       case LONGLONG:
         {
-        UpdateCellInformation( static_cast< long long * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< long long * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< long long * >( buffer ), numberOfCells);
         break;
         }
       case FLOAT:
         {
-        UpdateCellInformation( static_cast< float * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< float * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< float * >( buffer ), numberOfCells);
         break;
         }
       case DOUBLE:
         {
-        UpdateCellInformation( static_cast< double * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< double * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< double * >( buffer ), numberOfCells);
         break;
         }
       case LDOUBLE:
         {
-        UpdateCellInformation( static_cast< long double * >( buffer ) );
-        WriteCellsBufferAsASCII( outputFile, static_cast< long double * >( buffer ) );
+        WriteCellsBufferAsASCII(m_OutputFile, static_cast< long double * >( buffer ), numberOfCells);
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn cell component type");
+        {
+        itkExceptionMacro(<< "Unknown cell component type");
+        }
       }
     }
   else if ( this->m_FileType == BINARY )
@@ -2135,202 +1418,156 @@ void VTKPolyDataMeshIO::WriteCells(void *buffer)
       {
       case UCHAR:
         {
-        UpdateCellInformation( static_cast< unsigned char * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< unsigned char * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfCells);
         break;
         }
       case CHAR:
         {
-        UpdateCellInformation( static_cast< char * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< char * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< char * >( buffer ), numberOfCells);
         break;
         }
       case USHORT:
         {
-        UpdateCellInformation( static_cast< unsigned short * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< unsigned short * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfCells);
         break;
         }
-
       case SHORT:
         {
-        UpdateCellInformation( static_cast< short * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< short * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< short * >( buffer ), numberOfCells);
         break;
         }
-
       case UINT:
         {
-        UpdateCellInformation( static_cast< unsigned int * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< unsigned int * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfCells);
         break;
         }
-
       case INT:
         {
-        UpdateCellInformation( static_cast< int * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< int * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< int * >( buffer ), numberOfCells);
         break;
         }
       case ULONG:
         {
-        UpdateCellInformation( static_cast< unsigned long * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< unsigned long * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfCells);
         break;
         }
       case LONG:
         {
-        UpdateCellInformation( static_cast< long * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< long * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< long * >( buffer ), numberOfCells);
         break;
         }
       case ULONGLONG:
         {
-        UpdateCellInformation( static_cast< unsigned long long * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< unsigned long long * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfCells);
         break;
         }
       case LONGLONG:
         {
-        UpdateCellInformation( static_cast< long long * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< long long * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< long long * >( buffer ), numberOfCells);
         break;
         }
       case FLOAT:
         {
-        UpdateCellInformation( static_cast< float * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< float * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< float * >( buffer ), numberOfCells);
         break;
         }
       case DOUBLE:
         {
-        UpdateCellInformation( static_cast< double * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< double * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< double * >( buffer ), numberOfCells);
         break;
         }
       case LDOUBLE:
         {
-        UpdateCellInformation( static_cast< long double * >( buffer ) );
-        WriteCellsBufferAsBINARY( outputFile, static_cast< long double * >( buffer ) );
+        WriteCellsBufferAsBINARY(m_OutputFile, static_cast< long double * >( buffer ), numberOfCells);
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn cell component type");
+        {
+        itkExceptionMacro(<< "Unknown cell component type");
+        }
       }
     }
   else
     {
     itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
     }
-
-  outputFile.close();
 }
 
-void VTKPolyDataMeshIO::WritePointData(void *buffer)
+void VTKPolyDataMeshIO::WritePointDataChunk(void *buffer, SizeValueType numberOfPoints)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
-
-  // Write point data according to ASCII or BINARY
   if ( this->m_FileType == ASCII )
     {
     switch ( this->m_PointPixelComponentType )
       {
       case UCHAR:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfPoints);
         break;
         }
       case CHAR:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< char * >( buffer ), " char");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< char * >( buffer ), numberOfPoints);
         break;
         }
       case USHORT:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfPoints);
         break;
         }
-
       case SHORT:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< short * >( buffer ), " short");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< short * >( buffer ), numberOfPoints);
         break;
         }
-
       case UINT:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfPoints);
         break;
         }
       case INT:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< int * >( buffer ), " int");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< int * >( buffer ), numberOfPoints);
         break;
         }
       case ULONG:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfPoints);
         break;
         }
       case LONG:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< long * >( buffer ), " long");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< long * >( buffer ), numberOfPoints);
         break;
         }
       case ULONGLONG:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< unsigned long long * >( buffer ), " unsigned_long");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfPoints);
         break;
         }
       case LONGLONG:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< long long * >( buffer ), " long");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< long long * >( buffer ), numberOfPoints);
         break;
         }
       case FLOAT:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< float * >( buffer ), " float");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< float * >( buffer ), numberOfPoints);
         break;
         }
       case DOUBLE:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< double * >( buffer ), " double");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< double * >( buffer ), numberOfPoints);
         break;
         }
       case LDOUBLE:
         {
-        WritePointDataBufferAsASCII(outputFile, static_cast< long double * >( buffer ), " double");
+        WritePointDataBufferAsASCII(m_OutputFile, static_cast< long double * >( buffer ), numberOfPoints);
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn point pixel component type");
+        {
+        itkExceptionMacro(<< "Unknown point pixel component type");
+        }
       }
     }
   else if ( this->m_FileType == BINARY )
@@ -2339,219 +1576,164 @@ void VTKPolyDataMeshIO::WritePointData(void *buffer)
       {
       case UCHAR:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfPoints);
         break;
         }
       case CHAR:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< char * >( buffer ), " char");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< char * >( buffer ), numberOfPoints);
         break;
         }
       case USHORT:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfPoints);
         break;
         }
-
       case SHORT:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< short * >( buffer ), " short");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< short * >( buffer ), numberOfPoints);
         break;
         }
-
       case UINT:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfPoints);
         break;
         }
-
       case INT:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< int * >( buffer ), " int");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< int * >( buffer ), numberOfPoints);
         break;
         }
       case ULONG:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfPoints);
         break;
         }
       case LONG:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< long * >( buffer ), " long");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< long * >( buffer ), numberOfPoints);
         break;
         }
       case ULONGLONG:
         {
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long       numberOfComponent = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        unsigned long *     data = new unsigned long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
-
-        WritePointDataBufferAsBINARY(outputFile, data, " unsigned_long");
-        delete[] data;
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfPoints);
         break;
         }
       case LONGLONG:
         {
-        long long *   input = static_cast< long long * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        long *        data = new long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-
-        WritePointDataBufferAsBINARY(outputFile, data, " long");
-        delete[] data;
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< long long * >( buffer ), numberOfPoints);
         break;
         }
       case FLOAT:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< float * >( buffer ), " float");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< float * >( buffer ), numberOfPoints);
         break;
         }
       case DOUBLE:
         {
-        WritePointDataBufferAsBINARY(outputFile, static_cast< double * >( buffer ), " double");
+        WritePointDataBufferAsBINARY(m_OutputFile, static_cast< double * >( buffer ), numberOfPoints);
         break;
         }
       case LDOUBLE:
         {
-        long double * input = static_cast< long double * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        double *      data = new double[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
+        long double *input = static_cast< long double * >( buffer );
+        SizeValueType numberOfComponents = numberOfPoints * this->m_NumberOfPointPixelComponents;
+        double *data = new double[numberOfComponents];
+        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
           {
           data[ii] = static_cast< double >( input[ii] );
           }
-
-        WritePointDataBufferAsBINARY(outputFile, data, " double");
+        WritePointDataBufferAsBINARY(m_OutputFile, data, numberOfPoints);
         delete[] data;
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn point pixel component type");
+        {
+        itkExceptionMacro(<< "Unknown point pixel component type");
+        }
       }
     }
   else
     {
     itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
     }
-
-  outputFile.close();
-
-  return;
 }
 
-void VTKPolyDataMeshIO::WriteCellData(void *buffer)
+void VTKPolyDataMeshIO::WriteCellDataChunk(void *buffer, SizeValueType numberOfCells)
 {
-  // check file name
-  if ( this->m_FileName == "" )
-    {
-    itkExceptionMacro("No Input FileName");
-    return;
-    }
-
-  // Write to output file
-  std::ofstream outputFile;
-  if ( this->m_FileType == ASCII )
-    {
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-    }
-  else if ( m_FileType == BINARY )
-    {
-#ifdef _WIN32
-    outputFile.open(this->m_FileName.c_str(), std::ios::app | std::ios::binary);
-#else
-    outputFile.open(this->m_FileName.c_str(), std::ios::app);
-#endif
-    }
-
-  if ( !outputFile.is_open() )
-    {
-    itkExceptionMacro("Unable to open file\n"
-                      "outputFilename= " << this->m_FileName);
-    return;
-    }
-
-  // Write cell data according to ASCII or BINARY
   if ( this->m_FileType == ASCII )
     {
     switch ( this->m_CellPixelComponentType )
       {
       case UCHAR:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfCells);
         break;
         }
       case CHAR:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< char * >( buffer ), " char");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< char * >( buffer ), numberOfCells);
         break;
         }
       case USHORT:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfCells);
         break;
         }
-
       case SHORT:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< short * >( buffer ), " short");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< short * >( buffer ), numberOfCells);
         break;
         }
-
       case UINT:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfCells);
         break;
         }
-
       case INT:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< int * >( buffer ), " int");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< int * >( buffer ), numberOfCells);
         break;
         }
       case ULONG:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfCells);
         break;
         }
       case LONG:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< long * >( buffer ), " long");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< long * >( buffer ), numberOfCells);
         break;
         }
       case ULONGLONG:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< unsigned long long * >( buffer ), " unsigned_long");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfCells);
         break;
         }
       case LONGLONG:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< long long * >( buffer ), " long");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< long long * >( buffer ), numberOfCells);
         break;
         }
       case FLOAT:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< float * >( buffer ), " float");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< float * >( buffer ), numberOfCells);
         break;
         }
       case DOUBLE:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< double * >( buffer ), " double");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< double * >( buffer ), numberOfCells);
         break;
         }
       case LDOUBLE:
         {
-        WriteCellDataBufferAsASCII(outputFile, static_cast< long double * >( buffer ), " double");
+        WriteCellDataBufferAsASCII(m_OutputFile, static_cast< long double * >( buffer ), numberOfCells);
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn cell pixel component type");
+        {
+        itkExceptionMacro(<< "Unknown cell pixel component type");
+        }
       }
     }
   else if ( this->m_FileType == BINARY )
@@ -2560,111 +1742,425 @@ void VTKPolyDataMeshIO::WriteCellData(void *buffer)
       {
       case UCHAR:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< unsigned char * >( buffer ), " unsigned_char");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< unsigned char * >( buffer ), numberOfCells);
         break;
         }
       case CHAR:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< char * >( buffer ), " char");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< char * >( buffer ), numberOfCells);
         break;
         }
       case USHORT:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< unsigned short * >( buffer ), " unsigned_short");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< unsigned short * >( buffer ), numberOfCells);
         break;
         }
-
       case SHORT:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< short * >( buffer ), " short");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< short * >( buffer ), numberOfCells);
         break;
         }
-
       case UINT:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< unsigned int * >( buffer ), " unsigned_int");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< unsigned int * >( buffer ), numberOfCells);
         break;
         }
-
       case INT:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< int * >( buffer ), " int");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< int * >( buffer ), numberOfCells);
         break;
         }
       case ULONG:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< unsigned long * >( buffer ), " unsigned_long");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< unsigned long * >( buffer ), numberOfCells);
         break;
         }
       case LONG:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< long * >( buffer ), " long");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< long * >( buffer ), numberOfCells);
         break;
         }
       case ULONGLONG:
         {
-        unsigned long long *input = static_cast< unsigned long long * >( buffer );
-        unsigned long       numberOfComponent = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        unsigned long *     data = new unsigned long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< unsigned long >( input[ii] );
-          }
-
-        WriteCellDataBufferAsBINARY(outputFile, data, " unsigned_long");
-        delete[] data;
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< unsigned long long * >( buffer ), numberOfCells);
         break;
         }
       case LONGLONG:
         {
-        long long *   input = static_cast< long long * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        long *        data = new long[numberOfComponent];
-        for ( unsigned long ii = 0; ii < numberOfComponent; ii++ )
-          {
-          data[ii] = static_cast< long >( input[ii] );
-          }
-
-        WriteCellDataBufferAsBINARY(outputFile, data, " long");
-        delete[] data;
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< long long * >( buffer ), numberOfCells);
         break;
         }
       case FLOAT:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< float * >( buffer ), " float");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< float * >( buffer ), numberOfCells);
         break;
         }
       case DOUBLE:
         {
-        WriteCellDataBufferAsBINARY(outputFile, static_cast< double * >( buffer ), " double");
+        WriteCellDataBufferAsBINARY(m_OutputFile, static_cast< double * >( buffer ), numberOfCells);
         break;
         }
       case LDOUBLE:
         {
-        long double * input = static_cast< long double * >( buffer );
-        unsigned long numberOfComponent = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        double *      data = new double[numberOfComponent];
-        for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+        long double *input = static_cast< long double * >( buffer );
+        SizeValueType numberOfComponents = numberOfCells * this->m_NumberOfCellPixelComponents;
+        double *data = new double[numberOfComponents];
+        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
           {
           data[ii] = static_cast< double >( input[ii] );
           }
-
-        WriteCellDataBufferAsBINARY(outputFile, data, " double");
+        WriteCellDataBufferAsBINARY(m_OutputFile, data, numberOfCells);
         delete[] data;
         break;
         }
       default:
-        itkExceptionMacro(<< "Unknonwn cell pixel component type");
+        {
+        itkExceptionMacro(<< "Unknown cell pixel component type");
+        }
       }
     }
   else
     {
     itkExceptionMacro(<< "Invalid output file type(not ASCII or BINARY)");
     }
+}
+
+void VTKPolyDataMeshIO::BeginWriteSection(SectionType section, unsigned int pass)
+{
+  Superclass::BeginWriteSection(section, pass);
+
+  // Write the section header, the data follows in chunks
+  switch ( section )
+    {
+    case POINTS_SECTION:
+      {
+      m_OutputFile << "POINTS " << this->m_NumberOfPoints << " "
+                   << this->GetComponentTypeNameForVTK(this->m_PointComponentType) << '\n';
+      break;
+      }
+    case CELLS_SECTION:
+      {
+      // The legacy binary files store the point identifiers as 32 bits
+      // integers
+      if ( this->m_FileType == BINARY && this->m_NumberOfPoints > NumericTraits< unsigned int >::max() )
+        {
+        itkExceptionMacro(<< "The identifiers of " << this->m_NumberOfPoints
+                          << " points cannot be written to a binary VTK file");
+        }
+
+      StringType    keyword;
+      SizeValueType numberOfCells = 0;
+      SizeValueType numberOfIndices = 0;
+      if ( !this->GetCellsWritePassInformation(pass, m_CellsWriteGroup, keyword, numberOfCells, numberOfIndices) )
+        {
+        itkExceptionMacro(<< "Invalid cells write pass " << pass);
+        }
+
+      m_OutputFile << keyword << " " << numberOfCells << " " << numberOfIndices << '\n';
+      break;
+      }
+    case POINTDATA_SECTION:
+      {
+      if ( m_LastWriteSection != POINTDATA_SECTION )
+        {
+        m_OutputFile << "POINT_DATA " << this->m_NumberOfPoints << '\n';
+        }
+      this->WriteDataAttributeHeader("point", this->m_PointPixelType, this->m_PointPixelComponentType,
+                                     this->m_NumberOfPointPixelComponents);
+      break;
+      }
+    case CELLDATA_SECTION:
+      {
+      if ( m_LastWriteSection != CELLDATA_SECTION )
+        {
+        m_OutputFile << "CELL_DATA " << this->m_NumberOfCells << '\n';
+        }
+      this->WriteDataAttributeHeader("cell", this->m_CellPixelType, this->m_CellPixelComponentType,
+                                     this->m_NumberOfCellPixelComponents);
+      break;
+      }
+    }
+  m_LastWriteSection = section;
+}
+
+void VTKPolyDataMeshIO::EndWriteSection(SectionType section, unsigned int pass)
+{
+  // Binary data is followed by a new line
+  if ( this->m_FileType == BINARY )
+    {
+    m_OutputFile << "\n";
+    }
+
+  Superclass::EndWriteSection(section, pass);
+}
+
+unsigned int VTKPolyDataMeshIO::GetNumberOfCellsWritePasses()
+{
+  if ( this->m_CellTypeStatisticsAvailable )
+    {
+    this->UpdateCellInformation();
+    }
+
+  // One pass for each of the vertices, lines and polygons present
+  unsigned int     numberOfPasses = 0;
+  CellGeometryType group;
+  StringType       keyword;
+  SizeValueType    numberOfCells = 0;
+  SizeValueType    numberOfIndices = 0;
+  while ( this->GetCellsWritePassInformation(numberOfPasses, group, keyword, numberOfCells, numberOfIndices) )
+    {
+    numberOfPasses++;
+    }
+
+  return numberOfPasses;
+}
+
+bool VTKPolyDataMeshIO::GetCellsWritePassInformation(unsigned int pass, CellGeometryType & group, StringType & keyword,
+                                                     SizeValueType & numberOfCells, SizeValueType & numberOfIndices)
+{
+  const MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
+  const CellGeometryType     groups[3] = { VERTEX_CELL, POLYLINE_CELL, POLYGON_CELL };
+  const char *               keywords[3] = { "VERTICES", "LINES", "POLYGONS" };
+  const char *               cellsKeys[3] = { "numberOfVertices", "numberOfLines", "numberOfPolygons" };
+  const char *               indicesKeys[3] = { "numberOfVertexIndices", "numberOfLineIndices", "numberOfPolygonIndices" };
+
+  // Empty groups are skipped
+  unsigned int remainingPasses = pass;
+  for ( unsigned int ii = 0; ii < 3; ii++ )
+    {
+    numberOfCells = 0;
+    numberOfIndices = 0;
+    ExposeMetaData< SizeValueType >(metaDic, cellsKeys[ii], numberOfCells);
+    if ( numberOfCells )
+      {
+      if ( remainingPasses == 0 )
+        {
+        ExposeMetaData< SizeValueType >(metaDic, indicesKeys[ii], numberOfIndices);
+        group = groups[ii];
+        keyword = keywords[ii];
+        return true;
+        }
+      remainingPasses--;
+      }
+    }
+
+  return false;
+}
+
+void VTKPolyDataMeshIO::UpdateCellInformation()
+{
+  if ( !this->m_CellTypeStatisticsAvailable )
+    {
+    itkExceptionMacro(<< "Cell type statistics are not available");
+    }
+
+  for ( unsigned int ii = 0; ii < LAST_ITK_CELL; ii++ )
+    {
+    if ( this->m_NumberOfCellsOfType[ii] && ii != VERTEX_CELL && ii != POLYLINE_CELL
+         && ii != TRIANGLE_CELL && ii != POLYGON_CELL )
+      {
+      itkExceptionMacro(<< "Currently we dont support this cell type");
+      }
+    }
+
+  SizeValueType numberOfVertices = this->m_NumberOfCellsOfType[VERTEX_CELL];
+  SizeValueType numberOfLines = this->m_NumberOfCellsOfType[POLYLINE_CELL];
+  SizeValueType numberOfPolygons = this->m_NumberOfCellsOfType[TRIANGLE_CELL] + this->m_NumberOfCellsOfType[POLYGON_CELL];
+
+  MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertices", numberOfVertices);
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertexIndices",
+                                      this->m_NumberOfCellPointsOfType[VERTEX_CELL] + numberOfVertices);
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLines", numberOfLines);
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLineIndices",
+                                      this->m_NumberOfCellPointsOfType[POLYLINE_CELL] + numberOfLines);
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygons", numberOfPolygons);
+  EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygonIndices",
+                                      this->m_NumberOfCellPointsOfType[TRIANGLE_CELL]
+                                      + this->m_NumberOfCellPointsOfType[POLYGON_CELL] + numberOfPolygons);
+}
+
+VTKPolyDataMeshIO::StringType VTKPolyDataMeshIO::GetDataAttributeName(const StringType & attribute,
+                                                                      IOPixelType pixelType) const
+{
+  StringType key;
+
+  switch ( pixelType )
+    {
+    case SCALAR:
+      {
+      key = "ScalarDataName";
+      break;
+      }
+    case OFFSET:
+    case POINT:
+    case COVARIANTVECTOR:
+    case VECTOR:
+      {
+      key = "VectorDataName";
+      break;
+      }
+    case SYMMETRICSECONDRANKTENSOR:
+    case DIFFUSIONTENSOR3D:
+      {
+      key = "TensorDataName";
+      break;
+      }
+    case ARRAY:
+    case VARIABLELENGTHVECTOR:
+      {
+      key = "ColorScalarDataName";
+      break;
+      }
+    default:
+      {
+      itkExceptionMacro(<< "Unknown " << attribute << " pixel type");
+      }
+    }
+
+  StringType dataName;
+  ExposeMetaData< StringType >(this->GetMetaDataDictionary(), attribute + key, dataName);
+  return dataName;
+}
+
+void VTKPolyDataMeshIO::WriteDataAttributeHeader(const StringType & attribute, IOPixelType pixelType,
+                                                 IOComponentType componentType, unsigned int numberOfComponents)
+{
+  const StringType dataName = this->GetDataAttributeName(attribute, pixelType);
+
+  switch ( pixelType )
+    {
+    case SCALAR:
+      {
+      m_OutputFile << "SCALARS " << dataName << "  ";
+      break;
+      }
+    case ARRAY:
+    case VARIABLELENGTHVECTOR:
+      {
+      // Color scalars are written as floats in ASCII and unsigned char in
+      // BINARY, so only the number of components follows the name
+      m_OutputFile << "COLOR_SCALARS " << dataName << "  " << numberOfComponents << "\n";
+      return;
+      }
+    case SYMMETRICSECONDRANKTENSOR:
+    case DIFFUSIONTENSOR3D:
+      {
+      m_OutputFile << "TENSORS " << dataName << "  ";
+      break;
+      }
+    default:
+      {
+      m_OutputFile << "VECTORS " << dataName << "  ";
+      break;
+      }
+    }
+
+  m_OutputFile << " " << this->GetComponentTypeNameForVTK(componentType) << '\n';
+  if ( pixelType == SCALAR )
+    {
+    m_OutputFile << "LOOKUP_TABLE default" << '\n';
+    }
+}
+
+const char * VTKPolyDataMeshIO::GetComponentTypeNameForVTK(IOComponentType componentType) const
+{
+  // The 64 bits integers have the fixed size types of VTK, as long is 32
+  // bits on some platforms. VTK has no long double type.
+  switch ( componentType )
+    {
+    case UCHAR:
+      return "unsigned_char";
+    case CHAR:
+      return "char";
+    case USHORT:
+      return "unsigned_short";
+    case SHORT:
+      return "short";
+    case UINT:
+      return "unsigned_int";
+    case INT:
+      return "int";
+    case ULONG:
+      return "unsigned_long";
+    case LONG:
+      return "long";
+    case ULONGLONG:
+      return "vtktypeuint64";
+    case LONGLONG:
+      return "vtktypeint64";
+    case FLOAT:
+      return "float";
+    case DOUBLE:
+      return "double";
+    case LDOUBLE:
+      return "double";
+    default:
+      itkExceptionMacro(<< "Unknown component type: " << componentType);
+    }
+
+  return "";
+}
 
-  outputFile.close();
+MeshIOBase::IOComponentType VTKPolyDataMeshIO::GetComponentTypeFromVTKName(const StringType & name) const
+{
+  // The long long and long double names are not supported by standard vtk
+  // format, which names the 64 bits integers vtktypeuint64 and vtktypeint64
+  if ( name == "unsigned_char" )
+    {
+    return UCHAR;
+    }
+  else if ( name == "char" )
+    {
+    return CHAR;
+    }
+  else if ( name == "unsigned_short" )
+    {
+    return USHORT;
+    }
+  else if ( name == "short" )
+    {
+    return SHORT;
+    }
+  else if ( name == "unsigned_int" )
+    {
+    return UINT;
+    }
+  else if ( name == "int" )
+    {
+    return INT;
+    }
+  else if ( name == "unsigned_long" )
+    {
+    return ULONG;
+    }
+  else if ( name == "long" )
+    {
+    return LONG;
+    }
+  else if ( name == "unsigned_long_long" || name == "vtktypeuint64" )
+    {
+    return ULONGLONG;
+    }
+  else if ( name == "long_long" || name == "vtktypeint64" )
+    {
+    return LONGLONG;
+    }
+  else if ( name == "float" )
+    {
+    return FLOAT;
+    }
+  else if ( name == "double" )
+    {
+    return DOUBLE;
+    }
+  else if ( name == "long_double" )
+    {
+    return LDOUBLE;
+    }
 
-  return;
+  itkExceptionMacro(<< "Unknown component type: " << name);
+  return UNKNOWNCOMPONENTTYPE;
 }
 
 void VTKPolyDataMeshIO::PrintSelf(std::ostream & os, Indent indent) const
@@ -2672,19 +2168,19 @@ void VTKPolyDataMeshIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
 
   const MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-  unsigned int value = 0;
+  SizeValueType              value = 0;
 
-  if ( ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", value) )
+  if ( ExposeMetaData< SizeValueType >(metaDic, "numberOfVertices", value) )
     {
     os << indent << "number of vertices : " << value << std::endl;
     }
 
-  if ( ExposeMetaData< unsigned int >(metaDic, "numberOfLines", value) )
+  if ( ExposeMetaData< SizeValueType >(metaDic, "numberOfLines", value) )
     {
     os << indent << "number of lines : " << value << std::endl;
     }
 
-  if ( ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", value) )
+  if ( ExposeMetaData< SizeValueType >(metaDic, "numberOfPolygons", value) )
     {
     os << indent << "number of polygons : " << value << std::endl;
     }
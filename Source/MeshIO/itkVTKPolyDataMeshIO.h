@@ -21,7 +21,7 @@
 #pragma warning ( disable : 4786 )
 #endif
 
-#include "itkByteSwapper.h"
+#include "itkMeshByteSwapper.h"
 #include "itkMetaDataObject.h"
 #include "itkMeshIOBase.h"
 
@@ -61,12 +61,9 @@ public:
 
   /**-------- This part of the interfaces deals with reading data. ----- */
 
-  /** Determine if the file can be read with this MeshIO implementation.
-  * \param FileNameToRead The name of the file to test for reading.
-  * \post Sets classes MeshIOBase::m_FileName variable to be FileNameToWrite
-  * \return Returns true if this MeshIO can read the file specified.
-  */
-  virtual bool CanReadFile(const char *FileNameToRead);
+  /** Score the header of a file: 100 for the first line of the legacy vtk
+   * files, unless they hold another dataset than polygonal data */
+  virtual unsigned int ScoreFileHeader(const std::string & header) const;
 
   /** Set the spacing and dimension information for the set filename. */
   virtual void ReadMeshInformation();
@@ -80,6 +77,26 @@ public:
 
   virtual void ReadCellData(void *buffer);
 
+  virtual void CloseInputFile();
+
+  virtual bool SupportsConcurrentReads() const { return true; }
+
+  /** The named point data and cell data arrays are read in a single pass
+   * over the file. */
+  virtual void ReadPointDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers);
+
+  virtual void ReadCellDataArrays(const std::vector< std::string > & names, const std::vector< void * > & buffers);
+
+  /** The points, point data and cell data of binary files are read by range
+   * at their offset in the section. */
+  virtual bool SupportsRandomAccess(SectionType section) const;
+
+  virtual void ReadPointsRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
+  virtual void ReadPointDataRange(void *buffer, SizeValueType firstPoint, SizeValueType numberOfPoints);
+
+  virtual void ReadCellDataRange(void *buffer, SizeValueType firstCell, SizeValueType numberOfCells);
+
   /*-------- This part of the interfaces deals with writing data. ----- */
   /** Determine if the file can be written with this MeshIO implementation.
    * \param FileNameToWrite The name of the file to test for writing.
@@ -101,26 +118,61 @@ public:
 
   virtual void WriteCellData(void *buffer);
 
-  virtual void Write(){}
+  virtual void Write();
+
+  /** Polydata files are written chunk by chunk, the cells are written in one
+   * pass for each of the vertices, lines and polygons. */
+  virtual bool CanStreamWrite() { return true; }
+
+  virtual unsigned int GetNumberOfCellsWritePasses();
+
+  virtual void BeginWriteSection(SectionType section, unsigned int pass = 0);
+
+  virtual void EndWriteSection(SectionType section, unsigned int pass = 0);
+
+  virtual void WritePointsChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellsChunk(void *buffer, SizeValueType numberOfCells);
+
+  virtual void WritePointDataChunk(void *buffer, SizeValueType numberOfPoints);
+
+  virtual void WriteCellDataChunk(void *buffer, SizeValueType numberOfCells);
+
+  /** Point data and cell data attributes are appended at the end of the
+   * file, after its last POINT_DATA or CELL_DATA section. */
+  virtual bool CanAppendData() { return true; }
+
 protected:
   VTKPolyDataMeshIO();
   virtual ~VTKPolyDataMeshIO() {}
 
   void PrintSelf(std::ostream & os, Indent indent) const;
 
+  /** Update the number of vertices, lines and polygons from the cell type
+    statistics */
+  void UpdateCellInformation();
+
   template< typename T >
   void UpdateCellInformation(T *buffer)
     {
-    unsigned int numberOfVertices = 0;
-    unsigned int numberOfVertexIndices = 0;
-    unsigned int numberOfLines = 0;
-    unsigned int numberOfLineIndices = 0;
-    unsigned int numberOfPolygons = 0;
-    unsigned int numberOfPolygonIndices = 0;
+    if ( this->m_CellTypeStatisticsAvailable )
+      {
+      // The statistics were gathered while the cell buffer was filled, so
+      // there is no need to scan the buffer again
+      this->UpdateCellInformation();
+      return;
+      }
 
-    unsigned long index = 0;
+    SizeValueType numberOfVertices = 0;
+    SizeValueType numberOfVertexIndices = 0;
+    SizeValueType numberOfLines = 0;
+    SizeValueType numberOfLineIndices = 0;
+    SizeValueType numberOfPolygons = 0;
+    SizeValueType numberOfPolygonIndices = 0;
 
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    SizeValueType index = 0;
+
+    for ( SizeValueType ii = 0; ii < this->m_NumberOfCells; ii++ )
       {
       MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
       unsigned int nn = static_cast< unsigned int >( buffer[index++] );
@@ -150,17 +202,17 @@ protected:
       }
 
     MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-    EncapsulateMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertices", numberOfVertices);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLines", numberOfLines);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfLineIndices", numberOfLineIndices);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygons", numberOfPolygons);
+    EncapsulateMetaData< SizeValueType >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
     return;
     }
 
   template< typename T >
-  void ReadPointsBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadPointsBufferAsASCII(std::istream & inputFile, T *buffer)
     {
     std::string line;
 
@@ -171,17 +223,14 @@ protected:
       if ( line.find("POINTS") != std::string::npos )
         {
         /**  Load the point coordinates into the itk::Mesh */
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        for ( unsigned int ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
+        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+        this->ReadBufferAsAscii(buffer, inputFile, numberOfComponents);
         }
       }
     }
 
   template< typename T >
-  void ReadPointsBufferAsBINARY(std::ifstream & inputFile, T *buffer)
+  void ReadPointsBufferAsBINARY(std::istream & inputFile, T *buffer)
     {
     std::string line;
 
@@ -192,706 +241,386 @@ protected:
       if ( line.find("POINTS") != std::string::npos )
         {
         /**  Load the point coordinates into the itk::Mesh */
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
+        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
+        this->ReadBufferAsBinary(buffer, inputFile, numberOfComponents);
         }
       }
     }
 
-  void ReadCellsBufferAsASCII(std::ifstream & inputFile, void *buffer);
-
-  void ReadCellsBufferAsBINARY(std::ifstream & inputFile, void *buffer);
-
+  /** Read the vertices, lines and polygons into a cell buffer of T */
   template< typename T >
-  void ReadPointDataBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadCellsBufferAsASCII(std::istream & inputFile, T *buffer)
     {
-    StringType line;
+    std::string                line;
+    SizeValueType              index = 0;
+    unsigned int               numberOfCellPoints = 0;
+    const MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
 
     while ( !inputFile.eof() )
       {
       std::getline(inputFile, line, '\n');
-      if ( line.find("POINT_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        for ( unsigned int ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
+      CellGeometryType cellType;
+      SizeValueType    numberOfCells = 0;
+      if ( line.find("VERTICES") != std::string::npos )
+        {
+        cellType = VERTEX_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfVertices", numberOfCells);
         }
-      }
-    }
-
-  template< typename T >
-  void ReadPointDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
-    {
-    StringType line;
-
-    while ( !inputFile.eof() )
-      {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("POINT_DATA") != std::string::npos )
+      else if ( line.find("LINES") != std::string::npos )
         {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
+        cellType = POLYLINE_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfLines", numberOfCells);
+        }
+      else if ( line.find("POLYGONS") != std::string::npos )
+        {
+        cellType = POLYGON_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfPolygons", numberOfCells);
+        }
+      else
+        {
+        continue;
+        }
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        unsigned long numberOfComponents = this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
+      for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
+        {
+        MeshNumberParser::Read(inputFile, numberOfCellPoints);
+        buffer[index++] = static_cast< T >( cellType );
+        buffer[index++] = static_cast< T >( numberOfCellPoints );
+        this->ReadBufferAsAscii(buffer + index, inputFile, numberOfCellPoints);
+        index += numberOfCellPoints;
         }
       }
     }
 
+  /** Read the vertices, lines and polygons into a cell buffer of T. The
+   * legacy binary files store them as 32 bits integers. */
   template< typename T >
-  void ReadCellDataBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadCellsBufferAsBINARY(std::istream & inputFile, T *buffer)
     {
-    StringType line;
+    std::string                 line;
+    std::vector< unsigned int > data;
+    T *                         output = buffer;
+    const MetaDataDictionary &  metaDic = this->GetMetaDataDictionary();
 
     while ( !inputFile.eof() )
       {
       std::getline(inputFile, line, '\n');
-      if ( line.find("CELL_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read CELL_DATA");
-          }
 
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
+      CellGeometryType cellType;
+      SizeValueType    numberOfCells = 0;
+      SizeValueType    numberOfIndices = 0;
+      if ( line.find("VERTICES") != std::string::npos )
+        {
+        cellType = VERTEX_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfVertices", numberOfCells);
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfVertexIndices", numberOfIndices);
+        }
+      else if ( line.find("LINES") != std::string::npos )
+        {
+        cellType = POLYLINE_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfLines", numberOfCells);
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfLineIndices", numberOfIndices);
+        }
+      else if ( line.find("POLYGONS") != std::string::npos )
+        {
+        cellType = POLYGON_CELL;
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfPolygons", numberOfCells);
+        ExposeMetaData< SizeValueType >(metaDic, "numberOfPolygonIndices", numberOfIndices);
+        }
+      else
+        {
+        continue;
+        }
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        unsigned long numberOfComponents = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        for ( unsigned int ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
+      if ( numberOfIndices == 0 )
+        {
+        continue;
         }
+
+      data.resize(numberOfIndices);
+      this->ReadBufferAsBinary(&data[0], inputFile, numberOfIndices);
+      this->WriteCellsBuffer(&data[0], output, cellType, numberOfCells);
+      output += numberOfIndices + numberOfCells;
       }
     }
 
-  template< typename T >
-  void ReadCellDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
+  /** Read numberOfComponents components stored as TFile in a binary
+   * section into a buffer of a wider type, swapping and converting them
+   * block by block */
+  template< typename TFile, typename T >
+  void ReadConvertedBufferAsBinary(std::istream & inputFile, T *buffer, SizeValueType numberOfComponents)
     {
-    StringType line;
+    const bool          swap = sizeof( TFile ) > 1 && this->IsFileByteOrderSwapped();
+    MemoryStreamBuffer *memoryBuffer = dynamic_cast< MemoryStreamBuffer * >( inputFile.rdbuf() );
+    const char *        data = memoryBuffer ? memoryBuffer->Consume(numberOfComponents * sizeof( TFile ) ) : 0;
 
-    while ( !inputFile.eof() )
+    if ( data )
       {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("CELL_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-        /** For VECTORS or NORMALS or TENSORS, we could read them directly */
-        unsigned long numberOfComponents = this->m_NumberOfCells * this->m_NumberOfCellPixelComponents;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
-        }
+      MeshByteSwapper::ConvertCopy< TFile >(buffer, data, numberOfComponents, swap);
+      }
+    else
+      {
+      MeshByteSwapper::ConvertRead< TFile >(inputFile, buffer, numberOfComponents, swap);
       }
     }
 
   template< typename T >
-  void WritePointsBufferAsASCII(std::ofstream & outputFile, T *buffer, const StringType & pointComponentType)
+  void WritePointsBufferAsASCII(std::ostream & outputFile, T *buffer, SizeValueType numberOfPoints)
   {
-    /** 1. Write number of points */
-    outputFile << "POINTS " << this->m_NumberOfPoints;
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
 
-    outputFile << pointComponentType << '\n';
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+    for ( SizeValueType ii = 0; ii < numberOfPoints; ii++ )
       {
       for ( unsigned int jj = 0; jj < this->m_PointDimension - 1; jj++ )
         {
-        outputFile << buffer[ii * this->m_PointDimension + jj] << " ";
+        formatter << buffer[ii * this->m_PointDimension + jj] << " ";
         }
 
-      outputFile << buffer[ii * this->m_PointDimension + this->m_PointDimension - 1] << '\n';
+      formatter << buffer[ii * this->m_PointDimension + this->m_PointDimension - 1] << '\n';
       }
 
     return;
   }
 
   template< typename T >
-  void WritePointsBufferAsBINARY(std::ofstream & outputFile, T *buffer, const StringType & pointComponentType)
+  void WritePointsBufferAsBINARY(std::ostream & outputFile, T *buffer, SizeValueType numberOfPoints)
   {
-    /** 1. Write number of points */
-    outputFile << "POINTS " << this->m_NumberOfPoints;
-    outputFile << pointComponentType << "\n";
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer, this->m_NumberOfPoints * this->m_PointDimension, &outputFile);
-    outputFile << "\n";
+    MeshByteSwapper::WriteBigEndian(outputFile, buffer, numberOfPoints * this->m_PointDimension);
 
     return;
   }
 
+  /** Write the cells of the group selected by the current cells pass */
   template< typename T >
-  void WriteCellsBufferAsASCII(std::ofstream & outputFile, T *buffer)
+  void WriteCellsBufferAsASCII(std::ostream & outputFile, T *buffer, SizeValueType numberOfCells)
     {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    unsigned int         numberOfVertices = 0;
-    unsigned int         numberOfVertexIndices = 0;
-    unsigned int         numberOfLines = 0;
-    unsigned int         numberOfLineIndices = 0;
-    unsigned int         numberOfPolygons = 0;
-    unsigned int         numberOfPolygonIndices = 0;
-
-    /** Write vertices */
-    unsigned long index = 0;
-
-    ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-    if ( numberOfVertices )
-      {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
-      outputFile << "VERTICES " << numberOfVertices << " " << numberOfVertexIndices << '\n';
-      for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
-        {
-        MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
-        unsigned int                 nn = static_cast< unsigned int >( buffer[index++] );
-        if ( cellType == VERTEX_CELL )
-          {
-          outputFile << nn;
-          for ( unsigned int jj = 0; jj < nn; jj++ )
-            {
-            outputFile << " " << buffer[index++];
-            }
-          }
-
-        outputFile << '\n';
-        }
-      }
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    SizeValueType       index = 0;
 
-    /** Write lines */
-    index = 0;
-    ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-    if ( numberOfLines )
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
-      outputFile << "LINES " << numberOfLines << " " << numberOfLineIndices << '\n';
-      for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+      MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
+      unsigned int                 nn = static_cast< unsigned int >( buffer[index++] );
+      if ( this->IsCellInWriteGroup(cellType) )
         {
-        MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
-        unsigned int  nn = static_cast< unsigned int >( buffer[index++] );
-        if ( cellType == POLYLINE_CELL )
+        formatter << nn;
+        for ( unsigned int jj = 0; jj < nn; jj++ )
           {
-          outputFile << nn;
-          for ( unsigned int jj = 0; jj < nn; jj++ )
-            {
-            outputFile << " " << buffer[index++];
-            }
+          formatter << " " << buffer[index + jj];
           }
 
-        outputFile << '\n';
+        formatter << '\n';
         }
-      }
-
-    /** Write polygons */
-    index = 0;
-    ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-    if ( numberOfPolygons )
-      {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
-      outputFile << "POLYGONS " << numberOfPolygons << " " << numberOfPolygonIndices << '\n';
-      for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
-        {
-        MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
-        unsigned int                 nn = static_cast< unsigned int >( buffer[index++] );
-        if ( cellType == POLYGON_CELL || cellType == TRIANGLE_CELL )
-          {
-          outputFile << nn;
-          for ( unsigned int jj = 0; jj < nn; jj++ )
-            {
-            outputFile << " " << buffer[index++];
-            }
-          }
 
-        outputFile << '\n';
-        }
+      index += nn;
       }
     }
 
   template< typename T >
-  void WriteCellsBufferAsBINARY(std::ofstream & outputFile, T *buffer)
+  void WriteCellsBufferAsBINARY(std::ostream & outputFile, T *buffer, SizeValueType numberOfCells)
     {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    unsigned int         numberOfVertices = 0;
-    unsigned int         numberOfVertexIndices = 0;
-    unsigned int         numberOfLines = 0;
-    unsigned int         numberOfLineIndices = 0;
-    unsigned int         numberOfPolygons = 0;
-    unsigned int         numberOfPolygonIndices = 0;
-
-    /** Write vertices */
-    unsigned long index = 0;
-
-    ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-    if ( numberOfVertices )
-      {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
-      outputFile << "VERTICES " << numberOfVertices << " " << numberOfVertexIndices << '\n';
-      unsigned int *data  = new unsigned int[numberOfVertexIndices];
-      ReadCellsBuffer(buffer, data);
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfVertexIndices, &outputFile);
-      outputFile << "\n";
-      delete[] data;
-      }
+    std::vector< unsigned int > data;
+    SizeValueType               index = 0;
 
-    /** Write lines */
-    index = 0;
-    ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-    if ( numberOfLines )
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
-      outputFile << "LINES " << numberOfLines << " " << numberOfLineIndices << '\n';
-      unsigned int *data  = new unsigned int[numberOfLineIndices];
-      ReadCellsBuffer(buffer, data);
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfLineIndices, &outputFile);
-      outputFile << "\n";
-      delete[] data;
+      MeshIOBase::CellGeometryType cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
+      unsigned int                 nn = static_cast< unsigned int >( buffer[index++] );
+      if ( this->IsCellInWriteGroup(cellType) )
+        {
+        data.push_back(nn);
+        for ( unsigned int jj = 0; jj < nn; jj++ )
+          {
+          data.push_back( static_cast< unsigned int >( buffer[index + jj] ) );
+          }
+        }
+
+      index += nn;
       }
 
-    /** Write polygons */
-    index = 0;
-    ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-    if ( numberOfPolygons )
+    if ( !data.empty() )
       {
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
-      outputFile << "POLYGONS " << numberOfPolygons << " " << numberOfPolygonIndices << '\n';
-      unsigned int *data  = new unsigned int[numberOfPolygonIndices];
-      ReadCellsBuffer(buffer, data);
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfPolygonIndices, &outputFile);
-      outputFile << "\n";
-      delete[] data;
+      MeshByteSwapper::WriteBigEndian(outputFile, &data[0], data.size());
       }
     }
 
   template< typename T >
-  void WritePointDataBufferAsASCII(std::ofstream & outputFile, T *buffer, const StringType & pointPixelComponentName)
+  void WritePointDataBufferAsASCII(std::ostream & outputFile, T *buffer, SizeValueType numberOfPoints)
   {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    StringType           dataName;
-
-    outputFile << "POINT_DATA " << this->m_NumberOfPoints << '\n';
-    switch ( this->m_PointPixelType )
-      {
-      case SCALAR:
-        {
-        outputFile << "SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "pointScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case OFFSET:
-      case POINT:
-      case COVARIANTVECTOR:
-      case VECTOR:
-        {
-        outputFile << "VECTORS ";
-        ExposeMetaData< StringType >(metaDic, "pointVectorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case SYMMETRICSECONDRANKTENSOR:
-      case DIFFUSIONTENSOR3D:
-        {
-        outputFile << "TENSORS ";
-        ExposeMetaData< StringType >(metaDic, "pointTensorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case ARRAY:
-      case VARIABLELENGTHVECTOR:
-        {
-        outputFile << "COLOR_SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "pointColorScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        WriteColorScalarBufferAsASCII(outputFile, buffer, this->m_NumberOfPointPixelComponents, this->m_NumberOfPoints);
-        return;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown point pixel type");
-        }
-      }
-
-    outputFile << pointPixelComponentName << '\n';
-
-    if ( this->m_PointPixelType == SCALAR )
+    if ( this->m_PointPixelType == ARRAY || this->m_PointPixelType == VARIABLELENGTHVECTOR )
       {
-      outputFile << "LOOKUP_TABLE default" << '\n';
+      WriteColorScalarBufferAsASCII(outputFile, buffer, this->m_NumberOfPointPixelComponents, numberOfPoints);
+      return;
       }
 
-    Indent indent(2);
-    for ( unsigned long ii = 0; ii < this->m_NumberOfPoints; ii++ )
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    for ( SizeValueType ii = 0; ii < numberOfPoints; ii++ )
       {
       for ( unsigned int jj = 0; jj < this->m_NumberOfPointPixelComponents; jj++ )
         {
-        outputFile << buffer[ii * this->m_NumberOfPointPixelComponents + jj] << indent;
+        formatter << buffer[ii * this->m_NumberOfPointPixelComponents + jj] << "  ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
 
     return;
   }
 
   template< typename T >
-  void WritePointDataBufferAsBINARY(std::ofstream & outputFile, T *buffer, const StringType & pointPixelComponentName)
+  void WritePointDataBufferAsBINARY(std::ostream & outputFile, T *buffer, SizeValueType numberOfPoints)
   {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    StringType           dataName;
-
-    outputFile << "POINT_DATA " << this->m_NumberOfPoints << "\n";
-    switch ( this->m_PointPixelType )
+    if ( this->m_PointPixelType == ARRAY || this->m_PointPixelType == VARIABLELENGTHVECTOR )
       {
-      case SCALAR:
-        {
-        outputFile << "SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "pointScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case OFFSET:
-      case POINT:
-      case COVARIANTVECTOR:
-      case VECTOR:
-        {
-        outputFile << "VECTORS ";
-        ExposeMetaData< StringType >(metaDic, "pointVectorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case SYMMETRICSECONDRANKTENSOR:
-      case DIFFUSIONTENSOR3D:
-        {
-        outputFile << "TENSORS ";
-        ExposeMetaData< StringType >(metaDic, "pointTensorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case ARRAY:
-      case VARIABLELENGTHVECTOR:
-        {
-        outputFile << "COLOR_SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "pointColorScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        WriteColorScalarBufferAsBINARY(outputFile, buffer, this->m_NumberOfPointPixelComponents, this->m_NumberOfPoints);
-        return;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown point pixel type");
-        }
+      WriteColorScalarBufferAsBINARY(outputFile, buffer, this->m_NumberOfPointPixelComponents, numberOfPoints);
+      return;
       }
 
-    outputFile << pointPixelComponentName << "\n";
-    if ( this->m_PointPixelType == SCALAR )
-      {
-      outputFile << "LOOKUP_TABLE default\n";
-      }
-
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer,
-                                                               this->m_NumberOfPoints * this->m_NumberOfPointPixelComponents,
-                                                               &outputFile);
-    outputFile << "\n";
+    MeshByteSwapper::WriteBigEndian(outputFile, buffer, numberOfPoints * this->m_NumberOfPointPixelComponents);
     return;
   }
 
   template< typename T >
-  void WriteCellDataBufferAsASCII(std::ofstream & outputFile, T *buffer, const StringType & cellPixelComponentName)
+  void WriteCellDataBufferAsASCII(std::ostream & outputFile, T *buffer, SizeValueType numberOfCells)
   {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    StringType           dataName;
-
-    outputFile << "CELL_DATA " << this->m_NumberOfCells << '\n';
-    switch ( this->m_CellPixelType )
+    if ( this->m_CellPixelType == ARRAY || this->m_CellPixelType == VARIABLELENGTHVECTOR )
       {
-      case SCALAR:
-        {
-        outputFile << "SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "cellScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case OFFSET:
-      case POINT:
-      case COVARIANTVECTOR:
-      case VECTOR:
-        {
-        outputFile << "VECTORS ";
-        ExposeMetaData< StringType >(metaDic, "cellVectorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case SYMMETRICSECONDRANKTENSOR:
-      case DIFFUSIONTENSOR3D:
-        {
-        outputFile << "TENSORS ";
-        ExposeMetaData< StringType >(metaDic, "cellTensorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case ARRAY:
-      case VARIABLELENGTHVECTOR:
-        {
-        outputFile << "COLOR_SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "cellColorScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        WriteColorScalarBufferAsASCII(outputFile, buffer, this->m_NumberOfCellPixelComponents, this->m_NumberOfCells);
-        return;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown cell pixel type");
-        }
+      WriteColorScalarBufferAsASCII(outputFile, buffer, this->m_NumberOfCellPixelComponents, numberOfCells);
+      return;
       }
 
-    outputFile << cellPixelComponentName << '\n';
-    if ( this->m_CellPixelType == SCALAR )
-      {
-      outputFile << "LOOKUP_TABLE default" << '\n';
-      }
-
-    Indent indent(2);
-    for ( unsigned long ii = 0; ii < this->m_NumberOfCells; ii++ )
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    for ( SizeValueType ii = 0; ii < numberOfCells; ii++ )
       {
       for ( unsigned int jj = 0; jj < this->m_NumberOfCellPixelComponents; jj++ )
         {
-        outputFile << buffer[ii * this->m_NumberOfCellPixelComponents + jj] << indent;
+        formatter << buffer[ii * this->m_NumberOfCellPixelComponents + jj] << "  ";
         }
-      outputFile << '\n';
+      formatter << '\n';
       }
 
     return;
   }
 
   template< typename T >
-  void WriteCellDataBufferAsBINARY(std::ofstream & outputFile, T *buffer, const StringType & cellPixelComponentName)
+  void WriteCellDataBufferAsBINARY(std::ostream & outputFile, T *buffer, SizeValueType numberOfCells)
   {
-    MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
-    StringType           dataName;
-
-    outputFile << "CELL_DATA " << this->m_NumberOfCells << "\n";
-    switch ( this->m_CellPixelType )
-      {
-      case SCALAR:
-        {
-        outputFile << "SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "cellScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case OFFSET:
-      case POINT:
-      case COVARIANTVECTOR:
-      case VECTOR:
-        {
-        outputFile << "VECTORS ";
-        ExposeMetaData< StringType >(metaDic, "cellVectorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case SYMMETRICSECONDRANKTENSOR:
-      case DIFFUSIONTENSOR3D:
-        {
-        outputFile << "TENSORS ";
-        ExposeMetaData< StringType >(metaDic, "cellTensorDataName", dataName);
-        outputFile << dataName << "  ";
-        break;
-        }
-      case ARRAY:
-      case VARIABLELENGTHVECTOR:
-        {
-        outputFile << "COLOR_SCALARS ";
-        ExposeMetaData< StringType >(metaDic, "cellColorScalarDataName", dataName);
-        outputFile << dataName << "  ";
-        WriteColorScalarBufferAsBINARY(outputFile, buffer, this->m_NumberOfCellPixelComponents, this->m_NumberOfCells);
-        return;
-        }
-      default:
-        {
-        itkExceptionMacro(<< "Unknown cell pixel type");
-        }
-      }
-
-    outputFile << cellPixelComponentName << "\n";
-    if ( this->m_CellPixelType == SCALAR )
+    if ( this->m_CellPixelType == ARRAY || this->m_CellPixelType == VARIABLELENGTHVECTOR )
       {
-      outputFile << "LOOKUP_TABLE default\n";
+      WriteColorScalarBufferAsBINARY(outputFile, buffer, this->m_NumberOfCellPixelComponents, numberOfCells);
+      return;
       }
 
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer,
-                                                               this->m_NumberOfCells * this->m_NumberOfCellPixelComponents,
-                                                               &outputFile);
-    outputFile << "\n";
+    MeshByteSwapper::WriteBigEndian(outputFile, buffer, numberOfCells * this->m_NumberOfCellPixelComponents);
     return;
   }
 
   template< typename T >
-  void WriteColorScalarBufferAsASCII(std::ofstream & outputFile,
+  void WriteColorScalarBufferAsASCII(std::ostream & outputFile,
                                      T *buffer,
                                      unsigned long numberOfPixelComponents,
                                      unsigned long numberOfPixels)
     {
-    outputFile << numberOfPixelComponents << "\n";
-    Indent indent(2);
-    for ( unsigned long ii = 0; ii < numberOfPixels; ++ii )
+    MeshNumberFormatter formatter(outputFile, this->m_AsciiPrecision);
+    for ( SizeValueType ii = 0; ii < numberOfPixels; ++ii )
       {
       for ( unsigned int jj = 0; jj < numberOfPixelComponents; ++jj )
         {
-        outputFile << static_cast< float >( buffer[ii * numberOfPixelComponents + jj] ) << indent;
+        formatter << static_cast< float >( buffer[ii * numberOfPixelComponents + jj] ) << "  ";
         }
 
-      outputFile << "\n";
+      formatter << "\n";
       }
 
     return;
     }
 
   template< typename T >
-  void WriteColorScalarBufferAsBINARY(std::ofstream & outputFile,
+  void WriteColorScalarBufferAsBINARY(std::ostream & outputFile,
                                       T *buffer,
                                       unsigned long numberOfPixelComponents,
                                       unsigned long numberOfPixels)
     {
-    outputFile << numberOfPixelComponents << "\n";
-    unsigned long  numberOfElements = numberOfPixelComponents * numberOfPixels;
-    unsigned char *data = new unsigned char[numberOfElements];
-    for ( unsigned long ii = 0; ii < numberOfElements; ++ii )
-      {
-      data[ii] = static_cast< unsigned char >( buffer[ii] );
-      }
-
-    outputFile.write(reinterpret_cast< char * >( data ), numberOfElements);
-
-    delete[] data;
-    outputFile << "\n";
+    MeshByteSwapper::ConvertWrite< unsigned char >(outputFile, buffer, numberOfPixelComponents * numberOfPixels, false);
     return;
     }
 
-  /** Convert cells buffer for output cells buffer, it's user's responsibility to make sure
-  the input cells don't contain any cell type that coule not be written as polygon cell */
-  template< typename TInput, typename TOutput >
-  void ReadCellsBuffer(TInput *input, TOutput *output)
+  /** Whether a cell belongs to the group written by the current cells pass,
+    triangles are written as polygons */
+  bool IsCellInWriteGroup(CellGeometryType cellType) const
     {
-    unsigned long inputIndex = 0;
-    unsigned long outputIndex = 0;
-
-    if ( input && output )
+    if ( m_CellsWriteGroup == POLYGON_CELL )
       {
-      for ( unsigned int ii = 0; ii < this->m_NumberOfCells; ii++ )
-        {
-        inputIndex++;
-        unsigned int nn = static_cast< unsigned int >( input[inputIndex++] );
-        output[outputIndex++] = nn;
-        for ( unsigned int jj = 0; jj < nn; jj++ )
-          {
-          output[outputIndex++] = static_cast< TOutput >( input[inputIndex++] );
-          }
-        }
+      return cellType == POLYGON_CELL || cellType == TRIANGLE_CELL;
       }
+
+    return cellType == m_CellsWriteGroup;
     }
 
+  /** Find the group of cells written by a cells pass, empty groups are
+    skipped. Returns false when there is no such pass. */
+  bool GetCellsWritePassInformation(unsigned int pass, CellGeometryType & group, StringType & keyword,
+                                    SizeValueType & numberOfCells, SizeValueType & numberOfIndices);
+
+  /** Check the number of points and cells and the attribute names of the
+   * file the data are appended to, and open it for appending */
+  void OpenAppendFile();
+
+  /** Name of the point or cell data attribute, from the meta data
+    dictionary */
+  StringType GetDataAttributeName(const StringType & attribute, IOPixelType pixelType) const;
+
+  /** Write the header of a point or cell data attribute */
+  void WriteDataAttributeHeader(const StringType & attribute, IOPixelType pixelType,
+                                IOComponentType componentType, unsigned int numberOfComponents);
+
+  /** Name of a component type in a VTK file */
+  const char * GetComponentTypeNameForVTK(IOComponentType componentType) const;
+
+  /** Component type of a name in a VTK file */
+  IOComponentType GetComponentTypeFromVTKName(const StringType & name) const;
+
 private:
   VTKPolyDataMeshIO(const Self &); // purposely not implemented
   void operator=(const Self &);    // purposely not implemented
+
+  /** Read the components of the elements [first, first + count) of a
+   * binary section whose data start at position, out of size elements */
+  void ReadSectionRange(void *buffer, SectionType section, StreamOffsetType position, IOComponentType componentType,
+                        unsigned int numberOfComponents, SizeValueType first, SizeValueType count, SizeValueType size);
+
+  /** Describe the attribute of a SCALARS, COLOR_SCALARS, VECTORS, NORMALS or
+   * TENSORS line, whose data follow in inputFile. Returns false for the
+   * other lines. */
+  bool ReadDataArrayInformation(std::istream & inputFile, const StringType & line, DataArrayInformation & array);
+
+  /** Seek m_InputFile past the numberOfComponents components of
+   * componentType of the binary data starting at position. Text data are
+   * left to be read line by line. */
+  void SkipBinaryData(StreamOffsetType position, SizeValueType numberOfComponents, IOComponentType componentType);
+
+  /** Read the named arrays of numberOfElements elements into buffers */
+  void ReadDataArrays(const DataArrayInformationContainer & arrays, const std::vector< std::string > & names,
+                      const std::vector< void * > & buffers, SizeValueType numberOfElements);
+
+  void ReadDataArray(std::istream & inputFile, void *buffer, const DataArrayInformation & array,
+                     SizeValueType numberOfElements);
+
+  /** File opened by ReadMeshInformation(), shared by the reads of the
+    sections */
+  MeshInputFileStream m_InputFile;
+
+  /** Position of the point coordinates found by ReadMeshInformation(), -1
+    when the file has none */
+  StreamOffsetType m_PointsStartPosition;
+
+  /** Group of cells written by the current cells pass */
+  CellGeometryType m_CellsWriteGroup;
+
+  /** Section last begun in the output file. An attribute following one of
+    the same POINT_DATA or CELL_DATA section does not repeat its keyword.
+    ReadMeshInformation() sets it to the last data section of the file. */
+  SectionType m_LastWriteSection;
 };
 } // end namespace itk
 
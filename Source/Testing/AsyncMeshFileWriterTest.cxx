@@ -0,0 +1,224 @@
+#include "itkMeshFileReader.h"
+#include "itkAsyncMeshFileWriter.h"
+#include "itkCreateObjectFunction.h"
+#include "itkMesh.h"
+#include "itkVersion.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Check the queue of the asynchronous writer: meshes queued beyond the
+// maximum queue size are all written once Flush() returns, a queued copy is
+// not affected by a later change of the mesh, and the exception of a write
+// failing on the IO thread is thrown by Flush(), once, even when it is not
+// an itk::ExceptionObject.
+
+typedef itk::Mesh<float, 3>                   MeshType;
+typedef itk::MeshFileReader<MeshType>         MeshFileReaderType;
+typedef itk::AsyncMeshFileWriter<MeshType>    AsyncMeshFileWriterType;
+
+// MeshIO of the ".fail" files, throwing an int once the writing starts
+class FailingMeshIO:public itk::VTKPolyDataMeshIO
+{
+public:
+	typedef FailingMeshIO Self;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkNewMacro(Self);
+	itkTypeMacro(FailingMeshIO, VTKPolyDataMeshIO);
+
+	virtual bool CanWriteFile(const char * fileName)
+	{
+		return this->GetFileNameExtension(fileName) == ".fail";
+	}
+
+	virtual void WriteMeshInformation()
+	{
+		throw 42;
+	}
+};
+
+class FailingMeshIOFactory:public itk::ObjectFactoryBase
+{
+public:
+	typedef FailingMeshIOFactory Self;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkFactorylessNewMacro(Self);
+	itkTypeMacro(FailingMeshIOFactory, ObjectFactoryBase);
+
+	virtual const char * GetITKSourceVersion() const
+	{
+		return ITK_SOURCE_VERSION;
+	}
+	virtual const char * GetDescription() const
+	{
+		return "Failing Mesh IO Factory";
+	}
+
+protected:
+	FailingMeshIOFactory()
+	{
+		this->RegisterOverride("itkMeshIOBase", "FailingMeshIO", "Failing Mesh IO", 1,
+			itk::CreateObjectFunction<FailingMeshIO>::New());
+	}
+};
+
+static MeshType::Pointer ReadMesh(const std::string & fileName)
+{
+	MeshFileReaderType::Pointer reader = MeshFileReaderType::New();
+	reader->SetFileName(fileName.c_str());
+	reader->Update();
+	return reader->GetOutput();
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 3)
+	{
+		std::cerr<<"Usage: "<<argv[0]<<" input outputDirectory"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[2];
+	const unsigned int numberOfWrites = 4;
+	const double tol = 1e-6;
+
+	MeshType::Pointer mesh;
+	try
+	{
+		mesh = ReadMesh(argv[1]);
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Read file "<<argv[1]<<" failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+	if(mesh->GetNumberOfPoints() == 0)
+	{
+		std::cerr<<"No point in "<<argv[1]<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Queue more meshes than the queue holds, moving the first point after
+	// each write: every file keeps the point of the copy it was queued with
+	AsyncMeshFileWriterType::Pointer writer = AsyncMeshFileWriterType::New();
+	writer->SetMaximumQueueSize(1);
+	writer->SetFileTypeAsBINARY();
+
+	MeshType::PointType point;
+	mesh->GetPoint(0, &point);
+	const float firstCoordinate = point[0];
+	try
+	{
+		for(unsigned int i = 0; i < numberOfWrites; i++)
+		{
+			std::ostringstream fileName;
+			fileName<<directory<<"/async_"<<i<<".vtk";
+			writer->Write(mesh, fileName.str());
+
+			point[0] = firstCoordinate + i + 1;
+			mesh->SetPoint(0, point);
+		}
+		writer->Flush();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Asynchronous write failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	for(unsigned int i = 0; i < numberOfWrites; i++)
+	{
+		std::ostringstream fileName;
+		fileName<<directory<<"/async_"<<i<<".vtk";
+		MeshType::Pointer written;
+		try
+		{
+			written = ReadMesh(fileName.str());
+		}
+		catch(itk::ExceptionObject & err)
+		{
+			std::cerr<<"Read file "<<fileName.str()<<" failed "<<std::endl;
+			std::cerr<<err<<std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if(written->GetNumberOfPoints() != mesh->GetNumberOfPoints()
+			|| written->GetNumberOfCells() != mesh->GetNumberOfCells())
+		{
+			std::cerr<<fileName.str()<<" has "<<written->GetNumberOfPoints()<<" points and "
+				<<written->GetNumberOfCells()<<" cells"<<std::endl;
+			return EXIT_FAILURE;
+		}
+		MeshType::PointType writtenPoint;
+		written->GetPoint(0, &writtenPoint);
+		if(std::abs(writtenPoint[0] - (firstCoordinate + i)) > tol)
+		{
+			std::cerr<<fileName.str()<<" was written after the mesh was changed"<<std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// A file in a missing directory is accepted by Write(), which only
+	// checks its extension, and fails on the IO thread
+	try
+	{
+		writer->Write(mesh, directory + "/missing_directory/async.vtk");
+		writer->Flush();
+		std::cerr<<"The failed write was not reported"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cout<<"Expected exception: "<<err.GetDescription()<<std::endl;
+	}
+
+	// The error is reported once, and the writer is usable again
+	try
+	{
+		writer->Flush();
+		writer->Write(mesh, directory + "/async_after_error.vtk", true);
+		writer->Flush();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Write after the failed write failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// An exception of any type is reported by Flush(), rather than ending
+	// the IO thread and leaving Flush() waiting
+	itk::ObjectFactoryBase::RegisterFactory(FailingMeshIOFactory::New());
+	try
+	{
+		writer->Write(mesh, directory + "/async.fail");
+		writer->Flush();
+		std::cerr<<"The write throwing an int was not reported"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cout<<"Expected exception: "<<err.GetDescription()<<std::endl;
+	}
+
+	try
+	{
+		writer->Write(mesh, directory + "/async_after_unknown_error.vtk");
+		writer->Flush();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Write after the write throwing an int failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
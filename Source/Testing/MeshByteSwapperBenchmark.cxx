@@ -0,0 +1,192 @@
+#include "itkMeshByteSwapper.h"
+#include "itkByteSwapper.h"
+#include "itkTimeProbe.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Reverse the bytes of a component one at a time
+template<class T>
+void ReverseBytes(T *value)
+{
+	unsigned char *bytes = reinterpret_cast<unsigned char *>(value);
+	for(size_t i = 0; i < sizeof(T) / 2; i++)
+	{
+		const unsigned char byte = bytes[i];
+		bytes[i] = bytes[sizeof(T) - 1 - i];
+		bytes[sizeof(T) - 1 - i] = byte;
+	}
+}
+
+// Check the components swapped by SwapCopy(), Swap(), SwapWrite() and
+// ConvertCopy() against ReverseBytes(), for the lengths which are not a
+// multiple of the vectors and the buffers which are not aligned on them
+template<class T>
+bool CheckShortSwaps(const char *name, const std::vector<T> & values)
+{
+	const size_t maximumLength = values.size() < 100 ? values.size() : 100;
+	std::vector<unsigned char> input(maximumLength * sizeof(T) + 32);
+	std::vector<unsigned char> output(maximumLength * sizeof(T) + 32);
+
+	for(size_t length = 0; length <= maximumLength; length++)
+	{
+		std::vector<T> expected(values.begin(), values.begin() + length);
+		for(size_t i = 0; i < length; i++)
+		{
+			ReverseBytes(&expected[i]);
+		}
+		const size_t size = length * sizeof(T);
+
+		for(size_t offset = 0; offset < 32; offset += ( offset < 4 ? 1 : 7 ))
+		{
+			// Unaligned source and destination
+			if(size > 0)
+			{
+				std::memcpy(&input[offset], &values[0], size);
+			}
+			std::memset(&output[0], 0, output.size());
+			itk::MeshByteSwapper::SwapCopy(&output[offset], &input[offset], sizeof(T), length);
+			bool wrong = size > 0 && std::memcmp(&expected[0], &output[offset], size) != 0;
+			for(size_t i = 0; i < output.size() && !wrong; i++)
+			{
+				wrong = ( i < offset || i >= offset + size ) && output[i] != 0;
+			}
+
+			// In place
+			itk::MeshByteSwapper::Swap(&input[offset], sizeof(T), length);
+			wrong = wrong || ( size > 0 && std::memcmp(&expected[0], &input[offset], size) != 0 );
+
+			// Swapped back while converted, from an unaligned buffer
+			std::vector<T> converted(length + 1);
+			itk::MeshByteSwapper::ConvertCopy<T, T>(&converted[0], &input[offset], length, true);
+			wrong = wrong || ( size > 0 && std::memcmp(&values[0], &converted[0], size) != 0 );
+
+			if(wrong)
+			{
+				std::cerr << name << ": " << length << " components at offset " << offset << " swapped wrongly"
+					<< std::endl;
+				return false;
+			}
+		}
+
+		std::ostringstream stream;
+		itk::MeshByteSwapper::SwapWrite(stream, length > 0 ? &values[0] : 0, sizeof(T), length);
+		if(stream.str().size() != size || ( size > 0 && std::memcmp(&expected[0], stream.str().data(), size) != 0 ))
+		{
+			std::cerr << name << ": " << length << " components written wrongly" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Check the components swapped by MeshByteSwapper, failing on any
+// difference with the scalar swap, and time it against the range swap of
+// ByteSwapper used before.
+template<class T>
+bool BenchmarkSwap(const char *name, unsigned long numberOfValues)
+{
+	std::vector<T> values(numberOfValues);
+	unsigned char *bytes = reinterpret_cast<unsigned char *>(&values[0]);
+	for(size_t i = 0; i < numberOfValues * sizeof(T); i++)
+	{
+		bytes[i] = static_cast<unsigned char>( std::rand() );
+	}
+
+	if(!CheckShortSwaps(name, values))
+	{
+		return false;
+	}
+
+	std::vector<T> expected(values);
+	for(size_t i = 0; i < numberOfValues; i++)
+	{
+		ReverseBytes(&expected[i]);
+	}
+
+	std::vector<T> byteSwapped(values);
+	itk::TimeProbe byteSwapperProbe;
+	byteSwapperProbe.Start();
+	itk::ByteSwapper<T>::SwapRangeFromSystemToBigEndian(&byteSwapped[0], numberOfValues);
+	byteSwapperProbe.Stop();
+
+	std::vector<T> swapped(values);
+	itk::TimeProbe meshProbe;
+	meshProbe.Start();
+	itk::MeshByteSwapper::Swap(&swapped[0], sizeof(T), numberOfValues);
+	meshProbe.Stop();
+
+	std::ostringstream output;
+	itk::MeshByteSwapper::SwapWrite(output, &values[0], sizeof(T), numberOfValues);
+	const std::string written = output.str();
+
+	if(std::memcmp(&expected[0], &swapped[0], numberOfValues * sizeof(T)) != 0
+		|| written.size() != numberOfValues * sizeof(T)
+		|| std::memcmp(&expected[0], written.data(), written.size()) != 0)
+	{
+		std::cerr << name << ": the components were swapped wrongly" << std::endl;
+		return false;
+	}
+
+	std::cout << name << ": " << numberOfValues << " components, ByteSwapper "
+		<< byteSwapperProbe.GetMeanTime() << " s, MeshByteSwapper " << meshProbe.GetMeanTime() << " s";
+	if(meshProbe.GetMeanTime() > 0)
+	{
+		std::cout << ", " << byteSwapperProbe.GetMeanTime() / meshProbe.GetMeanTime() << "x";
+	}
+	std::cout << std::endl;
+	return true;
+}
+
+// Check the conversion to big endian floats written in a single pass
+bool CheckConvertWrite(unsigned long numberOfValues)
+{
+	std::vector<double> values(numberOfValues);
+	for(unsigned long i = 0; i < numberOfValues; i++)
+	{
+		values[i] = ( std::rand() - RAND_MAX / 2.0 ) / ( 1.0 + std::rand() % 1000 );
+	}
+
+	std::ostringstream output;
+	itk::MeshByteSwapper::ConvertWriteBigEndian<float>(output, &values[0], numberOfValues);
+	const std::string written = output.str();
+	if(written.size() != numberOfValues * sizeof(float))
+	{
+		std::cerr << "double to big endian float: " << written.size() << " bytes written" << std::endl;
+		return false;
+	}
+
+	for(unsigned long i = 0; i < numberOfValues; i++)
+	{
+		float value;
+		std::memcpy(&value, written.data() + i * sizeof(float), sizeof(float));
+		if(itk::ByteSwapper<float>::SystemIsLittleEndian())
+		{
+			ReverseBytes(&value);
+		}
+		if(value != static_cast<float>( values[i] ))
+		{
+			std::cerr << "double to big endian float: component " << i << " written as " << value << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	const unsigned long numberOfValues = argc > 1 ? std::atol(argv[1]) : 10000000;
+
+	std::srand(1);
+	bool success = true;
+	success = BenchmarkSwap<short>("2 bytes", numberOfValues) && success;
+	success = BenchmarkSwap<float>("4 bytes", numberOfValues) && success;
+	success = BenchmarkSwap<double>("8 bytes", numberOfValues) && success;
+	success = CheckConvertWrite(numberOfValues) && success;
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,184 @@
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkMeshFileStreams.h"
+#include "itkMesh.h"
+#include "itkTriangleCell.h"
+#include "itk_zlib.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Check the gzip files compressed by blocks on several threads: a binary
+// mesh larger than a block is written plain and as a .vtk.gz file, whose
+// members must be inflated by MeshFileReader to the same mesh, and by the
+// gzread() of zlib to the bytes of the plain file.
+
+typedef itk::Mesh<float, 3>                   MeshType;
+typedef MeshType::CellType                    CellType;
+typedef itk::TriangleCell<CellType>           TriangleCellType;
+typedef itk::MeshFileReader<MeshType>         MeshFileReaderType;
+typedef itk::MeshFileWriter<MeshType>         MeshFileWriterType;
+
+// Triangulated grid of size x size points, with a scalar per point
+static MeshType::Pointer CreateGridMesh(unsigned int size)
+{
+	MeshType::Pointer mesh = MeshType::New();
+
+	for(unsigned int j = 0; j < size; j++)
+	{
+		for(unsigned int i = 0; i < size; i++)
+		{
+			MeshType::PointType point;
+			point[0] = i * 0.5f;
+			point[1] = j * 0.25f;
+			point[2] = ( i * j ) % 7;
+			mesh->SetPoint(j * size + i, point);
+			mesh->SetPointData(j * size + i, static_cast<float>(i + j));
+		}
+	}
+
+	MeshType::CellIdentifier cellId = 0;
+	for(unsigned int j = 0; j + 1 < size; j++)
+	{
+		for(unsigned int i = 0; i + 1 < size; i++)
+		{
+			const MeshType::PointIdentifier corner = j * size + i;
+
+			CellType::CellAutoPointer cell;
+			cell.TakeOwnership(new TriangleCellType);
+			cell->SetPointId(0, corner);
+			cell->SetPointId(1, corner + 1);
+			cell->SetPointId(2, corner + size);
+			mesh->SetCell(cellId++, cell);
+
+			cell.TakeOwnership(new TriangleCellType);
+			cell->SetPointId(0, corner + 1);
+			cell->SetPointId(1, corner + size + 1);
+			cell->SetPointId(2, corner + size);
+			mesh->SetCell(cellId++, cell);
+		}
+	}
+
+	return mesh;
+}
+
+static bool WriteMesh(MeshType * mesh, const char * fileName, unsigned int numberOfThreads)
+{
+	MeshFileWriterType::Pointer writer = MeshFileWriterType::New();
+	writer->SetFileName(fileName);
+	writer->SetInput(mesh);
+	writer->SetFileTypeAsBINARY();
+	writer->SetNumberOfCompressionThreads(numberOfThreads);
+
+	try
+	{
+		writer->Update();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Write file "<<fileName<<" failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 3)
+	{
+		std::cerr<<"Usage: "<<argv[0]<<" output.vtk output.vtk.gz [numberOfThreads]"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	const unsigned int numberOfThreads = argc > 3 ? std::atoi(argv[3]) : 4;
+
+	MeshType::Pointer mesh = CreateGridMesh(400);
+
+	if(!WriteMesh(mesh, argv[1], 1) || !WriteMesh(mesh, argv[2], numberOfThreads))
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream plainFile(argv[1], std::ios::in | std::ios::binary);
+	std::ostringstream plainContent;
+	plainContent << plainFile.rdbuf();
+	const std::string plain = plainContent.str();
+	if(static_cast<std::streamsize>(plain.size()) <= 2 * itk::GzipOutputStreamBuffer::BlockSize)
+	{
+		std::cerr<<"The file "<<argv[1]<<" is not larger than two blocks"<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// zlib reads the concatenated gzip members as one file
+	gzFile compressedFile = gzopen(argv[2], "rb");
+	if(compressedFile == NULL)
+	{
+		std::cerr<<"Unable to open "<<argv[2]<<" with zlib"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	std::string inflated;
+	char buffer[65536];
+	int read;
+	while((read = gzread(compressedFile, buffer, sizeof(buffer))) > 0)
+	{
+		inflated.append(buffer, read);
+	}
+	gzclose(compressedFile);
+
+	if(read < 0 || inflated != plain)
+	{
+		std::cerr<<"zlib inflates "<<argv[2]<<" to "<<inflated.size()<<" bytes differing from the "
+			<<plain.size()<<" bytes of "<<argv[1]<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	MeshFileReaderType::Pointer reader = MeshFileReaderType::New();
+	reader->SetFileName(argv[2]);
+	try
+	{
+		reader->Update();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Read file "<<argv[2]<<" failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	MeshType::Pointer output = reader->GetOutput();
+	if(output->GetNumberOfPoints() != mesh->GetNumberOfPoints()
+		|| output->GetNumberOfCells() != mesh->GetNumberOfCells())
+	{
+		std::cerr<<"Read "<<output->GetNumberOfPoints()<<" points and "<<output->GetNumberOfCells()
+			<<" cells instead of "<<mesh->GetNumberOfPoints()<<" and "<<mesh->GetNumberOfCells()<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	for(MeshType::PointIdentifier id = 0; id < mesh->GetNumberOfPoints(); id++)
+	{
+		MeshType::PointType point0;
+		MeshType::PointType point1;
+		mesh->GetPoint(id, &point0);
+		output->GetPoint(id, &point1);
+
+		float data0 = 0;
+		float data1 = 0;
+		mesh->GetPointData(id, &data0);
+		output->GetPointData(id, &data1);
+
+		bool differs = data0 != data1;
+		for(unsigned int d = 0; d < 3; d++)
+		{
+			differs = differs || point0[d] != point1[d];
+		}
+		if(differs)
+		{
+			std::cerr<<"Point "<<id<<" or its data differs in "<<argv[2]<<std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,190 @@
+#include "itkMeshFileReader.h"
+#include "itkMeshIOFactory.h"
+#include "itkMesh.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+
+// Check that the point data and cell data read into a mesh whose pixel
+// type matches the file, which the MeshIO fills directly, equal those read
+// into a mesh whose pixel type needs a conversion: a mesh with float point
+// data and cell data is written as binary and ASCII VTK, and read into
+// float and double meshes, which must hold the same points, cells and
+// data.
+
+typedef itk::Mesh<float, 3>  FloatMeshType;
+typedef itk::Mesh<double, 3> DoubleMeshType;
+
+static const unsigned int NumberOfPoints = 6;
+static const unsigned int NumberOfCells = 4;
+
+static void WriteMesh(const std::string & fileName, bool binary)
+{
+	float points[3 * NumberOfPoints];
+	float pointData[NumberOfPoints];
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		points[3 * ii] = static_cast<float>(ii % 2);
+		points[3 * ii + 1] = static_cast<float>(ii / 2);
+		points[3 * ii + 2] = 0.125f * ii;
+		pointData[ii] = 0.25f * ii - 0.75f;
+	}
+	unsigned int cells[5 * NumberOfCells];
+	float cellData[NumberOfCells];
+	for(unsigned int ii = 0; ii < NumberOfCells; ii++)
+	{
+		cells[5 * ii] = itk::MeshIOBase::TRIANGLE_CELL;
+		cells[5 * ii + 1] = 3;
+		cells[5 * ii + 2] = ii;
+		cells[5 * ii + 3] = ii + 1;
+		cells[5 * ii + 4] = ii + 2;
+		cellData[ii] = 2.0f * ii + 0.5f;
+	}
+
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::WriteMode);
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->SetFileType(binary ? itk::MeshIOBase::BINARY : itk::MeshIOBase::ASCII);
+	meshIO->SetUpdatePoints(true);
+	meshIO->SetNumberOfPoints(NumberOfPoints);
+	meshIO->SetPointDimension(3);
+	meshIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetUpdateCells(true);
+	meshIO->SetNumberOfCells(NumberOfCells);
+	meshIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	meshIO->SetCellBufferSize(5 * NumberOfCells);
+	meshIO->SetUpdatePointData(true);
+	meshIO->SetPointPixelType(itk::MeshIOBase::SCALAR);
+	meshIO->SetPointPixelComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetNumberOfPointPixelComponents(1);
+	meshIO->SetUpdateCellData(true);
+	meshIO->SetCellPixelType(itk::MeshIOBase::SCALAR);
+	meshIO->SetCellPixelComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetNumberOfCellPixelComponents(1);
+	meshIO->WriteMeshInformation();
+	meshIO->WritePoints(points);
+	meshIO->WriteCells(cells);
+	meshIO->WritePointData(pointData);
+	meshIO->WriteCellData(cellData);
+	meshIO->Write();
+}
+
+// Whether the data of the file are read without conversion into float,
+// and converted into double
+static bool CheckReadPaths(const std::string & fileName)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::ReadMode);
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->ReadMeshInformation();
+
+	const itk::MeshIOBase::SectionType sections[2] = { itk::MeshIOBase::POINTDATA_SECTION,
+		itk::MeshIOBase::CELLDATA_SECTION };
+	for(unsigned int ii = 0; ii < 2; ii++)
+	{
+		if(meshIO->GetReadPath(sections[ii], typeid(float), 1) == itk::MeshIOBase::CONVERT_READ
+			|| meshIO->GetReadPath(sections[ii], typeid(double), 1) != itk::MeshIOBase::CONVERT_READ)
+		{
+			std::cerr << "The data of " << fileName << " are not read directly as float and converted to double"
+				<< std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class TMesh>
+static typename TMesh::Pointer ReadMesh(const std::string & fileName)
+{
+	typename itk::MeshFileReader<TMesh>::Pointer reader = itk::MeshFileReader<TMesh>::New();
+	reader->SetFileName(fileName.c_str());
+	reader->Update();
+	return reader->GetOutput();
+}
+
+static bool CompareMeshes(const FloatMeshType * floatMesh, const DoubleMeshType * doubleMesh, const std::string & fileName)
+{
+	if(floatMesh->GetNumberOfPoints() != NumberOfPoints || doubleMesh->GetNumberOfPoints() != NumberOfPoints
+		|| floatMesh->GetNumberOfCells() != NumberOfCells || doubleMesh->GetNumberOfCells() != NumberOfCells)
+	{
+		std::cerr << "The meshes read from " << fileName << " have " << floatMesh->GetNumberOfPoints() << " and "
+			<< doubleMesh->GetNumberOfPoints() << " points, " << floatMesh->GetNumberOfCells() << " and "
+			<< doubleMesh->GetNumberOfCells() << " cells" << std::endl;
+		return false;
+	}
+
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		FloatMeshType::PointType floatPoint;
+		DoubleMeshType::PointType doublePoint;
+		float floatData = -1;
+		double doubleData = 1;
+		floatMesh->GetPoint(ii, &floatPoint);
+		doubleMesh->GetPoint(ii, &doublePoint);
+		floatMesh->GetPointData(ii, &floatData);
+		doubleMesh->GetPointData(ii, &doubleData);
+		if(floatPoint[0] != doublePoint[0] || floatPoint[1] != doublePoint[1] || floatPoint[2] != doublePoint[2]
+			|| static_cast<double>(floatData) != doubleData || floatData != 0.25f * ii - 0.75f)
+		{
+			std::cerr << "Point " << ii << " of " << fileName << " is read with data " << floatData << " and "
+				<< doubleData << std::endl;
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < NumberOfCells; ii++)
+	{
+		FloatMeshType::CellAutoPointer floatCell;
+		DoubleMeshType::CellAutoPointer doubleCell;
+		float floatData = -1;
+		double doubleData = 1;
+		floatMesh->GetCell(ii, floatCell);
+		doubleMesh->GetCell(ii, doubleCell);
+		floatMesh->GetCellData(ii, &floatData);
+		doubleMesh->GetCellData(ii, &doubleData);
+		bool differs = floatCell->GetNumberOfPoints() != doubleCell->GetNumberOfPoints()
+			|| static_cast<double>(floatData) != doubleData || floatData != 2.0f * ii + 0.5f;
+		for(unsigned int jj = 0; !differs && jj < floatCell->GetNumberOfPoints(); jj++)
+		{
+			differs = floatCell->GetPointIds()[jj] != doubleCell->GetPointIds()[jj];
+		}
+		if(differs)
+		{
+			std::cerr << "Cell " << ii << " of " << fileName << " is read with data " << floatData << " and "
+				<< doubleData << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[1];
+
+	try
+	{
+		for(unsigned int binary = 0; binary < 2; binary++)
+		{
+			const std::string fileName = directory + (binary ? "/read_path_binary.vtk" : "/read_path_ascii.vtk");
+			WriteMesh(fileName, binary != 0);
+			if(!CheckReadPaths(fileName)
+				|| !CompareMeshes(ReadMesh<FloatMeshType>(fileName), ReadMesh<DoubleMeshType>(fileName), fileName))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,239 @@
+#include "itkMeshFileReader.h"
+#include "itkMeshFileSeriesReader.h"
+#include "itkMeshFileSeriesWriter.h"
+#include "itkMesh.h"
+#include "itkTriangleCell.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Check the files of a series sharing its topology: five frames are
+// written, the topology file being written with the first frame, after a
+// cell is added and after TopologyModified(). Each frame file must hold
+// the points and point data of its frame, the manifest must list the
+// frames with their topology files, and MeshFileSeriesReader must give the
+// frames back with their cells.
+
+typedef itk::Mesh<float, 3>                  MeshType;
+typedef itk::TriangleCell<MeshType::CellType> TriangleType;
+typedef itk::MeshFileSeriesWriter<MeshType>  SeriesWriterType;
+typedef itk::MeshFileSeriesReader<MeshType>  SeriesReaderType;
+
+static const unsigned int NumberOfFrames = 5;
+static const unsigned int NumberOfPoints = 5;
+
+static std::string ReadFile(const std::string & fileName)
+{
+	std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+	if(!file.is_open())
+	{
+		return "";
+	}
+	std::ostringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+static void WriteFile(const std::string & fileName, const std::string & content)
+{
+	std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+	file << content;
+}
+
+static bool FileExists(const std::string & fileName)
+{
+	std::ifstream file(fileName.c_str(), std::ios::in);
+	return file.is_open();
+}
+
+static double GetTime(unsigned int frame)
+{
+	return 0.5 * frame;
+}
+
+// The points of a frame move along the z axis and carry their z coordinate
+static void SetFramePoints(MeshType * mesh, unsigned int frame)
+{
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		MeshType::PointType point;
+		point[0] = static_cast<float>(ii % 2);
+		point[1] = static_cast<float>(ii / 2);
+		point[2] = static_cast<float>(frame + 0.25 * ii);
+		mesh->SetPoint(ii, point);
+		mesh->SetPointData(ii, point[2]);
+	}
+}
+
+static void AddTriangle(MeshType * mesh, unsigned int cellId)
+{
+	MeshType::CellAutoPointer cell;
+	cell.TakeOwnership(new TriangleType);
+	cell->SetPointId(0, cellId);
+	cell->SetPointId(1, cellId + 1);
+	cell->SetPointId(2, cellId + 2);
+	mesh->SetCell(cellId, cell);
+	mesh->SetCellData(cellId, 10.0f * (cellId + 1));
+}
+
+static bool CheckFrame(const MeshType * mesh, unsigned int frame, unsigned int numberOfCells, const std::string & description)
+{
+	if(mesh->GetNumberOfPoints() != NumberOfPoints || mesh->GetNumberOfCells() != numberOfCells)
+	{
+		std::cerr << description << " has " << mesh->GetNumberOfPoints() << " points and " << mesh->GetNumberOfCells()
+			<< " cells instead of " << NumberOfPoints << " and " << numberOfCells << std::endl;
+		return false;
+	}
+
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		MeshType::PointType point;
+		float data = -1;
+		mesh->GetPoint(ii, &point);
+		mesh->GetPointData(ii, &data);
+		const float z = static_cast<float>(frame + 0.25 * ii);
+		if(point[0] != ii % 2 || point[1] != ii / 2 || point[2] != z || data != z)
+		{
+			std::cerr << "Point " << ii << " of " << description << " is at z = " << point[2] << " with data " << data << std::endl;
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < numberOfCells; ii++)
+	{
+		MeshType::CellAutoPointer cell;
+		float data = -1;
+		if(!mesh->GetCell(ii, cell) || !mesh->GetCellData(ii, &data) || cell->GetNumberOfPoints() != 3
+			|| cell->GetPointIds()[0] != ii || cell->GetPointIds()[2] != ii + 2 || data != 10.0f * (ii + 1))
+		{
+			std::cerr << "Cell " << ii << " of " << description << " differs" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = std::string(argv[1]) + "/";
+	const std::string manifestFileName = directory + "series.pvd";
+
+	// The topology files of the frames written
+	const unsigned int frameTopology[NumberOfFrames] = { 0, 0, 0, 1, 2 };
+	const unsigned int frameNumberOfCells[NumberOfFrames] = { 2, 2, 2, 3, 3 };
+
+	try
+	{
+		MeshType::Pointer mesh = MeshType::New();
+		mesh->SetCellsAllocationMethod(MeshType::CellsAllocatedDynamicallyCellByCell);
+		AddTriangle(mesh, 0);
+		AddTriangle(mesh, 1);
+
+		SeriesWriterType::Pointer writer = SeriesWriterType::New();
+		writer->SetFileName(manifestFileName);
+
+		std::string topology;
+		for(unsigned int frame = 0; frame < NumberOfFrames; frame++)
+		{
+			if(frame == 3)
+			{
+				AddTriangle(mesh, 2);
+			}
+			else if(frame == 4)
+			{
+				writer->TopologyModified();
+			}
+			SetFramePoints(mesh, frame);
+			writer->WriteFrame(mesh, GetTime(frame));
+
+			// The first topology file is replaced by a marker, which must
+			// remain while the topology is unchanged
+			if(frame == 0)
+			{
+				topology = ReadFile(directory + "series_topology_0000.vtk");
+				WriteFile(directory + "series_topology_0000.vtk", "unchanged");
+			}
+		}
+
+		if(ReadFile(directory + "series_topology_0000.vtk") != "unchanged")
+		{
+			std::cerr << "The topology file was written again for an unchanged topology" << std::endl;
+			return EXIT_FAILURE;
+		}
+		WriteFile(directory + "series_topology_0000.vtk", topology);
+		if(!FileExists(directory + "series_topology_0001.vtk") || !FileExists(directory + "series_topology_0002.vtk")
+			|| FileExists(directory + "series_topology_0003.vtk"))
+		{
+			std::cerr << "The topology files written are not those of the added cell and of TopologyModified()"
+				<< std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// The frame files only hold the points and point data
+		for(unsigned int frame = 0; frame < NumberOfFrames; frame++)
+		{
+			std::ostringstream fileName;
+			fileName << directory << "series_000" << frame << ".vtk";
+
+			itk::MeshFileReader<MeshType>::Pointer reader = itk::MeshFileReader<MeshType>::New();
+			reader->SetFileName(fileName.str().c_str());
+			reader->Update();
+			if(!CheckFrame(reader->GetOutput(), frame, 0, fileName.str()))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+
+		std::ostringstream manifest;
+		manifest << "<?xml version=\"1.0\"?>\n"
+			<< "<VTKFile type=\"Collection\" version=\"0.1\">\n"
+			<< "  <Collection>\n";
+		for(unsigned int frame = 0; frame < NumberOfFrames; frame++)
+		{
+			manifest << "    <DataSet timestep=\"" << GetTime(frame) << "\" part=\"0\" file=\"series_000" << frame
+				<< ".vtk\" topology=\"series_topology_000" << frameTopology[frame] << ".vtk\"/>\n";
+		}
+		manifest << "  </Collection>\n"
+			<< "</VTKFile>\n";
+		if(ReadFile(manifestFileName) != manifest.str())
+		{
+			std::cerr << "The manifest differs:\n" << ReadFile(manifestFileName) << "instead of:\n" << manifest.str()
+				<< std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// The frames are put back together with their topology
+		SeriesReaderType::Pointer reader = SeriesReaderType::New();
+		reader->SetFileName(manifestFileName);
+		if(reader->GetNumberOfFrames() != NumberOfFrames)
+		{
+			std::cerr << "Read " << reader->GetNumberOfFrames() << " frames from " << manifestFileName << std::endl;
+			return EXIT_FAILURE;
+		}
+		for(unsigned int frame = 0; frame < NumberOfFrames; frame++)
+		{
+			std::ostringstream description;
+			description << "frame " << frame << " of " << manifestFileName;
+			if(reader->GetFrameTime(frame) != GetTime(frame)
+				|| !CheckFrame(reader->ReadFrame(frame), frame, frameNumberOfCells[frame], description.str()))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
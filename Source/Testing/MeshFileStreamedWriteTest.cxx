@@ -0,0 +1,130 @@
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkMesh.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Check that streamed writing gives the file written from whole buffers:
+// the mesh read from the input file is written from whole buffers, then
+// streamed a few points and cells at a time to the same output file, and
+// both files must be identical. With "mixed" as fourth argument, the input
+// file is first written as a VTK file mixing vertices, lines and polygons,
+// which the VTK MeshIO streams in one pass per group of cells.
+
+typedef itk::Mesh<float, 3>                   MeshType;
+typedef itk::MeshFileWriter<MeshType>         MeshFileWriterType;
+
+static std::string ReadFile(const char * fileName)
+{
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+	std::ostringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+static void WriteMixedCellsFile(const char * fileName)
+{
+	std::ofstream file(fileName);
+	file << "# vtk DataFile Version 2.0\n"
+		<< "Mixed cells\n"
+		<< "ASCII\n"
+		<< "DATASET POLYDATA\n"
+		<< "POINTS 7 float\n"
+		<< "0 0 0 1 0 0 1 1 0 0 1 0 0 0 1 1 0 1 1 1 1\n"
+		<< "VERTICES 2 4\n"
+		<< "1 0\n"
+		<< "1 6\n"
+		<< "LINES 2 7\n"
+		<< "3 1 2 3\n"
+		<< "2 5 6\n"
+		<< "POLYGONS 3 13\n"
+		<< "3 0 1 2\n"
+		<< "4 3 4 5 6\n"
+		<< "3 4 5 6\n"
+		<< "POINT_DATA 7\n"
+		<< "SCALARS PointScalarData float\n"
+		<< "LOOKUP_TABLE default\n"
+		<< "0 1.5 3 4.5 6 7.5 9\n"
+		<< "CELL_DATA 7\n"
+		<< "SCALARS CellScalarData float\n"
+		<< "LOOKUP_TABLE default\n"
+		<< "0 2.5 5 7.5 10 12.5 15\n";
+}
+
+static bool WriteMesh(MeshType * mesh, const char * fileName, bool binary, bool streaming)
+{
+	MeshFileWriterType::Pointer writer = MeshFileWriterType::New();
+	writer->SetFileName(fileName);
+	writer->SetInput(mesh);
+	if(binary)
+	{
+		writer->SetFileTypeAsBINARY();
+	}
+	writer->SetUseStreaming(streaming);
+	writer->SetChunkSize(2);
+
+	try
+	{
+		writer->Update();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Write file "<<fileName<<" failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 3)
+	{
+		std::cerr<<"Usage: "<<argv[0]<<" input output [binary [mixed]]"<<std::endl;
+		return EXIT_FAILURE;
+	}
+	const bool binary = argc > 3 && std::atoi(argv[3]) != 0;
+
+	if(argc > 4 && std::strcmp(argv[4], "mixed") == 0)
+	{
+		WriteMixedCellsFile(argv[1]);
+	}
+
+	typedef itk::MeshFileReader<MeshType> MeshFileReaderType;
+	MeshFileReaderType::Pointer reader = MeshFileReaderType::New();
+	reader->SetFileName(argv[1]);
+	try
+	{
+		reader->Update();
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr<<"Read file "<<argv[1]<<" failed "<<std::endl;
+		std::cerr<<err<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(!WriteMesh(reader->GetOutput(), argv[2], binary, false))
+	{
+		return EXIT_FAILURE;
+	}
+	const std::string buffered = ReadFile(argv[2]);
+
+	if(!WriteMesh(reader->GetOutput(), argv[2], binary, true))
+	{
+		return EXIT_FAILURE;
+	}
+	const std::string streamed = ReadFile(argv[2]);
+
+	if(buffered.empty() || streamed != buffered)
+	{
+		std::cerr<<"The streamed file differs from the buffered file "<<argv[2]<<std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
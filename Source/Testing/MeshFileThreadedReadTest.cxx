@@ -0,0 +1,238 @@
+#include "itkMeshFileReader.h"
+#include "itkMeshIOFactory.h"
+#include "itkMesh.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Check the reads of the sections on several threads: a binary VTK file
+// read on one thread and on four threads must give the same mesh, and the
+// exception of a section read failing on a thread must reach the caller of
+// Update(), with the input file closed.
+
+typedef itk::Mesh<float, 3>             MeshType;
+typedef itk::MeshFileReader<MeshType>   MeshFileReaderType;
+
+static const unsigned int NumberOfPoints = 1000;
+static const unsigned int NumberOfCells = NumberOfPoints - 2;
+
+// VTK MeshIO failing to read the cell data, which records the closing of
+// its input file
+class FailingMeshIO:public itk::VTKPolyDataMeshIO
+{
+public:
+	typedef FailingMeshIO Self;
+	typedef itk::VTKPolyDataMeshIO Superclass;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkNewMacro(Self);
+	itkTypeMacro(FailingMeshIO, VTKPolyDataMeshIO);
+
+	virtual void ReadCellData(void * itkNotUsed(buffer))
+	{
+		itkExceptionMacro(<< "Failing to read the cell data");
+	}
+
+	virtual void CloseInputFile()
+	{
+		Superclass::CloseInputFile();
+		m_NumberOfCloses++;
+	}
+
+	unsigned int GetNumberOfCloses() const
+	{
+		return m_NumberOfCloses;
+	}
+
+protected:
+	FailingMeshIO():m_NumberOfCloses(0) {}
+
+private:
+	unsigned int m_NumberOfCloses;
+};
+
+static void WriteMesh(const std::string & fileName)
+{
+	std::vector<float> points(3 * NumberOfPoints);
+	std::vector<float> pointData(NumberOfPoints);
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		points[3 * ii] = static_cast<float>(ii % 10);
+		points[3 * ii + 1] = static_cast<float>(ii / 10);
+		points[3 * ii + 2] = 0.25f * (ii % 7);
+		pointData[ii] = 0.5f * ii;
+	}
+	std::vector<unsigned int> cells(5 * NumberOfCells);
+	std::vector<float> cellData(NumberOfCells);
+	for(unsigned int ii = 0; ii < NumberOfCells; ii++)
+	{
+		cells[5 * ii] = itk::MeshIOBase::TRIANGLE_CELL;
+		cells[5 * ii + 1] = 3;
+		cells[5 * ii + 2] = ii;
+		cells[5 * ii + 3] = ii + 1;
+		cells[5 * ii + 4] = ii + 2;
+		cellData[ii] = 2.0f * ii;
+	}
+
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::WriteMode);
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->SetFileType(itk::MeshIOBase::BINARY);
+	meshIO->SetUpdatePoints(true);
+	meshIO->SetNumberOfPoints(NumberOfPoints);
+	meshIO->SetPointDimension(3);
+	meshIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetUpdateCells(true);
+	meshIO->SetNumberOfCells(NumberOfCells);
+	meshIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	meshIO->SetCellBufferSize(5 * NumberOfCells);
+	meshIO->SetUpdatePointData(true);
+	meshIO->SetPointPixelType(itk::MeshIOBase::SCALAR);
+	meshIO->SetPointPixelComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetNumberOfPointPixelComponents(1);
+	meshIO->SetUpdateCellData(true);
+	meshIO->SetCellPixelType(itk::MeshIOBase::SCALAR);
+	meshIO->SetCellPixelComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetNumberOfCellPixelComponents(1);
+	meshIO->WriteMeshInformation();
+	meshIO->WritePoints(&points[0]);
+	meshIO->WriteCells(&cells[0]);
+	meshIO->WritePointData(&pointData[0]);
+	meshIO->WriteCellData(&cellData[0]);
+	meshIO->Write();
+}
+
+static MeshType::Pointer ReadMesh(const std::string & fileName, unsigned int numberOfThreads)
+{
+	MeshFileReaderType::Pointer reader = MeshFileReaderType::New();
+	reader->SetFileName(fileName.c_str());
+	reader->SetNumberOfThreads(numberOfThreads);
+	reader->Update();
+	return reader->GetOutput();
+}
+
+static bool CompareMeshes(const MeshType * mesh0, const MeshType * mesh1)
+{
+	if(mesh0->GetNumberOfPoints() != NumberOfPoints || mesh1->GetNumberOfPoints() != NumberOfPoints
+		|| mesh0->GetNumberOfCells() != NumberOfCells || mesh1->GetNumberOfCells() != NumberOfCells)
+	{
+		std::cerr << "The meshes read have " << mesh0->GetNumberOfPoints() << " and " << mesh1->GetNumberOfPoints()
+			<< " points, " << mesh0->GetNumberOfCells() << " and " << mesh1->GetNumberOfCells() << " cells" << std::endl;
+		return false;
+	}
+
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		MeshType::PointType point0;
+		MeshType::PointType point1;
+		float data0 = -1;
+		float data1 = -2;
+		mesh0->GetPoint(ii, &point0);
+		mesh1->GetPoint(ii, &point1);
+		mesh0->GetPointData(ii, &data0);
+		mesh1->GetPointData(ii, &data1);
+		if(point0[0] != point1[0] || point0[1] != point1[1] || point0[2] != point1[2] || data0 != data1
+			|| data0 != 0.5f * ii)
+		{
+			std::cerr << "Point " << ii << " differs" << std::endl;
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < NumberOfCells; ii++)
+	{
+		MeshType::CellAutoPointer cell0;
+		MeshType::CellAutoPointer cell1;
+		float data0 = -1;
+		float data1 = -2;
+		mesh0->GetCell(ii, cell0);
+		mesh1->GetCell(ii, cell1);
+		mesh0->GetCellData(ii, &data0);
+		mesh1->GetCellData(ii, &data1);
+		bool differs = cell0->GetNumberOfPoints() != 3 || cell1->GetNumberOfPoints() != 3 || data0 != data1
+			|| data0 != 2.0f * ii;
+		for(unsigned int jj = 0; !differs && jj < 3; jj++)
+		{
+			differs = cell0->GetPointIds()[jj] != ii + jj || cell1->GetPointIds()[jj] != ii + jj;
+		}
+		if(differs)
+		{
+			std::cerr << "Cell " << ii << " differs" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Whether the failure of a section read on a thread reaches the caller,
+// with the input file closed
+static bool CheckFailure(const std::string & fileName)
+{
+	FailingMeshIO::Pointer meshIO = FailingMeshIO::New();
+	MeshFileReaderType::Pointer reader = MeshFileReaderType::New();
+	reader->SetFileName(fileName.c_str());
+	reader->SetMeshIO(meshIO);
+	reader->SetNumberOfThreads(4);
+
+	try
+	{
+		reader->Update();
+		std::cerr << "The failing read of " << fileName << " succeeded" << std::endl;
+		return false;
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		if(std::string(err.GetDescription()).find("Failing to read the cell data") == std::string::npos)
+		{
+			std::cerr << "Unexpected exception " << err << std::endl;
+			return false;
+		}
+	}
+
+	if(meshIO->GetNumberOfCloses() == 0)
+	{
+		std::cerr << "The input file was not closed after the failing read" << std::endl;
+		return false;
+	}
+
+	// The sections of the closed file are not read anymore
+	try
+	{
+		std::vector<float> points(3 * NumberOfPoints);
+		meshIO->ReadPoints(&points[0]);
+	}
+	catch(itk::ExceptionObject &)
+	{
+		return true;
+	}
+	std::cerr << "The points were read after the input file was closed" << std::endl;
+	return false;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string fileName = std::string(argv[1]) + "/threaded_read.vtk";
+
+	try
+	{
+		WriteMesh(fileName);
+		if(!CompareMeshes(ReadMesh(fileName, 1), ReadMesh(fileName, 4)) || !CheckFailure(fileName))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
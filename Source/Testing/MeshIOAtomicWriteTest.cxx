@@ -0,0 +1,185 @@
+#include "itkMeshFileWriter.h"
+#include "itkMesh.h"
+#include "itkTriangleCell.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <itksys/Directory.hxx>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Check that a failed write leaves the existing file as it was: a write
+// throwing once the cells are written to the temporary file, and an append
+// throwing once the point data are appended, must leave the file byte
+// identical and no temporary file behind, while a write that succeeds
+// replaces the file.
+
+typedef itk::Mesh<float, 3>                   MeshType;
+typedef itk::TriangleCell<MeshType::CellType> TriangleType;
+typedef itk::MeshFileWriter<MeshType>         MeshFileWriterType;
+
+// VTK MeshIO failing after writing the cells or the point data
+class FailingMeshIO:public itk::VTKPolyDataMeshIO
+{
+public:
+	typedef FailingMeshIO Self;
+	typedef itk::VTKPolyDataMeshIO Superclass;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkNewMacro(Self);
+	itkTypeMacro(FailingMeshIO, VTKPolyDataMeshIO);
+
+	virtual void WriteCells(void * buffer)
+	{
+		Superclass::WriteCells(buffer);
+		itkExceptionMacro(<< "Failing after the cells");
+	}
+
+	virtual void WritePointData(void * buffer)
+	{
+		Superclass::WritePointData(buffer);
+		itkExceptionMacro(<< "Failing after the point data");
+	}
+};
+
+static std::string ReadFile(const std::string & fileName)
+{
+	std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+	std::ostringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+static MeshType::Pointer CreateMesh(float z, bool pointData)
+{
+	MeshType::Pointer mesh = MeshType::New();
+	mesh->SetCellsAllocationMethod(MeshType::CellsAllocatedDynamicallyCellByCell);
+	for(unsigned int ii = 0; ii < 3; ii++)
+	{
+		MeshType::PointType point;
+		point[0] = static_cast<float>(ii == 1);
+		point[1] = static_cast<float>(ii == 2);
+		point[2] = z;
+		mesh->SetPoint(ii, point);
+		if(pointData)
+		{
+			mesh->SetPointData(ii, 1.5f * ii);
+		}
+	}
+
+	MeshType::CellAutoPointer cell;
+	cell.TakeOwnership(new TriangleType);
+	for(unsigned int ii = 0; ii < 3; ii++)
+	{
+		cell->SetPointId(ii, ii);
+	}
+	mesh->SetCell(0, cell);
+	return mesh;
+}
+
+static void WriteMesh(MeshType * mesh, const std::string & fileName, itk::MeshIOBase * meshIO, bool append)
+{
+	MeshFileWriterType::Pointer writer = MeshFileWriterType::New();
+	writer->SetFileName(fileName.c_str());
+	writer->SetInput(mesh);
+	if(meshIO)
+	{
+		writer->SetMeshIO(meshIO);
+	}
+	writer->SetAppendData(append);
+	writer->SetSyncOutputFile(true);
+	writer->Update();
+}
+
+// Whether the write fails, reporting a write that succeeds
+static bool WriteFails(MeshType * mesh, const std::string & fileName, bool append)
+{
+	try
+	{
+		WriteMesh(mesh, fileName, FailingMeshIO::New(), append);
+	}
+	catch(itk::ExceptionObject &)
+	{
+		return true;
+	}
+	std::cerr << "The failing write of " << fileName << " succeeded" << std::endl;
+	return false;
+}
+
+// Whether a temporary file of fileName is left in directory
+static bool HasTemporaryFile(const std::string & directory, const std::string & fileName)
+{
+	itksys::Directory files;
+	files.Load(directory.c_str());
+	for(unsigned long ii = 0; ii < files.GetNumberOfFiles(); ii++)
+	{
+		const std::string name = files.GetFile(ii);
+		if(name.size() > fileName.size() + 4 && name.compare(0, fileName.size() + 1, fileName + ".") == 0
+			&& name.compare(name.size() - 4, 4, ".tmp") == 0)
+		{
+			std::cerr << "The temporary file " << name << " was left in " << directory << std::endl;
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[1];
+	const std::string fileName = directory + "/atomic.vtk";
+
+	try
+	{
+		WriteMesh(CreateMesh(0, false), fileName, 0, false);
+		const std::string original = ReadFile(fileName);
+
+		// The temporary file of the failed write is deleted
+		if(!WriteFails(CreateMesh(1, false), fileName, false))
+		{
+			return EXIT_FAILURE;
+		}
+		if(ReadFile(fileName) != original || HasTemporaryFile(directory, "atomic.vtk"))
+		{
+			std::cerr << "The failed write changed " << fileName << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// The data appended are cut off
+		if(!WriteFails(CreateMesh(0, true), fileName, true))
+		{
+			return EXIT_FAILURE;
+		}
+		if(ReadFile(fileName) != original)
+		{
+			std::cerr << "The failed append changed " << fileName << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// The temporary file of the write that succeeds replaces the file
+		WriteMesh(CreateMesh(1, false), fileName, 0, false);
+		WriteMesh(CreateMesh(1, false), directory + "/atomic_expected.vtk", 0, false);
+		const std::string replaced = ReadFile(fileName);
+		if(replaced == original || replaced != ReadFile(directory + "/atomic_expected.vtk")
+			|| HasTemporaryFile(directory, "atomic.vtk"))
+		{
+			std::cerr << "The write did not replace " << fileName << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Check that binary points of 64 bits integers and long doubles are read
+// back: the points are written by the VTK MeshIO, which stores the 64 bits
+// integers as the vtktypeuint64 and vtktypeint64 of VTK, whatever the size
+// of long, and the long doubles as double. The 64 bits points and the
+// cells following them are read, and all the points are read again once the
+// POINTS line names their type as the long long and long double names also
+// read by the MeshIO.
+
+// Whether the points and the cells of fileName are read back
+template <class T>
+static bool ReadPoints(const char * fileName, itk::MeshIOBase::IOComponentType componentType, const std::string & name,
+	const T * points, unsigned int numberOfPoints, const unsigned int * cells, unsigned int cellBufferSize)
+{
+	itk::VTKPolyDataMeshIO::Pointer readIO = itk::VTKPolyDataMeshIO::New();
+	readIO->SetFileName(fileName);
+	readIO->ReadMeshInformation();
+	if(readIO->GetPointComponentType() != componentType
+		|| readIO->GetNumberOfPoints() != numberOfPoints || readIO->GetNumberOfCells() != 2)
+	{
+		std::cerr << "Read " << readIO->GetNumberOfPoints() << " points of "
+			<< readIO->GetComponentTypeAsString(readIO->GetPointComponentType()) << " and "
+			<< readIO->GetNumberOfCells() << " cells from " << fileName << std::endl;
+		return false;
+	}
+
+	T readPoints[3 * 4];
+	readIO->ReadPoints(readPoints);
+	for(unsigned int ii = 0; ii < 3 * numberOfPoints; ii++)
+	{
+		if(readPoints[ii] != points[ii])
+		{
+			std::cerr << "Component " << ii << " of the points of " << name << " differs" << std::endl;
+			return false;
+		}
+	}
+
+	unsigned int readCells[10];
+	readIO->ReadCells(readCells);
+	for(unsigned int ii = 1; ii < cellBufferSize; ii++)
+	{
+		// The triangles are read back as polygons
+		if(ii != 5 && readCells[ii] != cells[ii])
+		{
+			std::cerr << "The cells following the points of " << name << " differ" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <class T>
+static bool TestPoints(const char * fileName, itk::MeshIOBase::IOComponentType componentType,
+	itk::MeshIOBase::IOComponentType storedComponentType, const std::string & storedName, const std::string & name,
+	T scale)
+{
+	const unsigned int numberOfPoints = 4;
+	T points[3 * numberOfPoints];
+	for(unsigned int ii = 0; ii < 3 * numberOfPoints; ii++)
+	{
+		points[ii] = static_cast<T>(ii + 1) * scale;
+	}
+	unsigned int cells[] = { itk::MeshIOBase::TRIANGLE_CELL, 3, 0, 1, 2, itk::MeshIOBase::TRIANGLE_CELL, 3, 1, 2, 3 };
+
+	itk::VTKPolyDataMeshIO::Pointer writeIO = itk::VTKPolyDataMeshIO::New();
+	writeIO->SetFileName(fileName);
+	writeIO->SetFileType(itk::MeshIOBase::BINARY);
+	writeIO->SetUpdatePoints(true);
+	writeIO->SetNumberOfPoints(numberOfPoints);
+	writeIO->SetPointDimension(3);
+	writeIO->SetPointComponentType(componentType);
+	writeIO->SetUpdateCells(true);
+	writeIO->SetNumberOfCells(2);
+	writeIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	writeIO->SetCellBufferSize(sizeof(cells) / sizeof(cells[0]));
+	writeIO->WriteMeshInformation();
+	writeIO->WritePoints(points);
+	writeIO->WriteCells(cells);
+	writeIO->Write();
+
+	const unsigned int cellBufferSize = sizeof(cells) / sizeof(cells[0]);
+	if(storedComponentType == componentType
+		&& !ReadPoints(fileName, componentType, storedName, points, numberOfPoints, cells, cellBufferSize))
+	{
+		return false;
+	}
+
+	// Name the points by their type
+	std::ifstream inputFile(fileName, std::ios::in | std::ios::binary);
+	std::ostringstream content;
+	content << inputFile.rdbuf();
+	inputFile.close();
+
+	std::string file = content.str();
+	const std::string pointsLine = "POINTS 4 " + storedName + "\n";
+	const std::string::size_type position = file.find(pointsLine);
+	if(position == std::string::npos)
+	{
+		std::cerr << fileName << " has no line " << pointsLine << std::endl;
+		return false;
+	}
+	file.replace(position, pointsLine.size(), "POINTS 4 " + name + "\n");
+
+	std::ofstream outputFile(fileName, std::ios::out | std::ios::binary);
+	outputFile << file;
+	outputFile.close();
+
+	return ReadPoints(fileName, componentType, name, points, numberOfPoints, cells, cellBufferSize);
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " output.vtk" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		if(!TestPoints<unsigned long long>(argv[1], itk::MeshIOBase::ULONGLONG, itk::MeshIOBase::ULONGLONG,
+				"vtktypeuint64", "unsigned_long_long", 5000000011ULL)
+			|| !TestPoints<long long>(argv[1], itk::MeshIOBase::LONGLONG, itk::MeshIOBase::LONGLONG,
+				"vtktypeint64", "long_long", -5000000011LL)
+			|| !TestPoints<long double>(argv[1], itk::MeshIOBase::LDOUBLE, itk::MeshIOBase::DOUBLE,
+				"double", "long_double", 0.125L))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
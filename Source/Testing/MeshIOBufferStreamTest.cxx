@@ -0,0 +1,213 @@
+#include "itkMeshIOFactory.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Check the round trip of meshes through memory: a mesh is written by the
+// MeshIO of each format into a string buffer and into an output stream,
+// which must hold the bytes of the file written, then read back from the
+// buffer, by a MeshIO created for the buffer and its format hint, and from
+// an input stream.
+
+static const unsigned int NumberOfPoints = 4;
+static const unsigned int NumberOfCells = 2;
+static const unsigned int CellBufferSize = 10;
+
+static float Points[3 * NumberOfPoints] = { 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0.5 };
+static unsigned int Cells[CellBufferSize] = { itk::MeshIOBase::TRIANGLE_CELL, 3, 0, 1, 2,
+	itk::MeshIOBase::TRIANGLE_CELL, 3, 1, 3, 2 };
+
+enum OutputType { FILE_OUTPUT, BUFFER_OUTPUT, STREAM_OUTPUT };
+
+static std::string WriteMesh(const std::string & fileName, OutputType outputType, bool binary)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::WriteMode);
+	if(meshIO.IsNull())
+	{
+		std::cerr << "No MeshIO writes " << fileName << std::endl;
+		return "";
+	}
+
+	std::string buffer;
+	std::ostringstream stream;
+	meshIO->SetFileName(fileName.c_str());
+	if(outputType == BUFFER_OUTPUT)
+	{
+		meshIO->SetOutputBuffer(&buffer);
+	}
+	else if(outputType == STREAM_OUTPUT)
+	{
+		meshIO->SetOutputStream(&stream);
+	}
+	if(binary)
+	{
+		meshIO->SetFileType(itk::MeshIOBase::BINARY);
+	}
+	meshIO->SetUpdatePoints(true);
+	meshIO->SetNumberOfPoints(NumberOfPoints);
+	meshIO->SetPointDimension(3);
+	meshIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetUpdateCells(true);
+	meshIO->SetNumberOfCells(NumberOfCells);
+	meshIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	meshIO->SetCellBufferSize(CellBufferSize);
+	meshIO->WriteMeshInformation();
+	meshIO->WritePoints(Points);
+	meshIO->WriteCells(Cells);
+	meshIO->Write();
+
+	if(outputType == BUFFER_OUTPUT)
+	{
+		return buffer;
+	}
+	if(outputType == STREAM_OUTPUT)
+	{
+		return stream.str();
+	}
+
+	std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+	std::ostringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+static double GetComponent(const std::vector<char> & buffer, itk::MeshIOBase::IOComponentType componentType,
+	unsigned int index)
+{
+	switch(componentType)
+	{
+	case itk::MeshIOBase::INT:
+		return reinterpret_cast<const int *>(&buffer[0])[index];
+	case itk::MeshIOBase::UINT:
+		return reinterpret_cast<const unsigned int *>(&buffer[0])[index];
+	case itk::MeshIOBase::LONG:
+		return reinterpret_cast<const long *>(&buffer[0])[index];
+	case itk::MeshIOBase::ULONG:
+		return reinterpret_cast<const unsigned long *>(&buffer[0])[index];
+	case itk::MeshIOBase::FLOAT:
+		return reinterpret_cast<const float *>(&buffer[0])[index];
+	case itk::MeshIOBase::DOUBLE:
+		return reinterpret_cast<const double *>(&buffer[0])[index];
+	default:
+		return -1;
+	}
+}
+
+static bool CheckMesh(itk::MeshIOBase * meshIO, const std::string & description)
+{
+	meshIO->ReadMeshInformation();
+	if(meshIO->GetNumberOfPoints() != NumberOfPoints || meshIO->GetNumberOfCells() != NumberOfCells
+		|| meshIO->GetCellBufferSize() != CellBufferSize)
+	{
+		std::cerr << "Read " << meshIO->GetNumberOfPoints() << " points and " << meshIO->GetNumberOfCells()
+			<< " cells from " << description << std::endl;
+		return false;
+	}
+
+	// Each MeshIO reads the components in the type of its own choice
+	std::vector<char> readPoints(3 * NumberOfPoints * meshIO->GetComponentSize(meshIO->GetPointComponentType()));
+	std::vector<char> readCells(CellBufferSize * meshIO->GetComponentSize(meshIO->GetCellComponentType()));
+	meshIO->ReadPoints(&readPoints[0]);
+	meshIO->ReadCells(&readCells[0]);
+	meshIO->CloseInputFile();
+
+	for(unsigned int ii = 0; ii < 3 * NumberOfPoints; ii++)
+	{
+		if(GetComponent(readPoints, meshIO->GetPointComponentType(), ii) != Points[ii])
+		{
+			std::cerr << "Component " << ii << " of the points read from " << description << " differs" << std::endl;
+			return false;
+		}
+	}
+	for(unsigned int ii = 0; ii < CellBufferSize; ii++)
+	{
+		// The triangles may be read back as polygons
+		if(ii != 0 && ii != 5 && GetComponent(readCells, meshIO->GetCellComponentType(), ii) != Cells[ii])
+		{
+			std::cerr << "The cells read from " << description << " differ" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool TestFormat(const std::string & fileName, const char * className, bool binary)
+{
+	const std::string file = WriteMesh(fileName, FILE_OUTPUT, binary);
+	const std::string buffer = WriteMesh(fileName, BUFFER_OUTPUT, binary);
+	const std::string streamed = WriteMesh(fileName, STREAM_OUTPUT, binary);
+
+	// A compressed output is only checked to be gzip compressed, as the
+	// compression of the file may differ from the compression in memory
+	const bool compressed = fileName.size() > 3 && fileName.compare(fileName.size() - 3, 3, ".gz") == 0;
+	if(compressed)
+	{
+		if(buffer.size() < 2 || buffer[0] != '\x1f' || buffer[1] != '\x8b' || streamed.size() < 2
+			|| streamed[0] != '\x1f' || streamed[1] != '\x8b')
+		{
+			std::cerr << "The buffer or the stream of " << fileName << " is not gzip compressed" << std::endl;
+			return false;
+		}
+	}
+	else if(file.empty() || buffer != file || streamed != file)
+	{
+		std::cerr << "The " << buffer.size() << " bytes of the buffer and the " << streamed.size()
+			<< " bytes of the stream differ from the " << file.size() << " bytes of " << fileName << std::endl;
+		return false;
+	}
+
+	// The buffer is identified by its header and the extension of the hint
+	const std::string extension = itk::MeshIOBase::GetFileNameExtension(fileName);
+	itk::MeshIOBase::Pointer bufferIO = itk::MeshIOFactory::CreateMeshIO(buffer.data(), buffer.size(), extension.c_str());
+	if(bufferIO.IsNull() || std::string(bufferIO->GetNameOfClass()) != className)
+	{
+		std::cerr << "The buffer of " << fileName << " is not read by " << className << std::endl;
+		return false;
+	}
+	bufferIO->SetInputBuffer(buffer.data(), buffer.size());
+	if(!CheckMesh(bufferIO, "the buffer of " + fileName))
+	{
+		return false;
+	}
+
+	// The stream is read once, and its content read again by the later reads
+	std::istringstream stream(streamed);
+	itk::MeshIOBase::Pointer streamIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::WriteMode);
+	streamIO->SetFileName(fileName.c_str());
+	streamIO->SetInputStream(&stream);
+	return CheckMesh(streamIO, "the stream of " + fileName) && CheckMesh(streamIO, "the stream of " + fileName + " again");
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[1];
+
+	try
+	{
+		if(!TestFormat(directory + "/buffer_ascii.vtk", "VTKPolyDataMeshIO", false)
+			|| !TestFormat(directory + "/buffer_binary.vtk", "VTKPolyDataMeshIO", true)
+			|| !TestFormat(directory + "/buffer.vtk.gz", "VTKPolyDataMeshIO", true)
+			|| !TestFormat(directory + "/buffer.off", "OFFMeshIO", false)
+			|| !TestFormat(directory + "/buffer.obj", "OBJMeshIO", false)
+			|| !TestFormat(directory + "/buffer.byu", "BYUMeshIO", false))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+#include "itkVTKPolyDataMeshIO.h"
+#include "itkMetaDataObject.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Check the selection of named data arrays: a VTK file with three point
+// data arrays and a cell data array, of different component types, is
+// written by appending the arrays, then each array is selected by name
+// and read alone, several are read at once in another order, and an
+// unknown name is refused.
+
+static void WriteMeshWithDataArrays(const char * fileName, bool binary)
+{
+	itk::VTKPolyDataMeshIO::Pointer meshIO = itk::VTKPolyDataMeshIO::New();
+	meshIO->SetFileName(fileName);
+	if(binary)
+	{
+		meshIO->SetFileType(itk::MeshIOBase::BINARY);
+	}
+	float points[12] = { 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0 };
+	unsigned int cells[10] = { itk::MeshIOBase::TRIANGLE_CELL, 3, 0, 1, 2, itk::MeshIOBase::TRIANGLE_CELL, 3, 1, 3, 2 };
+	float pointData[4] = { 1, 2, 3, 4 };
+	meshIO->SetUpdatePoints(true);
+	meshIO->SetNumberOfPoints(4);
+	meshIO->SetPointDimension(3);
+	meshIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetUpdateCells(true);
+	meshIO->SetNumberOfCells(2);
+	meshIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	meshIO->SetCellBufferSize(10);
+	meshIO->SetUpdatePointData(true);
+	meshIO->SetPointPixelType(itk::MeshIOBase::SCALAR);
+	meshIO->SetPointPixelComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetNumberOfPointPixelComponents(1);
+	meshIO->WriteMeshInformation();
+	meshIO->WritePoints(points);
+	meshIO->WriteCells(cells);
+	meshIO->WritePointData(pointData);
+	meshIO->Write();
+}
+
+static void AppendDataArray(const char * fileName, const char * arrayName, double * data, bool cellData)
+{
+	itk::VTKPolyDataMeshIO::Pointer meshIO = itk::VTKPolyDataMeshIO::New();
+	meshIO->SetFileName(fileName);
+	meshIO->SetAppendData(true);
+	if(cellData)
+	{
+		itk::EncapsulateMetaData<std::string>(meshIO->GetMetaDataDictionary(), "cellScalarDataName", arrayName);
+		meshIO->SetUpdateCellData(true);
+		meshIO->SetNumberOfCells(2);
+		meshIO->SetCellPixelType(itk::MeshIOBase::SCALAR);
+		meshIO->SetCellPixelComponentType(itk::MeshIOBase::DOUBLE);
+		meshIO->SetNumberOfCellPixelComponents(1);
+	}
+	else
+	{
+		itk::EncapsulateMetaData<std::string>(meshIO->GetMetaDataDictionary(), "pointScalarDataName", arrayName);
+		meshIO->SetUpdatePointData(true);
+		meshIO->SetNumberOfPoints(4);
+		meshIO->SetPointPixelType(itk::MeshIOBase::SCALAR);
+		meshIO->SetPointPixelComponentType(itk::MeshIOBase::DOUBLE);
+		meshIO->SetNumberOfPointPixelComponents(1);
+	}
+	meshIO->WriteMeshInformation();
+	if(cellData)
+	{
+		meshIO->WriteCellData(data);
+	}
+	else
+	{
+		meshIO->WritePointData(data);
+	}
+	meshIO->Write();
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " output.vtk [binary]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const bool binary = argc > 2 && std::atoi(argv[2]) != 0;
+
+	double thickness[4] = { 10, 20, 30, 40 };
+	double curvature[4] = { -0.5, 0.25, -0.125, 0.0625 };
+	double area[2] = { 0.5, 1.5 };
+	try
+	{
+		WriteMeshWithDataArrays(argv[1], binary);
+		AppendDataArray(argv[1], "thickness", thickness, false);
+		AppendDataArray(argv[1], "area", area, true);
+		AppendDataArray(argv[1], "curvature", curvature, false);
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << "Write file " << argv[1] << " failed " << std::endl;
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	itk::VTKPolyDataMeshIO::Pointer meshIO = itk::VTKPolyDataMeshIO::New();
+	meshIO->SetFileName(argv[1]);
+	try
+	{
+		// The first arrays are selected by default
+		meshIO->ReadMeshInformation();
+		const itk::MeshIOBase::DataArrayInformationContainer & pointArrays = meshIO->GetPointDataArrays();
+		const itk::MeshIOBase::DataArrayInformationContainer & cellArrays = meshIO->GetCellDataArrays();
+		if(pointArrays.size() != 3 || pointArrays[0].Name != "PointScalarData" || pointArrays[1].Name != "thickness"
+			|| pointArrays[2].Name != "curvature" || cellArrays.size() != 1 || cellArrays[0].Name != "area")
+		{
+			std::cerr << "Found " << pointArrays.size() << " point data arrays and " << cellArrays.size()
+				<< " cell data arrays, or misnamed" << std::endl;
+			return EXIT_FAILURE;
+		}
+		if(meshIO->GetPointPixelComponentType() != itk::MeshIOBase::FLOAT)
+		{
+			std::cerr << "The first point data array is not selected" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// A named array describes the point data and is read alone
+		meshIO->SetPointDataArrayName("curvature");
+		meshIO->SetCellDataArrayName("area");
+		meshIO->ReadMeshInformation();
+		if(meshIO->GetPointPixelComponentType() != itk::MeshIOBase::DOUBLE
+			|| meshIO->GetCellPixelComponentType() != itk::MeshIOBase::DOUBLE)
+		{
+			std::cerr << "The named arrays do not describe the data" << std::endl;
+			return EXIT_FAILURE;
+		}
+		double readCurvature[4];
+		double readArea[2];
+		meshIO->ReadPointData(readCurvature);
+		meshIO->ReadCellData(readArea);
+		for(unsigned int ii = 0; ii < 4; ii++)
+		{
+			if(readCurvature[ii] != curvature[ii] || (ii < 2 && readArea[ii] != area[ii]))
+			{
+				std::cerr << "The named arrays read differ at " << ii << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		// Several arrays are read at once, in the order of the names
+		std::vector<std::string> names;
+		names.push_back("thickness");
+		names.push_back("PointScalarData");
+		names.push_back("curvature");
+		double readThickness[4] = { 0, 0, 0, 0 };
+		float readScalars[4] = { 0, 0, 0, 0 };
+		double readCurvatureAgain[4] = { 0, 0, 0, 0 };
+		std::vector<void *> buffers;
+		buffers.push_back(readThickness);
+		buffers.push_back(readScalars);
+		buffers.push_back(readCurvatureAgain);
+		meshIO->ReadPointDataArrays(names, buffers);
+		for(unsigned int ii = 0; ii < 4; ii++)
+		{
+			if(readThickness[ii] != thickness[ii] || readScalars[ii] != ii + 1 || readCurvatureAgain[ii] != curvature[ii])
+			{
+				std::cerr << "The arrays read at once differ at " << ii << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << "Read file " << argv[1] << " failed " << std::endl;
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// An unknown name is refused
+	try
+	{
+		meshIO->SetPointDataArrayName("missing");
+		meshIO->ReadMeshInformation();
+		std::cerr << "The point data array named missing was selected" << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cout << "Expected exception: " << err.GetDescription() << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
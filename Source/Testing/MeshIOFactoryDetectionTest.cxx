@@ -0,0 +1,177 @@
+#include "itkCreateObjectFunction.h"
+#include "itkMeshIOFactory.h"
+#include "itkOFFMeshIO.h"
+#include "itkVersion.h"
+#include "itkVTKPolyDataMeshIO.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Check that the MeshIO reading a file is chosen by its content: a VTK and
+// an OBJ file without extension, an OFF file named ".vtk" and a gzip
+// compressed ".vtk.gz" file must each be read by the MeshIO of their
+// format, which finds their three points. A factory registered after the
+// first use of the MeshIOs must then be used without ReHash().
+
+// MeshIO writing the ".late" files, registered by the test
+class LateMeshIO:public itk::OFFMeshIO
+{
+public:
+	typedef LateMeshIO Self;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkNewMacro(Self);
+	itkTypeMacro(LateMeshIO, OFFMeshIO);
+
+	virtual bool CanWriteFile(const char * fileName)
+	{
+		return this->GetFileNameExtension(fileName) == ".late";
+	}
+};
+
+class LateMeshIOFactory:public itk::ObjectFactoryBase
+{
+public:
+	typedef LateMeshIOFactory Self;
+	typedef itk::SmartPointer<Self> Pointer;
+
+	itkFactorylessNewMacro(Self);
+	itkTypeMacro(LateMeshIOFactory, ObjectFactoryBase);
+
+	virtual const char * GetITKSourceVersion() const
+	{
+		return ITK_SOURCE_VERSION;
+	}
+	virtual const char * GetDescription() const
+	{
+		return "Late Mesh IO Factory";
+	}
+
+protected:
+	LateMeshIOFactory()
+	{
+		this->RegisterOverride("itkMeshIOBase", "LateMeshIO", "Late Mesh IO", 1, itk::CreateObjectFunction<LateMeshIO>::New());
+	}
+};
+
+static void WriteTextFile(const std::string & fileName, const char * content)
+{
+	std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+	file << content;
+}
+
+static bool CheckDetection(const std::string & fileName, const char * className)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::ReadMode);
+	if(meshIO.IsNull())
+	{
+		std::cerr << "No MeshIO reads " << fileName << std::endl;
+		return false;
+	}
+	if(std::string(meshIO->GetNameOfClass()) != className)
+	{
+		std::cerr << fileName << " is read by " << meshIO->GetNameOfClass() << " instead of " << className << std::endl;
+		return false;
+	}
+
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->ReadMeshInformation();
+	if(meshIO->GetNumberOfPoints() != 3)
+	{
+		std::cerr << "Read " << meshIO->GetNumberOfPoints() << " points from " << fileName << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[1];
+
+	const char * vtkContent = "# vtk DataFile Version 2.0\n"
+		"Detection\n"
+		"ASCII\n"
+		"DATASET POLYDATA\n"
+		"POINTS 3 float\n"
+		"0 0 0 1 0 0 0 1 0\n"
+		"POLYGONS 1 4\n"
+		"3 0 1 2\n";
+	WriteTextFile(directory + "/detection_vtk", vtkContent);
+	WriteTextFile(directory + "/detection_obj",
+		"# OBJ\n"
+		"v 0 0 0\n"
+		"v 1 0 0\n"
+		"v 0 1 0\n"
+		"f 1 2 3\n");
+	WriteTextFile(directory + "/detection_off.vtk",
+		"OFF\n"
+		"3 1 0\n"
+		"0 0 0\n"
+		"1 0 0\n"
+		"0 1 0\n"
+		"3 0 1 2\n");
+
+	try
+	{
+		// The ".gz" extension compresses the file written
+		float points[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+		unsigned int cells[5] = { itk::MeshIOBase::TRIANGLE_CELL, 3, 0, 1, 2 };
+		itk::VTKPolyDataMeshIO::Pointer writeIO = itk::VTKPolyDataMeshIO::New();
+		writeIO->SetFileName((directory + "/detection.vtk.gz").c_str());
+		writeIO->SetUpdatePoints(true);
+		writeIO->SetNumberOfPoints(3);
+		writeIO->SetPointDimension(3);
+		writeIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+		writeIO->SetUpdateCells(true);
+		writeIO->SetNumberOfCells(1);
+		writeIO->SetCellComponentType(itk::MeshIOBase::UINT);
+		writeIO->SetCellBufferSize(5);
+		writeIO->WriteMeshInformation();
+		writeIO->WritePoints(points);
+		writeIO->WriteCells(cells);
+		writeIO->Write();
+
+		if(!CheckDetection(directory + "/detection_vtk", "VTKPolyDataMeshIO")
+			|| !CheckDetection(directory + "/detection_obj", "OBJMeshIO")
+			|| !CheckDetection(directory + "/detection_off.vtk", "OFFMeshIO")
+			|| !CheckDetection(directory + "/detection.vtk.gz", "VTKPolyDataMeshIO"))
+		{
+			return EXIT_FAILURE;
+		}
+
+		const std::string lateFileName = directory + "/detection.late";
+		if(itk::MeshIOFactory::CreateMeshIO(lateFileName.c_str(), itk::MeshIOFactory::WriteMode).IsNotNull())
+		{
+			std::cerr << "A MeshIO writes " << lateFileName << " before its factory is registered" << std::endl;
+			return EXIT_FAILURE;
+		}
+		itk::ObjectFactoryBase::RegisterFactory(LateMeshIOFactory::New());
+		itk::MeshIOBase::Pointer lateIO = itk::MeshIOFactory::CreateMeshIO(lateFileName.c_str(), itk::MeshIOFactory::WriteMode);
+		if(lateIO.IsNull() || std::string(lateIO->GetNameOfClass()) != "LateMeshIO")
+		{
+			std::cerr << "The MeshIO of the factory registered last does not write " << lateFileName << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream compressedFile((directory + "/detection.vtk.gz").c_str(), std::ios::in | std::ios::binary);
+	if(compressedFile.get() != 0x1f || compressedFile.get() != 0x8b)
+	{
+		std::cerr << "detection.vtk.gz is not gzip compressed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
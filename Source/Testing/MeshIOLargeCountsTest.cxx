@@ -0,0 +1,70 @@
+#include "itkVTKPolyDataMeshIO.h"
+#include "itkOFFMeshIO.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+// Check that the counts of meshes beyond 2^32 points and cells survive the
+// mesh information, without allocating their buffers: a VTK file header is
+// read back with its counts, and a binary OFF file, which counts on 32 bits,
+// refuses to be written.
+int main(int argc, char ** argv)
+{
+	if(argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " output.vtk output.off" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const itk::MeshIOBase::SizeValueType numberOfPoints = 5000000000ULL;
+	const itk::MeshIOBase::SizeValueType numberOfCells = 1100000000ULL;
+
+	std::ofstream outputFile(argv[1]);
+	outputFile << "# vtk DataFile Version 2.0\n"
+		<< "Large counts\n"
+		<< "ASCII\n"
+		<< "DATASET POLYDATA\n"
+		<< "POINTS " << numberOfPoints << " float\n"
+		<< "POLYGONS " << numberOfCells << " " << numberOfCells * 5 << "\n";
+	outputFile.close();
+
+	itk::VTKPolyDataMeshIO::Pointer vtkIO = itk::VTKPolyDataMeshIO::New();
+	vtkIO->SetFileName(argv[1]);
+	vtkIO->ReadMeshInformation();
+
+	if(vtkIO->GetNumberOfPoints() != numberOfPoints
+		|| vtkIO->GetNumberOfCells() != numberOfCells
+		|| vtkIO->GetCellBufferSize() != numberOfCells * 6)
+	{
+		std::cerr << "Read " << vtkIO->GetNumberOfPoints() << " points, "
+			<< vtkIO->GetNumberOfCells() << " cells and a cell buffer of "
+			<< vtkIO->GetCellBufferSize() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(vtkIO->GetCellComponentType() != itk::MeshIOBase::ULONGLONG)
+	{
+		std::cerr << "The point identifiers are read as "
+			<< vtkIO->GetComponentTypeAsString(vtkIO->GetCellComponentType()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	itk::OFFMeshIO::Pointer offIO = itk::OFFMeshIO::New();
+	offIO->SetFileName(argv[2]);
+	offIO->SetFileTypeToBinary();
+	offIO->SetNumberOfPoints(numberOfPoints);
+	offIO->SetNumberOfCells(numberOfCells);
+	try
+	{
+		offIO->WriteMeshInformation();
+		std::cerr << "The counts of the binary OFF file were truncated" << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cout << "Expected exception: " << err.GetDescription() << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,295 @@
+#include "itkMeshIOFactory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Check the ranged reads against the whole sections: a mesh is written as
+// binary and ASCII VTK and as a FreeSurfer surface, and each section read
+// by range, one record at a time, by chunks of three records, the last one
+// shorter, and all at once, must give the bytes of the whole section. Empty
+// ranges must leave the buffer alone, ranges past the end must throw, and
+// the sections without random access must refuse ranged reads.
+
+static const unsigned int NumberOfPoints = 10;
+static const unsigned int NumberOfCells = 8;
+
+static float Points[3 * NumberOfPoints];
+static unsigned int Cells[5 * NumberOfCells];
+static float PointData[NumberOfPoints];
+static float CellData[NumberOfCells];
+
+static const itk::MeshIOBase::SectionType Sections[4] = { itk::MeshIOBase::POINTS_SECTION,
+	itk::MeshIOBase::CELLS_SECTION, itk::MeshIOBase::POINTDATA_SECTION, itk::MeshIOBase::CELLDATA_SECTION };
+static const char * SectionNames[4] = { "points", "cells", "point data", "cell data" };
+
+static void CreateMesh()
+{
+	for(unsigned int ii = 0; ii < NumberOfPoints; ii++)
+	{
+		Points[3 * ii] = static_cast<float>(ii);
+		Points[3 * ii + 1] = static_cast<float>(ii % 3);
+		Points[3 * ii + 2] = 0.5f * ii;
+		PointData[ii] = 0.25f * ii;
+	}
+	for(unsigned int ii = 0; ii < NumberOfCells; ii++)
+	{
+		Cells[5 * ii] = itk::MeshIOBase::TRIANGLE_CELL;
+		Cells[5 * ii + 1] = 3;
+		Cells[5 * ii + 2] = ii;
+		Cells[5 * ii + 3] = ii + 1;
+		Cells[5 * ii + 4] = ii + 2;
+		CellData[ii] = 10.0f + ii;
+	}
+}
+
+static void WriteMesh(const std::string & fileName, bool binary, bool data)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::WriteMode);
+	if(meshIO.IsNull())
+	{
+		itkGenericExceptionMacro(<< "No MeshIO writes " << fileName);
+	}
+
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->SetFileType(binary ? itk::MeshIOBase::BINARY : itk::MeshIOBase::ASCII);
+	meshIO->SetUpdatePoints(true);
+	meshIO->SetNumberOfPoints(NumberOfPoints);
+	meshIO->SetPointDimension(3);
+	meshIO->SetPointComponentType(itk::MeshIOBase::FLOAT);
+	meshIO->SetUpdateCells(true);
+	meshIO->SetNumberOfCells(NumberOfCells);
+	meshIO->SetCellComponentType(itk::MeshIOBase::UINT);
+	meshIO->SetCellBufferSize(5 * NumberOfCells);
+	if(data)
+	{
+		meshIO->SetUpdatePointData(true);
+		meshIO->SetPointPixelType(itk::MeshIOBase::SCALAR);
+		meshIO->SetPointPixelComponentType(itk::MeshIOBase::FLOAT);
+		meshIO->SetNumberOfPointPixelComponents(1);
+		meshIO->SetUpdateCellData(true);
+		meshIO->SetCellPixelType(itk::MeshIOBase::SCALAR);
+		meshIO->SetCellPixelComponentType(itk::MeshIOBase::FLOAT);
+		meshIO->SetNumberOfCellPixelComponents(1);
+	}
+	meshIO->WriteMeshInformation();
+	meshIO->WritePoints(Points);
+	meshIO->WriteCells(Cells);
+	if(data)
+	{
+		meshIO->WritePointData(PointData);
+		meshIO->WriteCellData(CellData);
+	}
+	meshIO->Write();
+}
+
+static void ReadSection(itk::MeshIOBase * meshIO, itk::MeshIOBase::SectionType section, void * buffer)
+{
+	switch(section)
+	{
+	case itk::MeshIOBase::POINTS_SECTION:
+		meshIO->ReadPoints(buffer);
+		break;
+	case itk::MeshIOBase::CELLS_SECTION:
+		meshIO->ReadCells(buffer);
+		break;
+	case itk::MeshIOBase::POINTDATA_SECTION:
+		meshIO->ReadPointData(buffer);
+		break;
+	default:
+		meshIO->ReadCellData(buffer);
+		break;
+	}
+}
+
+static void ReadRange(itk::MeshIOBase * meshIO, itk::MeshIOBase::SectionType section, void * buffer,
+	itk::MeshIOBase::SizeValueType first, itk::MeshIOBase::SizeValueType count)
+{
+	switch(section)
+	{
+	case itk::MeshIOBase::POINTS_SECTION:
+		meshIO->ReadPointsRange(buffer, first, count);
+		break;
+	case itk::MeshIOBase::CELLS_SECTION:
+		meshIO->ReadCellsRange(buffer, first, count);
+		break;
+	case itk::MeshIOBase::POINTDATA_SECTION:
+		meshIO->ReadPointDataRange(buffer, first, count);
+		break;
+	default:
+		meshIO->ReadCellDataRange(buffer, first, count);
+		break;
+	}
+}
+
+// Number of records of a section and size of a record in the buffers
+static void GetRecordLayout(itk::MeshIOBase * meshIO, itk::MeshIOBase::SectionType section,
+	unsigned int & numberOfRecords, std::size_t & recordSize)
+{
+	switch(section)
+	{
+	case itk::MeshIOBase::POINTS_SECTION:
+		numberOfRecords = NumberOfPoints;
+		recordSize = meshIO->GetPointDimension() * meshIO->GetComponentSize(meshIO->GetPointComponentType());
+		break;
+	case itk::MeshIOBase::CELLS_SECTION:
+		// The cells are all triangles
+		numberOfRecords = NumberOfCells;
+		recordSize = 5 * meshIO->GetComponentSize(meshIO->GetCellComponentType());
+		break;
+	case itk::MeshIOBase::POINTDATA_SECTION:
+		numberOfRecords = NumberOfPoints;
+		recordSize = meshIO->GetNumberOfPointPixelComponents()
+			* meshIO->GetComponentSize(meshIO->GetPointPixelComponentType());
+		break;
+	default:
+		numberOfRecords = NumberOfCells;
+		recordSize = meshIO->GetNumberOfCellPixelComponents()
+			* meshIO->GetComponentSize(meshIO->GetCellPixelComponentType());
+		break;
+	}
+}
+
+static bool CheckSection(itk::MeshIOBase * meshIO, unsigned int sectionIndex, const std::string & fileName)
+{
+	const itk::MeshIOBase::SectionType section = Sections[sectionIndex];
+	unsigned int numberOfRecords = 0;
+	std::size_t recordSize = 0;
+	GetRecordLayout(meshIO, section, numberOfRecords, recordSize);
+
+	std::vector<char> whole(numberOfRecords * recordSize);
+	ReadSection(meshIO, section, &whole[0]);
+
+	// Chunks of 1 record, of 3 records with a last one of 1 or 2, and the
+	// whole section
+	const unsigned int chunkSizes[3] = { 1, 3, numberOfRecords };
+	for(unsigned int ii = 0; ii < 3; ii++)
+	{
+		for(unsigned int first = 0; first < numberOfRecords; first += chunkSizes[ii])
+		{
+			const unsigned int count = first + chunkSizes[ii] > numberOfRecords ? numberOfRecords - first : chunkSizes[ii];
+			std::vector<char> range(count * recordSize);
+			ReadRange(meshIO, section, &range[0], first, count);
+			if(std::memcmp(&range[0], &whole[first * recordSize], range.size()) != 0)
+			{
+				std::cerr << "The " << SectionNames[sectionIndex] << " [" << first << ", " << first + count << ") of "
+					<< fileName << " differ from the whole section" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// The empty ranges read nothing, at the start as at the end
+	char untouched[4] = { 'a', 'b', 'c', 'd' };
+	ReadRange(meshIO, section, untouched, 0, 0);
+	ReadRange(meshIO, section, untouched, numberOfRecords, 0);
+	if(std::memcmp(untouched, "abcd", 4) != 0)
+	{
+		std::cerr << "An empty range of the " << SectionNames[sectionIndex] << " of " << fileName << " was written"
+			<< std::endl;
+		return false;
+	}
+
+	try
+	{
+		std::vector<char> range(2 * recordSize);
+		ReadRange(meshIO, section, &range[0], numberOfRecords - 1, 2);
+	}
+	catch(itk::ExceptionObject &)
+	{
+		return true;
+	}
+	std::cerr << "A range past the " << SectionNames[sectionIndex] << " of " << fileName << " was read" << std::endl;
+	return false;
+}
+
+// Check the ranged reads of the sections with random access, and that the
+// others refuse them
+static bool CheckFile(const std::string & fileName, unsigned int numberOfRandomAccessSections,
+	const itk::MeshIOBase::SectionType * randomAccessSections)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName.c_str(), itk::MeshIOFactory::ReadMode);
+	if(meshIO.IsNull())
+	{
+		std::cerr << "No MeshIO reads " << fileName << std::endl;
+		return false;
+	}
+	meshIO->SetFileName(fileName.c_str());
+	meshIO->ReadMeshInformation();
+
+	for(unsigned int ii = 0; ii < 4; ii++)
+	{
+		bool randomAccess = false;
+		for(unsigned int jj = 0; jj < numberOfRandomAccessSections; jj++)
+		{
+			randomAccess = randomAccess || randomAccessSections[jj] == Sections[ii];
+		}
+		if(meshIO->SupportsRandomAccess(Sections[ii]) != randomAccess)
+		{
+			std::cerr << "The " << SectionNames[ii] << " of " << fileName << " are "
+				<< (randomAccess ? "not " : "") << "randomly accessible" << std::endl;
+			return false;
+		}
+
+		if(randomAccess)
+		{
+			if(!CheckSection(meshIO, ii, fileName))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		try
+		{
+			char buffer[64];
+			ReadRange(meshIO, Sections[ii], buffer, 0, 1);
+		}
+		catch(itk::ExceptionObject &)
+		{
+			continue;
+		}
+		std::cerr << "A range of the " << SectionNames[ii] << " of " << fileName << " was read" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::string directory = argv[1];
+
+	const itk::MeshIOBase::SectionType vtkSections[3] = { itk::MeshIOBase::POINTS_SECTION,
+		itk::MeshIOBase::POINTDATA_SECTION, itk::MeshIOBase::CELLDATA_SECTION };
+	const itk::MeshIOBase::SectionType surfaceSections[2] = { itk::MeshIOBase::POINTS_SECTION,
+		itk::MeshIOBase::CELLS_SECTION };
+
+	try
+	{
+		CreateMesh();
+		WriteMesh(directory + "/ranged_binary.vtk", true, true);
+		WriteMesh(directory + "/ranged_ascii.vtk", false, true);
+		WriteMesh(directory + "/ranged.fsb", true, false);
+
+		if(!CheckFile(directory + "/ranged_binary.vtk", 3, vtkSections)
+			|| !CheckFile(directory + "/ranged_ascii.vtk", 0, vtkSections)
+			|| !CheckFile(directory + "/ranged.fsb", 2, surfaceSections))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+#include "itkMeshIOFactory.h"
+#include "itkMeshIOTranscoder.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Check the conversion of a mesh file by MeshIOTranscoder, or by the
+// ConvertMesh example when its path is given: the file written is read
+// back and must hold the points, the cells and, when its format stores
+// them, the point data of the input file.
+
+template <class T>
+static void CopyComponents(const std::vector<char> & buffer, std::vector<double> & components)
+{
+	const T * data = reinterpret_cast<const T *>(&buffer[0]);
+	for(std::size_t ii = 0; ii < components.size(); ii++)
+	{
+		components[ii] = static_cast<double>(data[ii]);
+	}
+}
+
+// Read a section of numberOfComponents components as double
+static std::vector<double> ReadSection(itk::MeshIOBase * meshIO, itk::MeshIOBase::SectionType section,
+	itk::MeshIOBase::IOComponentType componentType, std::size_t numberOfComponents)
+{
+	std::vector<double> components(numberOfComponents);
+	if(numberOfComponents == 0)
+	{
+		return components;
+	}
+
+	std::vector<char> buffer(numberOfComponents * meshIO->GetComponentSize(componentType));
+	switch(section)
+	{
+	case itk::MeshIOBase::POINTS_SECTION:
+		meshIO->ReadPoints(&buffer[0]);
+		break;
+	case itk::MeshIOBase::CELLS_SECTION:
+		meshIO->ReadCells(&buffer[0]);
+		break;
+	default:
+		meshIO->ReadPointData(&buffer[0]);
+		break;
+	}
+
+	switch(componentType)
+	{
+	case itk::MeshIOBase::INT:
+		CopyComponents<int>(buffer, components);
+		break;
+	case itk::MeshIOBase::UINT:
+		CopyComponents<unsigned int>(buffer, components);
+		break;
+	case itk::MeshIOBase::LONG:
+		CopyComponents<long>(buffer, components);
+		break;
+	case itk::MeshIOBase::ULONG:
+		CopyComponents<unsigned long>(buffer, components);
+		break;
+	case itk::MeshIOBase::FLOAT:
+		CopyComponents<float>(buffer, components);
+		break;
+	case itk::MeshIOBase::DOUBLE:
+		CopyComponents<double>(buffer, components);
+		break;
+	default:
+		itkGenericExceptionMacro(<< "Unexpected component type " << meshIO->GetComponentTypeAsString(componentType));
+	}
+	return components;
+}
+
+static itk::MeshIOBase::Pointer ReadMeshInformation(const char * fileName)
+{
+	itk::MeshIOBase::Pointer meshIO = itk::MeshIOFactory::CreateMeshIO(fileName, itk::MeshIOFactory::ReadMode);
+	if(meshIO.IsNull())
+	{
+		itkGenericExceptionMacro(<< "No MeshIO reads " << fileName);
+	}
+	meshIO->SetFileName(fileName);
+	meshIO->ReadMeshInformation();
+	return meshIO;
+}
+
+static bool Differs(const std::vector<double> & values0, const std::vector<double> & values1)
+{
+	const double tol = 1e-5;
+
+	if(values0.size() != values1.size())
+	{
+		return true;
+	}
+	for(std::size_t ii = 0; ii < values0.size(); ii++)
+	{
+		if(std::fabs(values0[ii] - values1[ii]) > tol * (1 + std::fabs(values0[ii])))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool CompareFiles(const char * inputFileName, const char * outputFileName)
+{
+	itk::MeshIOBase::Pointer inputIO = ReadMeshInformation(inputFileName);
+	itk::MeshIOBase::Pointer outputIO = ReadMeshInformation(outputFileName);
+
+	if(inputIO->GetNumberOfPoints() != outputIO->GetNumberOfPoints()
+		|| inputIO->GetNumberOfCells() != outputIO->GetNumberOfCells()
+		|| inputIO->GetPointDimension() != outputIO->GetPointDimension())
+	{
+		std::cerr << outputFileName << " has " << outputIO->GetNumberOfPoints() << " points and "
+			<< outputIO->GetNumberOfCells() << " cells instead of " << inputIO->GetNumberOfPoints()
+			<< " and " << inputIO->GetNumberOfCells() << std::endl;
+		return false;
+	}
+
+	const std::size_t numberOfComponents = inputIO->GetNumberOfPoints() * inputIO->GetPointDimension();
+	if(Differs(ReadSection(inputIO, itk::MeshIOBase::POINTS_SECTION, inputIO->GetPointComponentType(), numberOfComponents),
+		ReadSection(outputIO, itk::MeshIOBase::POINTS_SECTION, outputIO->GetPointComponentType(), numberOfComponents)))
+	{
+		std::cerr << "The points of " << outputFileName << " differ" << std::endl;
+		return false;
+	}
+
+	// The cells are compared by their points, as a format may store the
+	// triangles as polygons
+	const std::vector<double> inputCells = ReadSection(inputIO, itk::MeshIOBase::CELLS_SECTION,
+		inputIO->GetCellComponentType(), inputIO->GetCellBufferSize());
+	const std::vector<double> outputCells = ReadSection(outputIO, itk::MeshIOBase::CELLS_SECTION,
+		outputIO->GetCellComponentType(), outputIO->GetCellBufferSize());
+	if(inputCells.size() != outputCells.size())
+	{
+		std::cerr << "The cells of " << outputFileName << " differ" << std::endl;
+		return false;
+	}
+	for(std::size_t position = 0; position + 1 < inputCells.size(); )
+	{
+		const std::size_t numberOfCellPoints = static_cast<std::size_t>(inputCells[position + 1]);
+		bool differs = outputCells[position + 1] != inputCells[position + 1];
+		for(std::size_t ii = position + 2; !differs && ii < position + 2 + numberOfCellPoints; ii++)
+		{
+			differs = ii >= inputCells.size() || outputCells[ii] != inputCells[ii];
+		}
+		if(differs)
+		{
+			std::cerr << "The cell at " << position << " in the cells of " << outputFileName << " differs" << std::endl;
+			return false;
+		}
+		position += 2 + numberOfCellPoints;
+	}
+
+	// VTK files store the point data, which the other formats drop
+	if(std::string(outputIO->GetNameOfClass()) == "VTKPolyDataMeshIO"
+		&& outputIO->GetUpdatePointData() != inputIO->GetUpdatePointData())
+	{
+		std::cerr << "The point data of " << inputFileName << " is not in " << outputFileName << std::endl;
+		return false;
+	}
+	if(outputIO->GetUpdatePointData() && inputIO->GetUpdatePointData())
+	{
+		const std::size_t numberOfPixelComponents = inputIO->GetNumberOfPoints() * inputIO->GetNumberOfPointPixelComponents();
+		if(outputIO->GetNumberOfPointPixelComponents() != inputIO->GetNumberOfPointPixelComponents()
+			|| Differs(ReadSection(inputIO, itk::MeshIOBase::POINTDATA_SECTION, inputIO->GetPointPixelComponentType(),
+				numberOfPixelComponents),
+			ReadSection(outputIO, itk::MeshIOBase::POINTDATA_SECTION, outputIO->GetPointPixelComponentType(),
+				numberOfPixelComponents)))
+		{
+			std::cerr << "The point data of " << outputFileName << " differ" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " input output [binary] [ConvertMesh]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		if(argc > 4)
+		{
+			// The example converts the file in a process of its own
+			const std::string command = std::string("\"") + argv[4] + "\" \"" + argv[1] + "\" \"" + argv[2] + "\"";
+			if(std::system(command.c_str()) != 0)
+			{
+				std::cerr << "Failed: " << command << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			itk::MeshIOTranscoder::Pointer transcoder = itk::MeshIOTranscoder::New();
+			transcoder->SetInputFileName(argv[1]);
+			transcoder->SetOutputFileName(argv[2]);
+			if(argc > 3 && std::atoi(argv[3]) != 0)
+			{
+				transcoder->SetFileTypeAsBINARY();
+			}
+			transcoder->Update();
+		}
+
+		if(!CompareFiles(argv[1], argv[2]))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	catch(itk::ExceptionObject & err)
+	{
+		std::cerr << err << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
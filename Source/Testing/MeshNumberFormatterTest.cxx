@@ -0,0 +1,301 @@
+#include "itkMeshNumberFormatter.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Check that the floating point numbers written by MeshNumberFormatter read
+// back exactly: denormals, zeros of both signs, the extreme values, the
+// powers of ten and random values are formatted with the default precision,
+// which must read back to the same bits with operator>>, with no more digits
+// than needed by any value of the type, and with more digits than the
+// shortest decimals reading back for few values only.
+// With a precision set, the formatter must write like the stream.
+
+static unsigned int RandomState = 12345;
+
+static unsigned int Random()
+{
+	RandomState = RandomState * 1103515245 + 12345;
+	return RandomState;
+}
+
+static void RandomBits(float & value)
+{
+	const unsigned int bits = ( Random() >> 16 ) | ( Random() & 0xffff0000 );
+	std::memcpy(&value, &bits, sizeof(value));
+}
+
+static void RandomBits(double & value)
+{
+	unsigned long long bits = 0;
+	for(unsigned int ii = 0; ii < 4; ii++)
+	{
+		bits = ( bits << 16 ) | ( Random() >> 16 );
+	}
+	std::memcpy(&value, &bits, sizeof(value));
+}
+
+// Number of significant digits of a formatted number
+static unsigned int CountDigits(const std::string & text)
+{
+	std::string digits;
+	for(size_t ii = 0; ii < text.size() && text[ii] != 'e'; ii++)
+	{
+		if(text[ii] >= '0' && text[ii] <= '9')
+		{
+			digits += text[ii];
+		}
+	}
+	const size_t first = digits.find_first_not_of('0');
+	if(first == std::string::npos)
+	{
+		return 1;
+	}
+	return static_cast<unsigned int>(digits.find_last_not_of('0') - first + 1);
+}
+
+template<class T>
+static bool ReadsBack(const std::string & text, T value)
+{
+	std::istringstream input(text);
+	input.imbue(std::locale::classic());
+	T readValue = 0;
+	input >> readValue;
+	return !input.fail() && std::memcmp(&readValue, &value, sizeof(T)) == 0;
+}
+
+// Fewest digits written by the stream which read back to value
+template<class T>
+static unsigned int CountShortestDigits(T value)
+{
+	const int maximumDigits = std::numeric_limits<T>::digits10 + 3;
+	for(int precision = 1; precision < maximumDigits; precision++)
+	{
+		std::ostringstream output;
+		output.imbue(std::locale::classic());
+		output.precision(precision);
+		output << value;
+		if(ReadsBack(output.str(), value))
+		{
+			return CountDigits(output.str());
+		}
+	}
+	return maximumDigits;
+}
+
+template<class T>
+class FormatterChecker
+{
+public:
+	FormatterChecker(const char * name):m_Name(name), m_NumberOfValues(0), m_NumberOfLongerValues(0) {}
+
+	// Whether the value reads back exactly, with no more digits than needed
+	// by any value of the type
+	bool Check(T value)
+	{
+		char formatted[itk::MeshNumberFormatter::MaximumLength];
+		const std::string text(formatted, itk::MeshNumberFormatter::Format(formatted, value));
+
+		// The formatter inserting the value writes the same characters
+		std::ostringstream output;
+		{
+			itk::MeshNumberFormatter formatter(output);
+			formatter << value;
+		}
+
+		m_NumberOfValues++;
+		if(output.str() != text || !ReadsBack(text, value))
+		{
+			std::cerr << m_Name << ": " << text << " and " << output.str() << " do not read back to "
+				<< std::numeric_limits<T>::digits10 + 3 << " digits " << Print(value) << std::endl;
+			return false;
+		}
+
+		const unsigned int digits = CountDigits(text);
+		const unsigned int shortestDigits = CountShortestDigits(value);
+		if(digits > static_cast<unsigned int>(std::numeric_limits<T>::digits10 + 3))
+		{
+			std::cerr << m_Name << ": " << text << " has " << digits << " digits, " << shortestDigits
+				<< " read back to " << Print(value) << std::endl;
+			return false;
+		}
+		if(digits > shortestDigits)
+		{
+			m_NumberOfLongerValues++;
+		}
+		return true;
+	}
+
+	// Whether few values have more digits than the shortest decimals
+	bool CheckLongerValues() const
+	{
+		std::cout << m_Name << ": " << m_NumberOfLongerValues << " of " << m_NumberOfValues
+			<< " values written with more digits than the shortest" << std::endl;
+		if(m_NumberOfLongerValues * 100 > m_NumberOfValues)
+		{
+			std::cerr << m_Name << ": more than 1% of the values are not written with the shortest decimals" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+private:
+	static std::string Print(T value)
+	{
+		std::ostringstream output;
+		output.precision(std::numeric_limits<T>::digits10 + 3);
+		output << value;
+		return output.str();
+	}
+
+	const char * m_Name;
+	unsigned int m_NumberOfValues;
+	unsigned int m_NumberOfLongerValues;
+};
+
+template<class T>
+static bool CheckValues(const char * name, unsigned int numberOfRandomValues, int minimumExponent, int maximumExponent)
+{
+	FormatterChecker<T> checker(name);
+
+	const T denormal = std::numeric_limits<T>::denorm_min();
+	const T special[] = { T(0), -T(0), T(1), T(-1), std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+		std::numeric_limits<T>::min(), -std::numeric_limits<T>::min(), denormal, -denormal, 3 * denormal,
+		std::numeric_limits<T>::min() - denormal, std::numeric_limits<T>::min() / 3, std::numeric_limits<T>::epsilon(),
+		1 + std::numeric_limits<T>::epsilon(), T(0.1), T(1) / 3, T(2) / 3, T(123456789) };
+	for(unsigned int ii = 0; ii < sizeof(special) / sizeof(special[0]); ii++)
+	{
+		if(!checker.Check(special[ii]))
+		{
+			return false;
+		}
+	}
+
+	// The powers of ten, from the text of the decimals
+	for(int exponent = minimumExponent; exponent <= maximumExponent; exponent++)
+	{
+		std::ostringstream text;
+		text << "1e" << exponent;
+		std::istringstream input(text.str());
+		T power = 0;
+		input >> power;
+		if(!checker.Check(power) || !checker.Check(-power))
+		{
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < numberOfRandomValues; ii++)
+	{
+		T value;
+		RandomBits(value);
+		if(value != value || value > std::numeric_limits<T>::max() || value < -std::numeric_limits<T>::max())
+		{
+			continue;
+		}
+		if(!checker.Check(value))
+		{
+			return false;
+		}
+	}
+
+	return checker.CheckLongerValues();
+}
+
+// Whether the formatter with a precision writes the values like the stream,
+// and restores the precision of the stream
+template<class T>
+static bool CheckPrecision(const char * name, const std::vector<T> & values, unsigned int precision)
+{
+	std::ostringstream output;
+	std::ostringstream expected;
+	output.precision(4);
+	expected.precision(precision);
+	{
+		itk::MeshNumberFormatter formatter(output, precision);
+		for(size_t ii = 0; ii < values.size(); ii++)
+		{
+			formatter << values[ii] << ' ';
+			expected << values[ii] << ' ';
+		}
+	}
+
+	if(output.str() != expected.str() || output.precision() != 4)
+	{
+		std::cerr << name << ": the formatter with precision " << precision << " wrote " << output.str()
+			<< " instead of " << expected.str() << std::endl;
+		return false;
+	}
+
+	// Enough digits read back exactly
+	if(precision == static_cast<unsigned int>(std::numeric_limits<T>::digits10 + 3))
+	{
+		std::istringstream input(output.str());
+		for(size_t ii = 0; ii < values.size(); ii++)
+		{
+			T value = 0;
+			input >> value;
+			if(input.fail() || std::memcmp(&value, &values[ii], sizeof(T)) != 0)
+			{
+				std::cerr << name << ": value " << ii << " does not read back with precision " << precision << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template<class T>
+static bool CheckPrecisions(const char * name)
+{
+	std::vector<T> values;
+	values.push_back(-T(0));
+	values.push_back(std::numeric_limits<T>::denorm_min());
+	values.push_back(std::numeric_limits<T>::min());
+	values.push_back(-std::numeric_limits<T>::max());
+	values.push_back(T(1) / 3);
+	values.push_back(T(1e10));
+	for(unsigned int ii = 0; ii < 100; ii++)
+	{
+		T value;
+		RandomBits(value);
+		if(value == value && value <= std::numeric_limits<T>::max() && value >= -std::numeric_limits<T>::max())
+		{
+			values.push_back(value);
+		}
+	}
+
+	const unsigned int precisions[3] = { 1, 6, std::numeric_limits<T>::digits10 + 3 };
+	for(unsigned int ii = 0; ii < 3; ii++)
+	{
+		if(!CheckPrecision(name, values, precisions[ii]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	unsigned int numberOfRandomValues = 100000;
+	if(argc > 1)
+	{
+		numberOfRandomValues = static_cast<unsigned int>(std::atoi(argv[1]));
+	}
+
+	if(!CheckValues<float>("float", numberOfRandomValues, -45, 38)
+		|| !CheckValues<double>("double", numberOfRandomValues, -323, 308)
+		|| !CheckPrecisions<float>("float") || !CheckPrecisions<double>("double"))
+	{
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
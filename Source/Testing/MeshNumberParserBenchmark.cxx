@@ -0,0 +1,101 @@
+#include "itkMeshNumberParser.h"
+#include "itkMeshFileStreams.h"
+#include "itkTimeProbe.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compare the numbers read by operator>> and by MeshNumberParser from the
+// same ASCII text, failing on any difference, and time both.
+template<class T>
+bool BenchmarkNumbers(const char *name, const std::vector<T> & values, int precision)
+{
+	std::ostringstream output;
+	output.imbue(std::locale::classic());
+	output.precision(precision);
+	for(size_t i = 0; i < values.size(); i++)
+	{
+		output << values[i] << ( (i % 3 == 2) ? '\n' : ' ' );
+	}
+	const std::string text = output.str();
+
+	std::vector<T> streamValues(values.size());
+	itk::TimeProbe streamProbe;
+	streamProbe.Start();
+	std::istringstream input(text);
+	input.imbue(std::locale::classic());
+	for(size_t i = 0; i < streamValues.size(); i++)
+	{
+		input >> streamValues[i];
+	}
+	streamProbe.Stop();
+
+	std::vector<T> parsedValues(values.size());
+	itk::TimeProbe parserProbe;
+	parserProbe.Start();
+	itk::MemoryStreamBuffer buffer;
+	buffer.SetRegion(text.data(), text.size());
+	std::istream memoryInput(&buffer);
+	itk::MeshNumberParser::Read(memoryInput, &parsedValues[0], parsedValues.size());
+	parserProbe.Stop();
+
+	if(input.fail() || memoryInput.fail())
+	{
+		std::cerr << name << ": the numbers could not be read" << std::endl;
+		return false;
+	}
+	if(std::memcmp(&streamValues[0], &parsedValues[0], values.size() * sizeof(T)) != 0)
+	{
+		for(size_t i = 0; i < values.size(); i++)
+		{
+			if(std::memcmp(&streamValues[i], &parsedValues[i], sizeof(T)) != 0)
+			{
+				std::cerr << name << ": number " << i << " read as " << parsedValues[i]
+					<< " instead of " << streamValues[i] << std::endl;
+				break;
+			}
+		}
+		return false;
+	}
+
+	std::cout << name << ": " << values.size() << " numbers, stream "
+		<< streamProbe.GetMeanTime() << " s, parser " << parserProbe.GetMeanTime() << " s";
+	if(parserProbe.GetMeanTime() > 0)
+	{
+		std::cout << ", " << streamProbe.GetMeanTime() / parserProbe.GetMeanTime() << "x";
+	}
+	std::cout << std::endl;
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	const unsigned long numberOfValues = argc > 1 ? std::atol(argv[1]) : 3000000;
+
+	std::srand(1);
+	std::vector<float> floats(numberOfValues);
+	std::vector<double> doubles(numberOfValues);
+	std::vector<unsigned int> indices(numberOfValues);
+	for(unsigned long i = 0; i < numberOfValues; i++)
+	{
+		// Coordinates of a few orders of magnitude, and some exponents
+		const double value = ( std::rand() - RAND_MAX / 2.0 ) / ( 1.0 + std::rand() % 1000 );
+		floats[i] = static_cast<float>( i % 17 ? value : value * 1e-30 );
+		doubles[i] = i % 13 ? value : value * 1e200;
+		indices[i] = static_cast<unsigned int>( std::rand() );
+	}
+
+	bool success = true;
+	success = BenchmarkNumbers("float, 6 digits", floats, 6) && success;
+	success = BenchmarkNumbers("float, 9 digits", floats, 9) && success;
+	success = BenchmarkNumbers("double, 6 digits", doubles, 6) && success;
+	success = BenchmarkNumbers("double, 17 digits", doubles, 17) && success;
+	success = BenchmarkNumbers("unsigned int", indices, 10) && success;
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+#include "itkMeshNumberParser.h"
+#include "itkMeshFileStreams.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+
+// Check the edge cases of MeshNumberParser: numbers with more than 19
+// significant digits, halfway cases rounding to even, denormals, exponents
+// overflowing the type or underflowing to zeros of both signs, leading
+// signs, and malformed numbers, which must fail rather than read a part of
+// the number. The numbers read are compared with the expected bits and with
+// operator>> of the classic locale, along with random long numbers.
+
+struct DoubleCase
+{
+	const char * m_Text;
+	double       m_Expected;
+};
+
+// Decimals of 2^53 + 1, half way between two doubles, and of 1 + 2^-53
+#define TWO_53_PLUS_1 "9007199254740993"
+#define ONE_PLUS_2_MINUS_53 "1.00000000000000011102230246251565404236316680908203125"
+
+static const DoubleCase DoubleCases[] = {
+	// Leading signs
+	{ "+1.5", 1.5 },
+	{ "+0", 0.0 },
+	{ "+1e+2", 100.0 },
+	{ "-0.25e1", -2.5 },
+	// Halfway cases round to even, and any digit beyond rounds up
+	{ TWO_53_PLUS_1, 9007199254740992.0 },
+	{ "9007199254740995", 9007199254740996.0 },
+	{ TWO_53_PLUS_1 "0000000000000000000000e-22", 9007199254740992.0 },
+	{ TWO_53_PLUS_1 ".0000000000000000000001", 9007199254740994.0 },
+	{ ONE_PLUS_2_MINUS_53, 1.0 },
+	{ ONE_PLUS_2_MINUS_53 "0000000000000000001", 1.0 + std::numeric_limits<double>::epsilon() },
+	{ "-" ONE_PLUS_2_MINUS_53, -1.0 },
+	// More than 19 significant digits
+	{ "123456789012345678901234567890", 123456789012345678901234567890.0 },
+	{ "0.000000000000000000000000000000123456789012345678901234567890", 1.2345678901234567890123456789e-31 },
+	{ "1.797693134862315708145274237317043567981e308", std::numeric_limits<double>::max() },
+	// Denormals, and the halfway case below the smallest one
+	{ "4.9406564584124654e-324", std::numeric_limits<double>::denorm_min() },
+	{ "2.4703282292062328e-324", std::numeric_limits<double>::denorm_min() },
+	{ "2.4703282292062327e-324", 0.0 },
+	{ "2.2250738585072011e-308", 2.2250738585072011e-308 },
+	{ "2.2250738585072014e-308", std::numeric_limits<double>::min() },
+	// Exponents far out of range
+	{ "1e-400", 0.0 },
+	{ "-1e-400", -0.0 },
+	{ "0e99999999999", 0.0 },
+	{ "1e-99999999999", 0.0 },
+	{ "1.7976931348623157e308", std::numeric_limits<double>::max() }
+};
+
+// Numbers which are out of the range of double or malformed
+static const char * const DoubleFailures[] = { "1e309", "-1e309", "1.7976931348623159e308", "1e99999999999",
+	"", "   ", "+", "-", ".", "+.", "e5", "-e5", ".e1", "+-1", "--1", "1e", "1E", "1e+", "1e-", "-2.5e", "inf", "nan" };
+
+// Numbers which are read up to the given number of characters, the rest
+// being left to the next read like operator>> does
+struct PrefixCase
+{
+	const char * m_Text;
+	int          m_Length;
+};
+
+static const PrefixCase PrefixCases[] = { { "1.5x", 3 }, { "1e5.5", 3 }, { "0x10", 1 }, { "1..2", 2 },
+	{ "1,5", 1 }, { "  7 8", 3 }, { "1/2/3", 1 } };
+
+static bool SameBits(double value, double expected)
+{
+	return std::memcmp(&value, &expected, sizeof(double)) == 0;
+}
+
+template<class T>
+static bool ReadWithStream(const std::string & text, T & value)
+{
+	std::istringstream input(text);
+	input.imbue(std::locale::classic());
+	input >> value;
+	return !input.fail();
+}
+
+// Whether text is parsed to the end like operator>> reads it, or fails
+// like operator>>
+template<class T>
+static bool CompareWithStream(const std::string & text)
+{
+	T value = 0;
+	T expected = 0;
+	const char * end = itk::MeshNumberParser::Parse(text.c_str(), text.c_str() + text.size(), value);
+	if(!ReadWithStream(text, expected))
+	{
+		if(end != 0)
+		{
+			std::cerr << text << " is parsed as " << value << " while operator>> fails" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	if(end != text.c_str() + text.size() || std::memcmp(&value, &expected, sizeof(T)) != 0)
+	{
+		std::cerr << text << " is parsed as " << value << " instead of " << expected << std::endl;
+		return false;
+	}
+	return true;
+}
+
+static bool CheckDoubles()
+{
+	for(unsigned int ii = 0; ii < sizeof(DoubleCases) / sizeof(DoubleCases[0]); ii++)
+	{
+		const std::string text = DoubleCases[ii].m_Text;
+		double value = 0;
+		const char * end = itk::MeshNumberParser::Parse(text.c_str(), text.c_str() + text.size(), value);
+		if(end != text.c_str() + text.size() || !SameBits(value, DoubleCases[ii].m_Expected))
+		{
+			std::cerr.precision(17);
+			std::cerr << text << " is parsed as " << value << " instead of " << DoubleCases[ii].m_Expected << std::endl;
+			return false;
+		}
+		if(!CompareWithStream<double>(text) || !CompareWithStream<float>(text))
+		{
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < sizeof(DoubleFailures) / sizeof(DoubleFailures[0]); ii++)
+	{
+		const char * text = DoubleFailures[ii];
+		double value = 0;
+		float floatValue = 0;
+		if(itk::MeshNumberParser::Parse(text, text + std::strlen(text), value) != 0
+			|| itk::MeshNumberParser::Parse(text, text + std::strlen(text), floatValue) != 0)
+		{
+			std::cerr << "\"" << text << "\" is parsed as " << value << std::endl;
+			return false;
+		}
+	}
+
+	for(unsigned int ii = 0; ii < sizeof(PrefixCases) / sizeof(PrefixCases[0]); ii++)
+	{
+		const char * text = PrefixCases[ii].m_Text;
+		double value = 0;
+		double expected = 0;
+		const char * end = itk::MeshNumberParser::Parse(text, text + std::strlen(text), value);
+		if(end != text + PrefixCases[ii].m_Length || !ReadWithStream(text, expected) || !SameBits(value, expected))
+		{
+			std::cerr << "\"" << text << "\" is not parsed up to character " << PrefixCases[ii].m_Length << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool CheckFloats()
+{
+	// The float halfway cases, denormals and extreme values
+	const char * texts[] = { "16777217", "16777219", "16777217.000000000000000000001", "3.4028235e38",
+		"1.4012984643248171e-45", "7.006492321624086e-46", "7.006492321624087e-46", "1.1754942e-38", "1e-50",
+		"-1e-50", "+1e+38" };
+	for(unsigned int ii = 0; ii < sizeof(texts) / sizeof(texts[0]); ii++)
+	{
+		if(!CompareWithStream<float>(texts[ii]))
+		{
+			return false;
+		}
+	}
+
+	const char * failures[] = { "3.4028236e38", "1e39", "-1e39", "1e", "+" };
+	for(unsigned int ii = 0; ii < sizeof(failures) / sizeof(failures[0]); ii++)
+	{
+		float value = 0;
+		if(itk::MeshNumberParser::Parse(failures[ii], failures[ii] + std::strlen(failures[ii]), value) != 0)
+		{
+			std::cerr << "\"" << failures[ii] << "\" is parsed as the float " << value << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool CheckIntegers()
+{
+	const char * texts[] = { "+7", "-0", "2147483647", "-2147483648", "0000000000000000000000012" };
+	for(unsigned int ii = 0; ii < sizeof(texts) / sizeof(texts[0]); ii++)
+	{
+		if(!CompareWithStream<int>(texts[ii]) || !CompareWithStream<long long>(texts[ii]))
+		{
+			return false;
+		}
+	}
+	if(!CompareWithStream<long long>("-9223372036854775808")
+		|| !CompareWithStream<unsigned long long>("18446744073709551615"))
+	{
+		return false;
+	}
+
+	const char * failures[] = { "2147483648", "-2147483649", "99999999999999999999", "", "+", "-", "+-1" };
+	for(unsigned int ii = 0; ii < sizeof(failures) / sizeof(failures[0]); ii++)
+	{
+		int value = 0;
+		if(itk::MeshNumberParser::Parse(failures[ii], failures[ii] + std::strlen(failures[ii]), value) != 0)
+		{
+			std::cerr << "\"" << failures[ii] << "\" is parsed as the int " << value << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Whether Read() from memory stops at a malformed number with the failbit
+// set, like operator>>
+static bool CheckRead()
+{
+	const std::string text = "1.5 +2 1e 4";
+	itk::MemoryStreamBuffer buffer;
+	buffer.SetRegion(text.data(), text.size());
+	std::istream input(&buffer);
+
+	double values[4] = { 0, 0, 0, 0 };
+	itk::MeshNumberParser::Read(input, values, 4);
+	if(!input.fail() || values[0] != 1.5 || values[1] != 2)
+	{
+		std::cerr << "The malformed number of \"" << text << "\" is read" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Random numbers with up to 25 significant digits and random exponents
+template<class T>
+static bool CheckRandomNumbers(unsigned int numberOfNumbers)
+{
+	std::srand(12345);
+	for(unsigned int ii = 0; ii < numberOfNumbers; ii++)
+	{
+		std::string text = ( std::rand() % 2 ) ? "-" : "+";
+		const int numberOfDigits = 1 + std::rand() % 25;
+		const int point = std::rand() % ( numberOfDigits + 1 );
+		for(int jj = 0; jj < numberOfDigits; jj++)
+		{
+			if(jj == point)
+			{
+				text += '.';
+			}
+			text += static_cast<char>('0' + std::rand() % 10);
+		}
+		const int exponentRange = 2 * std::numeric_limits<T>::max_exponent10;
+		std::ostringstream exponent;
+		exponent << 'e' << std::rand() % exponentRange - exponentRange / 2 - numberOfDigits / 2;
+		text += exponent.str();
+
+		if(!CompareWithStream<T>(text))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	unsigned int numberOfRandomNumbers = 100000;
+	if(argc > 1)
+	{
+		numberOfRandomNumbers = static_cast<unsigned int>(std::atoi(argv[1]));
+	}
+
+	if(!CheckDoubles() || !CheckFloats() || !CheckIntegers() || !CheckRead()
+		|| !CheckRandomNumbers<double>(numberOfRandomNumbers) || !CheckRandomNumbers<float>(numberOfRandomNumbers))
+	{
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}